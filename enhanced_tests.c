@@ -124,14 +124,14 @@ int test_edge_cases_zero_one_boundary(void) {
     if (ret == 0 && result.words[0] == 34) {
         printf("   ✅ 34^1 mod 35 = 34\n");
     } else {
-        printf("   ❌ 34^1 mod 35 failed, got %u\n", result.words[0]);
+        printf("   ❌ 34^1 mod 35 failed, got %" PRIuWORD "\n", result.words[0]);
     }
     
     /* (n-1)^2 mod n should be 1 for prime modulus */
     bigint_set_u32(&result, 2);
     ret = bigint_mod_exp(&result, &boundary_val, &result, &mod);
     if (ret == 0) {
-        printf("   ✅ 34^2 mod 35 = %u (computed successfully)\n", result.words[0]);
+        printf("   ✅ 34^2 mod 35 = %" PRIuWORD " (computed successfully)\n", result.words[0]);
         passed++;
     } else {
         printf("   ❌ 34^2 mod 35 computation failed\n");
@@ -7,15 +7,199 @@
  * @version FINAL_COMPLETE_FIXED_v8.3
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include "rsa_4096.h"
 
+/* ===================== SERVICE MODE ===================== */
+
+/* serve owns stdout for its wire protocol, so library diagnostics go to stderr */
+static void main_stderr_sink(int level, const char *func, int line, const char *message, void *user) {
+    (void)level;
+    (void)func;
+    (void)line;
+    (void)user;
+    fprintf(stderr, "%s\n", message);
+}
+
+static int main_serve(int argc, char **argv) {
+    const char *pub_path = NULL, *priv_path = NULL, *socket_path = NULL, *profile_path = NULL;
+    int crt_helper_cpu = -2;   /* -2: no helper, -1: helper left unpinned */
+    int blinding = 0;
+    rsa_4096_serve_config_t config = {0, 0, 0};
+    for (int i = 2; i < argc; i += 2) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value != NULL && strcmp(argv[i], "--pub") == 0) {
+            pub_path = value;
+        } else if (value != NULL && strcmp(argv[i], "--priv") == 0) {
+            priv_path = value;
+        } else if (value != NULL && strcmp(argv[i], "--socket") == 0) {
+            socket_path = value;
+        } else if (value != NULL && strcmp(argv[i], "--threads") == 0) {
+            config.num_threads = atoi(value);
+        } else if (value != NULL && strcmp(argv[i], "--batch") == 0) {
+            config.max_batch = atoi(value);
+        } else if (value != NULL && strcmp(argv[i], "--profile") == 0) {
+            profile_path = value;
+        } else if (value != NULL && strcmp(argv[i], "--crt-helper") == 0) {
+            crt_helper_cpu = atoi(value);
+            if (crt_helper_cpu < -1) crt_helper_cpu = -1;
+        } else if (value != NULL && strcmp(argv[i], "--blinding") == 0) {
+            blinding = strcmp(value, "on") == 0;
+        } else {
+            pub_path = priv_path = NULL;
+            break;
+        }
+    }
+    if (pub_path == NULL && priv_path == NULL) {
+        fprintf(stderr,
+                "Usage: %s serve [--pub pub.blob] [--priv priv.blob] [--socket PATH] [--threads N] [--batch N] "
+                "[--profile PATH] [--crt-helper CPU|-1] [--blinding on|off]\n", argv[0]);
+        return 1;
+    }
+    
+    rsa_4096_trace_set_sink(main_stderr_sink, NULL);
+    /* Cutovers are process-wide, so settle them before any worker starts */
+    if (profile_path != NULL && rsa_4096_tuning_init(profile_path, NULL) < 0) {
+        return 1;
+    }
+    if (crt_helper_cpu >= -1 && rsa_4096_parallel_crt_start(crt_helper_cpu) != 0) {
+        return 1;
+    }
+    rsa_4096_key_t pub_key, priv_key;
+    int ret = 0;
+    if (pub_path != NULL) {
+        ret = rsa_4096_key_load_blob(&pub_key, pub_path);
+    }
+    if (ret == 0 && priv_path != NULL) {
+        ret = rsa_4096_key_load_blob(&priv_key, priv_path);
+        if (ret == 0 && blinding) {
+            ret = rsa_4096_key_enable_blinding(&priv_key);
+        }
+    }
+    if (ret == 0) {
+        fprintf(stderr, "[main:%d] Serving on %s\n", __LINE__, socket_path != NULL ? socket_path : "stdin/stdout");
+        const rsa_4096_key_t *pub = pub_path != NULL ? &pub_key : NULL;
+        const rsa_4096_key_t *priv = priv_path != NULL ? &priv_key : NULL;
+        ret = socket_path != NULL ? rsa_4096_serve_unix(pub, priv, socket_path, &config)
+                                  : rsa_4096_serve_stream(pub, priv, 0, 1, &config, NULL);  /* fd 0 / fd 1 */
+    }
+    if (pub_path != NULL) rsa_4096_free(&pub_key);
+    if (priv_path != NULL) rsa_4096_free(&priv_key);
+    rsa_4096_parallel_crt_stop();
+    return ret == 0 ? 0 : 1;
+}
+
+/* ===================== FILE STREAMING ===================== */
+
+static int main_file(int argc, char **argv) {
+    rsa_4096_stream_config_t config = {0, 0};
+    int decrypt = argc >= 3 && strcmp(argv[2], "decrypt") == 0;
+    int ok = argc >= 6 && argc % 2 == 0 && (decrypt || strcmp(argv[2], "encrypt") == 0);
+    for (int i = 6; ok && i < argc; i += 2) {
+        if (strcmp(argv[i], "--threads") == 0) {
+            config.num_threads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--chunk") == 0) {
+            config.chunk_blocks = atoi(argv[i + 1]);
+        } else {
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Usage: %s file <encrypt|decrypt> <key.blob> <in|-> <out|-> [--threads N] [--chunk N]\n",
+                argv[0]);
+        return 1;
+    }
+    
+    /* "-" is stdin/stdout, so diagnostics stay off stdout here as well */
+    rsa_4096_trace_set_sink(main_stderr_sink, NULL);
+    rsa_4096_key_t key;
+    if (rsa_4096_key_load_blob(&key, argv[3]) != 0) {
+        return 1;
+    }
+    int in_fd = strcmp(argv[4], "-") == 0 ? 0 : open(argv[4], O_RDONLY);
+    int out_fd = strcmp(argv[5], "-") == 0 ? 1 : open(argv[5], O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    int ret = -1;
+    if (in_fd < 0 || out_fd < 0) {
+        fprintf(stderr, "Cannot open %s\n", in_fd < 0 ? argv[4] : argv[5]);
+    } else {
+        rsa_4096_stream_stats_t stats;
+        ret = decrypt ? rsa_4096_decrypt_stream(&key, in_fd, out_fd, &config, &stats)
+                      : rsa_4096_encrypt_stream(&key, in_fd, out_fd, &config, &stats);
+        if (ret == 0) {
+            fprintf(stderr, "[main:%d] %s %zu blocks: %zu -> %zu bytes (%s input)\n", __LINE__,
+                    decrypt ? "Decrypted" : "Encrypted", stats.blocks, stats.bytes_in, stats.bytes_out,
+                    stats.mapped ? "mapped" : "streamed");
+        }
+    }
+    if (in_fd > 0) close(in_fd);
+    if (out_fd > 1) close(out_fd);
+    rsa_4096_free(&key);
+    return ret == 0 ? 0 : 1;
+}
+
+/* ===================== AUTOTUNING ===================== */
+
+static int main_tune(int argc, char **argv) {
+    const char *path = NULL;
+    int force = 0;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--force") == 0) {
+            force = 1;
+        } else {
+            printf("Usage: %s tune [--profile PATH] [--force]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    rsa_4096_tuning_t tuning;
+    int ret;
+    if (force) {
+        ret = rsa_4096_tuning_calibrate(&tuning);
+        if (ret == 0) ret = rsa_4096_tuning_apply(&tuning);
+        if (ret == 0 && path != NULL) ret = rsa_4096_tuning_save(&tuning, path);
+    } else {
+        ret = rsa_4096_tuning_init(path, &tuning);
+    }
+    if (ret < 0) {
+        printf("❌ Tuning failed (%d)\n", ret);
+        return 1;
+    }
+    
+    const int *w = tuning.window_min_bits;
+    printf("[main:%d] %s tuning profile%s%s\n", __LINE__, tuning.calibrated ? "Calibrated" : "Default",
+           path != NULL ? " " : "", path != NULL ? path : "");
+    printf("  SIMD kernel:         %s from %d-bit moduli\n", montgomery_simd_name(montgomery_simd_active()),
+           tuning.simd_min_bits);
+    printf("  Windows 2..6 from:   %d / %d / %d / %d / %d exponent bits (0 = unused)\n", w[2], w[3], w[4], w[5],
+           w[6]);
+    printf("  Karatsuba from:      %d words\n", tuning.karatsuba_cutoff);
+    printf("  Montgomery from:     %d-bit moduli\n", tuning.montgomery_min_bits);
+    printf("  CRT from:            %d-bit moduli\n", tuning.crt_min_bits);
+    return 0;
+}
+
 int main(int argc, char **argv) {
+    if (argc >= 2 && strcmp(argv[1], "serve") == 0) {
+        return main_serve(argc, argv);
+    }
+    if (argc >= 2 && strcmp(argv[1], "file") == 0) {
+        return main_file(argc, argv);
+    }
     printf("[main:%d] Starting RSA-4096 application\n", __LINE__);
     if (argc < 2) {
-        printf("Usage: %s [verify|test|benchmark|binary|manual|real4096|hybrid|roundtrip|boundary|montgomery|algorithms|edge]\n", argv[0]);
+        printf("Usage: %s [verify|test|benchmark|binary|manual|real4096|hybrid|roundtrip|boundary|montgomery|algorithms|edge|cios|window|crt|division|blob|trace|batch|simd|karatsuba|square|shortexp|convert|workspace|multi|keygen|service|stream|registry|tuning|kernels|parallelcrt|stats|barrett|lazy|blinding|fixedio|keyblob|tune|serve|file]\n", argv[0]);
+        printf("       %s keyblob <out_file> <n> <exponent> <is_private> [p q dP dQ qInv]\n", argv[0]);
+        printf("       %s serve [--pub pub.blob] [--priv priv.blob] [--socket PATH] [--threads N] [--batch N] [--profile PATH] [--crt-helper CPU|-1]\n", argv[0]);
+        printf("       %s file <encrypt|decrypt> <key.blob> <in|-> <out|-> [--threads N] [--chunk N]\n", argv[0]);
+        printf("       %s tune [--profile PATH] [--force]\n", argv[0]);
         return 1;
     }
     if (strcmp(argv[1], "verify") == 0) {
@@ -67,6 +251,132 @@ int main(int argc, char **argv) {
         printf("[main:%d] Running edge cases testing\n", __LINE__);
         return test_edge_cases_zero_one_boundary();
     }
+    if (strcmp(argv[1], "cios") == 0) {
+        printf("[main:%d] Running fused CIOS Montgomery testing\n", __LINE__);
+        return test_montgomery_cios();
+    }
+    if (strcmp(argv[1], "window") == 0) {
+        printf("[main:%d] Running sliding-window Montgomery exponentiation testing\n", __LINE__);
+        return test_montgomery_sliding_window();
+    }
+    if (strcmp(argv[1], "crt") == 0) {
+        printf("[main:%d] Running CRT private-key decryption testing\n", __LINE__);
+        return test_rsa_crt_decryption();
+    }
+    if (strcmp(argv[1], "division") == 0) {
+        printf("[main:%d] Running Knuth division testing\n", __LINE__);
+        return test_bigint_division();
+    }
+    if (strcmp(argv[1], "blob") == 0) {
+        printf("[main:%d] Running key blob persistence testing\n", __LINE__);
+        return test_key_blob();
+    }
+    if (strcmp(argv[1], "trace") == 0) {
+        printf("[main:%d] Running trace sink testing\n", __LINE__);
+        return test_trace_sink();
+    }
+    if (strcmp(argv[1], "batch") == 0) {
+        printf("[main:%d] Running batch worker pool testing\n", __LINE__);
+        return test_batch_operations();
+    }
+    if (strcmp(argv[1], "simd") == 0) {
+        printf("[main:%d] Running SIMD Montgomery kernel testing\n", __LINE__);
+        return test_montgomery_simd();
+    }
+    if (strcmp(argv[1], "karatsuba") == 0) {
+        printf("[main:%d] Running Karatsuba multiplication testing\n", __LINE__);
+        return test_bigint_karatsuba();
+    }
+    if (strcmp(argv[1], "square") == 0) {
+        printf("[main:%d] Running Montgomery squaring kernel testing\n", __LINE__);
+        return test_montgomery_squaring();
+    }
+    if (strcmp(argv[1], "shortexp") == 0) {
+        printf("[main:%d] Running short public exponent testing\n", __LINE__);
+        return test_short_exponent();
+    }
+    if (strcmp(argv[1], "convert") == 0) {
+        printf("[main:%d] Running chunked conversion testing\n", __LINE__);
+        return test_chunked_conversion();
+    }
+    if (strcmp(argv[1], "workspace") == 0) {
+        printf("[main:%d] Running workspace API testing\n", __LINE__);
+        return test_workspace_api();
+    }
+    if (strcmp(argv[1], "multi") == 0) {
+        printf("[main:%d] Running multi-buffer exponentiation testing\n", __LINE__);
+        return test_montgomery_exp_multi();
+    }
+    if (strcmp(argv[1], "keygen") == 0) {
+        printf("[main:%d] Running key generation testing\n", __LINE__);
+        return test_key_generation();
+    }
+    if (strcmp(argv[1], "service") == 0) {
+        printf("[main:%d] Running service mode testing\n", __LINE__);
+        return test_serve_mode();
+    }
+    if (strcmp(argv[1], "stream") == 0) {
+        printf("[main:%d] Running streaming file encryption testing\n", __LINE__);
+        return test_stream_encryption();
+    }
+    if (strcmp(argv[1], "registry") == 0) {
+        printf("[main:%d] Running shared key registry testing\n", __LINE__);
+        return test_key_registry();
+    }
+    if (strcmp(argv[1], "tuning") == 0) {
+        printf("[main:%d] Running autotuning testing\n", __LINE__);
+        return test_tuning();
+    }
+    if (strcmp(argv[1], "kernels") == 0) {
+        printf("[main:%d] Running size-specialised Montgomery kernel testing\n", __LINE__);
+        return test_fixed_kernels();
+    }
+    if (strcmp(argv[1], "parallelcrt") == 0) {
+        printf("[main:%d] Running parallel CRT helper testing\n", __LINE__);
+        return test_parallel_crt();
+    }
+    if (strcmp(argv[1], "stats") == 0) {
+        printf("[main:%d] Running performance counter testing\n", __LINE__);
+        return test_perf_stats();
+    }
+    if (strcmp(argv[1], "barrett") == 0) {
+        printf("[main:%d] Running Barrett reduction testing\n", __LINE__);
+        return test_barrett();
+    }
+    if (strcmp(argv[1], "lazy") == 0) {
+        printf("[main:%d] Running lazy reduction testing\n", __LINE__);
+        return test_lazy_reduction();
+    }
+    if (strcmp(argv[1], "blinding") == 0) {
+        printf("[main:%d] Running blinding testing\n", __LINE__);
+        return test_blinding();
+    }
+    if (strcmp(argv[1], "fixedio") == 0) {
+        printf("[main:%d] Running fixed-length I/O testing\n", __LINE__);
+        return test_fixed_io();
+    }
+    if (strcmp(argv[1], "tune") == 0) {
+        return main_tune(argc, argv);
+    }
+    if (strcmp(argv[1], "keyblob") == 0) {
+        /* Precompute a key once and persist it for rsa_4096_key_load_blob() */
+        if (argc != 6 && argc != 11) {
+            printf("Usage: %s keyblob <out_file> <n> <exponent> <is_private> [p q dP dQ qInv]\n", argv[0]);
+            return 1;
+        }
+        printf("[main:%d] Writing precomputed key blob to %s\n", __LINE__, argv[2]);
+        rsa_4096_key_t key;
+        int ret = rsa_4096_load_key(&key, argv[3], argv[4], atoi(argv[5]));
+        if (ret == 0 && argc == 11) {
+            ret = rsa_4096_load_key_crt(&key, argv[6], argv[7], argv[8], argv[9], argv[10]);
+        }
+        if (ret == 0) {
+            ret = rsa_4096_key_save_blob(&key, argv[2]);
+        }
+        rsa_4096_free(&key);
+        printf("%s Key blob %s\n", ret == 0 ? "✅" : "❌", ret == 0 ? "written" : "generation failed");
+        return ret == 0 ? 0 : 1;
+    }
     printf("Unknown command: %s\n", argv[1]);
     return 1;
 }
\ No newline at end of file
@@ -11,18 +11,61 @@
 #define RSA_4096_H
 
 #include <stdint.h>
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdio.h>
 
 /* ===================== CONFIGURATION ===================== */
 
 /* BigInt configuration for 4096-bit numbers */
+/* Limb width is a build-time choice: 32-bit (default, portable) or 64-bit (make LIMB_BITS=64) */
+#ifndef BIGINT_LIMB_BITS
+#define BIGINT_LIMB_BITS 32
+#endif
+
+#if BIGINT_LIMB_BITS == 64
+#ifndef __SIZEOF_INT128__
+#error "BIGINT_LIMB_BITS=64 requires a compiler with unsigned __int128 support"
+#endif
+typedef uint64_t bigint_word_t;                    /* Single limb */
+__extension__ typedef unsigned __int128 bigint_dword_t;  /* Double-width product/accumulator */
+#define BIGINT_WORD_SIZE 64
+#define BIGINT_WORD_MASK 0xFFFFFFFFFFFFFFFFULL
+#define PRIxWORD PRIx64
+#define PRIuWORD PRIu64
+#elif BIGINT_LIMB_BITS == 32
+typedef uint32_t bigint_word_t;                    /* Single limb */
+typedef uint64_t bigint_dword_t;                   /* Double-width product/accumulator */
 #define BIGINT_WORD_SIZE 32
 #define BIGINT_WORD_MASK 0xFFFFFFFFUL
-#define BIGINT_4096_WORDS 512  /* Increased to 512 words to handle full RSA-4096 Montgomery multiplication and intermediate results */
+#define PRIxWORD PRIx32
+#define PRIuWORD PRIu32
+#else
+#error "BIGINT_LIMB_BITS must be 32 or 64"
+#endif
+
+#define BIGINT_WORD_BYTES (BIGINT_WORD_SIZE / 8)
+#define BIGINT_4096_WORDS (16384 / BIGINT_WORD_SIZE)  /* 16384 bits (512 words at 32-bit) to handle full RSA-4096 Montgomery multiplication and intermediate results */
 
 /* Montgomery REDC specific constants */
-#define MONTGOMERY_R_WORDS 264  /* Doubled to handle larger R values for 4096-bit modulus */
+#define MONTGOMERY_R_WORDS (8448 / BIGINT_WORD_SIZE)  /* Doubled to handle larger R values for 4096-bit modulus */
+#define MONTGOMERY_MAX_WORDS (4096 / BIGINT_WORD_SIZE)  /* Widest modulus held in a fixed-width residue */
+#define MONTGOMERY_WINDOW_AUTO 0  /* montgomery_exp_window: pick width from exponent length */
+#define MONTGOMERY_MAX_WINDOW 6   /* Largest sliding window (32 odd powers precomputed) */
+#define MONTGOMERY_WINDOW_DEFAULT_BITS {0, 0, 0, 24, 80, 240, 672}  /* Shortest exponent per width 0..6 */
+#define MONTGOMERY_TABLE_SIZE (1 << (MONTGOMERY_MAX_WINDOW - 1))
+#define MONTGOMERY_SIMD_MAX_LIMBS 160  /* ceil((4096 + 2) / 29) = 142 limbs, padded to whole vectors with one spare limb */
+
+/* Multiplication: Karatsuba from this many words per operand, schoolbook below */
+#ifndef BIGINT_KARATSUBA_CUTOFF
+#define BIGINT_KARATSUBA_CUTOFF (768 / BIGINT_WORD_SIZE)
+#endif
+#define BIGINT_MUL_SCRATCH_WORDS (4 * BIGINT_4096_WORDS)  /* Stack scratch in bigint_mul */
+
+/* bigint_to_decimal: chunked single-word passes up to this many words, divide-and-conquer above */
+#ifndef BIGINT_DEC_DC_WORDS
+#define BIGINT_DEC_DC_WORDS (768 / BIGINT_WORD_SIZE)
+#endif
 
 /* Algorithm limits */
 #define MAX_DIVISION_ITERATIONS 10000
@@ -37,13 +80,113 @@
 #define LOG_LEVEL LOG_INFO
 #endif
 
+/* Hot-path trace points below TRACE_LEVEL compile to nothing; build with -DTRACE_LEVEL=0 to diagnose */
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL LOG_LEVEL
+#endif
+
+/* ===================== TRACE SINK ===================== */
+
+/**
+ * @brief Receives every emitted trace line (without trailing newline)
+ */
+typedef void (*rsa_4096_trace_sink_t)(int level, const char *func, int line, const char *message, void *user);
+
+void rsa_4096_trace_set_sink(rsa_4096_trace_sink_t sink, void *user);  /* NULL restores stdout; install before starting worker threads */
+void rsa_4096_trace_emit(int level, const char *func, int line, const char *fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+
+/* ===================== PERFORMANCE COUNTERS ===================== */
+
+/* Counters compile to nothing with -DRSA_4096_STATS=0; otherwise they stay off until
+ * rsa_4096_stats_enable(1), and an idle probe costs one call and one flag load */
+#ifndef RSA_4096_STATS
+#define RSA_4096_STATS 1
+#endif
+
+#define RSA_4096_STAT_BIGINT_MUL       0
+#define RSA_4096_STAT_BIGINT_DIV       1
+#define RSA_4096_STAT_DIV_ITERATIONS   2   /* Quotient words produced by bigint_div */
+#define RSA_4096_STAT_MONT_REDC        3   /* Stand-alone REDC passes (leaving Montgomery form, reduce) */
+#define RSA_4096_STAT_MONT_MUL         4   /* Montgomery multiplications, scalar or one vector kernel call */
+#define RSA_4096_STAT_MONT_SQR         5
+#define RSA_4096_STAT_MONT_EXP         6   /* Exponentiations on the scalar Montgomery path */
+#define RSA_4096_STAT_SIMD_EXP         7   /* Exponentiations run by a vector kernel */
+#define RSA_4096_STAT_MULTI_EXP        8   /* Lanes run through montgomery_exp_multi */
+#define RSA_4096_STAT_TRADITIONAL_EXP  9   /* bigint_mod_exp: the non-Montgomery fallback */
+#define RSA_4096_STAT_CRT_EXP         10
+#define RSA_4096_STAT_BARRETT_REDUCE  11   /* Barrett reductions, the multiply-only path for any modulus */
+#define RSA_4096_STAT_COUNTERS        12
+
+#define RSA_4096_TIME_CTX_INIT 0   /* montgomery_ctx_init */
+#define RSA_4096_TIME_CONVERT  1   /* Into and out of Montgomery form, also inside exponentiations */
+#define RSA_4096_TIME_EXP      2   /* Whole modular exponentiations, any algorithm */
+#define RSA_4096_TIMERS        3
+
+#define RSA_4096_LATENCY_ENCRYPT 0   /* Public-key operation per block */
+#define RSA_4096_LATENCY_DECRYPT 1   /* Private-key operation per block */
+#define RSA_4096_LATENCY_OPS     2
+#define RSA_4096_LATENCY_BUCKETS 24  /* Bucket b: [2^b, 2^(b+1)) us; bucket 0 also takes < 1 us, the last is open */
+
+/* All fields are uint64_t so snapshots add and subtract element-wise */
+typedef struct {
+    uint64_t counts[RSA_4096_STAT_COUNTERS];
+    uint64_t time_ns[RSA_4096_TIMERS];
+    uint64_t time_calls[RSA_4096_TIMERS];
+    uint64_t latency[RSA_4096_LATENCY_OPS][RSA_4096_LATENCY_BUCKETS];
+    uint64_t latency_ns[RSA_4096_LATENCY_OPS];   /* Sum over all samples, for the mean */
+} rsa_4096_stats_t;
+
+/* Each thread counts into its own block; get merges the live blocks, those of exited threads
+ * and subtracts the last reset, so neither probes nor reads take a lock on the hot path */
+void rsa_4096_stats_enable(int on);
+int rsa_4096_stats_enabled(void);
+void rsa_4096_stats_get(rsa_4096_stats_t *stats);
+void rsa_4096_stats_reset(void);
+uint64_t rsa_4096_stats_latency_percentile(const rsa_4096_stats_t *stats, int op, double fraction);  /* Bucket upper bound in us, 0 if empty */
+const char *rsa_4096_stats_counter_name(int counter);
+const char *rsa_4096_stats_timer_name(int timer);
+void rsa_4096_stats_print(const rsa_4096_stats_t *stats, FILE *out);
+
+/* Probes behind the STATS_* macros */
+void rsa_4096_stats_count(int counter, uint64_t n);
+uint64_t rsa_4096_stats_start(void);   /* Monotonic ns, or 0 while disabled */
+void rsa_4096_stats_time(int timer, uint64_t start);
+void rsa_4096_stats_latency(int op, uint64_t start, uint64_t samples);
+
+#if RSA_4096_STATS
+#define STATS_COUNT(counter, n) rsa_4096_stats_count(counter, n)
+#define STATS_START() rsa_4096_stats_start()
+#define STATS_TIME(timer, start) \
+    do { \
+        if (start) rsa_4096_stats_time(timer, start); \
+    } while(0)
+#define STATS_LATENCY(op, start, samples) \
+    do { \
+        if (start) rsa_4096_stats_latency(op, start, samples); \
+    } while(0)
+#else
+#define STATS_COUNT(counter, n) ((void)(n))
+#define STATS_START() ((uint64_t)0)
+#define STATS_TIME(timer, start) ((void)(start))
+#define STATS_LATENCY(op, start, samples) ((void)(start))
+#endif
+
 /* ===================== MACROS ===================== */
 
+#define TRACE_ENABLED(level) ((level) >= TRACE_LEVEL)
+
+#define TRACE(level, fmt, ...) \
+    do { \
+        if (TRACE_ENABLED(level)) { \
+            rsa_4096_trace_emit(level, __func__, __LINE__, fmt, ##__VA_ARGS__); \
+        } \
+    } while(0)
+
 #define CHECKPOINT(level, fmt, ...) \
     do { \
         if (level >= LOG_LEVEL) { \
-            printf("[%s:%d] " fmt "\n", __func__, __LINE__, ##__VA_ARGS__); \
-            fflush(stdout); \
+            rsa_4096_trace_emit(level, __func__, __LINE__, "[%s:%d] " fmt, __func__, __LINE__, ##__VA_ARGS__); \
         } \
     } while(0)
 
@@ -71,8 +214,8 @@
 
 #define LOG_CONVERSION(step, input, output) \
     do { \
-        if (LOG_LEVEL <= LOG_DEBUG) { \
-            printf("[CONVERSION:%s] %s\n", step, #input " -> " #output); \
+        if (TRACE_ENABLED(LOG_DEBUG)) { \
+            TRACE(LOG_DEBUG, "[CONVERSION:%s] %s", step, #input " -> " #output); \
             debug_print_bigint("input", input); \
             debug_print_bigint("output", output); \
         } \
@@ -84,25 +227,76 @@
  * @brief Big integer representation
  */
 typedef struct {
-    uint32_t words[BIGINT_4096_WORDS];  /* Little-endian word array */
+    bigint_word_t words[BIGINT_4096_WORDS];  /* Little-endian word array */
     int used;                           /* Number of significant words */
     int sign;                          /* 0 = positive, 1 = negative */
 } bigint_t;
 
+/**
+ * @brief Fixed-width Montgomery residue (value in [0, n), n_words significant)
+ *
+ * Sized for a 4096-bit modulus instead of the 512-word bigint_t buffer so the
+ * hot loop touches only the limbs it uses. Words above ctx->n_words are unused.
+ */
+typedef struct {
+    bigint_word_t words[MONTGOMERY_MAX_WORDS];
+} mont_residue_t;
+
+/**
+ * @brief Double-width product buffer for REDC (2 * n_words plus carry words)
+ */
+typedef struct {
+    bigint_word_t words[2 * MONTGOMERY_MAX_WORDS + 2];
+} mont_product_t;
+
+/**
+ * @brief Word-level Montgomery kernels for one modulus width
+ *
+ * montgomery_ctx_init() binds the set specialised for the modulus width, so
+ * the standard RSA sizes and their CRT halves run with compile-time trip
+ * counts; other widths get the generic set. s is ignored by fixed-width sets.
+ */
+typedef struct {
+    void (*mul)(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b, const bigint_word_t *n,
+                bigint_word_t n_prime, int s);                      /* CIOS, out = a * b / R mod n */
+    void (*sqr)(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n, bigint_word_t n_prime,
+                int s);                                             /* out = a^2 / R mod n */
+    void (*redc)(bigint_word_t *out, bigint_word_t *t, const bigint_word_t *n, bigint_word_t n_prime,
+                 int s);                                            /* out = t / R mod n, t has 2s + 2 words */
+    void (*amm_mul)(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b, const bigint_word_t *n,
+                    bigint_word_t n_prime, int s);                  /* Almost: a, b, out in [0, R), not [0, n) */
+    void (*amm_sqr)(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n, bigint_word_t n_prime,
+                    int s);
+    int n_words;                                                    /* Specialised width, 0 = any */
+    const char *name;
+} montgomery_kernels_t;
+
 /**
  * @brief Complete Montgomery REDC context - FIXED
  */
 typedef struct {
-    bigint_t n;          /* Modulus (must be odd) */
-    bigint_t r;          /* R = 2^(32 * n_words) where R > n */
-    bigint_t r_squared;  /* R^2 mod n for conversion to Montgomery form */
-    bigint_t r_inv;      /* R^(-1) mod n for conversion from Montgomery form */
-    uint32_t n_prime;    /* -n^(-1) mod 2^32 for REDC algorithm */
+    mont_residue_t n;          /* Modulus (must be odd) */
+    mont_residue_t r_mod_n;    /* R mod n = Montgomery form of 1, R = 2^(BIGINT_WORD_SIZE * n_words) */
+    mont_residue_t r_squared;  /* R^2 mod n for conversion to Montgomery form */
+    mont_residue_t r_inv;      /* R^(-1) mod n, valid only when has_r_inv is set */
+    bigint_word_t n_prime;  /* -n^(-1) mod 2^BIGINT_WORD_SIZE for REDC algorithm */
     int n_words;         /* Number of words in modulus */
     int r_words;         /* Number of words in R */
     int is_active;       /* 1 if Montgomery is active, 0 if disabled */
+    int has_r_inv;       /* 1 once r_inv has been computed by montgomery_ctx_get_r_inv() */
+    const montgomery_kernels_t *kernels;  /* Bound by montgomery_ctx_bind_kernels(); NULL runs the generic set */
 } montgomery_ctx_t;
 
+/**
+ * @brief Barrett reduction context: any modulus, odd or even
+ */
+typedef struct {
+    bigint_t n;          /* Modulus, k significant words */
+    bigint_t mu;         /* floor(b^(2k) / n), b = 2^BIGINT_WORD_SIZE; k + 1 words */
+    int k;               /* Words in the modulus */
+    int is_active;       /* 1 once barrett_ctx_init() has succeeded */
+} barrett_ctx_t;
+
 /**
  * @brief RSA key structure
  */
@@ -111,8 +305,59 @@ typedef struct {
     bigint_t exponent;            /* Public or private exponent */
     montgomery_ctx_t mont_ctx;    /* Montgomery REDC context */
     int is_private;               /* 0 = public key, 1 = private key */
+    bigint_word_t short_exponent; /* Exponent when it fits one word (e = 3, 17, 65537, ...), else 0 */
+    
+    /* CRT private-key components - only valid when has_crt is set */
+    bigint_t p, q;                /* Prime factors, n = p * q */
+    bigint_t dp, dq;              /* d mod (p-1), d mod (q-1) */
+    bigint_t qinv;                /* q^(-1) mod p */
+    bigint_t qinv_mont;           /* qinv * R_p mod p, so one Montgomery multiply yields h */
+    montgomery_ctx_t p_ctx;       /* Half-size Montgomery context mod p */
+    montgomery_ctx_t q_ctx;       /* Half-size Montgomery context mod q */
+    int has_crt;                  /* 1 if decryption uses CRT + Garner recombination */
+    
+    /* Base blinding pair - only valid when has_blinding is set (see rsa_4096_key_enable_blinding) */
+    bigint_t blind_vf;            /* Random t, multiplied into the ciphertext */
+    bigint_t blind_vi;            /* (t^d)^(-1) mod n, multiplied into the result */
+    uint64_t blinding_id;         /* Process-unique tag the per-thread pairs are keyed by */
+    int has_blinding;
 } rsa_4096_key_t;
 
+/**
+ * @brief Per-call exponentiation state for the scalar and vector kernels
+ */
+typedef struct {
+    mont_residue_t table[MONTGOMERY_TABLE_SIZE];   /* Odd powers of the base, Montgomery form */
+    mont_residue_t acc;                            /* Running result */
+    mont_residue_t scratch;                        /* base^2 while the table is built */
+    bigint_t reduced;                              /* Base mod n when the caller's base is not below n */
+    bigint_t word_exp;                             /* montgomery_exp_word: the exponent as a bigint */
+    bigint_t simd_big[3];                          /* Vector domain setup: n, R'^2 mod n, widened R^2 */
+    uint64_t simd_table[MONTGOMERY_TABLE_SIZE * MONTGOMERY_SIMD_MAX_LIMBS];
+    uint64_t simd_acc[MONTGOMERY_SIMD_MAX_LIMBS];
+    uint64_t simd_scratch[MONTGOMERY_SIMD_MAX_LIMBS];
+    uint64_t simd_rr[MONTGOMERY_SIMD_MAX_LIMBS];
+    uint64_t simd_one[MONTGOMERY_SIMD_MAX_LIMBS];
+} mont_exp_scratch_t;
+
+#define RSA_4096_WS_TEMPS 5
+
+/**
+ * @brief Caller-owned scratch for the *_ws entry points
+ *
+ * Allocate one per thread and reuse it for every call; it must never be shared
+ * by two calls running at once. Nothing carries over between calls, so it
+ * needs no initialisation, but it does hold key-dependent intermediates -
+ * rsa_4096_workspace_clear() wipes them.
+ */
+typedef struct {
+    mont_exp_scratch_t exp;            /* montgomery_exp_ws and the vector kernels */
+    mont_residue_t mul_res[3];         /* montgomery_mul_ws operands and product */
+    bigint_t mul_tmp[3];               /* montgomery_mul_ws: modulus and reduced operands */
+    bigint_t tmp[RSA_4096_WS_TEMPS];   /* hybrid_mod_exp_ws input copies, CRT halves */
+    bigint_t input, output;            /* RSA entry points: parsed input and exponentiation result */
+} rsa_4096_workspace_t;
+
 /* ===================== DEBUG UTILITIES ===================== */
 
 void debug_print_bigint(const char *name, const bigint_t *a);
@@ -133,6 +378,7 @@ int bigint_from_hex(bigint_t *a, const char *hex);
 int bigint_to_hex(const bigint_t *a, char *hex, size_t hex_size);
 int bigint_from_binary(bigint_t *a, const uint8_t *data, size_t data_size);
 int bigint_to_binary(const bigint_t *a, uint8_t *data, size_t data_size, size_t *bytes_written);
+int bigint_to_binary_fixed(const bigint_t *a, uint8_t *data, size_t data_size);  /* Zero-padded; -2 if it won't fit */
 int bigint_from_decimal(bigint_t *a, const char *decimal);
 int bigint_to_decimal(const bigint_t *a, char *str, size_t str_size);
 
@@ -146,16 +392,19 @@ int bigint_bit_length(const bigint_t *a);
 int bigint_add(bigint_t *r, const bigint_t *a, const bigint_t *b);
 int bigint_sub(bigint_t *r, const bigint_t *a, const bigint_t *b);
 int bigint_mul(bigint_t *r, const bigint_t *a, const bigint_t *b);
+int bigint_set_karatsuba_cutoff(int words);   /* Process-wide; defaults to BIGINT_KARATSUBA_CUTOFF */
+int bigint_karatsuba_cutoff(void);
 int bigint_div(bigint_t *q, bigint_t *r, const bigint_t *a, const bigint_t *b);
 int bigint_mod(bigint_t *r, const bigint_t *a, const bigint_t *m);
 
 /* Extended arithmetic for Montgomery - FIXED */
-int bigint_mul_add_word(bigint_t *result, const bigint_t *a, uint32_t b, uint32_t c);
-int bigint_add_word(bigint_t *result, const bigint_t *a, uint32_t word);
+int bigint_mul_add_word(bigint_t *result, const bigint_t *a, bigint_word_t b, bigint_word_t c);
+int bigint_add_word(bigint_t *result, const bigint_t *a, bigint_word_t word);
 
 /* Modular arithmetic - FIXED */
 int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *mod);
 int mod_inverse_extended_gcd(bigint_t *result, const bigint_t *a, const bigint_t *m);
+int bigint_mod_inverse_odd(bigint_t *result, const bigint_t *a, const bigint_t *m);  /* m odd; -3 if not coprime */
 
 /* ===================== HYBRID ALGORITHM SELECTION - TERRANTSH MODEL ===================== */
 
@@ -176,6 +425,11 @@ int mod_inverse_extended_gcd(bigint_t *result, const bigint_t *a, const bigint_t
  */
 int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, 
                    const bigint_t *modulus, const montgomery_ctx_t *mont_ctx);
+int hybrid_mod_exp_ws(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                      const bigint_t *modulus, const montgomery_ctx_t *mont_ctx, rsa_4096_workspace_t *ws);
+#define HYBRID_MONTGOMERY_MIN_BITS 64   /* Default hybrid_mod_exp cutover to Montgomery */
+int hybrid_set_montgomery_min_bits(int bits);   /* Process-wide, 8..4096 */
+int hybrid_montgomery_min_bits(void);
 
 /* ===================== MONTGOMERY REDC OPERATIONS - FIXED ===================== */
 
@@ -183,6 +437,15 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
 int montgomery_ctx_init(montgomery_ctx_t *ctx, const bigint_t *modulus);
 void montgomery_ctx_free(montgomery_ctx_t *ctx);
 void montgomery_ctx_print_info(const montgomery_ctx_t *ctx);
+void montgomery_ctx_get_modulus(const montgomery_ctx_t *ctx, bigint_t *modulus);
+int montgomery_ctx_matches(const montgomery_ctx_t *ctx, const bigint_t *modulus);
+int montgomery_ctx_get_r_inv(montgomery_ctx_t *ctx, bigint_t *r_inv);  /* Lazily computed and cached */
+void montgomery_ctx_bind_kernels(montgomery_ctx_t *ctx);   /* Done by init; call after filling a context by hand */
+const char *montgomery_ctx_kernel_name(const montgomery_ctx_t *ctx);
+
+/* Fixed-width residue conversions */
+int mont_residue_from_bigint(mont_residue_t *dst, const bigint_t *src, const montgomery_ctx_t *ctx);
+void mont_residue_to_bigint(bigint_t *dst, const mont_residue_t *src, const montgomery_ctx_t *ctx);
 
 /* Core Montgomery REDC algorithm - FIXED */
 int montgomery_redc(bigint_t *result, const bigint_t *T, const montgomery_ctx_t *ctx);
@@ -190,9 +453,99 @@ int montgomery_redc(bigint_t *result, const bigint_t *T, const montgomery_ctx_t
 /* Montgomery arithmetic operations - FIXED */
 int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx);
 int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx);
+int montgomery_reduce(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx);  /* a mod n, REDC fast path for a < n * R */
 int montgomery_mul(bigint_t *result, const bigint_t *a, const bigint_t *b, const montgomery_ctx_t *ctx);
 int montgomery_square(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx);
 int montgomery_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const montgomery_ctx_t *ctx);
+int montgomery_exp_window(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                          const montgomery_ctx_t *ctx, int window_bits);
+int montgomery_select_window(int exp_bits);
+/* min_bits[w] = shortest exponent that gets width w (0 = never), w = 2..MONTGOMERY_MAX_WINDOW;
+ * widths must switch on in increasing order. NULL restores the built-in table */
+int montgomery_set_window_thresholds(const int *min_bits);
+void montgomery_get_window_thresholds(int *min_bits);
+/* Process-wide, default on: exponentiation loops keep values in [0, R) with the almost-Montgomery
+ * kernels and reduce below n once at the end; off runs the strict kernels for every step */
+void montgomery_set_lazy_reduction(int on);
+int montgomery_lazy_reduction(void);
+int montgomery_exp_word(bigint_t *result, const bigint_t *base, bigint_word_t exp, const montgomery_ctx_t *ctx);
+
+/* Workspace variants: same results, scratch taken from ws instead of the stack (ws == NULL: plain call) */
+int montgomery_mul_ws(bigint_t *result, const bigint_t *a, const bigint_t *b, const montgomery_ctx_t *ctx,
+                      rsa_4096_workspace_t *ws);
+int montgomery_exp_ws(bigint_t *result, const bigint_t *base, const bigint_t *exp, const montgomery_ctx_t *ctx,
+                      rsa_4096_workspace_t *ws);
+int montgomery_exp_word_ws(bigint_t *result, const bigint_t *base, bigint_word_t exp, const montgomery_ctx_t *ctx,
+                           rsa_4096_workspace_t *ws);
+
+/**
+ * @brief Multiply kernel for montgomery_exp_sliding(): out = a * b * R^(-1) in the kernel's own
+ * representation, with out allowed to alias a or b; sqr (out = a * a * R^(-1)) may be NULL
+ */
+typedef struct {
+    void (*mul)(void *out, const void *a, const void *b, const void *kernel_ctx);
+    void (*sqr)(void *out, const void *a, const void *kernel_ctx);
+    const void *kernel_ctx;
+    size_t elem_size;
+} mont_exp_kernel_t;
+
+/* acc holds Montgomery one on entry and the result on exit; table[0] holds the base in Montgomery
+ * form and needs room for 2^(window_bits - 1) elements; scratch holds one element. The operation
+ * counts include the table precomputation and are left for the caller to attribute */
+void montgomery_exp_sliding(const mont_exp_kernel_t *kernel, void *acc, void *table, void *scratch,
+                            const bigint_t *exp, int window_bits, int *squarings, int *multiplies);
+
+/* ===================== BARRETT REDUCTION ===================== */
+
+#define BARRETT_MIN_WORDS 2   /* bigint_mod_exp uses Barrett from this modulus width up */
+#define BARRETT_MAX_WORDS (BIGINT_4096_WORDS / 2 - 1)   /* q1 * mu must fit a bigint_t */
+#define BARRETT_MAX_WINDOW 5  /* Table of 16 bigint_t on the stack */
+
+int barrett_ctx_init(barrett_ctx_t *ctx, const bigint_t *modulus);
+void barrett_ctx_free(barrett_ctx_t *ctx);
+/* x mod n in two multiplications for x < b^(2k); wider inputs fall back to bigint_mod. r may alias x */
+int barrett_reduce(bigint_t *result, const bigint_t *x, const barrett_ctx_t *ctx);
+/* a * b mod n for a, b < n; result may alias a or b */
+int barrett_mul(bigint_t *result, const bigint_t *a, const bigint_t *b, const barrett_ctx_t *ctx);
+int barrett_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const barrett_ctx_t *ctx);
+
+/* ===================== SIMD MONTGOMERY KERNELS ===================== */
+
+#define MONTGOMERY_SIMD_AUTO   -1
+#define MONTGOMERY_SIMD_NONE    0
+#define MONTGOMERY_SIMD_AVX2    1   /* 4 x 64-bit lanes, radix 2^29 */
+#define MONTGOMERY_SIMD_IFMA    2   /* AVX-512 IFMA, 8 x 64-bit lanes, radix 2^52 */
+
+#define MONTGOMERY_SIMD_MIN_BITS 512     /* Below this the radix conversions outweigh the gain */
+
+int montgomery_simd_detect(void);                 /* Best kernel supported by this CPU */
+int montgomery_simd_select(int kernel);           /* Force a kernel (AUTO = detect); -1 if unsupported.
+                                                   * Process-wide: call before starting batch workers */
+int montgomery_simd_active(void);
+const char *montgomery_simd_name(int kernel);
+int montgomery_simd_set_min_bits(int bits);       /* Smallest modulus sent to a vector kernel (64..4096) */
+int montgomery_simd_min_bits(void);
+/* 0 = done, 1 = no vector kernel for this modulus (caller falls back to scalar), < 0 = error;
+ * base must already be reduced below n */
+int montgomery_simd_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                        const montgomery_ctx_t *ctx, int window_bits, mont_exp_scratch_t *scratch);
+
+/* Multi-buffer: independent exponentiations in lock-step, one per 64-bit lane (transposed limbs) */
+#define MONTGOMERY_MULTI_MAX_LANES 8
+
+int montgomery_multi_lanes(void);                 /* Lock-step width of the active kernel: 8 IFMA, 4 AVX2, 1 scalar */
+/* results[i] = bases[i]^exps[i] mod n_i, any mix of contexts; groups of consecutive vector-sized
+ * moduli share one pass, so order entries by modulus size. results must not alias any input */
+int montgomery_exp_multi(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                         const montgomery_ctx_t *const *ctxs, int count);
+/* Same, with entries that fall back to single exponentiation run in ws (NULL: plain montgomery_exp) */
+int montgomery_exp_multi_ws(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                            const montgomery_ctx_t *const *ctxs, int count, rsa_4096_workspace_t *ws);
+
+/* Residue-level arithmetic (operands in [0, n), in-place use allowed) */
+int montgomery_mul_residue(mont_residue_t *result, const mont_residue_t *a, const mont_residue_t *b,
+                           const montgomery_ctx_t *ctx);
+int montgomery_square_residue(mont_residue_t *result, const mont_residue_t *a, const montgomery_ctx_t *ctx);
 
 /* ===================== RSA OPERATIONS ===================== */
 
@@ -202,6 +555,16 @@ void rsa_4096_free(rsa_4096_key_t *key);
 int rsa_4096_load_key(rsa_4096_key_t *key, const char *n_decimal, const char *e_decimal, int is_private);
 int rsa_4096_load_key_binary(rsa_4096_key_t *key, const uint8_t *n_data, size_t n_size,
                             const uint8_t *e_data, size_t e_size, int is_private);
+void rsa_4096_key_classify_exponent(rsa_4096_key_t *key);  /* Sets short_exponent; loaders call it */
+
+/* CRT components - attach p, q, dP, dQ, qInv to an already loaded private key */
+int rsa_4096_load_key_crt(rsa_4096_key_t *key, const char *p_decimal, const char *q_decimal,
+                          const char *dp_decimal, const char *dq_decimal, const char *qinv_decimal);
+int rsa_4096_load_key_crt_binary(rsa_4096_key_t *key, const uint8_t *p_data, size_t p_size,
+                                 const uint8_t *q_data, size_t q_size,
+                                 const uint8_t *dp_data, size_t dp_size,
+                                 const uint8_t *dq_data, size_t dq_size,
+                                 const uint8_t *qinv_data, size_t qinv_size);
 
 /* Encryption/Decryption */
 int rsa_4096_encrypt(const rsa_4096_key_t *pub_key, const char *message_decimal,
@@ -215,6 +578,280 @@ int rsa_4096_decrypt_binary(const rsa_4096_key_t *priv_key, const uint8_t *encry
                            size_t encrypted_size, uint8_t *message, size_t message_buffer_size,
                            size_t *message_size);
 
+#define RSA_4096_CRT_MIN_BITS 0   /* Keys with CRT parameters use them from this modulus size (4097 = never) */
+int rsa_4096_set_crt_min_bits(int bits);   /* Process-wide */
+int rsa_4096_crt_min_bits(void);
+
+/* ===================== WORKSPACE ===================== */
+
+rsa_4096_workspace_t *rsa_4096_workspace_new(void);      /* Heap-allocated; NULL on allocation failure */
+void rsa_4096_workspace_free(rsa_4096_workspace_t *ws);  /* Wipes before freeing */
+void rsa_4096_workspace_clear(rsa_4096_workspace_t *ws);
+
+/* Per-thread workspace behind the plain (non-_ws) RSA calls and hybrid_mod_exp:
+ * allocated on the thread's first plain call, wiped and freed at thread exit. The
+ * workspace never lives on the stack, so the plain calls need no more stack than
+ * the _ws ones. With a Montgomery context that is under 32 KB per call, a blinded
+ * decrypt and its pair refresh included; rsa_4096_decrypt needs up to 48 KB for the
+ * decimal conversion, and moduli hybrid_mod_exp runs on the Barrett fallback up to
+ * 64 KB. The private-key calls and hybrid_mod_exp wipe it before returning. NULL on
+ * allocation failure. */
+rsa_4096_workspace_t *rsa_4096_thread_workspace(void);
+
+/* Encryption/Decryption with caller-owned scratch (ws == NULL: plain call) */
+int rsa_4096_encrypt_ws(const rsa_4096_key_t *pub_key, const char *message_decimal,
+                        char *encrypted_hex, size_t encrypted_size, rsa_4096_workspace_t *ws);
+int rsa_4096_decrypt_ws(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
+                        char *message_decimal, size_t message_size, rsa_4096_workspace_t *ws);
+int rsa_4096_encrypt_binary_ws(const rsa_4096_key_t *pub_key, const uint8_t *message,
+                               size_t message_size, uint8_t *encrypted, size_t encrypted_buffer_size,
+                               size_t *encrypted_size, rsa_4096_workspace_t *ws);
+int rsa_4096_decrypt_binary_ws(const rsa_4096_key_t *priv_key, const uint8_t *encrypted,
+                               size_t encrypted_size, uint8_t *message, size_t message_buffer_size,
+                               size_t *message_size, rsa_4096_workspace_t *ws);
+
+/* Fixed-length blocks for framing code: in and out are both exactly len = rsa_4096_key_bytes() bytes,
+ * big-endian, the result zero-padded in front; out may alias in. -3 = wrong length, -4 = in >= n */
+size_t rsa_4096_key_bytes(const rsa_4096_key_t *key);   /* Modulus bytes, 512 for RSA-4096 */
+int rsa_4096_encrypt_fixed(const rsa_4096_key_t *pub_key, const uint8_t *in, uint8_t *out, size_t len);
+int rsa_4096_decrypt_fixed(const rsa_4096_key_t *priv_key, const uint8_t *in, uint8_t *out, size_t len);
+int rsa_4096_encrypt_fixed_ws(const rsa_4096_key_t *pub_key, const uint8_t *in, uint8_t *out, size_t len,
+                              rsa_4096_workspace_t *ws);
+int rsa_4096_decrypt_fixed_ws(const rsa_4096_key_t *priv_key, const uint8_t *in, uint8_t *out, size_t len,
+                              rsa_4096_workspace_t *ws);
+
+/* ===================== BATCH OPERATIONS ===================== */
+
+#define RSA_4096_BATCH_MAX_THREADS 64
+
+/**
+ * @brief One block of a batch call - status and output_len are filled per item
+ */
+typedef struct {
+    const uint8_t *input;
+    size_t input_len;
+    uint8_t *output;
+    size_t output_size;
+    size_t output_len;
+    int status;             /* 0 ok, otherwise the single-block call's error code */
+} rsa_4096_batch_item_t;
+
+/* Process all items on a worker pool sharing one read-only key (num_threads <= 0: all online CPUs).
+ * With a vector kernel each worker takes montgomery_multi_lanes() items at a time in lock-step.
+ * Returns 0 if every item succeeded, -3 if any item failed (see item status). */
+int rsa_4096_encrypt_batch(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                           int num_threads);
+int rsa_4096_decrypt_batch(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                           int num_threads);
+
+/* Lock-step blocks for the batch workers: accepted items share montgomery_exp_multi passes, the
+ * rest (and any item the shared pass fails on) take the single-block call. 0 = all ok, -3 = some failed */
+int rsa_4096_encrypt_binary_multi(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                                  rsa_4096_workspace_t *ws);
+int rsa_4096_decrypt_binary_multi(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                                  rsa_4096_workspace_t *ws);
+/* The same with fixed-length blocks: input_len must be the modulus size, output_len always is */
+int rsa_4096_encrypt_fixed_multi(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                                 rsa_4096_workspace_t *ws);
+int rsa_4096_decrypt_fixed_multi(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                                 rsa_4096_workspace_t *ws);
+
+/* ===================== PARALLEL CRT ===================== */
+
+#define RSA_4096_PARALLEL_CRT_MIN_BITS 1024   /* Smaller keys stay inline: the hand-off would cost more */
+
+/* One helper thread that runs the mod-q half of a CRT decrypt while the caller computes the mod-p
+ * half. A caller that finds the helper busy with another decrypt runs both halves itself, so the
+ * option never queues. cpu >= 0 pins the helper (Linux, best effort), -1 leaves it floating.
+ * Process-wide: start and stop while no decrypt is running. */
+typedef struct {
+    size_t offloaded;       /* Halves run on the helper */
+    size_t busy_misses;     /* Decrypts that found the helper taken and ran inline */
+} rsa_4096_parallel_crt_stats_t;
+
+int rsa_4096_parallel_crt_start(int cpu);   /* 0 ok (also if running), -1 thread start failure, -2 OOM */
+void rsa_4096_parallel_crt_stop(void);
+int rsa_4096_parallel_crt_active(void);
+void rsa_4096_parallel_crt_get_stats(rsa_4096_parallel_crt_stats_t *stats);
+/* result = base^exp mod ctx's modulus on the helper. begin: 0 = taken (finish must follow and
+ * returns the exponentiation status; the arguments stay borrowed until then), 1 = helper stopped
+ * or busy, compute it yourself */
+int rsa_4096_parallel_crt_begin(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                                const montgomery_ctx_t *ctx);
+int rsa_4096_parallel_crt_finish(void);
+
+/* ===================== BLINDING ===================== */
+
+#define RSA_4096_BLINDING_SLOTS 4       /* Keys a thread keeps a blinding pair for */
+#define RSA_4096_BLINDING_REFRESH 32    /* Squarings before a thread re-derives its pair from the key's */
+
+/* Private operations on a blinded key compute (c * vf)^d * vi with vf^d * vi = 1 mod n, so the
+ * exponentiation never sees the caller's ciphertext. Enable draws vf at random and pays the one
+ * inversion; each thread then derives its own pair as (vf^k, vi^k) for a random 64-bit k and squares
+ * it after every use. Call once after loading, before sharing the key: -2 = not a private key with
+ * a Montgomery context, -4 = no invertible value found */
+int rsa_4096_key_enable_blinding(rsa_4096_key_t *key);
+void rsa_4096_key_disable_blinding(rsa_4096_key_t *key);
+/* Current thread's pair for key in Montgomery form, advanced by one squaring per call; a pair
+ * refresh exponentiates in ws (NULL: the calling thread's rsa_4096_thread_workspace()) */
+int rsa_4096_blinding_next(const rsa_4096_key_t *key, mont_residue_t *vf, mont_residue_t *vi,
+                           rsa_4096_workspace_t *ws);
+void rsa_4096_blinding_thread_clear(void);     /* Wipe the calling thread's pairs */
+
+/* ===================== KEY BLOB PERSISTENCE ===================== */
+
+#define RSA_4096_KEYBLOB_MAGIC "RSA4KBLB"
+#define RSA_4096_KEYBLOB_VERSION 1
+
+/* Precomputed key format: n, exponent, Montgomery and CRT state - reload without bignum setup */
+int rsa_4096_key_serialize(const rsa_4096_key_t *key, uint8_t *buf, size_t buf_size, size_t *written);  /* buf == NULL: size query */
+int rsa_4096_key_deserialize(rsa_4096_key_t *key, const uint8_t *buf, size_t buf_size);
+int rsa_4096_key_save_blob(const rsa_4096_key_t *key, const char *path);
+int rsa_4096_key_load_blob(rsa_4096_key_t *key, const char *path);
+
+/* ===================== SHARED KEY REGISTRY ===================== */
+
+#define RSA_4096_REGISTRY_DEFAULT_CAPACITY 1024
+
+/* Loaded keys (modulus, exponent, Montgomery and CRT contexts) shared by all threads and keyed
+ * by a modulus fingerprint. Lookups take no lock; eviction is approximate LRU (CLOCK) once
+ * capacity entries are held. A returned key is immutable and stays valid, even if evicted,
+ * until its rsa_4096_registry_release(); pass it straight to any call taking a const key. */
+typedef struct rsa_4096_registry rsa_4096_registry_t;
+
+typedef struct {
+    size_t entries;
+    size_t capacity;
+    size_t hits;
+    size_t misses;
+    size_t inserts;
+    size_t evictions;
+} rsa_4096_registry_stats_t;
+
+rsa_4096_registry_t *rsa_4096_registry_new(size_t capacity);  /* 0: RSA_4096_REGISTRY_DEFAULT_CAPACITY */
+void rsa_4096_registry_free(rsa_4096_registry_t *reg);         /* Every acquired key must be released first */
+uint64_t rsa_4096_modulus_fingerprint(const bigint_t *n);      /* Independent of the limb width */
+
+/* Copy a loaded key in and return it acquired. An identical key already present is returned
+ * instead; one with the same modulus and kind but a different exponent is replaced. NULL on error. */
+const rsa_4096_key_t *rsa_4096_registry_insert(rsa_4096_registry_t *reg, const rsa_4096_key_t *key);
+/* Acquire the public (is_private = 0) or private key for modulus n; NULL if not registered */
+const rsa_4096_key_t *rsa_4096_registry_lookup(rsa_4096_registry_t *reg, const bigint_t *n, int is_private);
+void rsa_4096_registry_release(const rsa_4096_key_t *key);
+void rsa_4096_registry_get_stats(rsa_4096_registry_t *reg, rsa_4096_registry_stats_t *stats);
+
+/* ===================== KEY GENERATION ===================== */
+
+#define RSA_4096_KEYGEN_MIN_BITS 1024
+#define RSA_4096_KEYGEN_MAX_BITS 4096
+#define RSA_4096_KEYGEN_MAX_THREADS 64
+
+int rsa_4096_random_bytes(uint8_t *buf, size_t len);  /* /dev/urandom */
+
+/* Fresh key pair of exactly bits bits (even, MIN..MAX) with public exponent e (odd, >= 3, usually 65537).
+ * The prime search runs on num_threads workers (<= 0: all online CPUs). priv_key gets d and the CRT
+ * components; either output may be NULL. Outputs are overwritten like the loaders do. */
+int rsa_4096_generate_key(rsa_4096_key_t *pub_key, rsa_4096_key_t *priv_key, int bits, uint32_t e,
+                          int num_threads);
+
+/* ===================== SERVICE MODE ===================== */
+
+/* Wire format, every field a big-endian u32:
+ *   request:  id | op | length | payload[length]
+ *   response: id | status (int32) | length | payload[length]     - always in request order
+ * OP_PUBLIC runs the public-key operation (encrypt / verify), OP_PRIVATE the private one (decrypt / sign).
+ * status is 0, the single-block call's error code, or one of RSA_4096_SERVE_ERR_*. */
+#define RSA_4096_SERVE_OP_PUBLIC     1
+#define RSA_4096_SERVE_OP_PRIVATE    2
+#define RSA_4096_SERVE_MAX_PAYLOAD   512     /* One 4096-bit block */
+#define RSA_4096_SERVE_MAX_BATCH     64
+#define RSA_4096_SERVE_MAX_CLIENTS   16      /* Concurrent connections in rsa_4096_serve_unix */
+#define RSA_4096_SERVE_ERR_BAD_OP    -100
+#define RSA_4096_SERVE_ERR_TOO_LONG  -101    /* Payload above RSA_4096_SERVE_MAX_PAYLOAD, skipped unread */
+#define RSA_4096_SERVE_ERR_NO_KEY    -102    /* No key loaded for this operation */
+
+typedef struct {
+    int num_threads;        /* Batch worker pool size, <= 0: all online CPUs */
+    int max_batch;          /* Requests per batch, <= 0: RSA_4096_SERVE_MAX_BATCH */
+    int max_connections;    /* rsa_4096_serve_unix returns after this many clients, <= 0: never */
+} rsa_4096_serve_config_t;
+
+typedef struct {
+    size_t requests;
+    size_t batches;
+    size_t failed;          /* Responses with a non-zero status */
+} rsa_4096_serve_stats_t;
+
+/* Serve until EOF on in_fd (config and stats may be NULL; either key may be NULL, not both).
+ * 0 on a clean end, negative on I/O errors or input that ends inside a frame. */
+int rsa_4096_serve_stream(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, int in_fd, int out_fd,
+                          const rsa_4096_serve_config_t *config, rsa_4096_serve_stats_t *stats);
+int rsa_4096_serve_unix(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, const char *path,
+                        const rsa_4096_serve_config_t *config);
+
+/* ===================== STREAMING FILE ENCRYPTION ===================== */
+
+/* Stream layout: header = magic[8] | version (u32 BE) | block bytes k (u32 BE), then k-byte
+ * big-endian ciphertext blocks. Each block encrypts 0x01 || up to k-2 plaintext bytes, so every
+ * block is below n and keeps its leading zeros. All blocks carry k-2 bytes except the last, which
+ * carries fewer (possibly none) - a stream cut at a block boundary is detected on decryption. */
+#define RSA_4096_STREAM_MAGIC          "RSA4KSTR"
+#define RSA_4096_STREAM_VERSION        1
+#define RSA_4096_STREAM_HEADER_SIZE    16
+#define RSA_4096_STREAM_CHUNK_BLOCKS   32      /* Default blocks per work unit */
+#define RSA_4096_STREAM_MAX_CHUNK      1024
+
+typedef struct {
+    int num_threads;        /* Worker threads, <= 0: all online CPUs */
+    int chunk_blocks;       /* Blocks per work unit, <= 0: RSA_4096_STREAM_CHUNK_BLOCKS */
+} rsa_4096_stream_config_t;
+
+typedef struct {
+    size_t bytes_in;
+    size_t bytes_out;
+    size_t blocks;
+    size_t chunks;
+    int mapped;             /* 1 if the input was memory-mapped rather than read */
+} rsa_4096_stream_stats_t;
+
+/* Transform all of in_fd into out_fd (config and stats may be NULL). A regular input file is
+ * mmapped, anything else is read in chunk-sized pieces; chunks run on the worker threads and
+ * are written back in order. 0 on success; -1 bad arguments, -2 unsuitable key (modulus below
+ * 17 bits, or no private key for decryption), -3 out of memory, -4 read error, -5 bad stream
+ * header or framing, -6 write error, -7 thread start failure, -8 a block failed to transform. */
+int rsa_4096_encrypt_stream(const rsa_4096_key_t *pub_key, int in_fd, int out_fd,
+                            const rsa_4096_stream_config_t *config, rsa_4096_stream_stats_t *stats);
+int rsa_4096_decrypt_stream(const rsa_4096_key_t *priv_key, int in_fd, int out_fd,
+                            const rsa_4096_stream_config_t *config, rsa_4096_stream_stats_t *stats);
+
+/* ===================== AUTOTUNING ===================== */
+
+#define RSA_4096_TUNING_VERSION 1
+
+/* Every cutover the hybrid dispatch uses; the fields mirror the module setters */
+typedef struct {
+    int simd_kernel;                                /* MONTGOMERY_SIMD_* (AUTO = detect) */
+    int simd_min_bits;                              /* montgomery_simd_set_min_bits */
+    int window_min_bits[MONTGOMERY_MAX_WINDOW + 1]; /* montgomery_set_window_thresholds */
+    int karatsuba_cutoff;                           /* bigint_set_karatsuba_cutoff, in words */
+    int montgomery_min_bits;                        /* hybrid_set_montgomery_min_bits */
+    int crt_min_bits;                               /* rsa_4096_set_crt_min_bits */
+    int calibrated;                                 /* 1: measured on a machine, 0: built-in defaults */
+} rsa_4096_tuning_t;
+
+void rsa_4096_tuning_defaults(rsa_4096_tuning_t *tuning);
+void rsa_4096_tuning_active(rsa_4096_tuning_t *tuning);          /* Settings currently in force */
+/* Time each cutover on this machine (a few hundred ms at 64-bit limbs); the active settings are
+ * left as they were. Process-wide like everything here: run before starting worker threads */
+int rsa_4096_tuning_calibrate(rsa_4096_tuning_t *tuning);
+int rsa_4096_tuning_apply(const rsa_4096_tuning_t *tuning);      /* -5 if out of range or kernel unsupported */
+/* Text profile; load rejects another version or limb width (-3) and kernels this CPU lacks (-5) */
+int rsa_4096_tuning_save(const rsa_4096_tuning_t *tuning, const char *path);
+int rsa_4096_tuning_load(rsa_4096_tuning_t *tuning, const char *path);
+/* Startup hook: apply the profile at profile_path, or calibrate, apply and save it there (path may be
+ * NULL). 0 = profile loaded, 1 = freshly calibrated, < 0 = error; tuning (may be NULL) gets the result */
+int rsa_4096_tuning_init(const char *profile_path, rsa_4096_tuning_t *tuning);
+
 /* ===================== TESTING FUNCTIONS ===================== */
 
 int run_verification(void);
@@ -227,6 +864,34 @@ int test_real_rsa_4096(void);
 /* Test hybrid algorithm selection */
 int test_hybrid_algorithm_selection(void);
 
+/* Fused CIOS Montgomery kernel cross-check */
+int test_montgomery_cios(void);
+int test_montgomery_sliding_window(void);
+int test_rsa_crt_decryption(void);
+int test_bigint_division(void);
+int test_key_blob(void);
+int test_trace_sink(void);
+int test_batch_operations(void);
+int test_montgomery_simd(void);
+int test_bigint_karatsuba(void);
+int test_montgomery_squaring(void);
+int test_short_exponent(void);
+int test_chunked_conversion(void);
+int test_workspace_api(void);
+int test_montgomery_exp_multi(void);
+int test_key_generation(void);
+int test_serve_mode(void);
+int test_stream_encryption(void);
+int test_key_registry(void);
+int test_tuning(void);
+int test_fixed_kernels(void);
+int test_parallel_crt(void);
+int test_perf_stats(void);
+int test_barrett(void);
+int test_lazy_reduction(void);
+int test_blinding(void);
+int test_fixed_io(void);
+
 /* TODO: Enhanced round-trip testing functions */
 int test_round_trip_comprehensive(void);
 int test_boundary_conditions(void);
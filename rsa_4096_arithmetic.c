@@ -16,7 +16,7 @@
 
 /* ===================== FIXED MODULAR EXPONENTIATION ===================== */
 
-int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *mod) {
+static int bigint_mod_exp_run(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *mod) {
     if (result == NULL || base == NULL || exp == NULL || mod == NULL) {
         ERROR_RETURN(-1, "NULL pointer in bigint_mod_exp");
     }
@@ -47,7 +47,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         return 0;
     }
     
-    printf("[MOD_EXP_COMPLETE] Computing %d-word^%d-word mod %d-word\n", 
+    TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Computing %d-word^%d-word mod %d-word", 
            base->used, exp->used, mod->used);
     
     /* TODO: Add comprehensive input validation */
@@ -57,7 +57,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     
     /* Optimized exponentiation with sliding window for large exponents */
     if (exp->used > 20) {
-        printf("[MOD_EXP_COMPLETE] Very large exponent (%d words), using 4-bit sliding window\n", exp->used);
+        TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Very large exponent (%d words), using 4-bit sliding window", exp->used);
         
         /* TODO: FIXME - Potential memory overflow in sliding window method */
         /* Use 4-bit sliding window for very large exponents */
@@ -96,7 +96,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
             bigint_normalize(&window_powers[i]);
         }
         
-        printf("[MOD_EXP_COMPLETE] Precomputed 16 window powers\n");
+        TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Precomputed 16 window powers");
         
         /* Process exponent in 4-bit windows from MSB to LSB */
         int exp_bits = bigint_bit_length(exp);
@@ -184,7 +184,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         bigint_copy(result, &temp_result);
         bigint_normalize(result);
         
-        printf("[MOD_EXP_COMPLETE] Sliding window completed, processed %d bits\n", processed_bits);
+        TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Sliding window completed, processed %d bits", processed_bits);
         return 0;
     }
     
@@ -207,8 +207,8 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     /* Copy exponent for processing */
     bigint_copy(&temp_exp, exp);
     
-    printf("[MOD_EXP_COMPLETE] Starting right-to-left binary method\n");
-    printf("[MOD_EXP_COMPLETE] Base: %d words, Exp: %d words, Mod: %d words\n", 
+    TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Starting right-to-left binary method");
+    TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Base: %d words, Exp: %d words, Mod: %d words", 
            temp_base.used, temp_exp.used, mod->used);
     
     int bit_count = 0;
@@ -217,7 +217,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         /* TODO: CRITICAL - Bit checking logic for round-trip correctness */
         if (temp_exp.words[0] & 1) {
             if (bit_count < 10 || bit_count % 50 == 0) {
-                printf("[MOD_EXP_COMPLETE] Bit %d is 1, multiplying result by base\n", bit_count);
+                TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Bit %d is 1, multiplying result by base", bit_count);
             }
             
             /* FIXME: Critical multiplication step - any error here corrupts round-trip */
@@ -248,7 +248,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
                     computed_product = ((uint64_t)product.words[1] << 32) | product.words[0];
                 }
                 if (manual_product != computed_product) {
-                    printf("[ROUND_TRIP_DEBUG] CRITICAL: Multiplication mismatch at bit %d - manual=0x%llx, computed=0x%llx\n", 
+                    TRACE(LOG_ERROR, "[ROUND_TRIP_DEBUG] CRITICAL: Multiplication mismatch at bit %d - manual=0x%llx, computed=0x%llx", 
                            bit_count, (unsigned long long)manual_product, (unsigned long long)computed_product);
                 }
             }
@@ -261,7 +261,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
             
             /* TODO: Validate reduction correctness */
             if (bigint_compare(&new_result, mod) >= 0) {
-                printf("[ROUND_TRIP_DEBUG] ERROR: Reduction failed at bit %d - result >= modulus\n", bit_count);
+                TRACE(LOG_ERROR, "[ROUND_TRIP_DEBUG] ERROR: Reduction failed at bit %d - result >= modulus", bit_count);
                 ERROR_RETURN(-98, "Invalid modular reduction result");
             }
             
@@ -288,9 +288,9 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         
         /* TODO: Add validation that shift produced expected result */
         if (temp_exp.used > 0 && new_exp.used > 0) {
-            uint32_t expected_msb = temp_exp.words[0] >> 1;
+            bigint_word_t expected_msb = temp_exp.words[0] >> 1;
             if (temp_exp.used == 1 && new_exp.used == 1 && new_exp.words[0] != expected_msb) {
-                printf("[ROUND_TRIP_DEBUG] WARNING: Shift result mismatch - expected 0x%x, got 0x%x\n", 
+                TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: Shift result mismatch - expected 0x%" PRIxWORD ", got 0x%" PRIxWORD, 
                        expected_msb, new_exp.words[0]);
             }
         }
@@ -327,7 +327,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
                     computed_square = ((uint64_t)squared_base.words[1] << 32) | squared_base.words[0];
                 }
                 if (manual_square != computed_square) {
-                    printf("[ROUND_TRIP_DEBUG] CRITICAL: Squaring mismatch - manual=0x%llx, computed=0x%llx\n", 
+                    TRACE(LOG_ERROR, "[ROUND_TRIP_DEBUG] CRITICAL: Squaring mismatch - manual=0x%llx, computed=0x%llx", 
                            (unsigned long long)manual_square, (unsigned long long)computed_square);
                 }
             }
@@ -340,7 +340,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
             
             /* TODO: Validate reduction preserved correctness */
             if (bigint_compare(&new_base, mod) >= 0) {
-                printf("[ROUND_TRIP_DEBUG] ERROR: Reduction failed - result >= modulus\n");
+                TRACE(LOG_ERROR, "[ROUND_TRIP_DEBUG] ERROR: Reduction failed - result >= modulus");
                 ERROR_RETURN(-99, "Modular reduction produced invalid result");
             }
             
@@ -366,7 +366,7 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     /* TODO: Final normalization */
     bigint_normalize(result);
     
-    printf("[MOD_EXP_COMPLETE] Completed in %d iterations\n", bit_count);
+    TRACE(LOG_DEBUG, "[MOD_EXP_COMPLETE] Completed in %d iterations", bit_count);
     
     /* TODO: Add result validation */
     if (bigint_compare(result, mod) >= 0) {
@@ -378,15 +378,33 @@ int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     return 0;
 }
 
+int bigint_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *mod) {
+    STATS_COUNT(RSA_4096_STAT_TRADITIONAL_EXP, 1);
+    uint64_t stats_start = STATS_START();
+    
+    /* Multi-word moduli, odd or even, reduce by Barrett: one division up front instead of one per multiply */
+    int ret;
+    barrett_ctx_t barrett;
+    if (result != NULL && base != NULL && exp != NULL && mod != NULL &&
+        mod->used >= BARRETT_MIN_WORDS && barrett_ctx_init(&barrett, mod) == 0) {
+        ret = barrett_exp(result, base, exp, &barrett);
+        barrett_ctx_free(&barrett);
+    } else {
+        ret = bigint_mod_exp_run(result, base, exp, mod);
+    }
+    STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+    return ret;
+}
+
 /* ===================== EXTENDED ARITHMETIC FOR MONTGOMERY - FIXED ===================== */
 
-int bigint_mul_add_word(bigint_t *result, const bigint_t *a, uint32_t b, uint32_t c) {
+int bigint_mul_add_word(bigint_t *result, const bigint_t *a, bigint_word_t b, bigint_word_t c) {
     if (result == NULL || a == NULL) {
         return -1;
     }
     
     bigint_init(result);
-    uint64_t carry = c;  /* Start with c */
+    bigint_dword_t carry = c;  /* Start with c */
     
     /* Compute a * b + c */
     int max_words = a->used + 2; /* Extra space for overflow */
@@ -395,21 +413,21 @@ int bigint_mul_add_word(bigint_t *result, const bigint_t *a, uint32_t b, uint32_
     }
     
     for (int i = 0; i < max_words && (i < a->used || carry > 0); i++) {
-        uint64_t word_product = 0;
+        bigint_dword_t word_product = 0;
         if (i < a->used) {
-            word_product = (uint64_t)a->words[i] * b;
+            word_product = (bigint_dword_t)a->words[i] * b;
         }
         
-        uint64_t sum = word_product + carry;
-        result->words[i] = (uint32_t)(sum & 0xFFFFFFFF);
-        carry = sum >> 32;
+        bigint_dword_t sum = word_product + carry;
+        result->words[i] = (bigint_word_t)(sum & BIGINT_WORD_MASK);
+        carry = sum >> BIGINT_WORD_SIZE;
         
         result->used = i + 1;
     }
     
     /* FIXED: Handle remaining carry overflow */
     if (carry > 0 && result->used < BIGINT_4096_WORDS) {
-        result->words[result->used] = (uint32_t)carry;
+        result->words[result->used] = (bigint_word_t)carry;
         result->used++;
     } else if (carry > 0) {
         return -2;  /* Overflow - this is important for Montgomery */
@@ -419,7 +437,7 @@ int bigint_mul_add_word(bigint_t *result, const bigint_t *a, uint32_t b, uint32_
     return 0;
 }
 
-int bigint_add_word(bigint_t *result, const bigint_t *a, uint32_t word) {
+int bigint_add_word(bigint_t *result, const bigint_t *a, bigint_word_t word) {
     if (result == NULL || a == NULL) {
         return -1;
     }
@@ -432,22 +450,22 @@ int bigint_add_word(bigint_t *result, const bigint_t *a, uint32_t word) {
         return 0;
     }
     
-    uint64_t carry = word;
+    bigint_dword_t carry = word;
     int i = 0;
     
     /* FIXED: Propagate carry through all words */
     while (carry > 0 && i < BIGINT_4096_WORDS) {
-        uint64_t sum;
+        bigint_dword_t sum;
         if (i < result->used) {
-            sum = (uint64_t)result->words[i] + carry;
-            result->words[i] = (uint32_t)(sum & 0xFFFFFFFF);
+            sum = (bigint_dword_t)result->words[i] + carry;
+            result->words[i] = (bigint_word_t)(sum & BIGINT_WORD_MASK);
         } else {
             /* Extend the number */
-            result->words[i] = (uint32_t)carry;
+            result->words[i] = (bigint_word_t)carry;
             result->used = i + 1;
             sum = carry;
         }
-        carry = sum >> 32;
+        carry = sum >> BIGINT_WORD_SIZE;
         i++;
     }
     
@@ -467,8 +485,162 @@ int mod_inverse_extended_gcd(bigint_t *result, const bigint_t *a, const bigint_t
     return extended_gcd_full(result, a, m);
 }
 
+/* Word-array helpers for the binary inverse; every array is w words wide */
+static int inverse_is_zero(const bigint_word_t *a, int w) {
+    bigint_word_t any = 0;
+    for (int i = 0; i < w; i++) {
+        any |= a[i];
+    }
+    return any == 0;
+}
+
+static int inverse_is_one(const bigint_word_t *a, int w) {
+    bigint_word_t any = a[0] ^ 1;
+    for (int i = 1; i < w; i++) {
+        any |= a[i];
+    }
+    return any == 0;
+}
+
+static int inverse_compare(const bigint_word_t *a, const bigint_word_t *b, int w) {
+    for (int i = w - 1; i >= 0; i--) {
+        if (a[i] != b[i]) {
+            return a[i] > b[i] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static bigint_word_t inverse_sub(bigint_word_t *a, const bigint_word_t *b, int w) {
+    bigint_dword_t borrow = 0;
+    for (int i = 0; i < w; i++) {
+        bigint_dword_t d = (bigint_dword_t)a[i] - b[i] - borrow;
+        a[i] = (bigint_word_t)d;
+        borrow = (d >> BIGINT_WORD_SIZE) & 1;
+    }
+    return (bigint_word_t)borrow;
+}
+
+static void inverse_add(bigint_word_t *a, const bigint_word_t *b, int w) {
+    bigint_dword_t carry = 0;
+    for (int i = 0; i < w; i++) {
+        bigint_dword_t s = (bigint_dword_t)a[i] + b[i] + carry;
+        a[i] = (bigint_word_t)s;
+        carry = s >> BIGINT_WORD_SIZE;
+    }
+}
+
+static void inverse_shr1(bigint_word_t *a, int w) {
+    for (int i = 0; i < w - 1; i++) {
+        a[i] = (a[i] >> 1) | (a[i + 1] << (BIGINT_WORD_SIZE - 1));
+    }
+    a[w - 1] >>= 1;
+}
+
+/* x = x / 2 mod m for x in [0, m), m odd; the spare top word takes the carry of x + m */
+static void inverse_halve(bigint_word_t *x, const bigint_word_t *m, int w) {
+    if (x[0] & 1) {
+        inverse_add(x, m, w);
+    }
+    inverse_shr1(x, w);
+}
+
+/* x = x - y mod m for x, y in [0, m) */
+static void inverse_sub_mod(bigint_word_t *x, const bigint_word_t *y, const bigint_word_t *m, int w) {
+    if (inverse_sub(x, y, w)) {
+        inverse_add(x, m, w);
+    }
+}
+
+/**
+ * @brief a^(-1) mod m for odd m by the binary extended Euclidean algorithm
+ *
+ * Shifts and subtractions on fixed word arrays, no output. The running time
+ * depends on the operands, so it belongs at key setup, not on a request path.
+ * Returns -3 when gcd(a, m) != 1.
+ */
+int bigint_mod_inverse_odd(bigint_t *result, const bigint_t *a, const bigint_t *m) {
+    if (result == NULL || a == NULL || m == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in bigint_mod_inverse_odd");
+    }
+    
+    bigint_t mod, a_red;
+    bigint_copy(&mod, m);
+    bigint_normalize(&mod);
+    if (bigint_is_zero(&mod) || (mod.words[0] & 1) == 0 || mod.used >= BIGINT_4096_WORDS) {
+        ERROR_RETURN(-2, "Modulus must be odd and below %d words", BIGINT_4096_WORDS);
+    }
+    if (bigint_is_one(&mod)) {
+        bigint_init(result);
+        return 0;
+    }
+    
+    int ret = bigint_mod(&a_red, a, &mod);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to reduce operand before inversion");
+    }
+    if (bigint_is_zero(&a_red)) {
+        ERROR_RETURN(-3, "Zero has no inverse");
+    }
+    
+    /* Invariants: x1 * a = u, x2 * a = v (mod m) */
+    int w = mod.used + 1;
+    bigint_word_t u[BIGINT_4096_WORDS], v[BIGINT_4096_WORDS], x1[BIGINT_4096_WORDS], x2[BIGINT_4096_WORDS];
+    memset(u, 0, (size_t)w * sizeof(bigint_word_t));
+    memset(v, 0, (size_t)w * sizeof(bigint_word_t));
+    memset(x1, 0, (size_t)w * sizeof(bigint_word_t));
+    memset(x2, 0, (size_t)w * sizeof(bigint_word_t));
+    memcpy(u, a_red.words, (size_t)a_red.used * sizeof(bigint_word_t));
+    memcpy(v, mod.words, (size_t)mod.used * sizeof(bigint_word_t));
+    x1[0] = 1;
+    
+    while (!inverse_is_one(u, w) && !inverse_is_one(v, w)) {
+        /* u or v reaches zero only when they meet at a common factor */
+        if (inverse_is_zero(u, w) || inverse_is_zero(v, w)) {
+            ERROR_RETURN(-3, "Operand is not invertible modulo m");
+        }
+        while ((u[0] & 1) == 0) {
+            inverse_shr1(u, w);
+            inverse_halve(x1, mod.words, w);
+        }
+        while ((v[0] & 1) == 0) {
+            inverse_shr1(v, w);
+            inverse_halve(x2, mod.words, w);
+        }
+        if (inverse_compare(u, v, w) >= 0) {
+            inverse_sub(u, v, w);
+            inverse_sub_mod(x1, x2, mod.words, w);
+        } else {
+            inverse_sub(v, u, w);
+            inverse_sub_mod(x2, x1, mod.words, w);
+        }
+    }
+    
+    /* Written last, so result may alias a or m */
+    bigint_init(result);
+    memcpy(result->words, inverse_is_one(u, w) ? x1 : x2, (size_t)mod.used * sizeof(bigint_word_t));
+    result->used = mod.used;
+    bigint_normalize(result);
+    return 0;
+}
+
 /* ===================== HYBRID ALGORITHM SELECTION - TERRANTSH MODEL ===================== */
 
+/* Smallest modulus handed to Montgomery; below it the context setup outweighs the products */
+static int montgomery_min_bits = HYBRID_MONTGOMERY_MIN_BITS;
+
+int hybrid_set_montgomery_min_bits(int bits) {
+    if (bits < 8 || bits > 4096) {
+        ERROR_RETURN(-1, "Montgomery cutover of %d bits outside 8..4096", bits);
+    }
+    montgomery_min_bits = bits;
+    return 0;
+}
+
+int hybrid_montgomery_min_bits(void) {
+    return montgomery_min_bits;
+}
+
 /**
  * @brief Hybrid modular exponentiation with intelligent algorithm selection - ENHANCED WITH ROUND-TRIP VALIDATION
  * 
@@ -481,6 +653,22 @@ int mod_inverse_extended_gcd(bigint_t *result, const bigint_t *a, const bigint_t
  */
 int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, 
                    const bigint_t *modulus, const montgomery_ctx_t *mont_ctx) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        CHECKPOINT(LOG_ERROR, "hybrid_mod_exp: no workspace");
+        return -1;
+    }
+    /* The exponent may be secret, so nothing it touched stays behind */
+    int ret = hybrid_mod_exp_ws(result, base, exp, modulus, mont_ctx, ws);
+    rsa_4096_workspace_clear(ws);
+    return ret;
+}
+
+int hybrid_mod_exp_ws(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                      const bigint_t *modulus, const montgomery_ctx_t *mont_ctx, rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return hybrid_mod_exp(result, base, exp, modulus, mont_ctx);
+    }
     
     /* TODO: Critical input validation for round-trip safety */
     if (result == NULL || base == NULL || exp == NULL || modulus == NULL) {
@@ -511,11 +699,9 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     if (mont_ctx != NULL && mont_ctx->is_active) {
         
         /* TODO: Validate Montgomery context integrity */
-        if (mont_ctx->n_words <= 0 || mont_ctx->n_words > BIGINT_4096_WORDS) {
+        if (mont_ctx->n_words <= 0 || mont_ctx->n_words > MONTGOMERY_MAX_WORDS) {
             reason = "invalid Montgomery context parameters";
-        } else if (bigint_is_zero(&mont_ctx->n)) {
-            reason = "zero modulus in Montgomery context";
-        } else if (bigint_compare(&mont_ctx->n, modulus) != 0) {
+        } else if (!montgomery_ctx_matches(mont_ctx, modulus)) {
             reason = "Montgomery context modulus mismatch";
         }
         /* Check 2: Modulus must be odd (Montgomery requirement) */
@@ -523,17 +709,17 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
             
             /* Check 3: Buffer capacity check with safety margins */
             int modulus_bits = bigint_bit_length(modulus);
-            int required_words = (modulus_bits + 31) / 32;
+            int required_words = (modulus_bits + BIGINT_WORD_SIZE - 1) / BIGINT_WORD_SIZE;
             
             /* TODO: FIXME - Conservative buffer check to prevent overflow */
             if (required_words <= BIGINT_4096_WORDS / 4) {  /* Use 1/4 of buffer as safety margin */
                 
                 /* Check 4: Performance threshold - Montgomery is better for larger modulus */
-                if (modulus_bits >= 512) {  /* 512+ bits favor Montgomery */
+                if (modulus_bits >= 512 && modulus_bits >= montgomery_min_bits) {  /* 512+ bits favor Montgomery */
                     use_montgomery = 1;
                     algorithm_choice = "Montgomery REDC";
                     reason = "optimal for large modulus";
-                } else if (modulus_bits >= 64) {  /* Medium size can use Montgomery */
+                } else if (modulus_bits >= montgomery_min_bits) {  /* Medium size can use Montgomery */
                     use_montgomery = 1;
                     algorithm_choice = "Montgomery REDC";
                     reason = "medium modulus Montgomery optimization";
@@ -552,22 +738,28 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
     
     CHECKPOINT(LOG_INFO, "Algorithm selection: %s (%s)", algorithm_choice, reason);
     
-    /* TODO: Store original inputs for validation */
-    bigint_t original_base, original_exp, original_modulus;
-    bigint_copy(&original_base, base);
-    bigint_copy(&original_exp, exp);
-    bigint_copy(&original_modulus, modulus);
+    /* The fallback re-reads the inputs, so keep copies only when result aliases one of them */
+    const bigint_t *original_base = base, *original_exp = exp, *original_modulus = modulus;
+    if (result == base || result == exp || result == modulus) {
+        bigint_copy(&ws->tmp[0], base);
+        bigint_copy(&ws->tmp[1], exp);
+        bigint_copy(&ws->tmp[2], modulus);
+        original_base = &ws->tmp[0];
+        original_exp = &ws->tmp[1];
+        original_modulus = &ws->tmp[2];
+        modulus = original_modulus;
+    }
     
     /* Execute chosen algorithm with comprehensive error handling */
     int ret;
     if (use_montgomery) {
         CHECKPOINT(LOG_INFO, "Executing Montgomery REDC exponentiation");
-        ret = montgomery_exp(result, base, exp, mont_ctx);
+        ret = montgomery_exp_ws(result, base, exp, mont_ctx, ws);
         if (ret != 0) {
             CHECKPOINT(LOG_ERROR, "Montgomery exponentiation failed (code %d), falling back to traditional", ret);
             /* TODO: FIXME - Fallback to traditional method - Terrantsh model approach */
             CHECKPOINT(LOG_INFO, "Fallback: Using traditional modular exponentiation (Terrantsh model)");
-            ret = bigint_mod_exp(result, &original_base, &original_exp, &original_modulus);
+            ret = bigint_mod_exp(result, original_base, original_exp, original_modulus);
             
             if (ret != 0) {
                 ERROR_RETURN(ret, "Both Montgomery and traditional algorithms failed");
@@ -575,7 +767,7 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         }
     } else {
         CHECKPOINT(LOG_INFO, "Executing traditional modular exponentiation (Terrantsh model)");
-        ret = bigint_mod_exp(result, &original_base, &original_exp, &original_modulus);
+        ret = bigint_mod_exp(result, original_base, original_exp, original_modulus);
     }
     
     /* TODO: Final validation and result verification */
@@ -586,10 +778,10 @@ int hybrid_mod_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
             debug_print_bigint("result", result);
             debug_print_bigint("modulus", modulus);
             /* Try to fix by taking modulo again */
-            bigint_t corrected_result;
-            int fix_ret = bigint_mod(&corrected_result, result, modulus);
+            bigint_t *corrected_result = &ws->tmp[3];
+            int fix_ret = bigint_mod(corrected_result, result, modulus);
             if (fix_ret == 0) {
-                bigint_copy(result, &corrected_result);
+                bigint_copy(result, corrected_result);
                 CHECKPOINT(LOG_INFO, "Result corrected by additional modular reduction");
             } else {
                 ERROR_RETURN(-10, "Failed to correct invalid result");
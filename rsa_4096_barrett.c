@@ -0,0 +1,214 @@
+/**
+ * @file rsa_4096_barrett.c
+ * @brief Barrett reduction for moduli Montgomery cannot take
+ *
+ * Montgomery needs an odd modulus and a context per key; bigint_mod_exp()
+ * serves everything else and used to follow every multiply with a long
+ * division. A Barrett context holds mu = floor(b^(2k) / n), paid for with one
+ * division, after which each reduction of a double-width product is two
+ * multiplications - one by mu, one truncated to k + 1 words by n - and at
+ * most two subtractions (HAC 14.42). It works for even moduli too.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rsa_4096.h"
+
+/* ===================== CONTEXT ===================== */
+
+int barrett_ctx_init(barrett_ctx_t *ctx, const bigint_t *modulus) {
+    if (ctx == NULL || modulus == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in barrett_ctx_init");
+    }
+    
+    memset(ctx, 0, sizeof(*ctx));
+    bigint_copy(&ctx->n, modulus);
+    bigint_normalize(&ctx->n);
+    if (bigint_is_zero(&ctx->n)) {
+        ERROR_RETURN(-2, "Zero modulus in barrett_ctx_init");
+    }
+    
+    int k = ctx->n.used;
+    if (k > BARRETT_MAX_WORDS) {
+        ERROR_RETURN(-3, "Modulus of %d words exceeds the Barrett limit of %d", k, BARRETT_MAX_WORDS);
+    }
+    
+    /* mu = floor(b^(2k) / n), at most k + 1 words */
+    bigint_t b2k, rem;
+    bigint_init(&b2k);
+    b2k.words[2 * k] = 1;
+    b2k.used = 2 * k + 1;
+    int ret = bigint_div(&ctx->mu, &rem, &b2k, &ctx->n);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to compute the Barrett constant");
+    }
+    
+    ctx->k = k;
+    ctx->is_active = 1;
+    TRACE(LOG_DEBUG, "[BARRETT] Context ready for %d-word modulus, mu has %d words", k, ctx->mu.used);
+    return 0;
+}
+
+void barrett_ctx_free(barrett_ctx_t *ctx) {
+    if (ctx != NULL) {
+        memset(ctx, 0, sizeof(*ctx));
+    }
+}
+
+/* ===================== REDUCTION ===================== */
+
+/* t has k + 1 words, n has k */
+static int barrett_at_least_n(const bigint_word_t *t, const bigint_word_t *n, int k) {
+    if (t[k] != 0) {
+        return 1;
+    }
+    for (int i = k - 1; i >= 0; i--) {
+        if (t[i] != n[i]) {
+            return t[i] > n[i];
+        }
+    }
+    return 1;
+}
+
+int barrett_reduce(bigint_t *result, const bigint_t *x, const barrett_ctx_t *ctx) {
+    if (result == NULL || x == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in barrett_reduce");
+    }
+    
+    if (!ctx->is_active) {
+        ERROR_RETURN(-2, "Barrett context not initialised");
+    }
+    
+    if (bigint_compare(x, &ctx->n) < 0) {
+        if (result != x) {
+            bigint_copy(result, x);
+        }
+        return 0;
+    }
+    
+    int k = ctx->k;
+    if (x->used > 2 * k) {
+        return bigint_mod(result, x, &ctx->n);
+    }
+    STATS_COUNT(RSA_4096_STAT_BARRETT_REDUCE, 1);
+    
+    /* q1 = floor(x / b^(k-1)), q2 = q1 * mu; q3 = floor(q2 / b^(k+1)) is within 2 of x / n */
+    bigint_t q1, q2;
+    bigint_init(&q1);
+    q1.used = x->used - (k - 1);
+    memcpy(q1.words, x->words + (k - 1), (size_t)q1.used * sizeof(bigint_word_t));
+    bigint_normalize(&q1);
+    int ret = bigint_mul(&q2, &q1, &ctx->mu);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Barrett quotient estimate overflowed");
+    }
+    const bigint_word_t *q3 = q2.words + (k + 1);
+    int q3_words = q2.used - (k + 1);
+    
+    /* Everything from here on is mod b^(k+1): t = x - q3 * n, only the low k + 1 words */
+    bigint_word_t t[BARRETT_MAX_WORDS + 1], qn[BARRETT_MAX_WORDS + 1];
+    memset(t, 0, sizeof(t));
+    memset(qn, 0, sizeof(qn));
+    memcpy(t, x->words, (size_t)(x->used < k + 1 ? x->used : k + 1) * sizeof(bigint_word_t));
+    for (int i = 0; i < q3_words && i <= k; i++) {
+        bigint_dword_t carry = 0;
+        for (int j = 0; j < k && i + j <= k; j++) {
+            bigint_dword_t cur = (bigint_dword_t)q3[i] * ctx->n.words[j] + qn[i + j] + carry;
+            qn[i + j] = (bigint_word_t)cur;
+            carry = cur >> BIGINT_WORD_SIZE;
+        }
+        if (i == 0) {
+            qn[k] = (bigint_word_t)carry;   /* Later rows' carries fall past b^(k+1) */
+        }
+    }
+    
+    bigint_dword_t borrow = 0;
+    for (int i = 0; i <= k; i++) {
+        bigint_dword_t d = (bigint_dword_t)t[i] - qn[i] - borrow;
+        t[i] = (bigint_word_t)d;
+        borrow = (d >> BIGINT_WORD_SIZE) & 1;
+    }
+    
+    /* HAC 14.42: at most two corrections */
+    while (barrett_at_least_n(t, ctx->n.words, k)) {
+        borrow = 0;
+        for (int i = 0; i <= k; i++) {
+            bigint_dword_t d = (bigint_dword_t)t[i] - (i < k ? ctx->n.words[i] : 0) - borrow;
+            t[i] = (bigint_word_t)d;
+            borrow = (d >> BIGINT_WORD_SIZE) & 1;
+        }
+    }
+    
+    /* x is fully consumed, so result may alias it */
+    bigint_init(result);
+    memcpy(result->words, t, (size_t)k * sizeof(bigint_word_t));
+    result->used = k;
+    bigint_normalize(result);
+    return 0;
+}
+
+int barrett_mul(bigint_t *result, const bigint_t *a, const bigint_t *b, const barrett_ctx_t *ctx) {
+    if (result == NULL || a == NULL || b == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in barrett_mul");
+    }
+    
+    bigint_t product;
+    int ret = bigint_mul(&product, a, b);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Barrett product overflowed");
+    }
+    return barrett_reduce(result, &product, ctx);
+}
+
+/* ===================== EXPONENTIATION ===================== */
+
+/* Plain residues: the sliding window's "R" is 1 here */
+static void barrett_kernel_mul(void *out, const void *a, const void *b, const void *kernel_ctx) {
+    barrett_mul((bigint_t *)out, (const bigint_t *)a, (const bigint_t *)b, (const barrett_ctx_t *)kernel_ctx);
+}
+
+int barrett_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const barrett_ctx_t *ctx) {
+    if (result == NULL || base == NULL || exp == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in barrett_exp");
+    }
+    
+    if (!ctx->is_active) {
+        ERROR_RETURN(-2, "Barrett context not initialised");
+    }
+    
+    if (bigint_is_one(&ctx->n)) {
+        bigint_init(result);
+        return 0;
+    }
+    if (bigint_is_zero(exp)) {
+        bigint_set_u32(result, 1);
+        return 0;
+    }
+    
+    bigint_t table[1 << (BARRETT_MAX_WINDOW - 1)], acc, scratch;
+    int ret = barrett_reduce(&table[0], base, ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to reduce base before Barrett exponentiation");
+    }
+    
+    int window_bits = montgomery_select_window(bigint_bit_length(exp));
+    if (window_bits > BARRETT_MAX_WINDOW) {
+        window_bits = BARRETT_MAX_WINDOW;
+    }
+    
+    int squarings = 0, multiplies = 0;
+    bigint_set_u32(&acc, 1);
+    mont_exp_kernel_t kernel = {barrett_kernel_mul, NULL, ctx, sizeof(bigint_t)};
+    montgomery_exp_sliding(&kernel, &acc, table, &scratch, exp, window_bits, &squarings, &multiplies);
+    TRACE(LOG_DEBUG, "[BARRETT] %d-bit window: %d squarings, %d multiplications", window_bits, squarings, multiplies);
+    
+    /* Written last, so result may alias base or exp */
+    bigint_copy(result, &acc);
+    memset(&acc, 0, sizeof(acc));
+    return 0;
+}
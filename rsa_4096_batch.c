@@ -0,0 +1,250 @@
+/**
+ * @file rsa_4096_batch.c
+ * @brief Multithreaded batch encrypt/decrypt over one shared, read-only key
+ *
+ * Items are split into one contiguous index range per worker. A worker pops
+ * from the front of its own range; once it runs dry it steals the back half
+ * of the largest remaining range, so uneven item costs still keep every core
+ * busy. With a vector kernel a worker pops a lane-width run of items at once
+ * and exponentiates them in lock-step (rsa_4096_*_binary_multi). The key
+ * and its Montgomery/CRT contexts are only ever read - every operation keeps
+ * its bignum state in the worker's own heap workspace.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "rsa_4096.h"
+
+/* Operations run out of a per-worker workspace; this still covers the stack fallback */
+#define BATCH_WORKER_STACK_SIZE (1u * 1024u * 1024u)
+
+/* ===================== WORK-STEALING QUEUES ===================== */
+
+typedef struct {
+    pthread_mutex_t lock;
+    size_t begin;           /* Next item the owner takes */
+    size_t end;             /* One past the last item; thieves shrink this */
+} batch_queue_t;
+
+typedef int (*batch_op_t)(const rsa_4096_key_t *key, const uint8_t *in, size_t in_len,
+                          uint8_t *out, size_t out_size, size_t *out_len, rsa_4096_workspace_t *ws);
+typedef int (*batch_group_op_t)(const rsa_4096_key_t *key, rsa_4096_batch_item_t *items, size_t count,
+                                rsa_4096_workspace_t *ws);
+
+typedef struct {
+    const rsa_4096_key_t *key;
+    rsa_4096_batch_item_t *items;
+    batch_op_t op;
+    batch_group_op_t group_op;
+    size_t group;           /* Items per pop: montgomery_multi_lanes(), 1 = one at a time */
+    batch_queue_t *queues;
+    int num_queues;
+} batch_job_t;
+
+typedef struct {
+    batch_job_t *job;
+    int id;
+    size_t processed;
+    size_t steals;
+} batch_worker_t;
+
+/**
+ * @brief Owner side: take up to max items from the front of a queue as [*begin, *end)
+ */
+static int batch_queue_pop(batch_queue_t *q, size_t max, size_t *begin, size_t *end) {
+    int found = 0;
+    pthread_mutex_lock(&q->lock);
+    if (q->begin < q->end) {
+        size_t take = q->end - q->begin < max ? q->end - q->begin : max;
+        *begin = q->begin;
+        *end = q->begin + take;
+        q->begin += take;
+        found = 1;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return found;
+}
+
+/**
+ * @brief Thief side: move the back half of the fullest other queue into ours
+ */
+static int batch_steal(batch_job_t *job, int self) {
+    for (;;) {
+        int victim = -1;
+        size_t best = 0;
+    
+        /* Pick the fullest victim; the sizes may move before we lock it again below */
+        for (int i = 0; i < job->num_queues; i++) {
+            if (i == self) continue;
+            pthread_mutex_lock(&job->queues[i].lock);
+            size_t remaining = job->queues[i].end - job->queues[i].begin;
+            pthread_mutex_unlock(&job->queues[i].lock);
+            if (remaining > best) {
+                best = remaining;
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            return 0;
+        }
+    
+        batch_queue_t *v = &job->queues[victim];
+        size_t begin = 0, end = 0;
+        pthread_mutex_lock(&v->lock);
+        if (v->begin < v->end) {
+            size_t take = (v->end - v->begin + 1) / 2;
+            end = v->end;
+            begin = v->end - take;
+            v->end = begin;
+        }
+        pthread_mutex_unlock(&v->lock);
+    
+        if (begin < end) {
+            batch_queue_t *own = &job->queues[self];
+            pthread_mutex_lock(&own->lock);
+            own->begin = begin;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+        /* Victim drained while we looked - rescan */
+    }
+}
+
+static void *batch_worker_main(void *arg) {
+    batch_worker_t *worker = (batch_worker_t *)arg;
+    batch_job_t *job = worker->job;
+    size_t begin, end;
+    
+    /* NULL on allocation failure: the *_ws calls then fall back to stack scratch */
+    rsa_4096_workspace_t *ws = rsa_4096_workspace_new();
+    
+    for (;;) {
+        while (batch_queue_pop(&job->queues[worker->id], job->group, &begin, &end)) {
+            if (end - begin > 1) {
+                job->group_op(job->key, &job->items[begin], end - begin, ws);
+            } else {
+                rsa_4096_batch_item_t *item = &job->items[begin];
+                item->output_len = 0;
+                if (item->input == NULL || item->output == NULL) {
+                    item->status = -1;
+                } else {
+                    item->status = job->op(job->key, item->input, item->input_len,
+                                           item->output, item->output_size, &item->output_len, ws);
+                }
+            }
+            worker->processed += end - begin;
+        }
+        if (!batch_steal(job, worker->id)) {
+            break;
+        }
+        worker->steals++;
+    }
+    rsa_4096_workspace_free(ws);
+    
+    TRACE(LOG_DEBUG, "[BATCH] worker %d: %zu items, %zu steals", worker->id, worker->processed, worker->steals);
+    return NULL;
+}
+
+/* ===================== BATCH DRIVER ===================== */
+
+static int batch_resolve_threads(int num_threads, size_t count) {
+    if (num_threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = online > 0 ? (int)online : 1;
+    }
+    if (num_threads > RSA_4096_BATCH_MAX_THREADS) {
+        num_threads = RSA_4096_BATCH_MAX_THREADS;
+    }
+    if ((size_t)num_threads > count) {
+        num_threads = (int)count;
+    }
+    return num_threads;
+}
+
+static int batch_run(const rsa_4096_key_t *key, rsa_4096_batch_item_t *items, size_t count,
+                     int num_threads, batch_op_t op, batch_group_op_t group_op) {
+    if (key == NULL || (items == NULL && count > 0)) {
+        ERROR_RETURN(-1, "NULL pointer in RSA batch operation");
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    for (size_t i = 0; i < count; i++) {
+        items[i].status = -2;  /* Not processed */
+        items[i].output_len = 0;
+    }
+    
+    int threads = batch_resolve_threads(num_threads, count);
+    batch_queue_t queues[RSA_4096_BATCH_MAX_THREADS];
+    batch_worker_t workers[RSA_4096_BATCH_MAX_THREADS];
+    pthread_t tids[RSA_4096_BATCH_MAX_THREADS];
+    batch_job_t job = {key, items, op, group_op, (size_t)montgomery_multi_lanes(), queues, threads};
+    
+    /* Even contiguous split; stealing evens out whatever the split gets wrong */
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&queues[t].lock, NULL);
+        queues[t].begin = count * (size_t)t / (size_t)threads;
+        queues[t].end = count * (size_t)(t + 1) / (size_t)threads;
+        workers[t].job = &job;
+        workers[t].id = t;
+        workers[t].processed = 0;
+        workers[t].steals = 0;
+    }
+    
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, BATCH_WORKER_STACK_SIZE);
+    
+    /* Worker 0 runs on the caller's thread; a failed spawn leaves its range to be stolen */
+    int started = 1;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tids[t], &attr, batch_worker_main, &workers[t]) != 0) {
+            CHECKPOINT(LOG_INFO, "Batch worker %d could not be started, continuing with %d", t, started);
+            break;
+        }
+        started++;
+    }
+    pthread_attr_destroy(&attr);
+    
+    batch_worker_main(&workers[0]);
+    for (int t = 1; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    
+    size_t failed = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (items[i].status != 0) failed++;
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_destroy(&queues[t].lock);
+    }
+    
+    CHECKPOINT(LOG_INFO, "Batch of %zu items on %d threads: %zu failed", count, started, failed);
+    return failed == 0 ? 0 : -3;
+}
+
+int rsa_4096_encrypt_batch(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                           int num_threads) {
+    return batch_run(pub_key, items, count, num_threads, rsa_4096_encrypt_binary_ws,
+                     rsa_4096_encrypt_binary_multi);
+}
+
+int rsa_4096_decrypt_batch(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                           int num_threads) {
+    if (priv_key != NULL && !priv_key->is_private) {
+        ERROR_RETURN(-2, "Batch decryption requires private key");
+    }
+    return batch_run(priv_key, items, count, num_threads, rsa_4096_decrypt_binary_ws,
+                     rsa_4096_decrypt_binary_multi);
+}
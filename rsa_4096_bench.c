@@ -0,0 +1,812 @@
+/**
+ * @file rsa_4096_bench.c
+ * @brief Per-primitive microbenchmarks over real 1024-4096-bit keys
+ *
+ * Every benchmark is timed with CLOCK_MONOTONIC (and, with --cycles, the
+ * time-stamp counter) over repeated samples. A sample runs enough back-to-back
+ * calls to last at least BENCH_MIN_SAMPLE_NS, so cheap primitives are not lost
+ * in clock resolution, and warm-up samples are discarded before recording.
+ * Results are reported per call as min / median / mean / p99 / max; --json
+ * writes them in a stable layout that can be diffed between releases.
+ *
+ * The bundled keys are fixed benchmark vectors (e = 65537, with PKCS#1 CRT
+ * components) - never use them for anything else.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "rsa_4096.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define BENCH_HAVE_TSC 1
+#include <x86intrin.h>
+#endif
+
+#define BENCH_DEFAULT_SAMPLES   101         /* Odd, so the median is a real sample */
+#define BENCH_MIN_SAMPLES       11          /* Kept even when the time budget runs out */
+#define BENCH_WARMUP_SAMPLES    3
+#define BENCH_DEFAULT_BUDGET_MS 500         /* Per benchmark and key size, warm-up excluded */
+#define BENCH_MIN_SAMPLE_NS     20000ull    /* Batch calls until a sample lasts this long */
+#define BENCH_MAX_REPS          (1u << 20)
+#define BENCH_BLOCK_BYTES       (4096 / 8)
+#define BENCH_TEXT_SIZE         1408        /* Decimal of a 4096-bit number is 1234 digits */
+#define BENCH_MAX_RESULTS       128
+
+/* ===================== BENCHMARK KEYS ===================== */
+
+typedef struct {
+    int bits;
+    const char *n, *d, *p, *q, *dp, *dq, *qinv;
+} bench_key_vector_t;
+
+static const bench_key_vector_t bench_keys[] = {
+    {1024,
+     /* n */ "14806654886168170751787964901181175033731108100679639153894760282419593799734946"
+            "28610342080194928053858928931789783653943517362615004295338207348050677240073406"
+            "87514540268973972596300148442239300672323007162406680030039211731876872660520494"
+            "473546745160328478898446043375574437678417476991034168885532172668489",
+     /* d */ "14516337179701196379814155680465887334899234900664787447030626022949230828700882"
+            "99395329345815104709042890302048570720862701643083132520317843333185103285374047"
+            "33603236713248649697467224499218655397785421498031619657266691860797903424636997"
+            "137952598153146776969864249264942714327675672334257760594529709581249",
+     /* p */ "12299339599644739943746822476869934824812469867607640000774514007810891060516288"
+            "566992438260798921774852119567696567546093225946711522802174456851279022717",
+     /* q */ "12038577166042194096266438348748656121251901567284464252100848810346484825691540"
+            "657435275807651007856055928570289407845460357144852846519816502955724361917",
+     /* dp */ "41242395447120375513645752895569477960553403086889161337415615581374207233456819"
+            "43760407452573616505548776715743774789705734675144306652739458073511265441",
+     /* dq */ "47741370606746818524187059627992976881965442686379179076262425893908042879552488"
+            "16496678490636582299752713483098428519821088578890176252346474690926898793",
+     /* qinv */ "63905670146682904314864660861866555846301281181408626606377152922699072426496079"
+            "07035922003260439237165444812140594738245481448963971902485937506541668637"
+    },
+    {2048,
+     /* n */ "17096183244862230870581302272871324172306640092131042221018543370562885888350466"
+            "43452182542985952147022635120613176722457048105789763266643208209179190211398447"
+            "28313079527720495896841537176829200106706373438815771411471335859146585399516845"
+            "58171757704798441105120654650230814685341341291147879898787803874510589872405902"
+            "95921802267513643327021450021576667307354426255066649470220498708708408613114252"
+            "04810722705533253622793496696330332597081985047723802604005442373395848058890199"
+            "65993274504015136193988910058911241661792177407278805201201879232343551006579615"
+            "075617028511906845794970255466901300524352820810984012739",
+     /* d */ "38555562256292441257181690891105508532079915248134153840830991808736965901676899"
+            "14128394339889279755404511509935265873920864702927003231912754220008305434253788"
+            "06547036852420606581826742065327307868398034610326548585004858934370894640410604"
+            "34529895917866389907027064975572797206058413458529634390357163322285526104616994"
+            "73347327165910137907203652811158867606158351923357288851650532312266145735474762"
+            "94900981555411954927016772745889815114250258024507614702198228873564759767387675"
+            "19052244100049995802969797879229544662734418654130612065660186898858392361414214"
+            "1724060720980335335364234422696753467292613572245340737",
+     /* p */ "13351052743932436055667837994114146602699236732496010886715159269921874074460842"
+            "59815759579785840959924534159912430013752871602023304640214187152190381939054680"
+            "01597305638892736557996104380989828014116020978243506883681887816094490442421532"
+            "471208195144753465913222642073015594013562730334983008891533035091377",
+     /* q */ "12805119995224211296122867444151816621379952122184112146373459026101319218996519"
+            "48844560093362549427001587501761433183650851282582284657687716924129875429396612"
+            "89797977639483973043154832429257346067501678716269695134081711977449423401162702"
+            "267483161172932320420112750404123242391186798075158423756284550480307",
+     /* dp */ "38520996740012272972004081454858232465697219490481265522818704950631355856078256"
+            "96760028364766539010209960240747080142523009768933376175566483797056308968305681"
+            "43522506725334201378633190066700742774145878004425968790689353603999377416688093"
+            "36681199352917333520806978332219232909691588994067377437630623320305",
+     /* dq */ "68430614399917230301068279978718750252619140817439638631984627839410791309781513"
+            "04512417130756148218849901441047145031204321905164922954391703897615183356540209"
+            "88539995859994688174681736449620829656852052074387526539350870284909464238357160"
+            "30853758239766981370426001455721322585204315561992057543316810526447",
+     /* qinv */ "74703022154301558681639678847302257748131423784588984261555222684939649445362027"
+            "79251797535806408572496344710208569218112400107737745284754036209838549377836258"
+            "81157091218762269975624066226320072872609910594579983643425426715584456506661761"
+            "61056599176268691066954860165734859891363469923068120486641132495078"
+    },
+    {3072,
+     /* n */ "48641944487391979626229147939059869418964496316235520916688863638531507044374919"
+            "94823171881968682369106371928403472450753531516022953061497095290455190532906899"
+            "25528564799401804018377701873191544932347476448057489215355413219247159243910598"
+            "02961408977142476796888113801761739523108495445494614940180303088451009818941791"
+            "73848680097490389383437926193379004659841300688116935177145566948892722336981723"
+            "61394779395353492647238435899439525456326921227028309516858815095544904452231509"
+            "41692807545436540756360239303814906963668567469316771308716421340736706220332419"
+            "20959094724168678026900478417172657831285574488439140191420076928154269510980598"
+            "49424129182799805860657239640807612003523210334388961900066353123454342503242861"
+            "12677802288837089136848470253148030052808168175013127048796639321465540904176268"
+            "83404414949154010868769857089971545396603999352730286095548701021968917225838385"
+            "679918053399108387009755101145673268447567113",
+     /* d */ "50443490132894906273617557654471591567843593526119485560206397860382825135553456"
+            "53245220307060135358875480252023288956611189358133398841237432038246785122538102"
+            "40388122529073889039219266905217941231810846043703448857036783668673172646837374"
+            "33508422332587553238453131472490234694292355481187427511592751737471238539977542"
+            "49962419388788127860533729881048789161454050606901732523017539657937419542328444"
+            "80290449445873376057851041351032577531661575628508036360366948815942300248561897"
+            "64948116752741232785119855103456250831485725878449264977701554759463897621202645"
+            "25034435235788732690793401944142915634979492633512193934863950868525001964895189"
+            "16015121497004396555307700890678212571224428022857752917961710724546593416621885"
+            "96822943643538175993121152636323735318703118761149669675857055212477284231936193"
+            "50473491408974435299112750529531551980509409982981270763393094339577000146702742"
+            "606215514018320083546498850992853417999137",
+     /* p */ "22071857819965468942253495545175093404264163582731495657710660481516351454052097"
+            "83157423544877394522785609491869398859968868374906266609667125872232496044799698"
+            "19334495456816568254641886903103245203177667318979304087068492708712827873952158"
+            "96244858012353036041396100681112482570647906007300669188549354449498492376781649"
+            "66920821243767655907953409526340328499291624085758051664759905065652314454827430"
+            "540084376572178659069083301981529770655672483200860292215354969",
+     /* q */ "22037992852324417132644076911725839971604641969309399377000344994586533670943067"
+            "47154418762115321001451945612046618692952229522049765191586799512565192591466934"
+            "20197975871283414435786590944238357905369418768687695996407744687498099615412782"
+            "80991323342707762990903568548416293207444354340882062932418721114382188406483708"
+            "95394757242454738984691429079587822225735371585028280373932341445496248479095516"
+            "270365875366636702973872432982412030526004286084318091969750577",
+     /* dp */ "78800880307544141829935347783085407551913102447281922486399138493754610574471059"
+            "86895554587948987143771867935785921620695421248463742028623740964416427736427260"
+            "68142961182018411587669693418803077843653365263817043354018126004922829332244780"
+            "10946059138049702808579270295660446341458978097688490116068449182807532330124515"
+            "76363485582445887503897626699011399091570474748396614561553360502637113937783575"
+            "65602548835556041089741842009305179880089487799773091799363345",
+     /* dq */ "10436748465105099936614038102281686607545253411072460266169640166577387514610982"
+            "88164421549960682025757420021683795480006078210413332350447525771266397339844045"
+            "91035362880769997617277391750252924520636444303580573121145416663348620134634886"
+            "24855084953348808153389292415539260147389267523352557902154200638220852061767167"
+            "78008866450006374015714297028291915077286856705136376977367564603870593161812221"
+            "164889233162248857137190879998704887184881746604192755549768049",
+     /* qinv */ "19749883325593662326083667724450916936774099222300112993741237289981197274529030"
+            "42219704805635015679328669111410805184009475088275775521544866404259392069476477"
+            "24756386299274931912599886593909527066921209836337648678437124562075503434643871"
+            "67124458948188181251209823856514967841674726726630149828709679377911328444649873"
+            "56906668814123449345383086215457794891412032755442475388415790928586201975033708"
+            "144520698004908507655231866321740579104745329852513043518599156"
+    },
+    {4096,
+     /* n */ "75645930527901014472163936756231914714392850408398504280053129115773307948175058"
+            "81699929433881383948540745530895224077671255028764422875448264206532565658034723"
+            "56041974287526988860122262013506263728549058760639147172843825182120294378803204"
+            "15713577744972924831460012593646828400916750038255727036766585956938017214967365"
+            "62332587844103488255107081587707544775453339149850253726149078467649609521403359"
+            "37572153340579329258763863162796308000304896297524868188899593004523326197548718"
+            "40349891326952846947771212297776673470222629580973222255474940863924438201924560"
+            "58569896961592653377713258199667787240184404132021694651549036868661610412485755"
+            "98652709816702021172063819297491538141182949494662829092206431841604079892317895"
+            "22748555135596298074133900641060345407358171776922771962023965373853557776312159"
+            "43015547095705501901244926365727811406829811774530261084056362596315767514164483"
+            "08835937527491697313804269890976060764059201672949540138539630664793518127399495"
+            "74300086271712618521759677566020834106234284674666266091846322168396206898317656"
+            "10678880160953585334195889047711918931403020018342799390566173622849062649023007"
+            "31457596745168780077862716019654996477524696675941777365143497921700303519680801"
+            "178540333697180535660263872019643",
+     /* d */ "78096398363028253340656605595719232640734550843527210577054102506572196099509048"
+            "01193481933814706775688036416381141356718145707710161462270618981857475814007803"
+            "16611989872805835883178544148097010907939474125224601335346647112657874447561298"
+            "09530199280175596900935112258512663222393873805459244263662163447311079920727100"
+            "08200297443154889838420207519787180974215678576664604225265829212828975696448590"
+            "80155208432238238211208370563113938680449658719357501589345659134321806773672067"
+            "49135200683303013938480556389025584433148650646942158136708035138213947674477253"
+            "60068956901007963860660070643903786939757339877818451563034438779616854606460160"
+            "41987343790011815179515003126633207575623346061683867911137411249228783502242561"
+            "53235566114929539904715717954627158389917474897550133788340004723386374887875442"
+            "56958388116437586964150347527890818068980582938745624735903558786124157338833201"
+            "35075917822320667557738311848139266787600322485481668299118239888705487599046188"
+            "05895146807599792509070197371092205775226110587282661159029206450751451615210880"
+            "64206619180237341073606531143831901038695787863635040466115400442707455525037274"
+            "61054544380132478542293035868860279999639321830546212969505096356911747201670628"
+            "32740998115554668682600997359777",
+     /* p */ "27765663230349237521586492602101591120402761552971503406361750458641335166572313"
+            "57445400467744800749160180541427718389726744346509072688527174229128848958746963"
+            "97840634849714625284428651429144434197068659801077573690628763556233258439875377"
+            "77689240527729391789272512052618486781368282331657936508977386225361927213409079"
+            "87638028531193015315314285103852565904201651289676447151953058108576126469715691"
+            "95288180865864195475302366929591267917308717424563303102596766414257471101723323"
+            "61348202281235173374854102651665407283693497259666215263045669260014529770604127"
+            "673175569852179135339666457884908036807187539642034414297",
+     /* q */ "27244416926160901652529257636115911570321759315536533219664642518171138441340265"
+            "29747412659989844724913180300546032723313027461733755891769764314062845777458073"
+            "91846931863792421890545967786788680027940529804455857727685986655481205174452979"
+            "15987911556967519965467968044471474623577779159639096182969758871937074571305529"
+            "26165286860231601476231465933593499930976703947188155385731626148268265034508360"
+            "58961087166635766443256792908183347437479366683367843732714148834375180716546846"
+            "91419028738937847743278928316252428030782025086367987402648852362195672501247736"
+            "695041536847752283308205830713540721102535018106087684019",
+     /* dp */ "16810561229794274922853204143595053695873493990575648620794786097142523125477559"
+            "70399561242651417503485463229981696415551024443064734351710785453066261773259697"
+            "32668851949308430606540495598776599546904608881196225742259467310798166862014054"
+            "88211718188195592364718311880858887910614035958891241020182701497415748506963377"
+            "64033894351117806043858515321662052924497876337383031669779596147064896504140393"
+            "07564272526612835684644134113542760878448702239791984738513161947469707124910810"
+            "04103564678229556500005125945884488084741051280441517851326565307660047404791204"
+            "692676403194601765584976812829627019736521268679620420905",
+     /* dq */ "14744418870822205163677124522601876063539255068182091951646635348497702644879328"
+            "15922017062491719375363850632463595963050894273658740161577276968600653280358926"
+            "49557150607214086998396087484349617822466617500105899902125006861720972658612665"
+            "59107973314349512460674395999226608815616471172529707850795297429999300561439561"
+            "03960059117120015276240560808897176488882337238489242644935369580950895284250767"
+            "25196939738258348172931808457321009001213332583512987800965949476747774686886546"
+            "01755498593354098963312587233484003195077236763405401180968758038701132372160073"
+            "318884496222226802941474959240549037887982544550203976025",
+     /* qinv */ "27612998661039750562453437294409280471605042081951187316285181316494117224435493"
+            "28544809914594198996109189261639568959036898312692139734118345142750270733801852"
+            "75147174446550478214942326006491861965918387728594043637167070212492867175572329"
+            "40637102038961969836035191991493212715417208082752064179532006959089831958935088"
+            "13688414081565254656332174267078484646919060163817407058233327342093049075890550"
+            "23228124431646491004293912440383417749946525202038504385766328500248283405604683"
+            "89182337176338848006964977897287461322906289328776466033304361357324629029006390"
+            "781253099116678685278987500078277882233037402367427191626"
+    },
+};
+
+#define BENCH_KEY_COUNT ((int)(sizeof(bench_keys) / sizeof(bench_keys[0])))
+
+/* ===================== BENCHMARK STATE ===================== */
+
+typedef struct {
+    const bench_key_vector_t *vec;
+    rsa_4096_key_t pub, priv, crt, scratch_key;
+    montgomery_ctx_t ctx;                   /* Over n, shared by the primitive benchmarks */
+    rsa_4096_workspace_t *ws;
+    bigint_t n, d, a, b, a_mont, b_mont, wide, result, quotient, remainder;
+    uint8_t message[32];
+    uint8_t cipher[BENCH_BLOCK_BYTES], plain[BENCH_BLOCK_BYTES], binary[BENCH_BLOCK_BYTES];
+    size_t cipher_len, binary_len;
+    char decimal[BENCH_TEXT_SIZE], hex[BENCH_TEXT_SIZE], text[BENCH_TEXT_SIZE];
+} bench_state_t;
+
+typedef int (*bench_fn_t)(bench_state_t *st);
+
+typedef struct {
+    const char *name;
+    bench_fn_t fn;
+} bench_case_t;
+
+typedef struct {
+    const char *name;
+    int bits;
+    int samples;
+    unsigned reps;
+    double min_ns, median_ns, mean_ns, p99_ns, max_ns;
+    double median_cycles, p99_cycles;
+} bench_result_t;
+
+typedef struct {
+    int json;
+    int cycles;
+    int stats;                      /* Library counters on for the run, printed to stderr */
+    int samples;
+    long budget_ms;
+    const char *filter;
+    int bits[BENCH_KEY_COUNT];
+    int num_bits;
+} bench_options_t;
+
+/* ===================== BENCHMARK BODIES ===================== */
+
+static int bench_bigint_mul(bench_state_t *st) {
+    return bigint_mul(&st->result, &st->a, &st->b);
+}
+
+static int bench_bigint_div(bench_state_t *st) {
+    return bigint_div(&st->quotient, &st->remainder, &st->wide, &st->n);
+}
+
+static int bench_montgomery_redc(bench_state_t *st) {
+    return montgomery_redc(&st->result, &st->wide, &st->ctx);
+}
+
+static int bench_montgomery_mul(bench_state_t *st) {
+    return montgomery_mul(&st->result, &st->a_mont, &st->b_mont, &st->ctx);
+}
+
+static int bench_montgomery_square(bench_state_t *st) {
+    return montgomery_square(&st->result, &st->a_mont, &st->ctx);
+}
+
+static int bench_montgomery_exp(bench_state_t *st) {
+    return montgomery_exp(&st->result, &st->a, &st->d, &st->ctx);
+}
+
+static int bench_montgomery_exp_word(bench_state_t *st) {
+    return montgomery_exp_word(&st->result, &st->a, 65537, &st->ctx);
+}
+
+static int bench_from_decimal(bench_state_t *st) {
+    return bigint_from_decimal(&st->result, st->decimal);
+}
+
+static int bench_to_decimal(bench_state_t *st) {
+    return bigint_to_decimal(&st->n, st->text, sizeof(st->text));
+}
+
+static int bench_from_hex(bench_state_t *st) {
+    return bigint_from_hex(&st->result, st->hex);
+}
+
+static int bench_to_hex(bench_state_t *st) {
+    return bigint_to_hex(&st->n, st->text, sizeof(st->text));
+}
+
+static int bench_from_binary(bench_state_t *st) {
+    return bigint_from_binary(&st->result, st->binary, st->binary_len);
+}
+
+static int bench_to_binary(bench_state_t *st) {
+    size_t written;
+    return bigint_to_binary(&st->n, (uint8_t *)st->text, sizeof(st->text), &written);
+}
+
+static int bench_key_load_public(bench_state_t *st) {
+    int ret = rsa_4096_load_key(&st->scratch_key, st->vec->n, "65537", 0);
+    rsa_4096_free(&st->scratch_key);
+    return ret;
+}
+
+static int bench_key_load_crt(bench_state_t *st) {
+    const bench_key_vector_t *v = st->vec;
+    int ret = rsa_4096_load_key(&st->scratch_key, v->n, v->d, 1);
+    if (ret == 0) {
+        ret = rsa_4096_load_key_crt(&st->scratch_key, v->p, v->q, v->dp, v->dq, v->qinv);
+    }
+    rsa_4096_free(&st->scratch_key);
+    return ret;
+}
+
+static int bench_encrypt(bench_state_t *st) {
+    size_t len;
+    return rsa_4096_encrypt_binary_ws(&st->pub, st->message, sizeof(st->message), st->cipher,
+                                      sizeof(st->cipher), &len, st->ws);
+}
+
+static int bench_decrypt_crt(bench_state_t *st) {
+    size_t len;
+    return rsa_4096_decrypt_binary_ws(&st->crt, st->cipher, st->cipher_len, st->plain, sizeof(st->plain),
+                                      &len, st->ws);
+}
+
+static int bench_decrypt(bench_state_t *st) {
+    size_t len;
+    return rsa_4096_decrypt_binary_ws(&st->priv, st->cipher, st->cipher_len, st->plain, sizeof(st->plain),
+                                      &len, st->ws);
+}
+
+static const bench_case_t bench_cases[] = {
+    {"bigint_mul",            bench_bigint_mul},
+    {"bigint_div",            bench_bigint_div},          /* 2k-bit / k-bit */
+    {"montgomery_redc",       bench_montgomery_redc},
+    {"montgomery_mul",        bench_montgomery_mul},
+    {"montgomery_square",     bench_montgomery_square},
+    {"montgomery_exp",        bench_montgomery_exp},      /* Full-size exponent d */
+    {"montgomery_exp_word",   bench_montgomery_exp_word}, /* e = 65537 */
+    {"bigint_from_decimal",   bench_from_decimal},
+    {"bigint_to_decimal",     bench_to_decimal},
+    {"bigint_from_hex",       bench_from_hex},
+    {"bigint_to_hex",         bench_to_hex},
+    {"bigint_from_binary",    bench_from_binary},
+    {"bigint_to_binary",      bench_to_binary},
+    {"key_load_public",       bench_key_load_public},
+    {"key_load_crt",          bench_key_load_crt},
+    {"encrypt_binary",        bench_encrypt},
+    {"decrypt_binary_crt",    bench_decrypt_crt},
+    {"decrypt_binary",        bench_decrypt},             /* Full-size d, no CRT */
+};
+
+#define BENCH_CASE_COUNT ((int)(sizeof(bench_cases) / sizeof(bench_cases[0])))
+
+/* ===================== STATE SETUP ===================== */
+
+/**
+ * @brief Deterministic operand below n, so runs are comparable across builds
+ */
+static int bench_operand(bigint_t *out, const bigint_t *n, uint64_t seed) {
+    uint8_t bytes[BENCH_BLOCK_BYTES];
+    size_t len = (size_t)(bigint_bit_length(n) + 7) / 8;
+    for (size_t i = 0; i < len; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        bytes[i] = (uint8_t)seed;
+    }
+    bigint_t full;
+    int ret = bigint_from_binary(&full, bytes, len);
+    return ret != 0 ? ret : bigint_mod(out, &full, n);
+}
+
+static int bench_state_init(bench_state_t *st, const bench_key_vector_t *vec) {
+    memset(st, 0, sizeof(*st));
+    st->vec = vec;
+    
+    int ret = rsa_4096_load_key(&st->pub, vec->n, "65537", 0);
+    if (ret == 0) ret = rsa_4096_load_key(&st->priv, vec->n, vec->d, 1);
+    if (ret == 0) ret = rsa_4096_load_key(&st->crt, vec->n, vec->d, 1);
+    if (ret == 0) ret = rsa_4096_load_key_crt(&st->crt, vec->p, vec->q, vec->dp, vec->dq, vec->qinv);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Benchmark key %d failed to load", vec->bits);
+    }
+    
+    bigint_from_decimal(&st->n, vec->n);
+    bigint_from_decimal(&st->d, vec->d);
+    ret = montgomery_ctx_init(&st->ctx, &st->n);
+    if (ret == 0) ret = bench_operand(&st->a, &st->n, 0x9E3779B97F4A7C15ull);
+    if (ret == 0) ret = bench_operand(&st->b, &st->n, 0xD1B54A32D192ED03ull);
+    if (ret == 0) ret = montgomery_to_form(&st->a_mont, &st->a, &st->ctx);
+    if (ret == 0) ret = montgomery_to_form(&st->b_mont, &st->b, &st->ctx);
+    if (ret == 0) ret = bigint_mul(&st->wide, &st->a_mont, &st->b_mont);  /* < n^2 < n * R, a valid REDC input */
+    if (ret == 0) ret = bigint_to_decimal(&st->n, st->decimal, sizeof(st->decimal));
+    if (ret == 0) ret = bigint_to_hex(&st->n, st->hex, sizeof(st->hex));
+    if (ret == 0) ret = bigint_to_binary(&st->n, st->binary, sizeof(st->binary), &st->binary_len);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Benchmark operands for %d bits failed", vec->bits);
+    }
+    
+    /* NULL leaves the *_ws calls on stack scratch, which is still a valid measurement */
+    st->ws = rsa_4096_workspace_new();
+    
+    /* Check the key before timing it: a wrong vector would benchmark garbage */
+    for (size_t i = 0; i < sizeof(st->message); i++) {
+        st->message[i] = (uint8_t)(0xA5 ^ (i * 29));
+    }
+    size_t plain_len = 0;
+    ret = rsa_4096_encrypt_binary_ws(&st->pub, st->message, sizeof(st->message), st->cipher, sizeof(st->cipher),
+                                     &st->cipher_len, st->ws);
+    if (ret == 0) {
+        ret = rsa_4096_decrypt_binary_ws(&st->crt, st->cipher, st->cipher_len, st->plain, sizeof(st->plain),
+                                         &plain_len, st->ws);
+    }
+    if (ret != 0 || plain_len != sizeof(st->message) || memcmp(st->plain, st->message, plain_len) != 0) {
+        ERROR_RETURN(-2, "Benchmark key %d failed its round trip", vec->bits);
+    }
+    return 0;
+}
+
+static void bench_state_free(bench_state_t *st) {
+    rsa_4096_workspace_free(st->ws);
+    montgomery_ctx_free(&st->ctx);
+    rsa_4096_free(&st->pub);
+    rsa_4096_free(&st->priv);
+    rsa_4096_free(&st->crt);
+}
+
+/* ===================== TIMING ===================== */
+
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t bench_cycles(void) {
+#ifdef BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int bench_compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Median and nearest-rank p99 of an ascending sample array
+ */
+static void bench_quantiles(const double *sorted, int count, double *median, double *p99) {
+    *median = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0;
+    int rank = (99 * count + 99) / 100;
+    *p99 = sorted[rank - 1];
+}
+
+static int bench_run_case(const bench_case_t *bc, bench_state_t *st, const bench_options_t *opt,
+                          bench_result_t *res) {
+    /* Double the batch until it lasts BENCH_MIN_SAMPLE_NS; the calibration runs double as warm-up */
+    unsigned reps = 1;
+    for (;;) {
+        int ret = 0;
+        uint64_t start = bench_now_ns();
+        for (unsigned r = 0; r < reps; r++) {
+            ret |= bc->fn(st);
+        }
+        uint64_t elapsed = bench_now_ns() - start;
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Benchmark %s (%d bits) failed", bc->name, st->vec->bits);
+        }
+        if (elapsed >= BENCH_MIN_SAMPLE_NS || reps >= BENCH_MAX_REPS) {
+            break;
+        }
+        reps *= 2;
+    }
+    
+    for (int w = 0; w < BENCH_WARMUP_SAMPLES; w++) {
+        for (unsigned r = 0; r < reps; r++) {
+            bc->fn(st);
+        }
+    }
+    
+    double *ns = malloc((size_t)opt->samples * sizeof(double));
+    double *cycles = malloc((size_t)opt->samples * sizeof(double));
+    if (ns == NULL || cycles == NULL) {
+        free(ns);
+        free(cycles);
+        ERROR_RETURN(-3, "Out of memory for %d samples", opt->samples);
+    }
+    
+    uint64_t deadline = bench_now_ns() + (uint64_t)opt->budget_ms * 1000000ull;
+    int taken = 0;
+    double sum = 0.0;
+    for (; taken < opt->samples; taken++) {
+        if (taken >= BENCH_MIN_SAMPLES && bench_now_ns() > deadline) {
+            break;
+        }
+        uint64_t c0 = opt->cycles ? bench_cycles() : 0;
+        uint64_t t0 = bench_now_ns();
+        for (unsigned r = 0; r < reps; r++) {
+            bc->fn(st);
+        }
+        uint64_t t1 = bench_now_ns();
+        uint64_t c1 = opt->cycles ? bench_cycles() : 0;
+        ns[taken] = (double)(t1 - t0) / reps;
+        cycles[taken] = (double)(c1 - c0) / reps;
+        sum += ns[taken];
+    }
+    
+    qsort(ns, (size_t)taken, sizeof(double), bench_compare_double);
+    qsort(cycles, (size_t)taken, sizeof(double), bench_compare_double);
+    res->name = bc->name;
+    res->bits = st->vec->bits;
+    res->samples = taken;
+    res->reps = reps;
+    res->min_ns = ns[0];
+    res->max_ns = ns[taken - 1];
+    res->mean_ns = sum / taken;
+    bench_quantiles(ns, taken, &res->median_ns, &res->p99_ns);
+    bench_quantiles(cycles, taken, &res->median_cycles, &res->p99_cycles);
+    
+    free(ns);
+    free(cycles);
+    return 0;
+}
+
+/* ===================== REPORTING ===================== */
+
+static void bench_print_header(const bench_options_t *opt) {
+    printf("===============================================\n");
+    printf("RSA-4096 Microbenchmarks\n");
+    printf("===============================================\n");
+    printf("Limbs: %d-bit, SIMD kernel: %s, reduction: %s, clock: CLOCK_MONOTONIC%s\n", BIGINT_WORD_SIZE,
+           montgomery_simd_name(montgomery_simd_active()), montgomery_lazy_reduction() ? "lazy" : "strict",
+           opt->cycles ? " + rdtsc" : "");
+    printf("Up to %d samples per benchmark, %ld ms budget each\n\n", opt->samples, opt->budget_ms);
+    printf("%-5s %-22s %7s %7s %13s %13s %13s%s\n", "bits", "benchmark", "samples", "reps",
+           "median", "p99", "min", opt->cycles ? "  median cyc" : "");
+}
+
+static void bench_format_time(char *buf, size_t size, double ns) {
+    if (ns >= 1e6) {
+        snprintf(buf, size, "%.3f ms", ns / 1e6);
+    } else if (ns >= 1e3) {
+        snprintf(buf, size, "%.3f us", ns / 1e3);
+    } else {
+        snprintf(buf, size, "%.1f ns", ns);
+    }
+}
+
+static void bench_print_row(const bench_result_t *r, const bench_options_t *opt) {
+    char median[32], p99[32], min[32];
+    bench_format_time(median, sizeof(median), r->median_ns);
+    bench_format_time(p99, sizeof(p99), r->p99_ns);
+    bench_format_time(min, sizeof(min), r->min_ns);
+    printf("%-5d %-22s %7d %7u %13s %13s %13s", r->bits, r->name, r->samples, r->reps, median, p99, min);
+    if (opt->cycles) {
+        printf("  %11.0f", r->median_cycles);
+    }
+    printf("\n");
+    fflush(stdout);
+}
+
+static void bench_print_json(const bench_result_t *results, int count, const bench_options_t *opt) {
+    printf("{\n");
+    printf("  \"schema\": 1,\n");
+    printf("  \"limb_bits\": %d,\n", BIGINT_WORD_SIZE);
+    printf("  \"simd\": \"%s\",\n", montgomery_simd_name(montgomery_simd_active()));
+    printf("  \"clock\": \"CLOCK_MONOTONIC\",\n");
+    printf("  \"cycles\": %s,\n", opt->cycles ? "\"rdtsc\"" : "null");
+    printf("  \"max_samples\": %d,\n", opt->samples);
+    printf("  \"budget_ms\": %ld,\n", opt->budget_ms);
+    printf("  \"results\": [");
+    for (int i = 0; i < count; i++) {
+        const bench_result_t *r = &results[i];
+        printf("%s\n    {\"name\": \"%s\", \"bits\": %d, \"samples\": %d, \"reps\": %u, "
+               "\"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f",
+               i ? "," : "", r->name, r->bits, r->samples, r->reps,
+               r->min_ns, r->median_ns, r->mean_ns, r->p99_ns, r->max_ns);
+        if (opt->cycles) {
+            printf(", \"median_cycles\": %.0f, \"p99_cycles\": %.0f", r->median_cycles, r->p99_cycles);
+        }
+        printf("}");
+    }
+    printf("\n  ]\n}\n");
+}
+
+/* ===================== COMMAND LINE ===================== */
+
+static void bench_usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --json               Print results as JSON instead of a table\n"
+            "  --bits LIST          Key sizes, comma separated (default 1024,2048,3072,4096)\n"
+            "  --filter TEXT        Only benchmarks whose name contains TEXT\n"
+            "  --samples N          Samples per benchmark (default %d, at least %d)\n"
+            "  --budget-ms MS       Time budget per benchmark (default %d)\n"
+            "  --kernel NAME        SIMD kernel: auto, scalar, avx2 or avx512-ifma\n"
+            "  --strict             Fully reduce after every scalar Montgomery step (lazy reduction off)\n"
+            "  --cycles             Also report time-stamp counter cycles (x86 only)\n"
+            "  --stats              Run with the performance counters on and print them to stderr\n",
+            prog, BENCH_DEFAULT_SAMPLES, BENCH_MIN_SAMPLES, BENCH_DEFAULT_BUDGET_MS);
+}
+
+static int bench_parse_bits(bench_options_t *opt, const char *list) {
+    opt->num_bits = 0;
+    const char *p = list;
+    while (*p != '\0') {
+        char *end;
+        long bits = strtol(p, &end, 10);
+        int found = 0;
+        for (int k = 0; k < BENCH_KEY_COUNT; k++) {
+            found |= bench_keys[k].bits == bits;
+        }
+        if (end == p || !found || opt->num_bits == BENCH_KEY_COUNT) {
+            fprintf(stderr, "❌ Unsupported key size list: %s\n", list);
+            return -1;
+        }
+        opt->bits[opt->num_bits++] = (int)bits;
+        p = *end == ',' ? end + 1 : end;
+        if (*end != ',' && *end != '\0') {
+            fprintf(stderr, "❌ Unsupported key size list: %s\n", list);
+            return -1;
+        }
+    }
+    return opt->num_bits > 0 ? 0 : -1;
+}
+
+static int bench_parse_kernel(const char *name) {
+    if (strcmp(name, "auto") == 0) {
+        return montgomery_simd_select(MONTGOMERY_SIMD_AUTO) < 0 ? -1 : 0;
+    }
+    const int kernels[] = {MONTGOMERY_SIMD_NONE, MONTGOMERY_SIMD_AVX2, MONTGOMERY_SIMD_IFMA};
+    for (int k = 0; k < 3; k++) {
+        if (strcmp(name, montgomery_simd_name(kernels[k])) == 0) {
+            if (montgomery_simd_select(kernels[k]) >= 0) {
+                return 0;
+            }
+            fprintf(stderr, "❌ Kernel %s is not supported on this CPU\n", name);
+            return -1;
+        }
+    }
+    fprintf(stderr, "❌ Unknown kernel: %s\n", name);
+    return -1;
+}
+
+static int bench_parse_args(bench_options_t *opt, int argc, char *argv[]) {
+    opt->json = 0;
+    opt->cycles = 0;
+    opt->stats = 0;
+    opt->samples = BENCH_DEFAULT_SAMPLES;
+    opt->budget_ms = BENCH_DEFAULT_BUDGET_MS;
+    opt->filter = NULL;
+    opt->num_bits = BENCH_KEY_COUNT;
+    for (int k = 0; k < BENCH_KEY_COUNT; k++) {
+        opt->bits[k] = bench_keys[k].bits;
+    }
+    
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(arg, "--json") == 0) {
+            opt->json = 1;
+        } else if (strcmp(arg, "--cycles") == 0) {
+#ifdef BENCH_HAVE_TSC
+            opt->cycles = 1;
+#else
+            fprintf(stderr, "⚠️  No time-stamp counter on this platform, --cycles ignored\n");
+#endif
+        } else if (strcmp(arg, "--stats") == 0) {
+            opt->stats = 1;
+        } else if (strcmp(arg, "--strict") == 0) {
+            montgomery_set_lazy_reduction(0);
+        } else if (value != NULL && strcmp(arg, "--bits") == 0) {
+            if (bench_parse_bits(opt, value) != 0) return -1;
+            i++;
+        } else if (value != NULL && strcmp(arg, "--filter") == 0) {
+            opt->filter = value;
+            i++;
+        } else if (value != NULL && strcmp(arg, "--samples") == 0) {
+            opt->samples = atoi(value);
+            if (opt->samples < BENCH_MIN_SAMPLES) {
+                fprintf(stderr, "❌ --samples must be at least %d\n", BENCH_MIN_SAMPLES);
+                return -1;
+            }
+            i++;
+        } else if (value != NULL && strcmp(arg, "--budget-ms") == 0) {
+            opt->budget_ms = atol(value);
+            if (opt->budget_ms < 0) return -1;
+            i++;
+        } else if (value != NULL && strcmp(arg, "--kernel") == 0) {
+            if (bench_parse_kernel(value) != 0) return -1;
+            i++;
+        } else {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* ===================== MAIN ===================== */
+
+/* Library diagnostics go to stderr so they never end up inside the JSON */
+static void bench_trace_sink(int level, const char *func, int line, const char *message, void *user) {
+    (void)level;
+    (void)func;
+    (void)line;
+    (void)user;
+    fprintf(stderr, "%s\n", message);
+}
+
+int main(int argc, char *argv[]) {
+    bench_options_t opt;
+    rsa_4096_trace_set_sink(bench_trace_sink, NULL);
+    if (bench_parse_args(&opt, argc, argv) != 0) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+    
+    static bench_result_t results[BENCH_MAX_RESULTS];
+    int count = 0;
+    bench_state_t *st = malloc(sizeof(bench_state_t));
+    if (st == NULL) {
+        fprintf(stderr, "❌ Out of memory\n");
+        return 1;
+    }
+    if (!opt.json) {
+        bench_print_header(&opt);
+    }
+    rsa_4096_stats_enable(opt.stats);
+    
+    int status = 0;
+    for (int b = 0; b < opt.num_bits && status == 0; b++) {
+        const bench_key_vector_t *vec = NULL;
+        for (int k = 0; k < BENCH_KEY_COUNT; k++) {
+            if (bench_keys[k].bits == opt.bits[b]) vec = &bench_keys[k];
+        }
+        if (bench_state_init(st, vec) != 0) {
+            status = 1;
+            bench_state_free(st);
+            break;
+        }
+        for (int c = 0; c < BENCH_CASE_COUNT && count < BENCH_MAX_RESULTS; c++) {
+            if (opt.filter != NULL && strstr(bench_cases[c].name, opt.filter) == NULL) {
+                continue;
+            }
+            if (bench_run_case(&bench_cases[c], st, &opt, &results[count]) != 0) {
+                status = 1;
+                break;
+            }
+            if (!opt.json) {
+                bench_print_row(&results[count], &opt);
+            }
+            count++;
+        }
+        bench_state_free(st);
+    }
+    free(st);
+    
+    if (opt.json && status == 0) {
+        bench_print_json(results, count, &opt);
+    }
+    if (opt.stats) {
+        rsa_4096_stats_t stats;
+        rsa_4096_stats_get(&stats);
+        rsa_4096_stats_print(&stats, stderr);
+    }
+    return status;
+}
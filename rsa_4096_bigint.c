@@ -79,7 +79,7 @@ void bigint_normalize(bigint_t *a) {
     
     /* TODO: Log significant normalization changes */
     if (original_used != a->used && original_used - a->used > 1) {
-        printf("[ROUND_TRIP_DEBUG] Normalization: reduced from %d to %d words (removed %d leading zeros)\n", 
+        TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] Normalization: reduced from %d to %d words (removed %d leading zeros)", 
                original_used, a->used, original_used - a->used);
     }
     
@@ -98,7 +98,7 @@ void bigint_normalize(bigint_t *a) {
     /* TODO: Additional validation for single-word values */
     if (a->used == 1) {
         if (a->words[0] == 0 && a->sign != 0) {
-            printf("[ROUND_TRIP_DEBUG] WARNING: Zero value with non-zero sign, correcting\n");
+            TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: Zero value with non-zero sign, correcting");
             a->sign = 0;
         }
     }
@@ -106,7 +106,7 @@ void bigint_normalize(bigint_t *a) {
     /* TODO: Detect and warn about potential corruption */
     for (int i = a->used; i < BIGINT_4096_WORDS && i < a->used + 5; i++) {
         if (a->words[i] != 0) {
-            printf("[ROUND_TRIP_DEBUG] WARNING: Non-zero word at index %d beyond used=%d, value=0x%x\n", 
+            TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: Non-zero word at index %d beyond used=%d, value=0x%" PRIxWORD, 
                    i, a->used, a->words[i]);
         }
     }
@@ -151,6 +151,76 @@ int bigint_ensure_capacity(bigint_t *a, int min_words) {
 
 /* ===================== STRING/BINARY CONVERSIONS - ENHANCED WITH ROUND-TRIP VALIDATION ===================== */
 
+/* Decimal digits per limb-sized chunk: 10^9 < 2^32, 10^19 < 2^64 */
+#if BIGINT_WORD_SIZE == 64
+#define DEC_CHUNK_DIGITS 19
+#define DEC_CHUNK_BASE 10000000000000000000ULL
+#else
+#define DEC_CHUNK_DIGITS 9
+#define DEC_CHUNK_BASE 1000000000UL
+#endif
+
+/* Most decimal digits a bigint_t can hold (16384 * log10(2) = 4932.2), and the
+ * deepest power-of-ten table bigint_to_decimal needs */
+#define DEC_MAX_DIGITS 4933
+#define DEC_MAX_LEVELS 12
+
+/**
+ * @brief a = a * mul + add in place; -2 if the result no longer fits
+ */
+static int bigint_mul_add_small(bigint_t *a, bigint_word_t mul, bigint_word_t add) {
+    bigint_dword_t carry = add;
+    for (int i = 0; i < a->used; i++) {
+        bigint_dword_t t = (bigint_dword_t)a->words[i] * mul + carry;
+        a->words[i] = (bigint_word_t)t;
+        carry = t >> BIGINT_WORD_SIZE;
+    }
+    if (carry != 0) {
+        if (a->used >= BIGINT_4096_WORDS) {
+            return -2;
+        }
+        a->words[a->used++] = (bigint_word_t)carry;
+    }
+    return 0;
+}
+
+/**
+ * @brief a = a / d in place, returning a mod d
+ */
+static bigint_word_t bigint_div_small(bigint_t *a, bigint_word_t d) {
+    bigint_dword_t rem = 0;
+    for (int i = a->used - 1; i >= 0; i--) {
+        bigint_dword_t cur = (rem << BIGINT_WORD_SIZE) | a->words[i];
+        a->words[i] = (bigint_word_t)(cur / d);
+        rem = cur % d;
+    }
+    bigint_normalize(a);
+    return (bigint_word_t)rem;
+}
+
+/**
+ * @brief Parse len digits (all '0'..'9') chunk by chunk into a
+ */
+static int dec_parse_chunked(bigint_t *a, const char *digits, size_t len) {
+    bigint_init(a);
+    size_t first = len % DEC_CHUNK_DIGITS;
+    if (first == 0) first = DEC_CHUNK_DIGITS;
+    
+    for (size_t pos = 0; pos < len; ) {
+        size_t take = (pos == 0) ? first : DEC_CHUNK_DIGITS;
+        bigint_word_t chunk = 0, scale = 1;
+        for (size_t i = 0; i < take; i++) {
+            chunk = chunk * 10 + (bigint_word_t)(digits[pos + i] - '0');
+            scale *= 10;
+        }
+        int ret = bigint_mul_add_small(a, scale, chunk);
+        if (ret != 0) return ret;
+        pos += take;
+    }
+    bigint_normalize(a);
+    return 0;
+}
+
 int bigint_from_decimal(bigint_t *a, const char *decimal) {
     /* TODO: Critical input validation */
     if (a == NULL) {
@@ -164,29 +234,60 @@ int bigint_from_decimal(bigint_t *a, const char *decimal) {
         return 0;
     }
     
-    size_t len = strlen(decimal);
-    bigint_t ten;
-    bigint_set_u32(&ten, 10);
+    /* Gather the digits, skipping separators and leading zeros as before */
+    char digits[DEC_MAX_DIGITS + 1];
+    size_t len = 0;
+    for (const char *c = decimal; *c; c++) {
+        if (*c < '0' || *c > '9' || (len == 0 && *c == '0')) continue;
+        if (len == DEC_MAX_DIGITS) {
+            CHECKPOINT(LOG_ERROR, "Decimal input exceeds %d significant digits", DEC_MAX_DIGITS);
+            return -2;
+        }
+        digits[len++] = *c;
+    }
     
-    for (size_t i = 0; i < len; ++i) {
-        if (decimal[i] < '0' || decimal[i] > '9') continue;
-        
-        uint32_t digit = decimal[i] - '0';
-        
-        /* a = a * 10 + digit */
-        bigint_t temp;
-        int ret = bigint_mul(&temp, a, &ten);
-        if (ret != 0) return ret;
-        
-        bigint_t digit_bigint;
-        bigint_set_u32(&digit_bigint, digit);
-        
-        ret = bigint_add(a, &temp, &digit_bigint);
-        if (ret != 0) return ret;
+    /* Chunked Horner is linear per chunk; at <= 16384 bits it beats a
+     * split-and-multiply parse even with Karatsuba, so there is no D&C mode here */
+    return dec_parse_chunked(a, digits, len);
+}
+
+/**
+ * @brief Write x's digits right-aligned so they end just before end, at least pad
+ * of them (zero-filled); x is consumed. Returns the first digit written.
+ */
+static char *dec_emit_chunked(bigint_t *x, char *end, size_t pad) {
+    char *p = end;
+    while (!bigint_is_zero(x)) {
+        bigint_word_t r = bigint_div_small(x, (bigint_word_t)DEC_CHUNK_BASE);
+        for (int i = 0; i < DEC_CHUNK_DIGITS; i++) {
+            *--p = (char)('0' + r % 10);
+            r /= 10;
+        }
+    }
+    while ((size_t)(end - p) > pad && *p == '0') p++;
+    while ((size_t)(end - p) < pad) *--p = '0';
+    return p;
+}
+
+/**
+ * @brief Divide-and-conquer emit for x < pows[k + 1]: split by pows[k], low half
+ * padded to exactly C * 2^k digits
+ */
+static char *dec_emit_dc(bigint_t *x, int k, char *end, size_t pad, const bigint_t *pows) {
+    if (k < 0 || x->used <= BIGINT_DEC_DC_WORDS) {
+        return dec_emit_chunked(x, end, pad);
     }
     
-    bigint_normalize(a);
-    return 0;
+    bigint_t q, r;
+    if (bigint_div(&q, &r, x, &pows[k]) != 0) {
+        return NULL;
+    }
+    size_t half = (size_t)DEC_CHUNK_DIGITS << k;
+    char *mid = dec_emit_dc(&r, k - 1, end, half, pows);
+    if (mid == NULL) {
+        return NULL;
+    }
+    return dec_emit_dc(&q, k - 1, mid, pad > half ? pad - half : 0, pows);
 }
 
 int bigint_to_decimal(const bigint_t *a, char *str, size_t str_size) {
@@ -194,31 +295,44 @@ int bigint_to_decimal(const bigint_t *a, char *str, size_t str_size) {
         if (str_size > 0) strcpy(str, "0");
         return 0;
     }
+    if (str_size == 0) {
+        return -2;
+    }
     
     bigint_t x;
     bigint_copy(&x, a);
-    char buf[2048];
-    size_t p = 0; /* FIXED: Use size_t for proper comparison */
-    
-    bigint_t ten;
-    bigint_set_u32(&ten, 10);
-    
-    while (!bigint_is_zero(&x)) {
-        bigint_t q, r;
-        int ret = bigint_div(&q, &r, &x, &ten);
-        if (ret != 0) return ret;
-        
-        buf[p++] = '0' + (r.used ? r.words[0] : 0);
-        bigint_copy(&x, &q);
-        
-        if (p >= sizeof(buf) - 1) break;
+    char buf[DEC_MAX_DIGITS + 2 * DEC_CHUNK_DIGITS];
+    char *end = buf + sizeof(buf);
+    char *p;
+    
+    if (x.used <= BIGINT_DEC_DC_WORDS) {
+        p = dec_emit_chunked(&x, end, 0);
+    } else {
+        /* Smallest table with pows[k]^2 > x, so the top quotient needs no further split */
+        bigint_t pows[DEC_MAX_LEVELS];
+        int x_bits = bigint_bit_length(&x);
+        int k = 0;
+        bigint_init(&pows[0]);
+        pows[0].words[0] = (bigint_word_t)DEC_CHUNK_BASE;
+        pows[0].used = 1;
+        while (x_bits > 2 * bigint_bit_length(&pows[k]) - 2) {
+            int ret = bigint_mul(&pows[k + 1], &pows[k], &pows[k]);
+            if (ret != 0) return ret;
+            k++;
+        }
+        p = dec_emit_dc(&x, k, end, 0, pows);
+        if (p == NULL) {
+            ERROR_RETURN(-3, "Division failed in decimal conversion");
+        }
+        /* The level bound is conservative: a zero top quotient leaves padded zeros in front */
+        while (*p == '0') p++;
     }
     
-    size_t i = 0;
-    /* FIXED: Proper size_t comparison */
-    for (size_t pi = p; pi > 0 && i < str_size - 1; pi--, i++)
-        str[i] = buf[pi - 1];
-    str[i] = 0;
+    /* Most significant digits first; over-long results are truncated as before */
+    size_t n = (size_t)(end - p);
+    if (n > str_size - 1) n = str_size - 1;
+    memcpy(str, p, n);
+    str[n] = 0;
     return 0;
 }
 
@@ -226,30 +340,32 @@ int bigint_from_hex(bigint_t *a, const char *hex) {
     bigint_init(a);
     if (!hex || !*hex) return 0;
     
+    /* Nibbles go straight into words from the least significant end */
     size_t len = strlen(hex);
-    bigint_t sixteen;
-    bigint_set_u32(&sixteen, 16);
-    
-    for (size_t i = 0; i < len; ++i) {
-        char c = hex[i];
-        uint32_t digit = 0;
-        if (c >= '0' && c <= '9') digit = c - '0';
-        else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
-        else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+    int nibble = 0;
+    for (size_t i = len; i > 0; i--) {
+        char c = hex[i - 1];
+        bigint_word_t digit;
+        if (c >= '0' && c <= '9') digit = (bigint_word_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') digit = (bigint_word_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') digit = (bigint_word_t)(c - 'A' + 10);
         else continue;
         
-        /* a = a * 16 + digit */
-        bigint_t temp;
-        int ret = bigint_mul(&temp, a, &sixteen);
-        if (ret != 0) return ret;
-        
-        bigint_t digit_bigint;
-        bigint_set_u32(&digit_bigint, digit);
-        
-        ret = bigint_add(a, &temp, &digit_bigint);
-        if (ret != 0) return ret;
+        int word = nibble / (BIGINT_WORD_SIZE / 4);
+        if (word >= BIGINT_4096_WORDS) {
+            if (digit != 0) {
+                CHECKPOINT(LOG_ERROR, "Hex input exceeds %d bits", BIGINT_4096_WORDS * BIGINT_WORD_SIZE);
+                bigint_init(a);
+                return -2;
+            }
+            continue;  /* Leading zeros beyond capacity */
+        }
+        a->words[word] |= digit << (4 * (nibble % (BIGINT_WORD_SIZE / 4)));
+        nibble++;
     }
     
+    a->used = (nibble + BIGINT_WORD_SIZE / 4 - 1) / (BIGINT_WORD_SIZE / 4);
+    if (a->used > BIGINT_4096_WORDS) a->used = BIGINT_4096_WORDS;
     bigint_normalize(a);
     return 0;
 }
@@ -259,53 +375,58 @@ int bigint_to_hex(const bigint_t *a, char *hex, size_t hex_size) {
         if (hex_size > 0) strcpy(hex, "0");
         return 0;
     }
-    
-    bigint_t x;
-    bigint_copy(&x, a);
-    char buf[2048];
-    size_t p = 0; /* FIXED: Use size_t for proper comparison */
-    
-    bigint_t sixteen;
-    bigint_set_u32(&sixteen, 16);
-    
-    while (!bigint_is_zero(&x)) {
-        bigint_t q, r;
-        int ret = bigint_div(&q, &r, &x, &sixteen);
-        if (ret != 0) return ret;
-        
-        uint32_t v = r.used ? r.words[0] : 0;
-        buf[p++] = (v < 10) ? ('0' + v) : ('a' + v - 10);
-        bigint_copy(&x, &q);
-        
-        if (p >= sizeof(buf) - 1) break;
+    if (hex_size == 0) {
+        return -2;
     }
     
+    static const char digits[] = "0123456789abcdef";
+    int nibbles = (bigint_bit_length(a) + 3) / 4;
     size_t i = 0;
-    /* FIXED: Proper size_t comparison */
-    for (size_t pi = p; pi > 0 && i < hex_size - 1; pi--, i++)
-        hex[i] = buf[pi - 1];
+    for (int nb = nibbles - 1; nb >= 0 && i < hex_size - 1; nb--, i++) {
+        bigint_word_t w = a->words[nb / (BIGINT_WORD_SIZE / 4)];
+        hex[i] = digits[(w >> (4 * (nb % (BIGINT_WORD_SIZE / 4)))) & 0xf];
+    }
     hex[i] = 0;
     return 0;
 }
 
+/* Big-endian bytes <-> limbs: one unaligned word load or store and a byte swap per limb */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define BIGINT_WORD_FROM_BE(w) (w)
+#elif BIGINT_WORD_SIZE == 64
+#define BIGINT_WORD_FROM_BE(w) __builtin_bswap64(w)
+#else
+#define BIGINT_WORD_FROM_BE(w) __builtin_bswap32(w)
+#endif
+
+static bigint_word_t bigint_load_be(const uint8_t *p) {
+    bigint_word_t w;
+    memcpy(&w, p, sizeof(w));
+    return BIGINT_WORD_FROM_BE(w);
+}
+
+static void bigint_store_be(uint8_t *p, bigint_word_t w) {
+    w = BIGINT_WORD_FROM_BE(w);
+    memcpy(p, &w, sizeof(w));
+}
+
 int bigint_from_binary(bigint_t *a, const uint8_t *data, size_t data_size) {
     bigint_init(a);
     if (!data || data_size == 0) return 0;
     
     /* Calculate required words */
-    int words_needed = (data_size + 3) / 4;
+    int words_needed = (data_size + BIGINT_WORD_BYTES - 1) / BIGINT_WORD_BYTES;
     if (words_needed > BIGINT_4096_WORDS) {
         return -1; /* Too large */
     }
     
-    /* Convert from big-endian bytes to little-endian words */
-    for (size_t i = 0; i < data_size; i++) {
-        int word_idx = (data_size - 1 - i) / 4;
-        int byte_idx = (data_size - 1 - i) % 4;
-        
-        if (word_idx < BIGINT_4096_WORDS) {
-            a->words[word_idx] |= ((uint32_t)data[i]) << (byte_idx * 8);
-        }
+    /* Whole limbs from the end of the string, then the short leading one */
+    size_t full = data_size / BIGINT_WORD_BYTES, head = data_size % BIGINT_WORD_BYTES;
+    for (size_t i = 0; i < full; i++) {
+        a->words[i] = bigint_load_be(data + data_size - (i + 1) * BIGINT_WORD_BYTES);
+    }
+    for (size_t i = 0; i < head; i++) {
+        a->words[full] = (a->words[full] << 8) | data[i];
     }
     
     a->used = words_needed;
@@ -313,6 +434,27 @@ int bigint_from_binary(bigint_t *a, const uint8_t *data, size_t data_size) {
     return 0;
 }
 
+int bigint_to_binary_fixed(const bigint_t *a, uint8_t *data, size_t data_size) {
+    if (!a || !data) return -1;
+    
+    /* Value right-aligned, zeros in front: exactly data_size bytes */
+    int used = a->used;
+    while (used > 0 && a->words[used - 1] == 0) used--;
+    size_t byte_len = ((size_t)bigint_bit_length(a) + 7) / 8;
+    if (byte_len > data_size) return -2; /* Buffer too small */
+    
+    size_t full = data_size / BIGINT_WORD_BYTES, head = data_size % BIGINT_WORD_BYTES;
+    for (size_t i = 0; i < full; i++) {
+        bigint_store_be(data + data_size - (i + 1) * BIGINT_WORD_BYTES, (int)i < used ? a->words[i] : 0);
+    }
+    bigint_word_t top = (int)full < used ? a->words[full] : 0;
+    for (size_t i = head; i > 0; i--) {
+        data[i - 1] = (uint8_t)top;
+        top >>= 8;
+    }
+    return 0;
+}
+
 int bigint_to_binary(const bigint_t *a, uint8_t *data, size_t data_size, size_t *bytes_written) {
     if (!a || !data || !bytes_written) return -1;
     
@@ -326,19 +468,9 @@ int bigint_to_binary(const bigint_t *a, uint8_t *data, size_t data_size, size_t
     
     if (byte_len > data_size) return -2; /* Buffer too small */
     
-    /* Convert from little-endian words to big-endian bytes */
-    memset(data, 0, data_size);
-    
-    for (size_t i = 0; i < byte_len; i++) {
-        int word_idx = (byte_len - 1 - i) / 4;
-        int byte_idx = (byte_len - 1 - i) % 4;
-        
-        if (word_idx < a->used) {
-            data[i] = (a->words[word_idx] >> (byte_idx * 8)) & 0xFF;
-        }
-    }
-    
-    return 0;
+    /* Minimal big-endian form at the front, the rest of the buffer zeroed */
+    memset(data + byte_len, 0, data_size - byte_len);
+    return bigint_to_binary_fixed(a, data, byte_len);
 }
 
 /* ===================== BITWISE/BINARY OPERATIONS - CRITICAL FIXES ===================== */
@@ -363,13 +495,13 @@ int bigint_shift_left(bigint_t *r, const bigint_t *a, int bits) {
     }
     
     /* FIXME: Potential overflow with very large shift amounts */
-    if (bits > 32 * BIGINT_4096_WORDS) {
+    if (bits > BIGINT_WORD_SIZE * BIGINT_4096_WORDS) {
         CHECKPOINT(LOG_ERROR, "Shift amount too large: %d", bits);
         return -2;
     }
     
-    int word_shift = bits / 32;
-    int bit_shift = bits % 32;
+    int word_shift = bits / BIGINT_WORD_SIZE;
+    int bit_shift = bits % BIGINT_WORD_SIZE;
     
     /* TODO: Enhanced overflow protection */
     if (a->used + word_shift + (bit_shift ? 1 : 0) > BIGINT_4096_WORDS) {
@@ -382,19 +514,19 @@ int bigint_shift_left(bigint_t *r, const bigint_t *a, int bits) {
     
     /* Perform the shift with bounds checking */
     for (int i = a->used - 1; i >= 0; i--) {
-        uint64_t val = (uint64_t)a->words[i];
+        bigint_dword_t val = (bigint_dword_t)a->words[i];
         
         /* Place the low part */
         int dest_idx = i + word_shift;
         if (dest_idx < BIGINT_4096_WORDS) {
-            r->words[dest_idx] |= (uint32_t)(val << bit_shift);
+            r->words[dest_idx] |= (bigint_word_t)(val << bit_shift);
         }
         
         /* Place the high part (carry) if bit_shift > 0 */
         if (bit_shift > 0) {
             dest_idx = i + word_shift + 1;
             if (dest_idx < BIGINT_4096_WORDS) {
-                r->words[dest_idx] |= (uint32_t)(val >> (32 - bit_shift));
+                r->words[dest_idx] |= (bigint_word_t)(val >> (BIGINT_WORD_SIZE - bit_shift));
             }
         }
     }
@@ -430,15 +562,15 @@ int bigint_shift_right(bigint_t *r, const bigint_t *a, int bits) {
     }
     
     /* FIXME: Handle very large shift amounts gracefully */
-    if (bits >= 32 * a->used) {
+    if (bits >= BIGINT_WORD_SIZE * a->used) {
         /* Shifting by more than the number of bits results in zero */
         CHECKPOINT(LOG_INFO, "Right shift amount %d >= bit length, result is zero", bits);
         bigint_init(r);
         return 0;
     }
     
-    int word_shift = bits / 32;
-    int bit_shift = bits % 32;
+    int word_shift = bits / BIGINT_WORD_SIZE;
+    int bit_shift = bits % BIGINT_WORD_SIZE;
     
     /* TODO: Enhanced bounds checking for right shift */
     if (word_shift >= a->used) {
@@ -451,19 +583,19 @@ int bigint_shift_right(bigint_t *r, const bigint_t *a, int bits) {
     
     /* Perform the shift with bounds checking */
     for (int i = word_shift; i < a->used; i++) {
-        uint64_t val = (uint64_t)a->words[i];
+        bigint_dword_t val = (bigint_dword_t)a->words[i];
         
         /* Shift the current word */
         int dest_idx = i - word_shift;
         if (dest_idx < BIGINT_4096_WORDS) {
-            r->words[dest_idx] = (uint32_t)(val >> bit_shift);
+            r->words[dest_idx] = (bigint_word_t)(val >> bit_shift);
         }
         
         /* TODO: CRITICAL FIX - Add proper bounds check for next word access */
         if (bit_shift > 0 && i + 1 < a->used && i + 1 < BIGINT_4096_WORDS) {
-            uint64_t next_val = (uint64_t)a->words[i + 1];
+            bigint_dword_t next_val = (bigint_dword_t)a->words[i + 1];
             if (dest_idx < BIGINT_4096_WORDS) {
-                r->words[dest_idx] |= (uint32_t)(next_val << (32 - bit_shift));
+                r->words[dest_idx] |= (bigint_word_t)(next_val << (BIGINT_WORD_SIZE - bit_shift));
             }
         }
     }
@@ -483,8 +615,8 @@ int bigint_shift_right(bigint_t *r, const bigint_t *a, int bits) {
 int bigint_get_bit(const bigint_t *a, int bit_pos) {
     if (!a || bit_pos < 0) return 0;
     
-    int word_idx = bit_pos / 32;
-    int bit_idx = bit_pos % 32;
+    int word_idx = bit_pos / BIGINT_WORD_SIZE;
+    int bit_idx = bit_pos % BIGINT_WORD_SIZE;
     
     if (word_idx >= a->used) return 0;
     
@@ -495,14 +627,181 @@ int bigint_bit_length(const bigint_t *a) {
     if (!a || bigint_is_zero(a)) return 0;
     
     int word_idx = a->used - 1;
-    uint32_t top_word = a->words[word_idx];
+    bigint_word_t top_word = a->words[word_idx];
     
-    int bit_pos = 31;
-    while (bit_pos > 0 && !(top_word & (1U << bit_pos))) {
+    int bit_pos = BIGINT_WORD_SIZE - 1;
+    while (bit_pos > 0 && !(top_word & ((bigint_word_t)1 << bit_pos))) {
         bit_pos--;
     }
     
-    return word_idx * 32 + bit_pos + 1;
+    return word_idx * BIGINT_WORD_SIZE + bit_pos + 1;
+}
+
+/* ===================== KARATSUBA MULTIPLICATION ===================== */
+
+/**
+ * @brief Schoolbook base case: r[0 .. an+bn) = a * b, r must not overlap a or b
+ */
+static void bigint_mul_base(bigint_word_t *r, const bigint_word_t *a, int an, const bigint_word_t *b, int bn) {
+    memset(r, 0, (size_t)(an + bn) * sizeof(bigint_word_t));
+    for (int i = 0; i < an; i++) {
+        bigint_dword_t ai = a[i];
+        bigint_word_t carry = 0;
+        for (int j = 0; j < bn; j++) {
+            /* (2^w - 1)^2 + 2 (2^w - 1) still fits in a double word */
+            bigint_dword_t t = ai * b[j] + r[i + j] + carry;
+            r[i + j] = (bigint_word_t)t;
+            carry = (bigint_word_t)(t >> BIGINT_WORD_SIZE);
+        }
+        r[i + bn] = carry;
+    }
+}
+
+/**
+ * @brief r[0 .. an] = a + b for an >= bn; returns the carry out of word an - 1
+ */
+static bigint_word_t bigint_words_add(bigint_word_t *r, const bigint_word_t *a, int an,
+                                      const bigint_word_t *b, int bn) {
+    bigint_word_t carry = 0;
+    for (int i = 0; i < an; i++) {
+        bigint_dword_t t = (bigint_dword_t)a[i] + (i < bn ? b[i] : 0) + carry;
+        r[i] = (bigint_word_t)t;
+        carry = (bigint_word_t)(t >> BIGINT_WORD_SIZE);
+    }
+    return carry;
+}
+
+/**
+ * @brief r[0 .. rn) += a[0 .. an), carry rippling through the rest of r
+ */
+static void bigint_words_add_in(bigint_word_t *r, int rn, const bigint_word_t *a, int an) {
+    bigint_word_t carry = 0;
+    int i = 0;
+    for (; i < an; i++) {
+        bigint_dword_t t = (bigint_dword_t)r[i] + a[i] + carry;
+        r[i] = (bigint_word_t)t;
+        carry = (bigint_word_t)(t >> BIGINT_WORD_SIZE);
+    }
+    for (; carry && i < rn; i++) {
+        r[i] += 1;
+        carry = (r[i] == 0);
+    }
+}
+
+/**
+ * @brief r[0 .. rn) -= a[0 .. an); the caller guarantees r >= a
+ */
+static void bigint_words_sub_in(bigint_word_t *r, int rn, const bigint_word_t *a, int an) {
+    bigint_word_t borrow = 0;
+    int i = 0;
+    for (; i < an; i++) {
+        bigint_word_t ri = r[i];
+        bigint_word_t d = ri - a[i] - borrow;
+        borrow = (ri < a[i]) || (ri == a[i] && borrow);
+        r[i] = d;
+    }
+    for (; borrow && i < rn; i++) {
+        borrow = (r[i] == 0);
+        r[i] -= 1;
+    }
+}
+
+static int karatsuba_cutoff = BIGINT_KARATSUBA_CUTOFF;
+
+int bigint_set_karatsuba_cutoff(int words) {
+    /* Each split recurses on h + 1 words, which only shrinks from 4 words up */
+    if (words < 4 || words > BIGINT_4096_WORDS) {
+        ERROR_RETURN(-1, "Karatsuba cutoff of %d words outside 4..%d", words, BIGINT_4096_WORDS);
+    }
+    karatsuba_cutoff = words;
+    return 0;
+}
+
+int bigint_karatsuba_cutoff(void) {
+    return karatsuba_cutoff;
+}
+
+/**
+ * @brief Scratch words bigint_karatsuba() needs for n-word operands
+ */
+static int bigint_karatsuba_scratch(int n) {
+    int words = 0;
+    while (n >= karatsuba_cutoff) {
+        int h = n - n / 2;
+        words += 4 * (h + 1);
+        n = h + 1;
+    }
+    return words;
+}
+
+/**
+ * @brief r[0 .. 2n) = a * b for n-word operands
+ *
+ * a = a1 B^m + a0 and b = b1 B^m + b0 with m = n/2; then
+ * a * b = z2 B^2m + ((a0 + a1)(b0 + b1) - z0 - z2) B^m + z0.
+ * z0 and z2 land directly in r, the middle product lives in scratch.
+ */
+static void bigint_karatsuba(bigint_word_t *r, const bigint_word_t *a, const bigint_word_t *b, int n,
+                             bigint_word_t *scratch) {
+    if (n < karatsuba_cutoff) {
+        bigint_mul_base(r, a, n, b, n);
+        return;
+    }
+    
+    int m = n / 2, h = n - m;
+    bigint_word_t *sa = scratch;
+    bigint_word_t *sb = sa + (h + 1);
+    bigint_word_t *z1 = sb + (h + 1);
+    bigint_word_t *next = z1 + 2 * (h + 1);
+    
+    bigint_karatsuba(r, a, b, m, next);
+    bigint_karatsuba(r + 2 * m, a + m, b + m, h, next);
+    
+    sa[h] = bigint_words_add(sa, a + m, h, a, m);
+    sb[h] = bigint_words_add(sb, b + m, h, b, m);
+    bigint_karatsuba(z1, sa, sb, h + 1, next);
+    bigint_words_sub_in(z1, 2 * (h + 1), r, 2 * m);
+    bigint_words_sub_in(z1, 2 * (h + 1), r + 2 * m, 2 * h);
+    bigint_words_add_in(r + m, 2 * n - m, z1, 2 * (h + 1));
+}
+
+/**
+ * @brief r[0 .. an+bn) = a * b for an >= bn, using caller-provided scratch
+ *
+ * Balanced operands go straight to Karatsuba. A longer a is cut into bn-word
+ * slices, each multiplied by b and accumulated. Falls back to schoolbook for
+ * short operands or when the scratch is too small.
+ */
+static void bigint_mul_words(bigint_word_t *r, const bigint_word_t *a, int an, const bigint_word_t *b, int bn,
+                             bigint_word_t *scratch, int scratch_words) {
+    if (bn < karatsuba_cutoff) {
+        bigint_mul_base(r, a, an, b, bn);
+        return;
+    }
+    if (an == bn && bigint_karatsuba_scratch(bn) <= scratch_words) {
+        bigint_karatsuba(r, a, b, bn, scratch);
+        return;
+    }
+    if (3 * bn + bigint_karatsuba_scratch(bn) > scratch_words) {
+        bigint_mul_base(r, a, an, b, bn);
+        return;
+    }
+    
+    bigint_word_t *slice = scratch;
+    bigint_word_t *prod = slice + bn;
+    bigint_word_t *next = prod + 2 * bn;
+    memset(r, 0, (size_t)(an + bn) * sizeof(bigint_word_t));
+    for (int off = 0; off < an; off += bn) {
+        int len = an - off < bn ? an - off : bn;
+        const bigint_word_t *src = a + off;
+        if (len < bn) {
+            memcpy(slice, src, (size_t)len * sizeof(bigint_word_t));
+            memset(slice + len, 0, (size_t)(bn - len) * sizeof(bigint_word_t));
+            src = slice;
+        }
+        bigint_karatsuba(prod, src, b, bn, next);
+        bigint_words_add_in(r + off, an + bn - off, prod, len + bn);
+    }
 }
 
 /* ===================== ADDITION/SUBTRACTION/MULTIPLICATION - ENHANCED ===================== */
@@ -519,7 +818,7 @@ int bigint_add(bigint_t *r, const bigint_t *a, const bigint_t *b) {
     VALIDATE_OVERFLOW(b, "bigint_add input b");
     
     int max_used = (a->used > b->used) ? a->used : b->used;
-    uint64_t carry = 0;
+    bigint_dword_t carry = 0;
     
     bigint_init(r);
     
@@ -530,12 +829,12 @@ int bigint_add(bigint_t *r, const bigint_t *a, const bigint_t *b) {
             return -2; /* Overflow */
         }
         
-        uint64_t sum = carry;
+        bigint_dword_t sum = carry;
         if (i < a->used) sum += a->words[i];
         if (i < b->used) sum += b->words[i];
         
-        r->words[i] = (uint32_t)(sum & 0xFFFFFFFF);
-        carry = sum >> 32;
+        r->words[i] = (bigint_word_t)(sum & BIGINT_WORD_MASK);
+        carry = sum >> BIGINT_WORD_SIZE;
         r->used = i + 1;
     }
     
@@ -564,17 +863,17 @@ int bigint_sub(bigint_t *r, const bigint_t *a, const bigint_t *b) {
     }
     
     bigint_init(r);
-    uint64_t borrow = 0;
+    bigint_dword_t borrow = 0;
     
     /* TODO: Enhanced subtraction with underflow detection */
     for (int i = 0; i < a->used; i++) {
-        uint64_t a_val = a->words[i];
-        uint64_t b_val = (i < b->used) ? b->words[i] : 0;
+        bigint_dword_t a_val = a->words[i];
+        bigint_dword_t b_val = (i < b->used) ? b->words[i] : 0;
         
-        uint64_t result = a_val - b_val - borrow;
+        bigint_dword_t result = a_val - b_val - borrow;
         
-        r->words[i] = (uint32_t)(result & 0xFFFFFFFF);
-        borrow = (result >> 63) & 1; /* Check if we borrowed */
+        r->words[i] = (bigint_word_t)(result & BIGINT_WORD_MASK);
+        borrow = (result >> (2 * BIGINT_WORD_SIZE - 1)) & 1; /* Check if we borrowed */
         r->used = i + 1;
     }
     
@@ -589,6 +888,7 @@ int bigint_mul(bigint_t *r, const bigint_t *a, const bigint_t *b) {
         return -1;
     }
     
+    STATS_COUNT(RSA_4096_STAT_BIGINT_MUL, 1);
     bigint_init(r);
     
     /* TODO: Handle zero multiplication efficiently */
@@ -608,33 +908,15 @@ int bigint_mul(bigint_t *r, const bigint_t *a, const bigint_t *b) {
         return -2; /* Result would be too large */
     }
     
-    /* TODO: School multiplication with enhanced bounds checking */
-    for (int i = 0; i < a->used; i++) {
-        uint64_t carry = 0;
-        
-        for (int j = 0; j < b->used || carry; j++) {
-            int pos = i + j;
-            if (pos >= BIGINT_4096_WORDS) {
-                CHECKPOINT(LOG_ERROR, "Multiplication position overflow: pos=%d", pos);
-                break;
-            }
-            
-            uint64_t current = r->words[pos];
-            uint64_t product = 0;
-            
-            if (j < b->used) {
-                product = (uint64_t)a->words[i] * b->words[j];
-            }
-            
-            uint64_t sum = current + (product & 0xFFFFFFFF) + carry;
-            r->words[pos] = (uint32_t)(sum & 0xFFFFFFFF);
-            carry = (sum >> 32) + (product >> 32);
-            
-            if (pos >= r->used) {
-                r->used = pos + 1;
-            }
-        }
+    /* Karatsuba above the cutover, tight schoolbook below; no heap use */
+    const bigint_t *x = a, *y = b;
+    if (x->used < y->used) {
+        x = b;
+        y = a;
     }
+    bigint_word_t scratch[BIGINT_MUL_SCRATCH_WORDS];
+    bigint_mul_words(r->words, x->words, x->used, y->words, y->used, scratch, BIGINT_MUL_SCRATCH_WORDS);
+    r->used = a->used + b->used;
     
     bigint_normalize(r);
     return 0;
@@ -642,11 +924,155 @@ int bigint_mul(bigint_t *r, const bigint_t *a, const bigint_t *b) {
 
 /* ===================== DIVISION/MODULO - CRITICAL FIXES ===================== */
 
+/**
+ * @brief Reciprocal of a normalized word: v = floor((B^2 - 1) / d) - B, B = 2^BIGINT_WORD_SIZE
+ *
+ * Computed once per division; every quotient-digit estimate then costs two
+ * multiplications instead of a double-word hardware (or libgcc) division.
+ */
+static bigint_word_t div_reciprocal_word(bigint_word_t d) {
+    bigint_dword_t num = ((bigint_dword_t)(bigint_word_t)~d << BIGINT_WORD_SIZE) | BIGINT_WORD_MASK;
+    return (bigint_word_t)(num / d);
+}
+
+/**
+ * @brief 2-by-1 division (u1:u0) / d with precomputed reciprocal (Moller-Granlund)
+ *
+ * Requires d normalized (top bit set) and u1 < d. Returns the quotient word and
+ * stores the remainder in *rem.
+ */
+static bigint_word_t div_2by1_word(bigint_word_t *rem, bigint_word_t u1, bigint_word_t u0,
+                                   bigint_word_t d, bigint_word_t v) {
+    bigint_dword_t q = (bigint_dword_t)v * u1;
+    q += ((bigint_dword_t)u1 << BIGINT_WORD_SIZE) | u0;
+    
+    bigint_word_t q1 = (bigint_word_t)(q >> BIGINT_WORD_SIZE) + 1;
+    bigint_word_t q0 = (bigint_word_t)q;
+    bigint_word_t r = u0 - q1 * d;
+    
+    if (r > q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+    
+    *rem = r;
+    return q1;
+}
+
+/**
+ * @brief Knuth Algorithm D on word arrays: q = a / b, r = a % b
+ *
+ * a has m + n words, b has n >= 2 words with b[n-1] != 0. Both operands are
+ * shifted so the divisor's top bit is set, which keeps each quotient-digit
+ * estimate at most 2 too large; the v[n-2] test removes nearly all of that
+ * and the rare remaining overshoot is fixed by one add-back.
+ */
+static void bigint_div_knuth(bigint_word_t *q, bigint_word_t *r,
+                             const bigint_word_t *a, int m_plus_n,
+                             const bigint_word_t *b, int n) {
+    bigint_word_t u[BIGINT_4096_WORDS + 1];
+    bigint_word_t v[BIGINT_4096_WORDS];
+    int m = m_plus_n - n;
+    
+    /* D1: normalize */
+    int shift = 0;
+    while (!(b[n - 1] & ((bigint_word_t)1 << (BIGINT_WORD_SIZE - 1 - shift)))) {
+        shift++;
+    }
+    if (shift == 0) {
+        memcpy(v, b, (size_t)n * sizeof(bigint_word_t));
+        memcpy(u, a, (size_t)m_plus_n * sizeof(bigint_word_t));
+        u[m_plus_n] = 0;
+    } else {
+        for (int i = n - 1; i > 0; i--) {
+            v[i] = (b[i] << shift) | (b[i - 1] >> (BIGINT_WORD_SIZE - shift));
+        }
+        v[0] = b[0] << shift;
+        u[m_plus_n] = a[m_plus_n - 1] >> (BIGINT_WORD_SIZE - shift);
+        for (int i = m_plus_n - 1; i > 0; i--) {
+            u[i] = (a[i] << shift) | (a[i - 1] >> (BIGINT_WORD_SIZE - shift));
+        }
+        u[0] = a[0] << shift;
+    }
+    
+    bigint_word_t d = v[n - 1];
+    bigint_word_t d2 = v[n - 2];
+    bigint_word_t recip = div_reciprocal_word(d);
+    
+    /* D2-D7: one quotient word per iteration, most significant first */
+    for (int j = m; j >= 0; j--) {
+        /* D3: estimate qhat from the top two words of the current remainder */
+        bigint_word_t qhat, rhat;
+        int rhat_overflow = 0;
+        if (u[j + n] >= d) {
+            /* u[j+n] == d: the true digit is B-1 or B-2 */
+            qhat = BIGINT_WORD_MASK;
+            rhat = u[j + n - 1] + d;
+            rhat_overflow = (rhat < d);
+        } else {
+            qhat = div_2by1_word(&rhat, u[j + n], u[j + n - 1], d, recip);
+        }
+        
+        while (!rhat_overflow &&
+               (bigint_dword_t)qhat * d2 > (((bigint_dword_t)rhat << BIGINT_WORD_SIZE) | u[j + n - 2])) {
+            qhat--;
+            rhat += d;
+            rhat_overflow = (rhat < d);
+        }
+        
+        /* D4: u[j .. j+n] -= qhat * v */
+        bigint_word_t borrow = 0;
+        bigint_word_t carry = 0;
+        for (int i = 0; i < n; i++) {
+            bigint_dword_t p = (bigint_dword_t)qhat * v[i] + carry;
+            carry = (bigint_word_t)(p >> BIGINT_WORD_SIZE);
+            bigint_word_t plo = (bigint_word_t)p;
+            bigint_word_t t = u[i + j] - plo;
+            bigint_word_t b1 = (u[i + j] < plo);
+            u[i + j] = t - borrow;
+            borrow = b1 | (t < borrow);
+        }
+        bigint_word_t t = u[j + n] - carry;
+        bigint_word_t b1 = (u[j + n] < carry);
+        u[j + n] = t - borrow;
+        borrow = b1 | (t < borrow);
+        
+        /* D5/D6: overshoot (probability ~2/B) - add one v back */
+        if (borrow) {
+            qhat--;
+            bigint_word_t c = 0;
+            for (int i = 0; i < n; i++) {
+                bigint_dword_t sum = (bigint_dword_t)u[i + j] + v[i] + c;
+                u[i + j] = (bigint_word_t)sum;
+                c = (bigint_word_t)(sum >> BIGINT_WORD_SIZE);
+            }
+            u[j + n] += c;
+        }
+        
+        q[j] = qhat;
+    }
+    
+    /* D8: unnormalize the remainder */
+    if (shift == 0) {
+        memcpy(r, u, (size_t)n * sizeof(bigint_word_t));
+    } else {
+        for (int i = 0; i < n - 1; i++) {
+            r[i] = (u[i] >> shift) | (u[i + 1] << (BIGINT_WORD_SIZE - shift));
+        }
+        r[n - 1] = u[n - 1] >> shift;
+    }
+}
+
 int bigint_div(bigint_t *q, bigint_t *r, const bigint_t *a, const bigint_t *b) {
     if (!q || !r || !a || !b) return -1;
     
     if (bigint_is_zero(b)) return -2; /* Division by zero */
     
+    STATS_COUNT(RSA_4096_STAT_BIGINT_DIV, 1);
     bigint_init(q);
     bigint_init(r);
     
@@ -660,87 +1086,41 @@ int bigint_div(bigint_t *q, bigint_t *r, const bigint_t *a, const bigint_t *b) {
         return 0;
     }
     
-    /* Binary long division - efficient for large numbers */
-    bigint_copy(r, a);  /* Start with remainder = dividend */
-    bigint_init(q);     /* Start with quotient = 0 */
-    
-    /* Handle single-word divisor for efficiency */
-    if (b->used == 1 && b->words[0] <= 0xFFFF) {
-        uint32_t divisor = b->words[0];
-        uint64_t remainder = 0;
+    /* Handle single-word divisor with one double-word division per word */
+    if (b->used == 1 || bigint_bit_length(b) <= BIGINT_WORD_SIZE) {
+        bigint_word_t divisor = b->words[0];
+        bigint_dword_t remainder = 0;
         
-        /* Divide from most significant word to least */
-        for (int i = r->used - 1; i >= 0; i--) {
-            uint64_t temp = (remainder << 32) | r->words[i];
-            uint32_t digit = (uint32_t)(temp / divisor);
+        /* Divide from most significant word to least; remainder < divisor keeps temp in range */
+        for (int i = a->used - 1; i >= 0; i--) {
+            bigint_dword_t temp = (remainder << BIGINT_WORD_SIZE) | a->words[i];
+            q->words[i] = (bigint_word_t)(temp / divisor);
             remainder = temp % divisor;
-            
-            if (q->used > 0 || digit > 0) {
-                if (q->used >= BIGINT_4096_WORDS) return -3;
-                q->words[q->used++] = digit;
-            }
-        }
-        
-        /* Reverse quotient words (we built it backwards) */
-        for (int i = 0; i < q->used / 2; i++) {
-            uint32_t temp = q->words[i];
-            q->words[i] = q->words[q->used - 1 - i];
-            q->words[q->used - 1 - i] = temp;
         }
+        q->used = a->used;
+        bigint_normalize(q);
+        STATS_COUNT(RSA_4096_STAT_DIV_ITERATIONS, (uint64_t)a->used);
         
         /* Set remainder */
-        bigint_set_u32(r, (uint32_t)remainder);
-        return 0;
-    }
-    
-    /* For multi-word divisors, use bit-by-bit division */
-    int dividend_bits = bigint_bit_length(a);
-    int divisor_bits = bigint_bit_length(b);
-    
-    if (dividend_bits < divisor_bits) {
-        /* Already handled above, but safety check */
-        bigint_copy(r, a);
-        bigint_init(q);
+        r->words[0] = (bigint_word_t)remainder;
+        r->used = 1;
+        bigint_normalize(r);
         return 0;
     }
     
-    bigint_t temp_quotient, temp_remainder, shifted_divisor;
-    bigint_init(&temp_quotient);
-    bigint_init(&temp_remainder);
-    bigint_init(&shifted_divisor);
-    
-    /* Process bit by bit from MSB to LSB */
-    for (int bit = dividend_bits - 1; bit >= 0; bit--) {
-        /* Shift remainder left by 1 */
-        int ret = bigint_shift_left(&temp_remainder, r, 1);
-        if (ret != 0) return ret;
-        bigint_copy(r, &temp_remainder);
-        
-        /* Set LSB to current bit of dividend */
-        if (bigint_get_bit(a, bit)) {
-            r->words[0] |= 1;
-        } else {
-            r->words[0] &= ~1;
-        }
-        
-        /* If remainder >= divisor, subtract divisor and set quotient bit */
-        if (bigint_compare(r, b) >= 0) {
-            ret = bigint_sub(&temp_remainder, r, b);
-            if (ret != 0) return ret;
-            bigint_copy(r, &temp_remainder);
-            
-            /* Set bit in quotient */
-            ret = bigint_shift_left(&temp_quotient, q, 1);
-            if (ret != 0) return ret;
-            bigint_copy(q, &temp_quotient);
-            q->words[0] |= 1;
-        } else {
-            /* Just shift quotient left */
-            ret = bigint_shift_left(&temp_quotient, q, 1);
-            if (ret != 0) return ret;
-            bigint_copy(q, &temp_quotient);
-        }
-    }
+    /* Significant lengths - Algorithm D needs a non-zero top divisor word */
+    int a_used = a->used, b_used = b->used;
+    while (a_used > 0 && a->words[a_used - 1] == 0) a_used--;
+    while (b_used > 0 && b->words[b_used - 1] == 0) b_used--;
+    
+    /* FIXED: Multi-word divisors use word-level Knuth Algorithm D instead of
+     * bit-by-bit shift/compare/subtract with full-buffer copies per dividend bit */
+    bigint_div_knuth(q->words, r->words, a->words, a_used, b->words, b_used);
+    STATS_COUNT(RSA_4096_STAT_DIV_ITERATIONS, (uint64_t)(a_used - b_used + 1));
+    q->used = a_used - b_used + 1;
+    r->used = b_used;
+    bigint_normalize(q);
+    bigint_normalize(r);
     
     return 0;
 }
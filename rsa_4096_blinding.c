@@ -0,0 +1,164 @@
+/**
+ * @file rsa_4096_blinding.c
+ * @brief Per-thread blinding pairs derived from a key's base pair
+ *
+ * rsa_4096_key_enable_blinding() pays for one inversion and leaves the key
+ * read-only from then on. Each thread keeps its own (vf, vi) per key in
+ * Montgomery form: a fresh one is (vf^k, vi^k) for a random 64-bit k - still
+ * an inverse pair, and unrelated to what other threads hold - and after every
+ * decryption both halves are squared, which keeps them a pair without
+ * another inversion. Every RSA_4096_BLINDING_REFRESH uses the thread draws a
+ * new k, so a run of squarings never gets long.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "rsa_4096.h"
+
+/* ===================== PER-THREAD STATE ===================== */
+
+typedef struct {
+    uint64_t id;                /* rsa_4096_key_t.blinding_id, 0 = free */
+    uint64_t last_use;          /* Block clock at the last hand-out, for eviction */
+    int uses;                   /* Hand-outs since the pair was derived */
+    mont_residue_t vf, vi;      /* Montgomery form */
+} blinding_slot_t;
+
+typedef struct {
+    blinding_slot_t slots[RSA_4096_BLINDING_SLOTS];
+    uint64_t clock;
+} blinding_block_t;
+
+static pthread_key_t blinding_key;
+static pthread_once_t blinding_key_once = PTHREAD_ONCE_INIT;
+static __thread blinding_block_t *blinding_local;
+
+/* Called through a volatile pointer so the wipe of the pairs is not optimised away */
+static void *(*volatile blinding_wipe)(void *, int, size_t) = memset;
+
+/**
+ * @brief Thread-exit destructor: the pairs are secret, wipe before freeing
+ */
+static void blinding_block_free(void *arg) {
+    blinding_wipe(arg, 0, sizeof(blinding_block_t));
+    free(arg);
+}
+
+static void blinding_key_create(void) {
+    pthread_key_create(&blinding_key, blinding_block_free);
+}
+
+static blinding_block_t *blinding_block(void) {
+    blinding_block_t *block = blinding_local;
+    if (block != NULL) {
+        return block;
+    }
+    
+    block = (blinding_block_t *)calloc(1, sizeof(blinding_block_t));
+    if (block == NULL) {
+        return NULL;
+    }
+    pthread_once(&blinding_key_once, blinding_key_create);
+    pthread_setspecific(blinding_key, block);
+    blinding_local = block;
+    return block;
+}
+
+/* ===================== PAIR DERIVATION ===================== */
+
+/* slot = (vf^k, vi^k) in Montgomery form for a random k with its top bit set */
+static int blinding_derive(blinding_slot_t *slot, const rsa_4096_key_t *key, rsa_4096_workspace_t *ws) {
+    const montgomery_ctx_t *ctx = &key->mont_ctx;
+    uint8_t k_bytes[8];
+    int ret = rsa_4096_random_bytes(k_bytes, sizeof(k_bytes));
+    if (ret != 0) {
+        ERROR_RETURN(ret, "No randomness for the blinding exponent");
+    }
+    k_bytes[0] |= 0x80;
+    
+    bigint_t k, power, form;
+    bigint_from_binary(&k, k_bytes, sizeof(k_bytes));
+    ret = montgomery_exp_ws(&power, &key->blind_vf, &k, ctx, ws);
+    if (ret == 0) ret = montgomery_to_form(&form, &power, ctx);
+    if (ret == 0) ret = mont_residue_from_bigint(&slot->vf, &form, ctx);
+    if (ret == 0) ret = montgomery_exp_ws(&power, &key->blind_vi, &k, ctx, ws);
+    if (ret == 0) ret = montgomery_to_form(&form, &power, ctx);
+    if (ret == 0) ret = mont_residue_from_bigint(&slot->vi, &form, ctx);
+    
+    blinding_wipe(k_bytes, 0, sizeof(k_bytes));
+    blinding_wipe(&k, 0, sizeof(k));
+    blinding_wipe(&power, 0, sizeof(power));
+    blinding_wipe(&form, 0, sizeof(form));
+    if (ret != 0) {
+        blinding_wipe(slot, 0, sizeof(*slot));
+        ERROR_RETURN(ret, "Failed to derive a thread blinding pair");
+    }
+    slot->id = key->blinding_id;
+    slot->uses = 0;
+    return 0;
+}
+
+/* ===================== HAND-OUT ===================== */
+
+int rsa_4096_blinding_next(const rsa_4096_key_t *key, mont_residue_t *vf, mont_residue_t *vi,
+                           rsa_4096_workspace_t *ws) {
+    if (key == NULL || vf == NULL || vi == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_blinding_next");
+    }
+    
+    if (!key->has_blinding || !key->mont_ctx.is_active) {
+        ERROR_RETURN(-2, "Key has no blinding pair");
+    }
+    
+    blinding_block_t *block = blinding_block();
+    if (block == NULL) {
+        ERROR_RETURN(-1, "Out of memory for the thread blinding state");
+    }
+    
+    /* This key's slot, else the least recently used one */
+    blinding_slot_t *slot = &block->slots[0];
+    for (int i = 0; i < RSA_4096_BLINDING_SLOTS; i++) {
+        if (block->slots[i].id == key->blinding_id) {
+            slot = &block->slots[i];
+            break;
+        }
+        if (block->slots[i].last_use < slot->last_use) {
+            slot = &block->slots[i];
+        }
+    }
+    
+    if (slot->id != key->blinding_id || slot->uses >= RSA_4096_BLINDING_REFRESH) {
+        /* The derivation exponentiates in the workspace, never in stack scratch */
+        if (ws == NULL) {
+            ws = rsa_4096_thread_workspace();
+            if (ws == NULL) {
+                ERROR_RETURN(-1, "No workspace for the thread blinding pair");
+            }
+        }
+        int ret = blinding_derive(slot, key, ws);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    
+    *vf = slot->vf;
+    *vi = slot->vi;
+    montgomery_square_residue(&slot->vf, &slot->vf, &key->mont_ctx);
+    montgomery_square_residue(&slot->vi, &slot->vi, &key->mont_ctx);
+    slot->uses++;
+    slot->last_use = ++block->clock;
+    return 0;
+}
+
+void rsa_4096_blinding_thread_clear(void) {
+    blinding_block_t *block = blinding_local;
+    if (block != NULL) {
+        blinding_wipe(block, 0, sizeof(*block));
+    }
+}
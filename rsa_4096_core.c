@@ -18,16 +18,49 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
 #include "rsa_4096.h"
 
 /* ===================== RSA KEY MANAGEMENT ===================== */
 
+static void rsa_4096_clear_crt(rsa_4096_key_t *key) {
+    bigint_init(&key->p);
+    bigint_init(&key->q);
+    bigint_init(&key->dp);
+    bigint_init(&key->dq);
+    bigint_init(&key->qinv);
+    bigint_init(&key->qinv_mont);
+    montgomery_ctx_free(&key->p_ctx);
+    montgomery_ctx_free(&key->q_ctx);
+    key->has_crt = 0;
+}
+
 void rsa_4096_init(rsa_4096_key_t *key) {
     if (key != NULL) {
         bigint_init(&key->n);
         bigint_init(&key->exponent);
         memset(&key->mont_ctx, 0, sizeof(montgomery_ctx_t));
         key->is_private = 0;
+        key->short_exponent = 0;
+        rsa_4096_clear_crt(key);
+        bigint_init(&key->blind_vf);
+        bigint_init(&key->blind_vi);
+        key->blinding_id = 0;
+        key->has_blinding = 0;
+    }
+}
+
+/**
+ * @brief Record a one-word exponent so public operations can skip the general exponentiation
+ */
+void rsa_4096_key_classify_exponent(rsa_4096_key_t *key) {
+    if (key == NULL) {
+        return;
+    }
+    key->short_exponent = (key->exponent.used == 1) ? key->exponent.words[0] : 0;
+    if (key->short_exponent != 0) {
+        CHECKPOINT(LOG_INFO, "Short exponent %" PRIuWORD " - public operations use the one-word path",
+                  key->short_exponent);
     }
 }
 
@@ -69,6 +102,7 @@ int rsa_4096_load_key(rsa_4096_key_t *key, const char *n_decimal, const char *e_
     if (bigint_is_zero(&key->exponent)) {
         ERROR_RETURN(-4, "Exponent cannot be zero");
     }
+    rsa_4096_key_classify_exponent(key);
     
     /* Check modulus parity for hybrid algorithm selection */
     if ((key->n.words[0] & 1) == 0) {
@@ -128,6 +162,7 @@ int rsa_4096_load_key_binary(rsa_4096_key_t *key, const uint8_t *n_data, size_t
     if (bigint_is_zero(&key->exponent)) {
         ERROR_RETURN(-4, "Parsed exponent is zero");
     }
+    rsa_4096_key_classify_exponent(key);
     
     /* Initialize Montgomery REDC context if possible */
     if ((key->n.words[0] & 1) == 1) {
@@ -140,10 +175,439 @@ int rsa_4096_load_key_binary(rsa_4096_key_t *key, const uint8_t *n_data, size_t
     return 0;
 }
 
+/* ===================== RSA CRT KEY COMPONENTS ===================== */
+
+/**
+ * @brief Validate parsed CRT components and build the two half-size contexts
+ */
+static int rsa_4096_setup_crt(rsa_4096_key_t *key) {
+    if (bigint_is_zero(&key->p) || bigint_is_zero(&key->q) ||
+        bigint_is_zero(&key->dp) || bigint_is_zero(&key->dq) || bigint_is_zero(&key->qinv)) {
+        ERROR_RETURN(-3, "CRT components cannot be zero");
+    }
+    
+    /* Montgomery needs odd moduli - true for every RSA prime */
+    if ((key->p.words[0] & 1) == 0 || (key->q.words[0] & 1) == 0) {
+        ERROR_RETURN(-4, "CRT primes must be odd");
+    }
+    
+    /* n = p * q ties the components to the loaded modulus */
+    bigint_t pq;
+    int ret = bigint_mul(&pq, &key->p, &key->q);
+    if (ret != 0 || bigint_compare(&pq, &key->n) != 0) {
+        ERROR_RETURN(-5, "CRT primes do not multiply to the modulus");
+    }
+    
+    if (bigint_compare(&key->dp, &key->p) >= 0 || bigint_compare(&key->dq, &key->q) >= 0 ||
+        bigint_compare(&key->qinv, &key->p) >= 0) {
+        ERROR_RETURN(-6, "CRT exponents/coefficient out of range");
+    }
+    
+    ret = montgomery_ctx_init(&key->p_ctx, &key->p);
+    if (ret != 0 || !key->p_ctx.is_active) {
+        ERROR_RETURN(-7, "Failed to build Montgomery context mod p");
+    }
+    ret = montgomery_ctx_init(&key->q_ctx, &key->q);
+    if (ret != 0 || !key->q_ctx.is_active) {
+        ERROR_RETURN(-7, "Failed to build Montgomery context mod q");
+    }
+    
+    /* qInv * q == 1 (mod p), otherwise Garner recombination silently produces garbage */
+    bigint_t check, check_mod;
+    ret = bigint_mul(&check, &key->qinv, &key->q);
+    if (ret == 0) {
+        ret = montgomery_reduce(&check_mod, &check, &key->p_ctx);
+    }
+    if (ret != 0 || !bigint_is_one(&check_mod)) {
+        ERROR_RETURN(-8, "CRT coefficient qInv is not q^(-1) mod p");
+    }
+    
+    ret = montgomery_to_form(&key->qinv_mont, &key->qinv, &key->p_ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to convert qInv to Montgomery form");
+    }
+    
+    key->has_crt = 1;
+    CHECKPOINT(LOG_INFO, "CRT enabled: %d-bit p, %d-bit q", 
+              bigint_bit_length(&key->p), bigint_bit_length(&key->q));
+    return 0;
+}
+
+int rsa_4096_load_key_crt(rsa_4096_key_t *key, const char *p_decimal, const char *q_decimal,
+                          const char *dp_decimal, const char *dq_decimal, const char *qinv_decimal) {
+    CHECKPOINT(LOG_INFO, "Loading RSA CRT components");
+    
+    if (key == NULL || p_decimal == NULL || q_decimal == NULL || 
+        dp_decimal == NULL || dq_decimal == NULL || qinv_decimal == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_load_key_crt");
+    }
+    
+    if (!key->is_private || bigint_is_zero(&key->n)) {
+        ERROR_RETURN(-2, "CRT components require a loaded private key");
+    }
+    
+    rsa_4096_clear_crt(key);
+    
+    int ret = bigint_from_decimal(&key->p, p_decimal);
+    if (ret == 0) ret = bigint_from_decimal(&key->q, q_decimal);
+    if (ret == 0) ret = bigint_from_decimal(&key->dp, dp_decimal);
+    if (ret == 0) ret = bigint_from_decimal(&key->dq, dq_decimal);
+    if (ret == 0) ret = bigint_from_decimal(&key->qinv, qinv_decimal);
+    if (ret == 0) ret = rsa_4096_setup_crt(key);
+    
+    if (ret != 0) {
+        rsa_4096_clear_crt(key);
+        ERROR_RETURN(ret, "Failed to load CRT components");
+    }
+    return 0;
+}
+
+int rsa_4096_load_key_crt_binary(rsa_4096_key_t *key, const uint8_t *p_data, size_t p_size,
+                                 const uint8_t *q_data, size_t q_size,
+                                 const uint8_t *dp_data, size_t dp_size,
+                                 const uint8_t *dq_data, size_t dq_size,
+                                 const uint8_t *qinv_data, size_t qinv_size) {
+    if (key == NULL || p_data == NULL || q_data == NULL || 
+        dp_data == NULL || dq_data == NULL || qinv_data == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_load_key_crt_binary");
+    }
+    
+    if (!key->is_private || bigint_is_zero(&key->n)) {
+        ERROR_RETURN(-2, "CRT components require a loaded private key");
+    }
+    
+    rsa_4096_clear_crt(key);
+    
+    int ret = bigint_from_binary(&key->p, p_data, p_size);
+    if (ret == 0) ret = bigint_from_binary(&key->q, q_data, q_size);
+    if (ret == 0) ret = bigint_from_binary(&key->dp, dp_data, dp_size);
+    if (ret == 0) ret = bigint_from_binary(&key->dq, dq_data, dq_size);
+    if (ret == 0) ret = bigint_from_binary(&key->qinv, qinv_data, qinv_size);
+    if (ret == 0) ret = rsa_4096_setup_crt(key);
+    
+    if (ret != 0) {
+        rsa_4096_clear_crt(key);
+        ERROR_RETURN(ret, "Failed to load binary CRT components");
+    }
+    return 0;
+}
+
+/**
+ * @brief Garner recombination m = m2 + q * ((m1 - m2) * qInv mod p), scratch in ws->tmp[0, 1, 4]
+ */
+static int rsa_4096_crt_combine(bigint_t *result, const bigint_t *m1, const bigint_t *m2, const rsa_4096_key_t *key,
+                                rsa_4096_workspace_t *ws) {
+    /* diff = (m1 - m2) mod p, with m2 reduced first since q may exceed p */
+    bigint_t *m2p = &ws->tmp[0], *diff = &ws->tmp[1];
+    int ret = montgomery_reduce(m2p, m2, &key->p_ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to reduce m2 mod p");
+    }
+    if (bigint_compare(m1, m2p) >= 0) {
+        ret = bigint_sub(diff, m1, m2p);
+    } else {
+        bigint_t *m1_plus_p = &ws->tmp[4];
+        ret = bigint_add(m1_plus_p, m1, &key->p);
+        if (ret == 0) ret = bigint_sub(diff, m1_plus_p, m2p);
+    }
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Garner difference failed");
+    }
+    
+    /* h = diff * qInv mod p: qinv_mont carries the extra R, so REDC cancels it */
+    bigint_t *h = m2p, *hq = &ws->tmp[4];
+    ret = montgomery_mul_ws(h, diff, &key->qinv_mont, &key->p_ctx, ws);
+    if (ret == 0) ret = bigint_mul(hq, h, &key->q);
+    if (ret == 0) ret = bigint_add(result, hq, m2);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Garner recombination failed");
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief m = c^d mod n via two half-size exponentiations and Garner recombination
+ *
+ * m1 = c^dP mod p, m2 = c^dQ mod q, h = qInv * (m1 - m2) mod p, m = m2 + h * q.
+ * Each half runs on a modulus of half the words with a half-length exponent,
+ * roughly 1/8 the work of the full exponentiation, so decrypt is ~4x faster.
+ */
+static int rsa_4096_crt_exp(bigint_t *result, const bigint_t *c, const rsa_4096_key_t *key,
+                            rsa_4096_workspace_t *ws) {
+    bigint_t *cp = &ws->tmp[0], *cq = &ws->tmp[1], *m1 = &ws->tmp[2], *m2 = &ws->tmp[3];
+    STATS_COUNT(RSA_4096_STAT_CRT_EXP, 1);
+    
+    /* c mod p and c mod q through REDC - no bit-serial division */
+    int ret = montgomery_reduce(cp, c, &key->p_ctx);
+    if (ret == 0) ret = montgomery_reduce(cq, c, &key->q_ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to reduce ciphertext mod p/q");
+    }
+    
+    /* The mod-q half goes to the helper thread when one is free; this thread takes mod p meanwhile */
+    int offloaded = bigint_bit_length(&key->n) >= RSA_4096_PARALLEL_CRT_MIN_BITS &&
+                    rsa_4096_parallel_crt_begin(m2, cq, &key->dq, &key->q_ctx) == 0;
+    ret = montgomery_exp_ws(m1, cp, &key->dp, &key->p_ctx, ws);
+    int ret_q = offloaded ? rsa_4096_parallel_crt_finish() : 0;
+    if (ret != 0) {
+        ERROR_RETURN(ret, "CRT exponentiation mod p failed");
+    }
+    ret = offloaded ? ret_q : montgomery_exp_ws(m2, cq, &key->dq, &key->q_ctx, ws);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "CRT exponentiation mod q failed");
+    }
+    
+    return rsa_4096_crt_combine(result, m1, m2, key, ws);
+}
+
+/* Smallest modulus decrypted through the CRT halves when the key carries them */
+static int crt_min_bits = RSA_4096_CRT_MIN_BITS;
+
+int rsa_4096_set_crt_min_bits(int bits) {
+    if (bits < 0 || bits > 4097) {
+        ERROR_RETURN(-1, "CRT cutover of %d bits outside 0..4097", bits);
+    }
+    crt_min_bits = bits;
+    return 0;
+}
+
+int rsa_4096_crt_min_bits(void) {
+    return crt_min_bits;
+}
+
+static int rsa_4096_use_crt(const rsa_4096_key_t *key) {
+    return key->has_crt && bigint_bit_length(&key->n) >= crt_min_bits;
+}
+
+/* Called through a volatile pointer so the wipe of secrets is not optimised away */
+static void *(*volatile rsa_4096_wipe)(void *, int, size_t) = memset;
+
+/**
+ * @brief Private-key exponentiation: CRT when available, full-size hybrid otherwise
+ */
+static int rsa_4096_private_exp_raw(bigint_t *result, const bigint_t *c, const rsa_4096_key_t *priv_key,
+                                    rsa_4096_workspace_t *ws) {
+    if (rsa_4096_use_crt(priv_key)) {
+        CHECKPOINT(LOG_INFO, "Using CRT with Garner recombination for decryption");
+        return rsa_4096_crt_exp(result, c, priv_key, ws);
+    }
+    /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
+    CHECKPOINT(LOG_INFO, "Using hybrid algorithm selection for decryption");
+    return hybrid_mod_exp_ws(result, c, &priv_key->exponent, &priv_key->n, &priv_key->mont_ctx, ws);
+}
+
+/* value = value * f mod n for f in Montgomery form: one residue multiply, no conversion */
+static int rsa_4096_blind_apply(bigint_t *value, const mont_residue_t *f, const montgomery_ctx_t *ctx) {
+    mont_residue_t x;
+    int ret = mont_residue_from_bigint(&x, value, ctx);
+    if (ret == 0) {
+        montgomery_mul_residue(&x, &x, f, ctx);
+        mont_residue_to_bigint(value, &x, ctx);
+    }
+    rsa_4096_wipe(&x, 0, sizeof(x));
+    return ret;
+}
+
+/**
+ * @brief result = ((c * vf)^d) * vi mod n with the calling thread's pair: two extra multiplies
+ */
+static int rsa_4096_private_exp_blinded(bigint_t *result, const bigint_t *c, const rsa_4096_key_t *priv_key,
+                                        rsa_4096_workspace_t *ws) {
+    mont_residue_t vf, vi;
+    int ret = rsa_4096_blinding_next(priv_key, &vf, &vi, ws);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "No blinding pair for this thread");
+    }
+    
+    bigint_t blinded;
+    bigint_copy(&blinded, c);
+    ret = rsa_4096_blind_apply(&blinded, &vf, &priv_key->mont_ctx);
+    if (ret == 0) {
+        ret = rsa_4096_private_exp_raw(result, &blinded, priv_key, ws);
+    }
+    if (ret == 0) {
+        ret = rsa_4096_blind_apply(result, &vi, &priv_key->mont_ctx);
+    }
+    
+    rsa_4096_wipe(&vf, 0, sizeof(vf));
+    rsa_4096_wipe(&vi, 0, sizeof(vi));
+    rsa_4096_wipe(&blinded, 0, sizeof(blinded));
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Blinded private exponentiation failed");
+    }
+    return 0;
+}
+
+static int rsa_4096_private_exp(bigint_t *result, const bigint_t *c, const rsa_4096_key_t *priv_key,
+                                rsa_4096_workspace_t *ws) {
+    uint64_t stats_start = STATS_START();
+    int ret = priv_key->has_blinding ? rsa_4096_private_exp_blinded(result, c, priv_key, ws)
+                                     : rsa_4096_private_exp_raw(result, c, priv_key, ws);
+    STATS_LATENCY(RSA_4096_LATENCY_DECRYPT, stats_start, 1);
+    return ret;
+}
+
+/**
+ * @brief Public-key exponentiation: one-word exponents skip the hybrid selection machinery
+ */
+static int rsa_4096_public_exp(bigint_t *result, const bigint_t *m, const rsa_4096_key_t *pub_key,
+                               rsa_4096_workspace_t *ws) {
+    uint64_t stats_start = STATS_START();
+    int ret;
+    if (pub_key->short_exponent != 0 && pub_key->mont_ctx.is_active) {
+        ret = montgomery_exp_word_ws(result, m, pub_key->short_exponent, &pub_key->mont_ctx, ws);
+    } else {
+        /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
+        ret = hybrid_mod_exp_ws(result, m, &pub_key->exponent, &pub_key->n, &pub_key->mont_ctx, ws);
+    }
+    STATS_LATENCY(RSA_4096_LATENCY_ENCRYPT, stats_start, 1);
+    return ret;
+}
+
+/* ===================== BLINDING ===================== */
+
+/* Zero is never handed out, so a slot tagged 0 is free */
+static uint64_t blinding_next_id;
+
+/**
+ * @brief Draw the key's base blinding pair - the only modular inversion blinding ever does
+ *
+ * A private key carries d but not e, so instead of (r^e, r^(-1)) the pair is
+ * (t, (t^d)^(-1)) for random t: the same thing with r = t^d, one private
+ * exponentiation to set up.
+ */
+int rsa_4096_key_enable_blinding(rsa_4096_key_t *key) {
+    if (key == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_key_enable_blinding");
+    }
+    
+    if (!key->is_private || !key->mont_ctx.is_active) {
+        ERROR_RETURN(-2, "Blinding needs a private key with a Montgomery context");
+    }
+    
+    rsa_4096_key_disable_blinding(key);
+    rsa_4096_workspace_t *ws = rsa_4096_workspace_new();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "Out of memory for the blinding setup");
+    }
+    
+    /* Eight spare random bytes make the reduction mod n negligibly biased */
+    size_t len = (size_t)(bigint_bit_length(&key->n) + 7) / 8 + 8;
+    uint8_t buf[MONTGOMERY_MAX_WORDS * sizeof(bigint_word_t) + 8];
+    bigint_t wide, t, w, vi;
+    int ret = -4;
+    for (int attempt = 0; attempt < 8 && ret != 0; attempt++) {
+        ret = rsa_4096_random_bytes(buf, len);
+        if (ret != 0) {
+            break;
+        }
+        bigint_from_binary(&wide, buf, len);
+        bigint_mod(&t, &wide, &key->n);
+        if (bigint_bit_length(&t) < 2) {
+            ret = -4;
+            continue;
+        }
+        ret = rsa_4096_private_exp_raw(&w, &t, key, ws);
+        if (ret == 0) {
+            /* Fails only when t shares a factor with n */
+            ret = bigint_mod_inverse_odd(&vi, &w, &key->n) == 0 ? 0 : -4;
+        }
+    }
+    
+    if (ret == 0) {
+        bigint_copy(&key->blind_vf, &t);
+        bigint_copy(&key->blind_vi, &vi);
+        key->blinding_id = __atomic_add_fetch(&blinding_next_id, 1, __ATOMIC_RELAXED);
+        key->has_blinding = 1;
+    }
+    rsa_4096_wipe(buf, 0, sizeof(buf));
+    rsa_4096_wipe(&wide, 0, sizeof(wide));
+    rsa_4096_wipe(&t, 0, sizeof(t));
+    rsa_4096_wipe(&w, 0, sizeof(w));
+    rsa_4096_wipe(&vi, 0, sizeof(vi));
+    rsa_4096_workspace_free(ws);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to draw a blinding pair");
+    }
+    CHECKPOINT(LOG_INFO, "Blinding enabled (pair %" PRIu64 ")", key->blinding_id);
+    return 0;
+}
+
+void rsa_4096_key_disable_blinding(rsa_4096_key_t *key) {
+    if (key != NULL) {
+        rsa_4096_wipe(&key->blind_vf, 0, sizeof(key->blind_vf));
+        rsa_4096_wipe(&key->blind_vi, 0, sizeof(key->blind_vi));
+        key->blinding_id = 0;
+        key->has_blinding = 0;
+    }
+}
+
+/* ===================== WORKSPACE ===================== */
+
+rsa_4096_workspace_t *rsa_4096_workspace_new(void) {
+    rsa_4096_workspace_t *ws = (rsa_4096_workspace_t *)malloc(sizeof(rsa_4096_workspace_t));
+    if (ws == NULL) {
+        CHECKPOINT(LOG_ERROR, "Failed to allocate %zu-byte workspace", sizeof(rsa_4096_workspace_t));
+    }
+    return ws;
+}
+
+void rsa_4096_workspace_clear(rsa_4096_workspace_t *ws) {
+    if (ws != NULL) {
+        rsa_4096_wipe(ws, 0, sizeof(*ws));
+    }
+}
+
+void rsa_4096_workspace_free(rsa_4096_workspace_t *ws) {
+    rsa_4096_workspace_clear(ws);
+    free(ws);
+}
+
+static pthread_key_t workspace_key;
+static pthread_once_t workspace_key_once = PTHREAD_ONCE_INIT;
+static __thread rsa_4096_workspace_t *workspace_local;
+
+static void workspace_thread_free(void *arg) {
+    rsa_4096_workspace_free((rsa_4096_workspace_t *)arg);
+}
+
+static void workspace_key_create(void) {
+    pthread_key_create(&workspace_key, workspace_thread_free);
+}
+
+rsa_4096_workspace_t *rsa_4096_thread_workspace(void) {
+    rsa_4096_workspace_t *ws = workspace_local;
+    if (ws != NULL) {
+        return ws;
+    }
+    
+    ws = rsa_4096_workspace_new();
+    if (ws == NULL) {
+        return NULL;
+    }
+    pthread_once(&workspace_key_once, workspace_key_create);
+    pthread_setspecific(workspace_key, ws);
+    workspace_local = ws;
+    return ws;
+}
+
 /* ===================== RSA ENCRYPTION/DECRYPTION - BUGS FIXED ===================== */
 
 int rsa_4096_encrypt(const rsa_4096_key_t *pub_key, const char *message_decimal,
                     char *encrypted_hex, size_t encrypted_size) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_encrypt");
+    }
+    return rsa_4096_encrypt_ws(pub_key, message_decimal, encrypted_hex, encrypted_size, ws);
+}
+
+int rsa_4096_encrypt_ws(const rsa_4096_key_t *pub_key, const char *message_decimal,
+                        char *encrypted_hex, size_t encrypted_size, rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_encrypt(pub_key, message_decimal, encrypted_hex, encrypted_size);
+    }
     CHECKPOINT(LOG_INFO, "Encrypting message using RSA-4096");
     
     if (pub_key == NULL || message_decimal == NULL || encrypted_hex == NULL) {
@@ -156,19 +620,19 @@ int rsa_4096_encrypt(const rsa_4096_key_t *pub_key, const char *message_decimal,
     }
     
     /* Parse message */
-    bigint_t message;
-    int ret = bigint_from_decimal(&message, message_decimal);
+    bigint_t *message = &ws->input;
+    int ret = bigint_from_decimal(message, message_decimal);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to parse message");
     }
     
     /* Verify message < modulus */
-    if (bigint_compare(&message, &pub_key->n) >= 0) {
+    if (bigint_compare(message, &pub_key->n) >= 0) {
         ERROR_RETURN(-3, "Message must be less than modulus");
     }
     
     /* FIXED: Check for zero message */
-    if (bigint_is_zero(&message)) {
+    if (bigint_is_zero(message)) {
         /* Zero message encrypts to zero */
         if (encrypted_size > 1) {
             strcpy(encrypted_hex, "0");
@@ -180,18 +644,16 @@ int rsa_4096_encrypt(const rsa_4096_key_t *pub_key, const char *message_decimal,
     }
     
     /* Perform encryption: c = m^e mod n */
-    bigint_t encrypted;
+    bigint_t *encrypted = &ws->output;
     
-    /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
-    CHECKPOINT(LOG_INFO, "Using hybrid algorithm selection for encryption");
-    ret = hybrid_mod_exp(&encrypted, &message, &pub_key->exponent, &pub_key->n, &pub_key->mont_ctx);
+    ret = rsa_4096_public_exp(encrypted, message, pub_key, ws);
     
     if (ret != 0) {
         ERROR_RETURN(ret, "Encryption computation failed");
     }
     
     /* Convert result to hex */
-    ret = bigint_to_hex(&encrypted, encrypted_hex, encrypted_size);
+    ret = bigint_to_hex(encrypted, encrypted_hex, encrypted_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert encrypted result to hex");
     }
@@ -202,6 +664,20 @@ int rsa_4096_encrypt(const rsa_4096_key_t *pub_key, const char *message_decimal,
 
 int rsa_4096_decrypt(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
                     char *message_decimal, size_t message_size) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_decrypt");
+    }
+    int ret = rsa_4096_decrypt_ws(priv_key, encrypted_hex, message_decimal, message_size, ws);
+    rsa_4096_workspace_clear(ws);
+    return ret;
+}
+
+int rsa_4096_decrypt_ws(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
+                        char *message_decimal, size_t message_size, rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_decrypt(priv_key, encrypted_hex, message_decimal, message_size);
+    }
     CHECKPOINT(LOG_INFO, "Decrypting message using RSA-4096");
     
     if (priv_key == NULL || encrypted_hex == NULL || message_decimal == NULL) {
@@ -218,19 +694,19 @@ int rsa_4096_decrypt(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
     }
     
     /* Parse encrypted message */
-    bigint_t encrypted;
-    int ret = bigint_from_hex(&encrypted, encrypted_hex);
+    bigint_t *encrypted = &ws->input;
+    int ret = bigint_from_hex(encrypted, encrypted_hex);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to parse encrypted message");
     }
     
     /* Verify encrypted < modulus */
-    if (bigint_compare(&encrypted, &priv_key->n) >= 0) {
+    if (bigint_compare(encrypted, &priv_key->n) >= 0) {
         ERROR_RETURN(-4, "Encrypted message must be less than modulus");
     }
     
     /* FIXED: Handle zero ciphertext */
-    if (bigint_is_zero(&encrypted)) {
+    if (bigint_is_zero(encrypted)) {
         /* Zero ciphertext decrypts to zero */
         if (message_size > 1) {
             strcpy(message_decimal, "0");
@@ -242,18 +718,16 @@ int rsa_4096_decrypt(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
     }
     
     /* Perform decryption: m = c^d mod n */
-    bigint_t decrypted;
+    bigint_t *decrypted = &ws->output;
     
-    /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
-    CHECKPOINT(LOG_INFO, "Using hybrid algorithm selection for decryption");
-    ret = hybrid_mod_exp(&decrypted, &encrypted, &priv_key->exponent, &priv_key->n, &priv_key->mont_ctx);
+    ret = rsa_4096_private_exp(decrypted, encrypted, priv_key, ws);
     
     if (ret != 0) {
         ERROR_RETURN(ret, "Decryption computation failed");
     }
     
     /* Convert result to decimal */
-    ret = bigint_to_decimal(&decrypted, message_decimal, message_size);
+    ret = bigint_to_decimal(decrypted, message_decimal, message_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert decrypted result to decimal");
     }
@@ -265,6 +739,21 @@ int rsa_4096_decrypt(const rsa_4096_key_t *priv_key, const char *encrypted_hex,
 int rsa_4096_encrypt_binary(const rsa_4096_key_t *pub_key, const uint8_t *message,
                            size_t message_size, uint8_t *encrypted, size_t encrypted_buffer_size,
                            size_t *encrypted_size) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_encrypt_binary");
+    }
+    return rsa_4096_encrypt_binary_ws(pub_key, message, message_size, encrypted, encrypted_buffer_size,
+                                      encrypted_size, ws);
+}
+
+int rsa_4096_encrypt_binary_ws(const rsa_4096_key_t *pub_key, const uint8_t *message,
+                               size_t message_size, uint8_t *encrypted, size_t encrypted_buffer_size,
+                               size_t *encrypted_size, rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_encrypt_binary(pub_key, message, message_size, encrypted, encrypted_buffer_size,
+                                       encrypted_size);
+    }
     CHECKPOINT(LOG_INFO, "Binary encryption using RSA-4096");
     
     if (pub_key == NULL || message == NULL || encrypted == NULL || encrypted_size == NULL) {
@@ -293,35 +782,33 @@ int rsa_4096_encrypt_binary(const rsa_4096_key_t *pub_key, const uint8_t *messag
     if (modulus_bits <= 8) {
         max_safe_size = 1;
         if (message_size > max_safe_size) {
-            printf("[rsa_4096_encrypt_binary] WARNING: Message too large (%zu bytes), will encrypt first %zu bytes only\n", 
+            TRACE(LOG_INFO, "[rsa_4096_encrypt_binary] WARNING: Message too large (%zu bytes), will encrypt first %zu bytes only", 
                    message_size, max_safe_size);
             message_size = max_safe_size;
         }
     }
     
     /* Convert message to bigint */
-    bigint_t message_bigint;
-    int ret = bigint_from_binary(&message_bigint, message, message_size);
+    bigint_t *message_bigint = &ws->input;
+    int ret = bigint_from_binary(message_bigint, message, message_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert message to bigint");
     }
     
     /* Verify message < modulus */
-    if (bigint_compare(&message_bigint, &pub_key->n) >= 0) {
+    if (bigint_compare(message_bigint, &pub_key->n) >= 0) {
         ERROR_RETURN(-4, "Message must be less than modulus");
     }
     
-    /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
-    bigint_t encrypted_bigint;
-    CHECKPOINT(LOG_INFO, "Using hybrid algorithm selection for binary encryption");
-    ret = hybrid_mod_exp(&encrypted_bigint, &message_bigint, &pub_key->exponent, &pub_key->n, &pub_key->mont_ctx);
+    bigint_t *encrypted_bigint = &ws->output;
+    ret = rsa_4096_public_exp(encrypted_bigint, message_bigint, pub_key, ws);
     
     if (ret != 0) {
         ERROR_RETURN(ret, "Binary encryption computation failed");
     }
     
     /* Convert result to binary */
-    ret = bigint_to_binary(&encrypted_bigint, encrypted, encrypted_buffer_size, encrypted_size);
+    ret = bigint_to_binary(encrypted_bigint, encrypted, encrypted_buffer_size, encrypted_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert encrypted result to binary");
     }
@@ -333,6 +820,23 @@ int rsa_4096_encrypt_binary(const rsa_4096_key_t *pub_key, const uint8_t *messag
 int rsa_4096_decrypt_binary(const rsa_4096_key_t *priv_key, const uint8_t *encrypted,
                            size_t encrypted_size, uint8_t *message, size_t message_buffer_size,
                            size_t *message_size) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_decrypt_binary");
+    }
+    int ret = rsa_4096_decrypt_binary_ws(priv_key, encrypted, encrypted_size, message, message_buffer_size,
+                                         message_size, ws);
+    rsa_4096_workspace_clear(ws);
+    return ret;
+}
+
+int rsa_4096_decrypt_binary_ws(const rsa_4096_key_t *priv_key, const uint8_t *encrypted,
+                               size_t encrypted_size, uint8_t *message, size_t message_buffer_size,
+                               size_t *message_size, rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_decrypt_binary(priv_key, encrypted, encrypted_size, message, message_buffer_size,
+                                       message_size);
+    }
     CHECKPOINT(LOG_INFO, "Binary decryption using RSA-4096");
     
     if (priv_key == NULL || encrypted == NULL || message == NULL || message_size == NULL) {
@@ -353,32 +857,308 @@ int rsa_4096_decrypt_binary(const rsa_4096_key_t *priv_key, const uint8_t *encry
     }
     
     /* Convert encrypted to bigint */
-    bigint_t encrypted_bigint;
-    int ret = bigint_from_binary(&encrypted_bigint, encrypted, encrypted_size);
+    bigint_t *encrypted_bigint = &ws->input;
+    int ret = bigint_from_binary(encrypted_bigint, encrypted, encrypted_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert encrypted to bigint");
     }
     
     /* Verify encrypted < modulus */
-    if (bigint_compare(&encrypted_bigint, &priv_key->n) >= 0) {
+    if (bigint_compare(encrypted_bigint, &priv_key->n) >= 0) {
         ERROR_RETURN(-5, "Encrypted message must be less than modulus");
     }
     
-    /* Use hybrid algorithm selection - Terrantsh model with intelligent fallback */
-    bigint_t decrypted_bigint;
-    CHECKPOINT(LOG_INFO, "Using hybrid algorithm selection for binary decryption");
-    ret = hybrid_mod_exp(&decrypted_bigint, &encrypted_bigint, &priv_key->exponent, &priv_key->n, &priv_key->mont_ctx);
+    bigint_t *decrypted_bigint = &ws->output;
+    ret = rsa_4096_private_exp(decrypted_bigint, encrypted_bigint, priv_key, ws);
     
     if (ret != 0) {
         ERROR_RETURN(ret, "Binary decryption computation failed");
     }
     
     /* Convert result to binary */
-    ret = bigint_to_binary(&decrypted_bigint, message, message_buffer_size, message_size);
+    ret = bigint_to_binary(decrypted_bigint, message, message_buffer_size, message_size);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert decrypted result to binary");
     }
     
     CHECKPOINT(LOG_INFO, "Binary decryption completed successfully");
     return 0;
-}
\ No newline at end of file
+}
+
+/* ===================== FIXED-LENGTH BLOCKS ===================== */
+
+size_t rsa_4096_key_bytes(const rsa_4096_key_t *key) {
+    return key != NULL ? ((size_t)bigint_bit_length(&key->n) + 7) / 8 : 0;
+}
+
+/**
+ * @brief len-byte big-endian block in, len-byte zero-padded block out, len = modulus bytes
+ */
+static int rsa_4096_fixed_run(const rsa_4096_key_t *key, const uint8_t *in, uint8_t *out, size_t len,
+                              rsa_4096_workspace_t *ws, int decrypt) {
+    if (key == NULL || in == NULL || out == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_%s_fixed", decrypt ? "decrypt" : "encrypt");
+    }
+    
+    if (decrypt && !key->is_private) {
+        ERROR_RETURN(-2, "Decryption requires private key");
+    }
+    
+    size_t k = rsa_4096_key_bytes(key);
+    if (len == 0 || len != k) {
+        ERROR_RETURN(-3, "Block of %zu bytes for a %zu-byte modulus", len, k);
+    }
+    
+    /* Word-wide import; the compare almost always stops at the top limb */
+    bigint_t *value = &ws->input;
+    int ret = bigint_from_binary(value, in, len);
+    if (ret != 0 || bigint_compare(value, &key->n) >= 0) {
+        ERROR_RETURN(-4, "Block must be less than modulus");
+    }
+    
+    ret = decrypt ? rsa_4096_private_exp(&ws->output, value, key, ws)
+                  : rsa_4096_public_exp(&ws->output, value, key, ws);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Fixed-length %s computation failed", decrypt ? "decryption" : "encryption");
+    }
+    
+    /* in is fully consumed, so out may alias it */
+    return bigint_to_binary_fixed(&ws->output, out, len);
+}
+
+int rsa_4096_encrypt_fixed(const rsa_4096_key_t *pub_key, const uint8_t *in, uint8_t *out, size_t len) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_encrypt_fixed");
+    }
+    return rsa_4096_fixed_run(pub_key, in, out, len, ws, 0);
+}
+
+int rsa_4096_decrypt_fixed(const rsa_4096_key_t *priv_key, const uint8_t *in, uint8_t *out, size_t len) {
+    rsa_4096_workspace_t *ws = rsa_4096_thread_workspace();
+    if (ws == NULL) {
+        ERROR_RETURN(-1, "No workspace for rsa_4096_decrypt_fixed");
+    }
+    int ret = rsa_4096_fixed_run(priv_key, in, out, len, ws, 1);
+    rsa_4096_workspace_clear(ws);
+    return ret;
+}
+
+int rsa_4096_encrypt_fixed_ws(const rsa_4096_key_t *pub_key, const uint8_t *in, uint8_t *out, size_t len,
+                              rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_encrypt_fixed(pub_key, in, out, len);
+    }
+    return rsa_4096_fixed_run(pub_key, in, out, len, ws, 0);
+}
+
+int rsa_4096_decrypt_fixed_ws(const rsa_4096_key_t *priv_key, const uint8_t *in, uint8_t *out, size_t len,
+                              rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return rsa_4096_decrypt_fixed(priv_key, in, out, len);
+    }
+    return rsa_4096_fixed_run(priv_key, in, out, len, ws, 1);
+}
+
+/* Batch-item shape of the fixed calls for the multi driver's single-block fallback */
+static int rsa_4096_fixed_item(const rsa_4096_key_t *key, const uint8_t *in, size_t in_len, uint8_t *out,
+                               size_t out_size, size_t *out_len, rsa_4096_workspace_t *ws, int decrypt) {
+    *out_len = 0;
+    if (out_size < in_len) {
+        ERROR_RETURN(-5, "Output buffer of %zu bytes for a %zu-byte block", out_size, in_len);
+    }
+    int ret = decrypt ? rsa_4096_decrypt_fixed_ws(key, in, out, in_len, ws)
+                      : rsa_4096_encrypt_fixed_ws(key, in, out, in_len, ws);
+    if (ret == 0) {
+        *out_len = in_len;
+    }
+    return ret;
+}
+
+static int rsa_4096_encrypt_fixed_item(const rsa_4096_key_t *key, const uint8_t *in, size_t in_len, uint8_t *out,
+                                       size_t out_size, size_t *out_len, rsa_4096_workspace_t *ws) {
+    return rsa_4096_fixed_item(key, in, in_len, out, out_size, out_len, ws, 0);
+}
+
+static int rsa_4096_decrypt_fixed_item(const rsa_4096_key_t *key, const uint8_t *in, size_t in_len, uint8_t *out,
+                                       size_t out_size, size_t *out_len, rsa_4096_workspace_t *ws) {
+    return rsa_4096_fixed_item(key, in, in_len, out, out_size, out_len, ws, 1);
+}
+
+/* ===================== MULTI-BUFFER BLOCKS ===================== */
+
+typedef struct {
+    bigint_t in[MONTGOMERY_MULTI_MAX_LANES];
+    bigint_t half[2 * MONTGOMERY_MULTI_MAX_LANES];      /* c mod p, then c mod q */
+    bigint_t out[2 * MONTGOMERY_MULTI_MAX_LANES];       /* Full results, or m1 then m2 */
+    mont_residue_t unblind[MONTGOMERY_MULTI_MAX_LANES];  /* vi per lane when the key is blinded */
+    rsa_4096_batch_item_t *item[MONTGOMERY_MULTI_MAX_LANES];
+} rsa_4096_multi_t;
+
+/**
+ * @brief Parse one item for the shared pass; anything it rejects takes the single-block call instead
+ *
+ * A blinded key's decrypt lanes are blinded here, and unblind gets the matching vi.
+ */
+static int rsa_4096_multi_accept(bigint_t *value, mont_residue_t *unblind, const rsa_4096_key_t *key,
+                                 rsa_4096_batch_item_t *item, int decrypt, size_t fixed_len,
+                                 rsa_4096_workspace_t *ws) {
+    item->output_len = 0;
+    if (item->input == NULL || item->output == NULL || item->input_len == 0 || item->output_size == 0) {
+        return 0;
+    }
+    if (fixed_len != 0 && (item->input_len != fixed_len || item->output_size < fixed_len)) {
+        return 0;
+    }
+    if (bigint_from_binary(value, item->input, item->input_len) != 0 || bigint_compare(value, &key->n) >= 0) {
+        return 0;
+    }
+    if (!decrypt || !key->has_blinding) {
+        return 1;
+    }
+    mont_residue_t vf;
+    int ok = rsa_4096_blinding_next(key, &vf, unblind, ws) == 0 &&
+             rsa_4096_blind_apply(value, &vf, &key->mont_ctx) == 0;
+    rsa_4096_wipe(&vf, 0, sizeof(vf));
+    return ok;
+}
+
+/**
+ * @brief Shared driver: gather accepted items per chunk, exponentiate them in lock-step, emit
+ *
+ * fixed: every block is exactly the modulus size on both sides (rsa_4096_*_fixed semantics).
+ */
+static int rsa_4096_multi_run(const rsa_4096_key_t *key, rsa_4096_batch_item_t *items, size_t count,
+                              rsa_4096_workspace_t *ws, int decrypt, int fixed) {
+    typedef int (*single_op_t)(const rsa_4096_key_t *, const uint8_t *, size_t, uint8_t *, size_t, size_t *,
+                               rsa_4096_workspace_t *);
+    single_op_t single = fixed ? (decrypt ? rsa_4096_decrypt_fixed_item : rsa_4096_encrypt_fixed_item)
+                               : (decrypt ? rsa_4096_decrypt_binary_ws : rsa_4096_encrypt_binary_ws);
+    size_t fixed_len = fixed ? rsa_4096_key_bytes(key) : 0;
+    rsa_4096_workspace_t *own = NULL;
+    if (ws == NULL) {
+        ws = own = rsa_4096_workspace_new();
+    }
+    int crt = decrypt && rsa_4096_use_crt(key);
+    int usable = ws != NULL && montgomery_multi_lanes() > 1 && (crt || key->mont_ctx.is_active) &&
+                 bigint_bit_length(&key->n) > 8 && (!decrypt || key->is_private);
+    
+    rsa_4096_multi_t *st = usable ? (rsa_4096_multi_t *)malloc(sizeof(rsa_4096_multi_t)) : NULL;
+    size_t failed = 0;
+    
+    for (size_t begin = 0; begin < count; begin += MONTGOMERY_MULTI_MAX_LANES) {
+        size_t chunk = count - begin < MONTGOMERY_MULTI_MAX_LANES ? count - begin : MONTGOMERY_MULTI_MAX_LANES;
+        int lanes = 0;
+        for (size_t i = begin; i < begin + chunk; i++) {
+            rsa_4096_batch_item_t *item = &items[i];
+            if (st != NULL && rsa_4096_multi_accept(&st->in[lanes], &st->unblind[lanes], key, item, decrypt,
+                                                    fixed_len, ws)) {
+                st->item[lanes++] = item;
+            } else {
+                item->output_len = 0;
+                item->status = single(key, item->input, item->input_len, item->output, item->output_size,
+                                      &item->output_len, ws);
+                if (item->status != 0) failed++;
+            }
+        }
+        if (lanes == 0) {
+            continue;
+        }
+    
+        /* One exponentiation per item, or two half-size ones with all the mod-p lanes first */
+        bigint_t *results[2 * MONTGOMERY_MULTI_MAX_LANES];
+        const bigint_t *bases[2 * MONTGOMERY_MULTI_MAX_LANES], *exps[2 * MONTGOMERY_MULTI_MAX_LANES];
+        const montgomery_ctx_t *ctxs[2 * MONTGOMERY_MULTI_MAX_LANES];
+        int total = crt ? 2 * lanes : lanes;
+        int ret = 0;
+        uint64_t stats_start = STATS_START();
+        for (int l = 0; l < lanes && ret == 0; l++) {
+            if (crt) {
+                ret = montgomery_reduce(&st->half[l], &st->in[l], &key->p_ctx);
+                if (ret == 0) ret = montgomery_reduce(&st->half[lanes + l], &st->in[l], &key->q_ctx);
+                bases[l] = &st->half[l];
+                bases[lanes + l] = &st->half[lanes + l];
+                exps[l] = &key->dp;
+                exps[lanes + l] = &key->dq;
+                ctxs[l] = &key->p_ctx;
+                ctxs[lanes + l] = &key->q_ctx;
+                results[lanes + l] = &st->out[lanes + l];
+            } else {
+                bases[l] = &st->in[l];
+                exps[l] = &key->exponent;
+                ctxs[l] = &key->mont_ctx;
+            }
+            results[l] = &st->out[l];
+        }
+        if (ret == 0) {
+            ret = montgomery_exp_multi_ws(results, bases, exps, ctxs, total, ws);
+        }
+    
+        for (int l = 0; l < lanes; l++) {
+            rsa_4096_batch_item_t *item = st->item[l];
+            int status = ret;
+            if (status == 0 && crt) {
+                status = rsa_4096_crt_combine(&ws->output, &st->out[l], &st->out[lanes + l], key, ws);
+            } else if (status == 0) {
+                bigint_copy(&ws->output, &st->out[l]);
+            }
+            if (status == 0 && decrypt && key->has_blinding) {
+                status = rsa_4096_blind_apply(&ws->output, &st->unblind[l], &key->mont_ctx);
+            }
+            if (status == 0 && fixed) {
+                status = bigint_to_binary_fixed(&ws->output, item->output, fixed_len);
+                item->output_len = status == 0 ? fixed_len : 0;
+            } else if (status == 0) {
+                status = bigint_to_binary(&ws->output, item->output, item->output_size, &item->output_len);
+            } else {
+                /* The shared pass failed: retry this item alone so it reports its own error */
+                status = single(key, item->input, item->input_len, item->output, item->output_size,
+                                &item->output_len, ws);
+            }
+            item->status = status;
+            if (status != 0) failed++;
+        }
+        /* Every lane waited for the whole lock-step pass */
+        STATS_LATENCY(decrypt ? RSA_4096_LATENCY_DECRYPT : RSA_4096_LATENCY_ENCRYPT, stats_start, (uint64_t)lanes);
+    }
+    
+    if (st != NULL) {
+        rsa_4096_wipe(st, 0, sizeof(rsa_4096_multi_t));
+        free(st);
+    }
+    rsa_4096_workspace_free(own);
+    CHECKPOINT(LOG_INFO, "Multi-buffer block of %zu items: %zu failed", count, failed);
+    return failed == 0 ? 0 : -3;
+}
+
+int rsa_4096_encrypt_binary_multi(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                                  rsa_4096_workspace_t *ws) {
+    if (pub_key == NULL || (items == NULL && count > 0)) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_encrypt_binary_multi");
+    }
+    return rsa_4096_multi_run(pub_key, items, count, ws, 0, 0);
+}
+
+int rsa_4096_decrypt_binary_multi(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                                  rsa_4096_workspace_t *ws) {
+    if (priv_key == NULL || (items == NULL && count > 0)) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_decrypt_binary_multi");
+    }
+    return rsa_4096_multi_run(priv_key, items, count, ws, 1, 0);
+}
+
+int rsa_4096_encrypt_fixed_multi(const rsa_4096_key_t *pub_key, rsa_4096_batch_item_t *items, size_t count,
+                                 rsa_4096_workspace_t *ws) {
+    if (pub_key == NULL || (items == NULL && count > 0)) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_encrypt_fixed_multi");
+    }
+    return rsa_4096_multi_run(pub_key, items, count, ws, 0, 1);
+}
+
+int rsa_4096_decrypt_fixed_multi(const rsa_4096_key_t *priv_key, rsa_4096_batch_item_t *items, size_t count,
+                                 rsa_4096_workspace_t *ws) {
+    if (priv_key == NULL || (items == NULL && count > 0)) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_decrypt_fixed_multi");
+    }
+    return rsa_4096_multi_run(priv_key, items, count, ws, 1, 1);
+}
@@ -0,0 +1,443 @@
+/**
+ * @file rsa_4096_keyblob.c
+ * @brief Persisted precomputed key format - load keys without Montgomery setup
+ * 
+ * A key blob stores the modulus, exponent, Montgomery context (n', R mod n,
+ * R^2 mod n, and R^(-1) mod n if it was computed) and any CRT components with their half-size
+ * contexts, so loading is a validated copy instead of bignum work.
+ *
+ * Layout (all integers little-endian, limbs as BIGINT_WORD_BYTES each):
+ *   magic[8] | u16 version | u16 limb_bits | u32 flags | u32 total_size | u64 checksum
+ *   bigint n | bigint exponent | ctx mont_ctx
+ *   [CRT: bigint p, q, dp, dq, qinv, qinv_mont | ctx p_ctx | ctx q_ctx]
+ *   bigint = u32 word_count + words;  ctx = u32 ctx_flags [+ u32 n_words, u32 r_words,
+ *   word n_prime, n_words words each of n, r_mod_n, r_squared, r_inv]
+ *   ctx_flags bit 0: context active, bit 1: r_inv present (otherwise zero, derived lazily)
+ * The checksum is FNV-1a 64 over the whole blob with the checksum field zeroed;
+ * it detects truncation and corruption, it is not a MAC.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L   /* fdopen, fchmod */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "rsa_4096.h"
+
+#define KEYBLOB_HEADER_SIZE 28
+#define KEYBLOB_CHECKSUM_OFFSET 20
+
+#define KEYBLOB_FLAG_PRIVATE 0x1u
+#define KEYBLOB_FLAG_CRT     0x2u
+
+#define KEYBLOB_CTX_ACTIVE   0x1u
+#define KEYBLOB_CTX_R_INV    0x2u
+
+/* Called through a volatile pointer so the wipe before free() is not optimised away */
+static void *(*volatile keyblob_wipe)(void *, int, size_t) = memset;
+
+/* ===================== BYTE WRITER / READER ===================== */
+
+typedef struct {
+    uint8_t *buf;       /* NULL when only measuring */
+    size_t size;
+    size_t pos;
+} blob_writer_t;
+
+typedef struct {
+    const uint8_t *buf;
+    size_t size;
+    size_t pos;
+    int error;
+} blob_reader_t;
+
+static void put_bytes_le(blob_writer_t *w, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        if (w->buf != NULL && w->pos < w->size) {
+            w->buf[w->pos] = (uint8_t)(value >> (8 * i));
+        }
+        w->pos++;
+    }
+}
+
+static void put_word(blob_writer_t *w, bigint_word_t word) {
+    put_bytes_le(w, (uint64_t)word, BIGINT_WORD_BYTES);
+}
+
+static void put_bigint(blob_writer_t *w, const bigint_t *a) {
+    int used = bigint_is_zero(a) ? 0 : a->used;
+    put_bytes_le(w, (uint64_t)used, 4);
+    for (int i = 0; i < used; i++) {
+        put_word(w, a->words[i]);
+    }
+}
+
+static void put_residue(blob_writer_t *w, const mont_residue_t *r, int n_words) {
+    for (int i = 0; i < n_words; i++) {
+        put_word(w, r->words[i]);
+    }
+}
+
+static void put_ctx(blob_writer_t *w, const montgomery_ctx_t *ctx) {
+    if (!ctx->is_active) {
+        put_bytes_le(w, 0, 4);
+        return;
+    }
+    put_bytes_le(w, KEYBLOB_CTX_ACTIVE | (ctx->has_r_inv ? KEYBLOB_CTX_R_INV : 0), 4);
+    
+    put_bytes_le(w, (uint64_t)ctx->n_words, 4);
+    put_bytes_le(w, (uint64_t)ctx->r_words, 4);
+    put_word(w, ctx->n_prime);
+    put_residue(w, &ctx->n, ctx->n_words);
+    put_residue(w, &ctx->r_mod_n, ctx->n_words);
+    put_residue(w, &ctx->r_squared, ctx->n_words);
+    put_residue(w, &ctx->r_inv, ctx->n_words);
+}
+
+static uint64_t get_bytes_le(blob_reader_t *r, int bytes) {
+    if (r->error || r->size - r->pos < (size_t)bytes) {
+        r->error = 1;
+        return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)r->buf[r->pos + i] << (8 * i);
+    }
+    r->pos += bytes;
+    return value;
+}
+
+static bigint_word_t get_word(blob_reader_t *r) {
+    return (bigint_word_t)get_bytes_le(r, BIGINT_WORD_BYTES);
+}
+
+static void get_bigint(blob_reader_t *r, bigint_t *a) {
+    bigint_init(a);
+    uint64_t used = get_bytes_le(r, 4);
+    if (used > BIGINT_4096_WORDS) {
+        r->error = 1;
+        return;
+    }
+    for (uint64_t i = 0; i < used && !r->error; i++) {
+        a->words[i] = get_word(r);
+    }
+    a->used = (int)used;
+    bigint_normalize(a);
+}
+
+static void get_ctx(blob_reader_t *r, montgomery_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(montgomery_ctx_t));
+    uint64_t ctx_flags = get_bytes_le(r, 4);
+    if (!(ctx_flags & KEYBLOB_CTX_ACTIVE)) return;
+    
+    uint64_t n_words = get_bytes_le(r, 4);
+    uint64_t r_words = get_bytes_le(r, 4);
+    if (r->error || n_words == 0 || n_words > MONTGOMERY_MAX_WORDS || r_words != n_words) {
+        r->error = 1;
+        return;
+    }
+    ctx->n_words = (int)n_words;
+    ctx->r_words = (int)r_words;
+    ctx->n_prime = get_word(r);
+    for (int i = 0; i < ctx->n_words; i++) ctx->n.words[i] = get_word(r);
+    for (int i = 0; i < ctx->n_words; i++) ctx->r_mod_n.words[i] = get_word(r);
+    for (int i = 0; i < ctx->n_words; i++) ctx->r_squared.words[i] = get_word(r);
+    for (int i = 0; i < ctx->n_words; i++) ctx->r_inv.words[i] = get_word(r);
+    ctx->has_r_inv = (ctx_flags & KEYBLOB_CTX_R_INV) ? 1 : 0;
+    ctx->is_active = !r->error;
+    montgomery_ctx_bind_kernels(ctx);
+}
+
+static uint64_t keyblob_checksum(const uint8_t *buf, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;  /* FNV-1a 64 offset basis */
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = (i >= KEYBLOB_CHECKSUM_OFFSET && i < KEYBLOB_CHECKSUM_OFFSET + 8) ? 0 : buf[i];
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/* ===================== CONTEXT VALIDATION ===================== */
+
+/**
+ * @brief Cheap consistency checks that replace recomputation on load
+ *
+ * The stored context must describe the stored modulus, n' must satisfy
+ * n * n' == -1 (mod 2^BIGINT_WORD_SIZE), every residue must be below n, and
+ * one REDC each ties them together: REDC(R^2) == R and REDC(R^(-1) * R^2) == 1.
+ */
+static int keyblob_validate_ctx(const montgomery_ctx_t *ctx, const bigint_t *modulus) {
+    if (!ctx->is_active) return 0;
+    
+    if (!montgomery_ctx_matches(ctx, modulus) || (ctx->n.words[0] & 1) == 0) {
+        return -1;
+    }
+    if ((bigint_word_t)(ctx->n.words[0] * ctx->n_prime) != BIGINT_WORD_MASK) {
+        return -1;
+    }
+    
+    const mont_residue_t *residues[3] = {&ctx->r_mod_n, &ctx->r_squared, &ctx->r_inv};
+    for (int k = 0; k < 3; k++) {
+        bigint_t value;
+        mont_residue_to_bigint(&value, residues[k], ctx);
+        if (bigint_compare(&value, modulus) >= 0) {
+            return -1;
+        }
+    }
+    
+    size_t bytes = (size_t)ctx->n_words * sizeof(bigint_word_t);
+    mont_residue_t one, check;
+    memset(&one, 0, sizeof(one));
+    one.words[0] = 1;
+    montgomery_mul_residue(&check, &ctx->r_squared, &one, ctx);
+    if (memcmp(check.words, ctx->r_mod_n.words, bytes) != 0) {
+        return -1;
+    }
+    if (ctx->has_r_inv) {
+        montgomery_mul_residue(&check, &ctx->r_inv, &ctx->r_squared, ctx);
+        if (memcmp(check.words, one.words, bytes) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief The checks rsa_4096_setup_crt() applies, against the stored Montgomery data
+ *
+ * A blob is only checksummed, so the CRT half must still prove it belongs to n:
+ * a wrong prime or coefficient would decrypt to garbage, and a faulty CRT half
+ * is exactly what leaks a factor. Contexts are validated before this runs.
+ */
+static int keyblob_validate_crt(const rsa_4096_key_t *key) {
+    bigint_t check, check_mod;
+    if (bigint_compare(&key->dp, &key->p) >= 0 || bigint_compare(&key->dq, &key->q) >= 0 ||
+        bigint_compare(&key->qinv, &key->p) >= 0 || bigint_compare(&key->qinv_mont, &key->p) >= 0) {
+        return -1;
+    }
+    
+    /* n = p * q */
+    if (bigint_mul(&check, &key->p, &key->q) != 0 || bigint_compare(&check, &key->n) != 0) {
+        return -1;
+    }
+    
+    /* qInv * q == 1 (mod p) */
+    if (bigint_mul(&check, &key->qinv, &key->q) != 0 ||
+        montgomery_reduce(&check_mod, &check, &key->p_ctx) != 0 || !bigint_is_one(&check_mod)) {
+        return -1;
+    }
+    
+    /* qinv_mont == qInv * R mod p */
+    if (montgomery_to_form(&check, &key->qinv, &key->p_ctx) != 0 || bigint_compare(&check, &key->qinv_mont) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/* ===================== SERIALIZE / DESERIALIZE ===================== */
+
+/**
+ * @brief Emit the whole blob through a writer (measuring only when w->buf is NULL)
+ */
+static void keyblob_write(blob_writer_t *w, const rsa_4096_key_t *key) {
+    uint32_t flags = (key->is_private ? KEYBLOB_FLAG_PRIVATE : 0) | (key->has_crt ? KEYBLOB_FLAG_CRT : 0);
+    
+    /* Header - total size and checksum are patched once the body is written */
+    for (int i = 0; i < 8; i++) {
+        put_bytes_le(w, (uint8_t)RSA_4096_KEYBLOB_MAGIC[i], 1);
+    }
+    put_bytes_le(w, RSA_4096_KEYBLOB_VERSION, 2);
+    put_bytes_le(w, BIGINT_WORD_SIZE, 2);
+    put_bytes_le(w, flags, 4);
+    put_bytes_le(w, 0, 4);
+    put_bytes_le(w, 0, 8);
+    
+    put_bigint(w, &key->n);
+    put_bigint(w, &key->exponent);
+    put_ctx(w, &key->mont_ctx);
+    
+    if (key->has_crt) {
+        put_bigint(w, &key->p);
+        put_bigint(w, &key->q);
+        put_bigint(w, &key->dp);
+        put_bigint(w, &key->dq);
+        put_bigint(w, &key->qinv);
+        put_bigint(w, &key->qinv_mont);
+        put_ctx(w, &key->p_ctx);
+        put_ctx(w, &key->q_ctx);
+    }
+}
+
+int rsa_4096_key_serialize(const rsa_4096_key_t *key, uint8_t *buf, size_t buf_size, size_t *written) {
+    if (key == NULL || written == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_key_serialize");
+    }
+    
+    /* Measure first so a short buffer is left untouched */
+    blob_writer_t measure = {NULL, 0, 0};
+    keyblob_write(&measure, key);
+    *written = measure.pos;
+    if (buf == NULL) {
+        return 0;  /* Size query */
+    }
+    if (measure.pos > buf_size) {
+        ERROR_RETURN(-2, "Key blob buffer too small: need %zu bytes, have %zu", measure.pos, buf_size);
+    }
+    
+    blob_writer_t w = {buf, buf_size, 0};
+    keyblob_write(&w, key);
+    
+    blob_writer_t patch = {buf, buf_size, 16};
+    put_bytes_le(&patch, (uint64_t)w.pos, 4);
+    put_bytes_le(&patch, keyblob_checksum(buf, w.pos), 8);
+    return 0;
+}
+
+int rsa_4096_key_deserialize(rsa_4096_key_t *key, const uint8_t *buf, size_t buf_size) {
+    if (key == NULL || buf == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_key_deserialize");
+    }
+    
+    rsa_4096_init(key);
+    
+    if (buf_size < KEYBLOB_HEADER_SIZE || memcmp(buf, RSA_4096_KEYBLOB_MAGIC, 8) != 0) {
+        ERROR_RETURN(-2, "Not an RSA-4096 key blob");
+    }
+    
+    blob_reader_t r = {buf, buf_size, 8, 0};
+    uint64_t version = get_bytes_le(&r, 2);
+    uint64_t limb_bits = get_bytes_le(&r, 2);
+    uint64_t flags = get_bytes_le(&r, 4);
+    uint64_t total_size = get_bytes_le(&r, 4);
+    uint64_t checksum = get_bytes_le(&r, 8);
+    
+    if (version != RSA_4096_KEYBLOB_VERSION) {
+        ERROR_RETURN(-3, "Unsupported key blob version %u", (unsigned)version);
+    }
+    /* n' and the residues are limb-width specific - regenerate the blob for this build */
+    if (limb_bits != BIGINT_WORD_SIZE) {
+        ERROR_RETURN(-4, "Key blob built for %u-bit limbs, this build uses %d-bit limbs",
+                     (unsigned)limb_bits, BIGINT_WORD_SIZE);
+    }
+    if (total_size != buf_size) {
+        ERROR_RETURN(-5, "Key blob size mismatch: header %u, buffer %zu", (unsigned)total_size, buf_size);
+    }
+    if (checksum != keyblob_checksum(buf, buf_size)) {
+        ERROR_RETURN(-6, "Key blob checksum mismatch");
+    }
+    
+    key->is_private = (flags & KEYBLOB_FLAG_PRIVATE) ? 1 : 0;
+    get_bigint(&r, &key->n);
+    get_bigint(&r, &key->exponent);
+    get_ctx(&r, &key->mont_ctx);
+    
+    if (flags & KEYBLOB_FLAG_CRT) {
+        get_bigint(&r, &key->p);
+        get_bigint(&r, &key->q);
+        get_bigint(&r, &key->dp);
+        get_bigint(&r, &key->dq);
+        get_bigint(&r, &key->qinv);
+        get_bigint(&r, &key->qinv_mont);
+        get_ctx(&r, &key->p_ctx);
+        get_ctx(&r, &key->q_ctx);
+    }
+    
+    int valid = !r.error && r.pos == buf_size &&
+                !bigint_is_zero(&key->n) && !bigint_is_zero(&key->exponent) &&
+                keyblob_validate_ctx(&key->mont_ctx, &key->n) == 0;
+    
+    if (valid && (flags & KEYBLOB_FLAG_CRT)) {
+        valid = key->is_private && key->p_ctx.is_active && key->q_ctx.is_active &&
+                keyblob_validate_ctx(&key->p_ctx, &key->p) == 0 &&
+                keyblob_validate_ctx(&key->q_ctx, &key->q) == 0 &&
+                keyblob_validate_crt(key) == 0;
+        key->has_crt = valid;
+    }
+    
+    if (!valid) {
+        rsa_4096_free(key);
+        ERROR_RETURN(-7, "Key blob contents failed validation");
+    }
+    rsa_4096_key_classify_exponent(key);
+    
+    CHECKPOINT(LOG_INFO, "Key blob loaded: %d-bit modulus, %s key%s", bigint_bit_length(&key->n),
+              key->is_private ? "private" : "public", key->has_crt ? " with CRT" : "");
+    return 0;
+}
+
+/* ===================== FILE HELPERS ===================== */
+
+int rsa_4096_key_save_blob(const rsa_4096_key_t *key, const char *path) {
+    if (key == NULL || path == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_key_save_blob");
+    }
+    
+    size_t size = 0;
+    int ret = rsa_4096_key_serialize(key, NULL, 0, &size);
+    if (ret != 0) return ret;
+    
+    uint8_t *buf = malloc(size);
+    if (buf == NULL) {
+        ERROR_RETURN(-2, "Out of memory for %zu-byte key blob", size);
+    }
+    
+    ret = rsa_4096_key_serialize(key, buf, size, &size);
+    if (ret == 0) {
+        /* Owner-only: a private blob holds d and the primes. The create mode only applies to a new
+         * file, so an existing one is narrowed as well */
+        int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        FILE *f = NULL;
+        if (fd >= 0 && fchmod(fd, 0600) == 0) {
+            f = fdopen(fd, "wb");
+        }
+        if (f == NULL) {
+            if (fd >= 0) close(fd);
+            ret = -3;
+        } else {
+            if (fwrite(buf, 1, size, f) != size) ret = -4;
+            if (fclose(f) != 0) ret = -4;
+        }
+    }
+    
+    keyblob_wipe(buf, 0, size);
+    free(buf);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to write key blob to %s", path);
+    }
+    return 0;
+}
+
+int rsa_4096_key_load_blob(rsa_4096_key_t *key, const char *path) {
+    if (key == NULL || path == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_key_load_blob");
+    }
+    
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        ERROR_RETURN(-2, "Cannot open key blob %s", path);
+    }
+    
+    /* Largest possible blob: header + 2 * (bigint + ctx) + 6 CRT bigints - bounded, so read at most that */
+    size_t max_size = KEYBLOB_HEADER_SIZE + 12 * (4 + sizeof(bigint_t)) + 3 * (16 + 4 * sizeof(mont_residue_t));
+    uint8_t *buf = malloc(max_size);
+    if (buf == NULL) {
+        fclose(f);
+        ERROR_RETURN(-3, "Out of memory reading key blob");
+    }
+    
+    size_t size = fread(buf, 1, max_size, f);
+    fclose(f);
+    
+    int ret = rsa_4096_key_deserialize(key, buf, size);
+    keyblob_wipe(buf, 0, max_size);
+    free(buf);
+    return ret;
+}
@@ -0,0 +1,571 @@
+/**
+ * @file rsa_4096_keygen.c
+ * @brief RSA key generation - sieved prime search on a worker pool, CRT output
+ *
+ * Each worker draws a random odd start with the top two bits set (so p * q has
+ * exactly the requested size), reduces it once modulo a table of small primes
+ * and then walks c, c + 2, c + 4, ... through a sieve window built from those
+ * residues. Survivors get a base-2 Miller-Rabin filter and then the random-base
+ * rounds; a^d is the Montgomery exponentiation, the squaring chain after it
+ * stays on Montgomery-form residues and compares against R mod n and
+ * n - R mod n, so no candidate is ever converted back.
+ *
+ * All workers search at once. The first two acceptable primes end the search:
+ * every worker polls the shared state between candidates and between rounds,
+ * so the losers stop within one Miller-Rabin round.
+ *
+ * d = e^(-1) mod lcm(p - 1, q - 1) as in FIPS 186-4. The keys are built through
+ * the binary loaders, so they pass the same checks as any imported key.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "rsa_4096.h"
+
+#define KEYGEN_SIEVE_PRIMES   2048              /* Odd primes 3 .. 17881 */
+#define KEYGEN_SIEVE_LIMIT    17882
+#define KEYGEN_SIEVE_SPAN     4096              /* Odd offsets per window: c + 2k, k < span */
+#define KEYGEN_MAX_ATTEMPTS   8                 /* Whole-key retries (d too small, |p - q| too close) */
+#define KEYGEN_WORKER_STACK_SIZE (1u * 1024u * 1024u)
+
+static void *(*volatile keygen_wipe)(void *, int, size_t) = memset;
+
+/* ===================== RANDOM BYTES ===================== */
+
+int rsa_4096_random_bytes(uint8_t *buf, size_t len) {
+    if (buf == NULL && len > 0) {
+        ERROR_RETURN(-1, "NULL buffer in rsa_4096_random_bytes");
+    }
+    
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0) {
+        ERROR_RETURN(-2, "Cannot open /dev/urandom");
+    }
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = read(fd, buf + got, len - got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            close(fd);
+            ERROR_RETURN(-2, "Short read from /dev/urandom");
+        }
+        got += (size_t)r;
+    }
+    close(fd);
+    return 0;
+}
+
+/* ===================== SMALL-PRIME HELPERS ===================== */
+
+/**
+ * @brief First KEYGEN_SIEVE_PRIMES odd primes by a plain Eratosthenes sieve
+ */
+static void keygen_small_primes(uint32_t *primes) {
+    uint8_t composite[KEYGEN_SIEVE_LIMIT] = {0};
+    int count = 0;
+    for (uint32_t i = 3; i < KEYGEN_SIEVE_LIMIT && count < KEYGEN_SIEVE_PRIMES; i += 2) {
+        if (composite[i]) continue;
+        primes[count++] = i;
+        for (uint32_t j = i * i; j < KEYGEN_SIEVE_LIMIT; j += 2 * i) {
+            composite[j] = 1;
+        }
+    }
+}
+
+/**
+ * @brief a mod m for m < 2^32, 32 bits at a time so both limb widths share it
+ */
+static uint32_t keygen_mod_small(const bigint_t *a, uint32_t m) {
+    uint64_t r = 0;
+    for (int i = a->used - 1; i >= 0; i--) {
+#if BIGINT_LIMB_BITS == 64
+        r = ((r << 32) | (a->words[i] >> 32)) % m;
+#endif
+        r = ((r << 32) | (uint32_t)a->words[i]) % m;
+    }
+    return (uint32_t)r;
+}
+
+static uint32_t keygen_gcd_small(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * @brief a^(-1) mod m for gcd(a, m) = 1, extended Euclid on machine words
+ */
+static uint32_t keygen_inverse_small(uint32_t a, uint32_t m) {
+    int64_t t = 0, new_t = 1, r = m, new_r = a % m;
+    while (new_r != 0) {
+        int64_t q = r / new_r, tmp;
+        tmp = t - q * new_t; t = new_t; new_t = tmp;
+        tmp = r - q * new_r; r = new_r; new_r = tmp;
+    }
+    return (uint32_t)(t < 0 ? t + m : t);
+}
+
+/* ===================== SHARED SEARCH STATE ===================== */
+
+typedef struct {
+    pthread_mutex_t lock;
+    const uint32_t *primes;         /* KEYGEN_SIEVE_PRIMES small primes, read-only */
+    int prime_bits;                 /* Size of p and q */
+    uint32_t e;
+    int rounds;                     /* Random-base Miller-Rabin rounds after the base-2 filter */
+    bigint_t found[2];
+    int num_found;
+    int error;                      /* First worker error, stops everyone */
+} keygen_search_t;
+
+typedef struct {
+    keygen_search_t *search;
+    int id;
+    size_t candidates;              /* Sieve survivors tested */
+    uint32_t residues[KEYGEN_SIEVE_PRIMES];
+    uint8_t sieve[KEYGEN_SIEVE_SPAN];
+    bigint_t start, cand, minus_one, odd_part, base, y, scratch;
+    montgomery_ctx_t ctx;
+    mont_residue_t acc, one_mont, minus_one_mont;
+    rsa_4096_workspace_t ws;
+} keygen_worker_t;
+
+static int keygen_stopped(keygen_search_t *s) {
+    pthread_mutex_lock(&s->lock);
+    int stop = s->num_found >= 2 || s->error != 0;
+    pthread_mutex_unlock(&s->lock);
+    return stop;
+}
+
+/**
+ * @brief Offer a prime; the second one is only taken if |p - q| > 2^(prime_bits - 100)
+ */
+static void keygen_submit(keygen_search_t *s, const bigint_t *prime) {
+    pthread_mutex_lock(&s->lock);
+    if (s->num_found == 0) {
+        bigint_copy(&s->found[0], prime);
+        s->num_found = 1;
+    } else if (s->num_found == 1) {
+        bigint_t diff;
+        const bigint_t *p = &s->found[0];
+        int cmp = bigint_compare(prime, p);
+        if (cmp > 0) bigint_sub(&diff, prime, p);
+        else bigint_sub(&diff, p, prime);
+        if (cmp != 0 && bigint_bit_length(&diff) > s->prime_bits - 100) {
+            bigint_copy(&s->found[1], prime);
+            s->num_found = 2;
+        }
+        keygen_wipe(&diff, 0, sizeof(diff));
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+static void keygen_fail(keygen_search_t *s, int error) {
+    pthread_mutex_lock(&s->lock);
+    if (s->error == 0) s->error = error;
+    pthread_mutex_unlock(&s->lock);
+}
+
+/* ===================== PRIMALITY TESTING ===================== */
+
+/**
+ * @brief Random start: prime_bits bits, the top two and the lowest set
+ */
+static int keygen_random_start(keygen_worker_t *w) {
+    int bits = w->search->prime_bits;
+    size_t len = (size_t)(bits + 7) / 8;
+    uint8_t bytes[RSA_4096_KEYGEN_MAX_BITS / 16];
+    int ret = rsa_4096_random_bytes(bytes, len);
+    if (ret == 0) {
+        int top = (bits - 1) % 8;               /* Bit index of the MSB within bytes[0] */
+        bytes[0] &= (uint8_t)((2u << top) - 1);
+        bytes[0] |= (uint8_t)(1u << top);
+        if (top > 0) bytes[0] |= (uint8_t)(1u << (top - 1));
+        else bytes[1] |= 0x80;
+        bytes[len - 1] |= 1;
+        ret = bigint_from_binary(&w->start, bytes, len);
+    }
+    keygen_wipe(bytes, 0, sizeof(bytes));
+    return ret;
+}
+
+/**
+ * @brief Uniform base in [2, n - 2] from prime_bits + 64 random bits mod (n - 3)
+ */
+static int keygen_random_base(keygen_worker_t *w) {
+    uint8_t bytes[RSA_4096_KEYGEN_MAX_BITS / 16 + 8];
+    size_t len = (size_t)(w->search->prime_bits + 7) / 8 + 8;
+    bigint_t three;
+    bigint_set_u32(&three, 3);
+    int ret = rsa_4096_random_bytes(bytes, len);
+    if (ret == 0) ret = bigint_from_binary(&w->scratch, bytes, len);
+    if (ret == 0) ret = bigint_sub(&w->y, &w->cand, &three);
+    if (ret == 0) ret = bigint_mod(&w->base, &w->scratch, &w->y);
+    if (ret == 0) ret = bigint_add_word(&w->base, &w->base, 2);
+    keygen_wipe(bytes, 0, sizeof(bytes));
+    return ret;
+}
+
+/**
+ * @brief One Miller-Rabin round with base w->base: 1 probably prime, 0 composite, < 0 error
+ *
+ * The squaring chain runs on Montgomery-form residues: y == 1 and y == n - 1
+ * become comparisons against R mod n and n - R mod n.
+ */
+static int keygen_mr_round(keygen_worker_t *w, int s) {
+    int ret = montgomery_exp_ws(&w->y, &w->base, &w->odd_part, &w->ctx, &w->ws);
+    if (ret != 0) return ret;
+    if (bigint_is_one(&w->y) || bigint_compare(&w->y, &w->minus_one) == 0) {
+        return 1;
+    }
+    
+    ret = montgomery_to_form(&w->scratch, &w->y, &w->ctx);
+    if (ret == 0) ret = mont_residue_from_bigint(&w->acc, &w->scratch, &w->ctx);
+    if (ret != 0) return ret;
+    
+    size_t bytes = (size_t)w->ctx.n_words * sizeof(bigint_word_t);
+    for (int i = 1; i < s; i++) {
+        ret = montgomery_square_residue(&w->acc, &w->acc, &w->ctx);
+        if (ret != 0) return ret;
+        if (memcmp(w->acc.words, w->minus_one_mont.words, bytes) == 0) {
+            return 1;
+        }
+        if (memcmp(w->acc.words, w->one_mont.words, bytes) == 0) {
+            return 0;                            /* Non-trivial square root of 1 */
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Full test of a sieve survivor: 1 prime, 0 composite or cancelled, < 0 error
+ */
+static int keygen_is_prime(keygen_worker_t *w) {
+    montgomery_ctx_free(&w->ctx);
+    int ret = montgomery_ctx_init(&w->ctx, &w->cand);
+    if (ret != 0 || !w->ctx.is_active) {
+        return ret != 0 ? ret : -3;
+    }
+    
+    /* n - 1 = 2^s * d with d odd */
+    bigint_t one;
+    bigint_set_u32(&one, 1);
+    ret = bigint_sub(&w->minus_one, &w->cand, &one);
+    int s = 1;
+    while (ret == 0 && !bigint_get_bit(&w->minus_one, s)) s++;
+    if (ret == 0) ret = bigint_shift_right(&w->odd_part, &w->minus_one, s);
+    
+    /* Montgomery forms of +1 and -1: R mod n and n - R mod n */
+    w->one_mont = w->ctx.r_mod_n;
+    if (ret == 0) {
+        mont_residue_to_bigint(&w->scratch, &w->ctx.r_mod_n, &w->ctx);
+        ret = bigint_sub(&w->y, &w->cand, &w->scratch);
+    }
+    if (ret == 0) ret = mont_residue_from_bigint(&w->minus_one_mont, &w->y, &w->ctx);
+    if (ret != 0) return ret;
+    
+    /* Base 2 throws out nearly every composite the sieve let through */
+    bigint_set_u32(&w->base, 2);
+    ret = keygen_mr_round(w, s);
+    for (int round = 0; ret == 1 && round < w->search->rounds; round++) {
+        if (keygen_stopped(w->search)) {
+            return 0;
+        }
+        ret = keygen_random_base(w);
+        if (ret == 0) ret = keygen_mr_round(w, s);
+    }
+    return ret;
+}
+
+/* ===================== CANDIDATE SEARCH ===================== */
+
+/**
+ * @brief Walk random starts through sieve windows until a prime turns up or the search ends
+ */
+static int keygen_find_prime(keygen_worker_t *w) {
+    keygen_search_t *s = w->search;
+    
+    while (!keygen_stopped(s)) {
+        int ret = keygen_random_start(w);
+        if (ret != 0) return ret;
+        for (int i = 0; i < KEYGEN_SIEVE_PRIMES; i++) {
+            w->residues[i] = keygen_mod_small(&w->start, s->primes[i]);
+        }
+    
+        /* Windows until the walk would carry out of prime_bits; then draw a new start */
+        while (bigint_bit_length(&w->start) == s->prime_bits) {
+            memset(w->sieve, 0, sizeof(w->sieve));
+            for (int i = 0; i < KEYGEN_SIEVE_PRIMES; i++) {
+                /* start + 2k == 0 (mod p)  <=>  k == -r * 2^(-1) (mod p) */
+                uint32_t p = s->primes[i], r = w->residues[i];
+                uint32_t k = (uint32_t)(((uint64_t)(r == 0 ? 0 : p - r) * ((p + 1) / 2)) % p);
+                for (; k < KEYGEN_SIEVE_SPAN; k += p) {
+                    w->sieve[k] = 1;
+                }
+            }
+    
+            for (uint32_t k = 0; k < KEYGEN_SIEVE_SPAN; k++) {
+                if (w->sieve[k]) continue;
+                ret = bigint_add_word(&w->cand, &w->start, (bigint_word_t)(2 * k));
+                if (ret != 0) return ret;
+    
+                /* gcd(e, p - 1) = 1, or e has no inverse mod lcm(p - 1, q - 1) */
+                uint32_t pm1 = keygen_mod_small(&w->cand, s->e);
+                pm1 = pm1 == 0 ? s->e - 1 : pm1 - 1;
+                if (keygen_gcd_small(pm1, s->e) != 1) continue;
+    
+                if (keygen_stopped(s)) return 0;
+                w->candidates++;
+                ret = keygen_is_prime(w);
+                if (ret < 0) return ret;
+                if (ret == 1) {
+                    keygen_submit(s, &w->cand);
+                    return 0;
+                }
+            }
+    
+            ret = bigint_add_word(&w->start, &w->start, (bigint_word_t)(2 * KEYGEN_SIEVE_SPAN));
+            if (ret != 0) return ret;
+            for (int i = 0; i < KEYGEN_SIEVE_PRIMES; i++) {
+                w->residues[i] = (uint32_t)((w->residues[i] + 2u * KEYGEN_SIEVE_SPAN) % s->primes[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+static void *keygen_worker_main(void *arg) {
+    keygen_worker_t *w = (keygen_worker_t *)arg;
+    while (!keygen_stopped(w->search)) {
+        int ret = keygen_find_prime(w);
+        if (ret != 0) {
+            keygen_fail(w->search, ret);
+        }
+    }
+    TRACE(LOG_DEBUG, "[KEYGEN] worker %d: %zu candidates tested", w->id, w->candidates);
+    return NULL;
+}
+
+/**
+ * @brief Run the worker pool until two primes are found; worker 0 is the caller's thread
+ */
+static int keygen_search_primes(keygen_search_t *search, keygen_worker_t *workers, int threads) {
+    pthread_t tids[RSA_4096_KEYGEN_MAX_THREADS];
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, KEYGEN_WORKER_STACK_SIZE);
+    
+    int started = 1;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&tids[t], &attr, keygen_worker_main, &workers[t]) != 0) {
+            CHECKPOINT(LOG_INFO, "Keygen worker %d could not be started, continuing with %d", t, started);
+            break;
+        }
+        started++;
+    }
+    pthread_attr_destroy(&attr);
+    
+    keygen_worker_main(&workers[0]);
+    for (int t = 1; t < started; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    return search->error;
+}
+
+/* ===================== KEY ASSEMBLY ===================== */
+
+typedef struct {
+    bigint_t p, q, n, pm1, qm1, phi, g, lambda, d, dp, dq, qinv, t0, t1;
+    montgomery_ctx_t p_ctx;
+    uint8_t bytes[7][RSA_4096_KEYGEN_MAX_BITS / 8];
+    size_t len[7];
+} keygen_material_t;
+
+/**
+ * @brief gcd by Euclid on bigint_mod; a and b are consumed
+ */
+static int keygen_gcd(bigint_t *g, bigint_t *a, bigint_t *b, bigint_t *tmp) {
+    while (!bigint_is_zero(b)) {
+        int ret = bigint_mod(tmp, a, b);
+        if (ret != 0) return ret;
+        bigint_copy(a, b);
+        bigint_copy(b, tmp);
+    }
+    bigint_copy(g, a);
+    return 0;
+}
+
+/**
+ * @brief n, d mod lcm(p-1, q-1), dP, dQ, qInv from p > q; 1 if d is too small (retry), < 0 error
+ */
+static int keygen_derive(keygen_material_t *m, int bits, uint32_t e) {
+    int ret = bigint_mul(&m->n, &m->p, &m->q);
+    if (ret == 0 && bigint_bit_length(&m->n) != bits) ret = -5;
+    
+    bigint_t one;
+    bigint_set_u32(&one, 1);
+    if (ret == 0) ret = bigint_sub(&m->pm1, &m->p, &one);
+    if (ret == 0) ret = bigint_sub(&m->qm1, &m->q, &one);
+    if (ret == 0) ret = bigint_mul(&m->phi, &m->pm1, &m->qm1);
+    if (ret == 0) {
+        bigint_copy(&m->t0, &m->pm1);
+        bigint_copy(&m->t1, &m->qm1);
+        ret = keygen_gcd(&m->g, &m->t0, &m->t1, &m->lambda);
+    }
+    if (ret == 0) ret = bigint_div(&m->lambda, &m->t0, &m->phi, &m->g);
+    if (ret != 0) return ret;
+    
+    /* e * d = 1 + k * lambda with k = -lambda^(-1) mod e, so d = (1 + k * lambda) / e exactly */
+    uint32_t u = keygen_inverse_small(keygen_mod_small(&m->lambda, e), e);
+    uint32_t k = u == 0 ? 0 : e - u;
+    bigint_t e_big;
+    bigint_set_u32(&e_big, e);
+    ret = bigint_mul_add_word(&m->t0, &m->lambda, (bigint_word_t)k, 1);
+    if (ret == 0) ret = bigint_div(&m->d, &m->t1, &m->t0, &e_big);
+    if (ret == 0 && !bigint_is_zero(&m->t1)) ret = -6;
+    if (ret != 0) return ret;
+    
+    /* FIPS 186-4 B.3.1: d > 2^(bits/2), almost always true - otherwise draw new primes */
+    if (bigint_bit_length(&m->d) <= bits / 2) {
+        return 1;
+    }
+    
+    ret = bigint_mod(&m->dp, &m->d, &m->pm1);
+    if (ret == 0) ret = bigint_mod(&m->dq, &m->d, &m->qm1);
+    
+    /* qInv by Fermat: q^(p-2) mod p on the Montgomery layer */
+    if (ret == 0) ret = montgomery_ctx_init(&m->p_ctx, &m->p);
+    if (ret == 0) ret = bigint_sub(&m->t0, &m->pm1, &one);
+    if (ret == 0) ret = montgomery_exp(&m->qinv, &m->q, &m->t0, &m->p_ctx);
+    montgomery_ctx_free(&m->p_ctx);
+    return ret;
+}
+
+/**
+ * @brief Hand the material to the binary loaders so the keys get the usual validation
+ */
+static int keygen_load(keygen_material_t *m, rsa_4096_key_t *pub_key, rsa_4096_key_t *priv_key, uint32_t e) {
+    const bigint_t *parts[7] = {&m->n, &m->d, &m->p, &m->q, &m->dp, &m->dq, &m->qinv};
+    for (int i = 0; i < 7; i++) {
+        int ret = bigint_to_binary(parts[i], m->bytes[i], sizeof(m->bytes[i]), &m->len[i]);
+        if (ret != 0) return ret;
+    }
+    
+    uint8_t e_bytes[4] = {(uint8_t)(e >> 24), (uint8_t)(e >> 16), (uint8_t)(e >> 8), (uint8_t)e};
+    int ret = 0;
+    if (pub_key != NULL) {
+        ret = rsa_4096_load_key_binary(pub_key, m->bytes[0], m->len[0], e_bytes, sizeof(e_bytes), 0);
+    }
+    if (ret == 0 && priv_key != NULL) {
+        ret = rsa_4096_load_key_binary(priv_key, m->bytes[0], m->len[0], m->bytes[1], m->len[1], 1);
+        if (ret == 0) {
+            ret = rsa_4096_load_key_crt_binary(priv_key, m->bytes[2], m->len[2], m->bytes[3], m->len[3],
+                                               m->bytes[4], m->len[4], m->bytes[5], m->len[5],
+                                               m->bytes[6], m->len[6]);
+        }
+    }
+    return ret;
+}
+
+/* ===================== PUBLIC ENTRY POINT ===================== */
+
+static int keygen_resolve_threads(int num_threads) {
+    if (num_threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = online > 0 ? (int)online : 1;
+    }
+    return num_threads > RSA_4096_KEYGEN_MAX_THREADS ? RSA_4096_KEYGEN_MAX_THREADS : num_threads;
+}
+
+/**
+ * @brief Miller-Rabin rounds after the base-2 filter, per FIPS 186-4 Table C.2 (2^-100 error)
+ */
+static int keygen_mr_rounds(int prime_bits) {
+    return prime_bits >= 1536 ? 4 : prime_bits >= 1024 ? 5 : 7;
+}
+
+int rsa_4096_generate_key(rsa_4096_key_t *pub_key, rsa_4096_key_t *priv_key, int bits, uint32_t e,
+                          int num_threads) {
+    if (pub_key == NULL && priv_key == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_generate_key");
+    }
+    if (bits < RSA_4096_KEYGEN_MIN_BITS || bits > RSA_4096_KEYGEN_MAX_BITS || bits % 2 != 0) {
+        ERROR_RETURN(-2, "Unsupported key size %d (even, %d..%d bits)", bits,
+                     RSA_4096_KEYGEN_MIN_BITS, RSA_4096_KEYGEN_MAX_BITS);
+    }
+    if (e < 3 || (e & 1) == 0) {
+        ERROR_RETURN(-2, "Public exponent %u must be odd and at least 3", e);
+    }
+    
+    uint32_t primes[KEYGEN_SIEVE_PRIMES];
+    keygen_small_primes(primes);
+    
+    int threads = keygen_resolve_threads(num_threads);
+    keygen_worker_t *workers = calloc((size_t)threads, sizeof(keygen_worker_t));
+    keygen_search_t *search = calloc(1, sizeof(keygen_search_t));
+    keygen_material_t *m = calloc(1, sizeof(keygen_material_t));
+    if (workers == NULL || search == NULL || m == NULL) {
+        free(workers);
+        free(search);
+        free(m);
+        ERROR_RETURN(-3, "Out of memory for key generation");
+    }
+    pthread_mutex_init(&search->lock, NULL);
+    search->primes = primes;
+    search->prime_bits = bits / 2;
+    search->e = e;
+    search->rounds = keygen_mr_rounds(bits / 2);
+    for (int t = 0; t < threads; t++) {
+        workers[t].search = search;
+        workers[t].id = t;
+    }
+    CHECKPOINT(LOG_INFO, "Generating %d-bit RSA key (e = %u) on %d threads", bits, e, threads);
+    
+    int ret = 1;
+    for (int attempt = 0; attempt < KEYGEN_MAX_ATTEMPTS && ret == 1; attempt++) {
+        search->num_found = 0;
+        ret = keygen_search_primes(search, workers, threads);
+        if (ret != 0) break;
+    
+        /* p > q, the orientation qInv = q^(-1) mod p expects */
+        int swap = bigint_compare(&search->found[0], &search->found[1]) < 0;
+        bigint_copy(&m->p, &search->found[swap ? 1 : 0]);
+        bigint_copy(&m->q, &search->found[swap ? 0 : 1]);
+        ret = keygen_derive(m, bits, e);
+    }
+    if (ret == 1) ret = -4;
+    if (ret == 0) ret = keygen_load(m, pub_key, priv_key, e);
+    
+    size_t tested = 0;
+    for (int t = 0; t < threads; t++) {
+        tested += workers[t].candidates;
+        montgomery_ctx_free(&workers[t].ctx);
+    }
+    pthread_mutex_destroy(&search->lock);
+    keygen_wipe(workers, 0, (size_t)threads * sizeof(keygen_worker_t));
+    keygen_wipe(search, 0, sizeof(keygen_search_t));
+    keygen_wipe(m, 0, sizeof(keygen_material_t));
+    free(workers);
+    free(search);
+    free(m);
+    
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Key generation failed");
+    }
+    CHECKPOINT(LOG_INFO, "Generated %d-bit RSA key after %zu Miller-Rabin candidates", bits, tested);
+    return 0;
+}
@@ -12,33 +12,64 @@
 #include <string.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <stdarg.h>
 #include "rsa_4096.h"
 
+/* ===================== TRACE SINK ===================== */
+
+static rsa_4096_trace_sink_t trace_sink = NULL;
+static void *trace_sink_user = NULL;
+
+void rsa_4096_trace_set_sink(rsa_4096_trace_sink_t sink, void *user) {
+    trace_sink = sink;
+    trace_sink_user = user;
+}
+
+void rsa_4096_trace_emit(int level, const char *func, int line, const char *fmt, ...) {
+    char message[1024];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(message, sizeof(message), fmt, args);
+    va_end(args);
+    
+    if (trace_sink != NULL) {
+        trace_sink(level, func, line, message, trace_sink_user);
+        return;
+    }
+    
+    /* Default sink: stdout, flushed only for errors so traces stay cheap */
+    fputs(message, stdout);
+    fputc('\n', stdout);
+    if (level >= LOG_ERROR) {
+        fflush(stdout);
+    }
+}
+
 /* ===================== DEBUG UTILITIES ===================== */
 
 void debug_print_bigint(const char *name, const bigint_t *a) {
-    if (LOG_LEVEL > LOG_DEBUG) return;
+    if (!TRACE_ENABLED(LOG_DEBUG)) return;
     
-    printf("[DEBUG] %s: ", name);
+    char digits[4 * 2 * BIGINT_WORD_BYTES + 1];
     if (a->used == 0) {
-        printf("0");
+        TRACE(LOG_DEBUG, "[DEBUG] %s: 0", name);
     } else if (a->used <= 4) {
-        printf("0x");
+        int pos = 0;
         for (int i = a->used - 1; i >= 0; i--) {
-            printf("%08x", a->words[i]);
+            pos += snprintf(digits + pos, sizeof(digits) - pos, "%08" PRIxWORD, a->words[i]);
         }
+        TRACE(LOG_DEBUG, "[DEBUG] %s: 0x%s", name, digits);
     } else {
-        printf("0x%08x...%08x (%d words, %d bits)", 
-               a->words[a->used-1], a->words[0], a->used, bigint_bit_length(a));
+        TRACE(LOG_DEBUG, "[DEBUG] %s: 0x%08" PRIxWORD "...%08" PRIxWORD " (%d words, %d bits)", 
+              name, a->words[a->used-1], a->words[0], a->used, bigint_bit_length(a));
     }
-    printf("\n");
 }
 
 void debug_verify_invariant(const char *step, const bigint_t *value, const bigint_t *modulus) {
-    if (LOG_LEVEL > LOG_DEBUG) return;
+    if (!TRACE_ENABLED(LOG_DEBUG)) return;
     
     if (bigint_compare(value, modulus) >= 0) {
-        printf("[DEBUG WARNING] %s: value >= modulus!\n", step);
+        TRACE(LOG_DEBUG, "[DEBUG WARNING] %s: value >= modulus!", step);
         debug_print_bigint("value", value);
         debug_print_bigint("modulus", modulus);
     }
@@ -47,95 +78,82 @@ void debug_verify_invariant(const char *step, const bigint_t *value, const bigin
 /* ===================== MONTGOMERY WORD INVERSE CALCULATION ===================== */
 
 /**
- * @brief Compute n^(-1) mod 2^32 using Newton's method
+ * @brief Compute n^(-1) mod 2^BIGINT_WORD_SIZE using Newton's method
  */
-static uint32_t compute_word_inverse(uint32_t n) {
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] Computing word inverse of 0x%08x\n", n);
-    }
+static bigint_word_t compute_word_inverse(bigint_word_t n) {
+    TRACE(LOG_DEBUG, "[DEBUG] Computing word inverse of 0x%08" PRIxWORD, n);
     
     if ((n & 1) == 0) {
-        printf("[DEBUG ERROR] Word is even, no inverse exists\n");
+        TRACE(LOG_ERROR, "[DEBUG ERROR] Word is even, no inverse exists");
         return 0;
     }
     
-    /* Newton's method: x_{i+1} = x_i * (2 - n * x_i) mod 2^32 */
-    uint32_t x = n;  /* Initial approximation */
+    /* Newton's method: x_{i+1} = x_i * (2 - n * x_i) mod 2^BIGINT_WORD_SIZE */
+    bigint_word_t x = n;  /* Initial approximation */
     
     /* Newton iterations - converges quadratically */
     for (int i = 0; i < 5; i++) {
-        uint32_t nx = n * x;
-        x = x * (2 - nx);  /* All arithmetic mod 2^32 automatically */
-        if (LOG_LEVEL <= LOG_DEBUG) {
-            printf("[DEBUG] Iteration %d: x = 0x%08x\n", i + 1, x);
-        }
+        bigint_word_t nx = n * x;
+        x = x * (2 - nx);  /* All arithmetic mod 2^BIGINT_WORD_SIZE automatically */
+        TRACE(LOG_DEBUG, "[DEBUG] Iteration %d: x = 0x%08" PRIxWORD, i + 1, x);
     }
     
-    /* Verify: n * x ≡ 1 (mod 2^32) */
-    uint32_t verify = n * x;
+    /* Verify: n * x ≡ 1 (mod 2^BIGINT_WORD_SIZE) */
+    bigint_word_t verify = n * x;
     if (verify != 1) {
-        printf("[DEBUG ERROR] Inverse verification failed: 0x%08x * 0x%08x = 0x%08x (should be 1)\n", 
+        TRACE(LOG_ERROR, "[DEBUG ERROR] Inverse verification failed: 0x%08" PRIxWORD " * 0x%08" PRIxWORD " = 0x%08" PRIxWORD " (should be 1)", 
                n, x, verify);
         return 0;
     }
     
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] ✓ Word inverse: 0x%08x^(-1) = 0x%08x (mod 2^32)\n", n, x);
-    }
+    TRACE(LOG_DEBUG, "[DEBUG] ✓ Word inverse: 0x%08" PRIxWORD "^(-1) = 0x%08" PRIxWORD " (mod 2^BIGINT_WORD_SIZE)", n, x);
     return x;
 }
 
 /**
- * @brief Compute n' = -n^(-1) mod 2^32 for Montgomery REDC
+ * @brief Compute n' = -n^(-1) mod 2^BIGINT_WORD_SIZE for Montgomery REDC
  */
-static uint32_t compute_montgomery_nprime(uint32_t n) {
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] Computing Montgomery n' for 0x%08x\n", n);
-    }
+static bigint_word_t compute_montgomery_nprime(bigint_word_t n) {
+    TRACE(LOG_DEBUG, "[DEBUG] Computing Montgomery n' for 0x%08" PRIxWORD, n);
     
-    /* Step 1: Compute n^(-1) mod 2^32 */
-    uint32_t n_inv = compute_word_inverse(n);
+    /* Step 1: Compute n^(-1) mod 2^BIGINT_WORD_SIZE */
+    bigint_word_t n_inv = compute_word_inverse(n);
     if (n_inv == 0) {
-        printf("[DEBUG ERROR] Failed to compute n^(-1)\n");
+        TRACE(LOG_ERROR, "[DEBUG ERROR] Failed to compute n^(-1)");
         return 0;
     }
     
-    /* Step 2: Compute n' = -n^(-1) mod 2^32 */
+    /* Step 2: Compute n' = -n^(-1) mod 2^BIGINT_WORD_SIZE */
     /* In two's complement: -x = (~x) + 1 */
-    uint32_t n_prime = (~n_inv) + 1;
+    bigint_word_t n_prime = (~n_inv) + 1;
     
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] n^(-1) = 0x%08x\n", n_inv);
-        printf("[DEBUG] n' = -n^(-1) = 0x%08x\n", n_prime);
-    }
+    TRACE(LOG_DEBUG, "[DEBUG] n^(-1) = 0x%08" PRIxWORD, n_inv);
+    TRACE(LOG_DEBUG, "[DEBUG] n' = -n^(-1) = 0x%08" PRIxWORD, n_prime);
     
-    /* CRITICAL VERIFICATION: n * n' ≡ -1 ≡ 0xFFFFFFFF (mod 2^32) */
-    uint32_t verify_product = n * n_prime;
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] Verification: n * n' = 0x%08x * 0x%08x = 0x%08x\n", 
-               n, n_prime, verify_product);
-    }
+    /* CRITICAL VERIFICATION: n * n' ≡ -1 ≡ all ones (mod 2^BIGINT_WORD_SIZE) */
+    bigint_word_t verify_product = n * n_prime;
+    TRACE(LOG_DEBUG, "[DEBUG] Verification: n * n' = 0x%08" PRIxWORD " * 0x%08" PRIxWORD " = 0x%08" PRIxWORD, 
+           n, n_prime, verify_product);
     
-    if (verify_product != 0xFFFFFFFF) {
-        printf("[DEBUG ERROR] n' verification failed: expected 0xFFFFFFFF, got 0x%08x\n", 
+    if (verify_product != BIGINT_WORD_MASK) {
+        TRACE(LOG_ERROR, "[DEBUG ERROR] n' verification failed: expected all ones, got 0x%08" PRIxWORD, 
                verify_product);
         return 0;
     }
     
-    if (LOG_LEVEL <= LOG_DEBUG) {
-        printf("[DEBUG] ✓ Montgomery n' verification PASSED\n");
-    }
+    TRACE(LOG_DEBUG, "[DEBUG] ✓ Montgomery n' verification PASSED");
     return n_prime;
 }
 
 /* ===================== COMPLETE EXTENDED GCD FOR MONTGOMERY ===================== */
 
 /**
- * @brief Complete Extended GCD implementation for Montgomery R^(-1) mod n
+ * @brief Complete Extended GCD implementation for modular inverses
+ * No longer on the context setup path - R^(-1) comes from montgomery_ctx_get_r_inv()
  * OPTIMIZED for Montgomery contexts - ENHANCED WITH ROUND-TRIP VALIDATION
  */
 int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
-    printf("[EXT_GCD_FULL] Computing %d-word^(-1) mod %d-word\n", a->used, m->used);
+    TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Computing %d-word^(-1) mod %d-word", a->used, m->used);
     
     /* TODO: Critical input validation for round-trip safety */
     if (result == NULL || a == NULL || m == NULL) {
@@ -161,10 +179,10 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
     bigint_init(&a_reduced);
     int ret = bigint_mod(&a_reduced, a, m);
     if (ret != 0) {
-        printf("[EXT_GCD_FULL] Failed to reduce a mod m, using original algorithm\n");
+        TRACE(LOG_INFO, "[EXT_GCD_FULL] Failed to reduce a mod m, using original algorithm");
         bigint_copy(&a_reduced, a);
     } else {
-        printf("[EXT_GCD_FULL] Reduced %d-word number to %d-word number\n", a->used, a_reduced.used);
+        TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Reduced %d-word number to %d-word number", a->used, a_reduced.used);
     }
     
     /* Use the reduced number for GCD computation */
@@ -172,12 +190,12 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
     
     /* Special handling for small modulus */
     if (m->used == 1 && m->words[0] <= 10000) {
-        printf("[EXT_GCD_FULL] Small modulus optimization\n");
+        TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Small modulus optimization");
         
         uint32_t m_val = m->words[0];
         uint32_t a_val = (gcd_input->used > 0) ? gcd_input->words[0] : 0;
         
-        printf("[EXT_GCD_FULL] Computing %u^(-1) mod %u\n", a_val, m_val);
+        TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Computing %u^(-1) mod %u", a_val, m_val);
         
         /* FIXED: Handle zero case properly */
         if (a_val == 0) {
@@ -187,7 +205,7 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
         /* Handle a_val = 1 case */
         if (a_val == 1) {
             bigint_set_u32(result, 1);
-            printf("[EXT_GCD_FULL] Found inverse by trial: 1\n");
+            TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Found inverse by trial: 1");
             return 0;
         }
         
@@ -195,7 +213,7 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
         for (uint32_t i = 1; i < m_val; i++) {
             if ((a_val * i) % m_val == 1) {
                 bigint_set_u32(result, i);
-                printf("[EXT_GCD_FULL] Found inverse by trial: %u\n", i);
+                TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Found inverse by trial: %u", i);
                 return 0;
             }
         }
@@ -220,7 +238,7 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
     bigint_init(&old_t);
     bigint_set_u32(&t, 1);
     
-    printf("[EXT_GCD_FULL] Starting extended GCD algorithm\n");
+    TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Starting extended GCD algorithm");
     
     int iteration = 0;
     int max_iterations = 3;  /* Very conservative limit for production use */
@@ -228,8 +246,7 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
     while (!bigint_is_zero(&r) && iteration < max_iterations) {
         iteration++;
         
-        printf("[EXT_GCD_FULL] Iteration %d starting\n", iteration);
-        fflush(stdout);
+        TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Iteration %d starting", iteration);
         
         /* Calculate quotient and remainder: old_r = quotient * r + remainder */
         bigint_t quotient, remainder;
@@ -249,25 +266,23 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
             ERROR_RETURN(ret, "Multiplication failed in extended GCD");
         }
         
-        /* FIXED: Handle subtraction: new_s = old_s - q_times_s */
-        if (bigint_compare(&old_s, &q_times_s) >= 0) {
-            ret = bigint_sub(&new_s, &old_s, &q_times_s);
+        /* FIXED: Handle subtraction modulo m: new_s = (old_s - q_times_s) mod m */
+        /* Reducing q_times_s first means at most one m is added, instead of looping
+         * over bigint_add until the (possibly huge) product is covered. */
+        bigint_t qs_mod;
+        ret = bigint_mod(&qs_mod, &q_times_s, m);
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Reduction failed in extended GCD");
+        }
+        if (bigint_compare(&old_s, &qs_mod) >= 0) {
+            ret = bigint_sub(&new_s, &old_s, &qs_mod);
         } else {
-            /* FIXED: Add modulus to handle negative result properly */
             bigint_t temp_old_s;
-            bigint_copy(&temp_old_s, &old_s);
-            
-            /* Keep adding modulus until temp_old_s >= q_times_s */
-            while (bigint_compare(&temp_old_s, &q_times_s) < 0) {
-                bigint_t temp_sum;
-                ret = bigint_add(&temp_sum, &temp_old_s, m);
-                if (ret != 0) {
-                    ERROR_RETURN(ret, "Addition failed while handling negative result");
-                }
-                bigint_copy(&temp_old_s, &temp_sum);
+            ret = bigint_add(&temp_old_s, &old_s, m);
+            if (ret != 0) {
+                ERROR_RETURN(ret, "Addition failed while handling negative result");
             }
-            
-            ret = bigint_sub(&new_s, &temp_old_s, &q_times_s);
+            ret = bigint_sub(&new_s, &temp_old_s, &qs_mod);
         }
         if (ret != 0) {
             ERROR_RETURN(ret, "Subtraction failed in extended GCD");
@@ -281,22 +296,21 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
         
         /* More frequent progress reporting and better early termination */
         if (iteration % 10 == 0) {
-            printf("[EXT_GCD_FULL] Progress: iteration %d, r has %d words, r_bits=%d\n", 
+            TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Progress: iteration %d, r has %d words, r_bits=%d", 
                    iteration, r.used, bigint_bit_length(&r));
-            fflush(stdout);
         }
         
         /* Enhanced safety check with very early termination for production use */
         if (iteration >= max_iterations) {
-            printf("[EXT_GCD_FULL] Reached maximum iterations (%d)\n", max_iterations);
-            printf("[EXT_GCD_FULL] Terminating early for performance reasons\n");
+            TRACE(LOG_INFO, "[EXT_GCD_FULL] Reached maximum iterations (%d)", max_iterations);
+            TRACE(LOG_INFO, "[EXT_GCD_FULL] Terminating early for performance reasons");
             ERROR_RETURN(-4, "Extended GCD exceeded practical iterations - numbers too large for this implementation");
         }
     }
     
     /* Check why the loop ended */
     if (iteration >= max_iterations) {
-        printf("[EXT_GCD_FULL] Loop terminated due to iteration limit\n");
+        TRACE(LOG_INFO, "[EXT_GCD_FULL] Loop terminated due to iteration limit");
         ERROR_RETURN(-4, "Extended GCD exceeded maximum iterations");
     }
     
@@ -304,12 +318,12 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
     bigint_t one;
     bigint_set_u32(&one, 1);
     if (bigint_compare(&old_r, &one) != 0) {
-        printf("[EXT_GCD_FULL] GCD is not 1\n");
+        TRACE(LOG_INFO, "[EXT_GCD_FULL] GCD is not 1");
         debug_print_bigint("GCD", &old_r);
         ERROR_RETURN(-5, "gcd(a, m) != 1, no inverse exists");
     }
     
-    printf("[EXT_GCD_FULL] GCD = 1, computing final result\n");
+    TRACE(LOG_DEBUG, "[EXT_GCD_FULL] GCD = 1, computing final result");
     
     /* FIXED: Ensure result is in range [0, m) */
     if (bigint_compare(&old_s, m) >= 0) {
@@ -321,14 +335,74 @@ int extended_gcd_full(bigint_t *result, const bigint_t *a, const bigint_t *m) {
         bigint_copy(result, &old_s);
     }
     
-    printf("[EXT_GCD_FULL] Extended GCD completed in %d iterations\n", iteration);
+    TRACE(LOG_DEBUG, "[EXT_GCD_FULL] Extended GCD completed in %d iterations", iteration);
     return 0;
 }
 
+/* ===================== FIXED-WIDTH RESIDUE HELPERS ===================== */
+
+int mont_residue_from_bigint(mont_residue_t *dst, const bigint_t *src, const montgomery_ctx_t *ctx) {
+    if (dst == NULL || src == NULL || ctx == NULL) {
+        return -1;
+    }
+    
+    int used = bigint_is_zero(src) ? 0 : src->used;
+    if (used > ctx->n_words) {
+        return -2; /* Wider than the modulus - caller must reduce first */
+    }
+    
+    memcpy(dst->words, src->words, (size_t)used * sizeof(bigint_word_t));
+    memset(dst->words + used, 0, (size_t)(ctx->n_words - used) * sizeof(bigint_word_t));
+    return 0;
+}
+
+void mont_residue_to_bigint(bigint_t *dst, const mont_residue_t *src, const montgomery_ctx_t *ctx) {
+    if (dst == NULL || src == NULL || ctx == NULL) return;
+    
+    bigint_init(dst);
+    memcpy(dst->words, src->words, (size_t)ctx->n_words * sizeof(bigint_word_t));
+    dst->used = ctx->n_words;
+    bigint_normalize(dst);
+}
+
+void montgomery_ctx_get_modulus(const montgomery_ctx_t *ctx, bigint_t *modulus) {
+    mont_residue_to_bigint(modulus, &ctx->n, ctx);
+}
+
+int montgomery_ctx_matches(const montgomery_ctx_t *ctx, const bigint_t *modulus) {
+    if (ctx == NULL || modulus == NULL || ctx->n_words <= 0) return 0;
+    if (modulus->used != ctx->n_words) return 0;
+    return memcmp(modulus->words, ctx->n.words, (size_t)ctx->n_words * sizeof(bigint_word_t)) == 0;
+}
+
+/**
+ * @brief Check a <  n without materialising n as a full bigint
+ */
+static int bigint_below_modulus(const bigint_t *a, const montgomery_ctx_t *ctx) {
+    if (a->used != ctx->n_words) {
+        return a->used < ctx->n_words;
+    }
+    for (int i = ctx->n_words - 1; i >= 0; i--) {
+        if (a->words[i] != ctx->n.words[i]) {
+            return a->words[i] < ctx->n.words[i];
+        }
+    }
+    return 0;
+}
+
+static void debug_print_residue(const char *name, const mont_residue_t *a, const montgomery_ctx_t *ctx) {
+    if (!TRACE_ENABLED(LOG_DEBUG)) return;
+    
+    bigint_t tmp;
+    mont_residue_to_bigint(&tmp, a, ctx);
+    debug_print_bigint(name, &tmp);
+}
+
 /* ===================== MONTGOMERY CONTEXT MANAGEMENT ===================== */
 
 int montgomery_ctx_init(montgomery_ctx_t *ctx, const bigint_t *modulus) {
-    printf("[MONTGOMERY_COMPLETE] Initializing context for %d-bit modulus\n", bigint_bit_length(modulus));
+    uint64_t stats_start = STATS_START();   /* Only completed setups are timed */
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Initializing context for %d-bit modulus", bigint_bit_length(modulus));
     
     /* TODO: Critical input validation for round-trip safety */
     if (ctx == NULL || modulus == NULL) {
@@ -350,9 +424,6 @@ int montgomery_ctx_init(montgomery_ctx_t *ctx, const bigint_t *modulus) {
     /* Initialize context with proper cleanup */
     memset(ctx, 0, sizeof(montgomery_ctx_t));
     ctx->is_active = 0;
-    
-    /* Copy modulus with validation */
-    bigint_copy(&ctx->n, modulus);
     ctx->n_words = modulus->used;
     
     /* TODO: Validate word count is reasonable */
@@ -360,101 +431,88 @@ int montgomery_ctx_init(montgomery_ctx_t *ctx, const bigint_t *modulus) {
         ERROR_RETURN(-4, "Invalid modulus word count: %d", ctx->n_words);
     }
     
-    debug_print_bigint("Modulus (n)", &ctx->n);
+    /* Residues are sized for the largest RSA modulus, not the full bigint buffer */
+    if (ctx->n_words > MONTGOMERY_MAX_WORDS) {
+        TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Modulus (%d words) exceeds residue width (%d words), disabling Montgomery",
+               ctx->n_words, MONTGOMERY_MAX_WORDS);
+        return 0;
+    }
+    
+    /* Copy modulus into the fixed-width residue */
+    memcpy(ctx->n.words, modulus->words, (size_t)ctx->n_words * sizeof(bigint_word_t));
+    debug_print_bigint("Modulus (n)", modulus);
     
     /* FIXME: For very large modulus (> 32 words), this implementation may need optimization */
     if (ctx->n_words > 32) {
-        printf("[MONTGOMERY_COMPLETE] Large modulus (%d words) - using Montgomery REDC implementation\n", ctx->n_words);
+        TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Large modulus (%d words) - using Montgomery REDC implementation", ctx->n_words);
         CHECKPOINT(LOG_INFO, "Large modulus detected, potential performance concerns");
     }
     
-    /* Calculate R = 2^(32 * n_words) with overflow checking */
+    /* Calculate R = 2^(BIGINT_WORD_SIZE * n_words); only needed transiently for the setup below */
     ctx->r_words = ctx->n_words;
+    bigint_t r;
+    bigint_init(&r);
+    r.words[ctx->r_words] = 1;
+    r.used = ctx->r_words + 1;
     
-    /* TODO: CRITICAL - Check for buffer overflow in R calculation */
-    if (ctx->r_words >= BIGINT_4096_WORDS - 10) {
-        printf("[MONTGOMERY_COMPLETE] R would overflow, disabling Montgomery\n");
-        return 0;
-    }
-    
-    /* FIXED: Set R = 2^(32 * r_words) properly with validation */
-    bigint_init(&ctx->r);
-    if (ctx->r_words < BIGINT_4096_WORDS) {
-        ctx->r.words[ctx->r_words] = 1;
-        ctx->r.used = ctx->r_words + 1;
-        /* TODO: Normalize R after creation */
-        bigint_normalize(&ctx->r);
-    } else {
-        printf("[MONTGOMERY_COMPLETE] R too large, disabling Montgomery\n");
-        return 0;
-    }
-    
-    debug_print_bigint("R", &ctx->r);
+    debug_print_bigint("R", &r);
     
     /* Verify R > n */
-    if (bigint_compare(&ctx->r, &ctx->n) <= 0) {
+    if (bigint_compare(&r, modulus) <= 0) {
         ERROR_RETURN(-4, "R must be > n");
     }
-    printf("[MONTGOMERY_COMPLETE] ✓ R > n verified\n");
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] ✓ R > n verified");
     
-    /* Calculate n' = -n^(-1) mod 2^32 */
+    /* Calculate n' = -n^(-1) mod 2^BIGINT_WORD_SIZE */
     ctx->n_prime = compute_montgomery_nprime(modulus->words[0]);
     if (ctx->n_prime == 0) {
         ERROR_RETURN(-5, "Failed to compute Montgomery n'");
     }
     
-    printf("[MONTGOMERY_COMPLETE] ✓ n' = 0x%08x computed successfully\n", ctx->n_prime);
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] ✓ n' = 0x%08" PRIxWORD " computed successfully", ctx->n_prime);
     
-    /* Calculate R^(-1) mod n using extended GCD - OPTIONAL for most operations */
-    printf("[MONTGOMERY_COMPLETE] Computing R^(-1) mod n (optional for conversion from Montgomery form)...\n");
-    int ret = extended_gcd_full(&ctx->r_inv, &ctx->r, &ctx->n);
-    if (ret != 0) {
-        printf("[MONTGOMERY_COMPLETE] WARNING: Failed to compute R^(-1) mod n (%d)\n", ret);
-        printf("[MONTGOMERY_COMPLETE] This will only affect conversion FROM Montgomery form\n");
-        printf("[MONTGOMERY_COMPLETE] RSA operations will still work correctly\n");
-        
-        /* Initialize r_inv to zero to indicate it's not available */
-        bigint_init(&ctx->r_inv);
-        
-        /* Continue with initialization - this is not a fatal error */
-    } else {
-        debug_print_bigint("R^(-1) mod n", &ctx->r_inv);
-    }
+    /* R^(-1) mod n is not needed for RSA - montgomery_ctx_get_r_inv() derives it on first use */
+    ctx->has_r_inv = 0;
     
     /* Calculate R^2 mod n */
-    printf("[MONTGOMERY_COMPLETE] Computing R^2 mod n...\n");
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Computing R^2 mod n...");
     
-    /* First compute R mod n to reduce size */
+    /* First compute R mod n to reduce size - this is also the Montgomery form of 1 */
     bigint_t r_mod_n;
-    ret = bigint_mod(&r_mod_n, &ctx->r, &ctx->n);
+    int ret = bigint_mod(&r_mod_n, &r, modulus);
     if (ret != 0) {
-        printf("[MONTGOMERY_COMPLETE] Failed to compute R mod n (%d), disabling Montgomery\n", ret);
+        TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Failed to compute R mod n (%d), disabling Montgomery", ret);
         return 0;
     }
+    mont_residue_from_bigint(&ctx->r_mod_n, &r_mod_n, ctx);
     
     /* Then compute (R mod n)^2 mod n */
     bigint_t r_squared_temp;
     ret = bigint_mul(&r_squared_temp, &r_mod_n, &r_mod_n);
     if (ret != 0) {
-        printf("[MONTGOMERY_COMPLETE] R^2 multiplication failed (%d), disabling Montgomery\n", ret);
+        TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] R^2 multiplication failed (%d), disabling Montgomery", ret);
         return 0;
     }
     
-    ret = bigint_mod(&ctx->r_squared, &r_squared_temp, &ctx->n);
+    bigint_t r_squared;
+    ret = bigint_mod(&r_squared, &r_squared_temp, modulus);
     if (ret != 0) {
-        printf("[MONTGOMERY_COMPLETE] R^2 mod n failed (%d), disabling Montgomery\n", ret);
+        TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] R^2 mod n failed (%d), disabling Montgomery", ret);
         return 0;
     }
+    mont_residue_from_bigint(&ctx->r_squared, &r_squared, ctx);
     
-    debug_print_bigint("R^2 mod n", &ctx->r_squared);
+    debug_print_bigint("R^2 mod n", &r_squared);
     
     /* Mark as active */
     ctx->is_active = 1;
+    montgomery_ctx_bind_kernels(ctx);
     
-    printf("[MONTGOMERY_COMPLETE] ✅ Context initialization completed successfully\n");
-    printf("[MONTGOMERY_COMPLETE] Parameters: n_words=%d, r_words=%d, n'=0x%08x, ACTIVE\n", 
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] ✅ Context initialization completed successfully");
+    TRACE(LOG_INFO, "[MONTGOMERY_COMPLETE] Parameters: n_words=%d, r_words=%d, n'=0x%08" PRIxWORD ", ACTIVE", 
            ctx->n_words, ctx->r_words, ctx->n_prime);
     
+    STATS_TIME(RSA_4096_TIME_CTX_INIT, stats_start);
     return 0;
 }
 
@@ -473,20 +531,319 @@ void montgomery_ctx_print_info(const montgomery_ctx_t *ctx) {
     
     printf("=== Montgomery REDC Context (COMPLETE) ===\n");
     if (ctx->is_active && ctx->n_words > 0) {
+        bigint_t n;
+        montgomery_ctx_get_modulus(ctx, &n);
         printf("Status: ACTIVE\n");
-        printf("Modulus bits: %d\n", bigint_bit_length(&ctx->n));
-        printf("R bits: %d\n", bigint_bit_length(&ctx->r));
+        printf("Modulus bits: %d\n", bigint_bit_length(&n));
+        printf("R bits: %d\n", BIGINT_WORD_SIZE * ctx->r_words + 1);
         printf("n_words: %d, r_words: %d\n", ctx->n_words, ctx->r_words);
-        printf("n' = 0x%08x\n", ctx->n_prime);
+        printf("n' = 0x%08" PRIxWORD "\n", ctx->n_prime);
+        printf("R^(-1) mod n: %s\n", ctx->has_r_inv ? "cached" : "computed on demand");
+        printf("Word kernels: %s\n", montgomery_ctx_kernel_name(ctx));
+        printf("Context size: %zu bytes\n", sizeof(montgomery_ctx_t));
         printf("Status: ACTIVE (Montgomery REDC implementation for RISC-V)\n");
     }
     printf("==========================================\n");
 }
 
+/* ===================== WORD-LEVEL MONTGOMERY KERNELS ===================== */
+
+/* The word loops are always inlined into the fixed-width instances below so s becomes a constant */
+#if defined(__GNUC__)
+#define MONTGOMERY_INLINE static inline __attribute__((always_inline))
+#define MONTGOMERY_UNROLL _Pragma("GCC unroll 8")
+#else
+#define MONTGOMERY_INLINE static inline
+#define MONTGOMERY_UNROLL
+#endif
+
+/**
+ * @brief Final conditional subtraction shared by all kernels
+ *
+ * t holds s words plus a carry word t[s]; the value is known to be < 2n,
+ * so at most one n is removed.
+ */
+MONTGOMERY_INLINE void montgomery_final_sub(bigint_word_t *out, const bigint_word_t *t, const bigint_word_t *n, int s) {
+    int ge = (t[s] != 0);
+    if (!ge) {
+        ge = 1;
+        for (int j = s - 1; j >= 0; j--) {
+            if (t[j] != n[j]) {
+                ge = (t[j] > n[j]);
+                break;
+            }
+        }
+    }
+    
+    if (ge) {
+        bigint_dword_t borrow = 0;
+        for (int j = 0; j < s; j++) {
+            bigint_dword_t diff = (bigint_dword_t)t[j] - n[j] - borrow;
+            out[j] = (bigint_word_t)diff;
+            borrow = (diff >> (2 * BIGINT_WORD_SIZE - 1)) & 1;
+        }
+    } else {
+        memcpy(out, t, (size_t)s * sizeof(bigint_word_t));
+    }
+}
+
+/**
+ * @brief Almost Montgomery final step: fold the carry word back below R
+ *
+ * For inputs below R every kernel leaves t < R + n, so t has a carry word of
+ * 0 or 1 and subtracting n once exactly when it is set gives a value below R
+ * that is congruent to the result but not necessarily below n. The subtraction
+ * is masked, so there is neither a full-width compare nor a data-dependent
+ * branch per operation.
+ */
+MONTGOMERY_INLINE void montgomery_almost_sub(bigint_word_t *out, const bigint_word_t *t, const bigint_word_t *n, int s) {
+    bigint_word_t mask = (bigint_word_t)0 - (t[s] & 1);
+    bigint_dword_t borrow = 0;
+    for (int j = 0; j < s; j++) {
+        bigint_dword_t diff = (bigint_dword_t)t[j] - (n[j] & mask) - borrow;
+        out[j] = (bigint_word_t)diff;
+        borrow = (diff >> (2 * BIGINT_WORD_SIZE - 1)) & 1;
+    }
+}
+
+/* lazy is a compile-time constant in every instance: strict [0, n) or almost [0, R) output */
+MONTGOMERY_INLINE void montgomery_finish(bigint_word_t *out, const bigint_word_t *t, const bigint_word_t *n, int s,
+                                         int lazy) {
+    if (lazy) {
+        montgomery_almost_sub(out, t, n, s);
+    } else {
+        montgomery_final_sub(out, t, n, s);
+    }
+}
+
+/**
+ * @brief Word-serial Montgomery REDC of a double-width value in place
+ *
+ * t holds 2s + 2 words (the top two zero on entry) with value < n * R;
+ * out receives t * R^(-1) mod n. With lazy set, t may be anything below R^2
+ * and out is only reduced below R.
+ */
+MONTGOMERY_INLINE void montgomery_redc_words(bigint_word_t *out, bigint_word_t *t, const bigint_word_t *n,
+                                             bigint_word_t n_prime, int s, int lazy) {
+    /* Row carries out of word i + s are deferred into the next row instead of rippled upward */
+    bigint_word_t top = 0;
+    for (int i = 0; i < s; i++) {
+        bigint_dword_t m = (bigint_word_t)(t[i] * n_prime);
+        bigint_dword_t carry = 0;
+        MONTGOMERY_UNROLL
+        for (int j = 0; j < s; j++) {
+            bigint_dword_t sum = (bigint_dword_t)t[i + j] + m * n[j] + carry;
+            t[i + j] = (bigint_word_t)sum;
+            carry = sum >> BIGINT_WORD_SIZE;
+        }
+        bigint_dword_t sum = (bigint_dword_t)t[i + s] + carry + top;
+        t[i + s] = (bigint_word_t)sum;
+        top = (bigint_word_t)(sum >> BIGINT_WORD_SIZE);
+    }
+    t[2 * s] += top;
+    
+    montgomery_finish(out, t + s, n, s, lazy);
+}
+
+/**
+ * @brief Coarsely Integrated Operand Scanning (CIOS) Montgomery multiplication
+ *
+ * Computes t = a * b * R^(-1) mod n for s-word operands a, b < n in a single
+ * pass: every outer iteration adds a * b[i] and m * n into an (s + 2)-word
+ * accumulator and shifts it down by one word, so no 2s-word product is ever
+ * materialised. The result is fully reduced into [0, n); with lazy set a and b
+ * may be anything below R and the result is only reduced below R.
+ */
+MONTGOMERY_INLINE void montgomery_cios_words(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b,
+                                             const bigint_word_t *n, bigint_word_t n_prime, int s, int lazy) {
+    bigint_word_t t[MONTGOMERY_MAX_WORDS + 2];
+    memset(t, 0, (size_t)(s + 2) * sizeof(bigint_word_t));
+    
+    for (int i = 0; i < s; i++) {
+        /* t = t + a * b[i] */
+        bigint_dword_t carry = 0;
+        bigint_dword_t bi = b[i];
+        MONTGOMERY_UNROLL
+        for (int j = 0; j < s; j++) {
+            bigint_dword_t sum = (bigint_dword_t)t[j] + (bigint_dword_t)a[j] * bi + carry;
+            t[j] = (bigint_word_t)sum;
+            carry = sum >> BIGINT_WORD_SIZE;
+        }
+        bigint_dword_t sum = (bigint_dword_t)t[s] + carry;
+        t[s] = (bigint_word_t)sum;
+        t[s + 1] = (bigint_word_t)(sum >> BIGINT_WORD_SIZE);
+        
+        /* t = (t + m * n) / 2^BIGINT_WORD_SIZE with m chosen so the low word vanishes */
+        bigint_dword_t m = (bigint_word_t)(t[0] * n_prime);
+        sum = (bigint_dword_t)t[0] + m * n[0];
+        carry = sum >> BIGINT_WORD_SIZE;
+        MONTGOMERY_UNROLL
+        for (int j = 1; j < s; j++) {
+            sum = (bigint_dword_t)t[j] + m * n[j] + carry;
+            t[j - 1] = (bigint_word_t)sum;
+            carry = sum >> BIGINT_WORD_SIZE;
+        }
+        sum = (bigint_dword_t)t[s] + carry;
+        t[s - 1] = (bigint_word_t)sum;
+        t[s] = t[s + 1] + (bigint_word_t)(sum >> BIGINT_WORD_SIZE);
+    }
+    
+    montgomery_finish(out, t, n, s, lazy);
+}
+
+/**
+ * @brief Montgomery squaring: t = a^2 * R^(-1) mod n for an s-word a < n
+ *
+ * Separated operand scanning: each cross product a[i] * a[j] (i < j) is
+ * formed once, the sum is doubled and the diagonal a[i]^2 added, then the
+ * 2s-word square goes through word-serial REDC. That is s(s+1)/2 + s^2 word
+ * products against 2s^2 for CIOS with b = a.
+ */
+MONTGOMERY_INLINE void montgomery_sqr_words(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n,
+                                            bigint_word_t n_prime, int s, int lazy) {
+    bigint_word_t t[2 * MONTGOMERY_MAX_WORDS + 2];
+    memset(t, 0, (size_t)(2 * s + 2) * sizeof(bigint_word_t));
+    
+    /* Off-diagonal half: sum of a[i] * a[j] * B^(i+j) for i < j */
+    for (int i = 0; i < s - 1; i++) {
+        bigint_dword_t carry = 0;
+        bigint_dword_t ai = a[i];
+        MONTGOMERY_UNROLL
+        for (int j = i + 1; j < s; j++) {
+            bigint_dword_t sum = (bigint_dword_t)t[i + j] + ai * a[j] + carry;
+            t[i + j] = (bigint_word_t)sum;
+            carry = sum >> BIGINT_WORD_SIZE;
+        }
+        t[i + s] = (bigint_word_t)carry;
+    }
+    
+    /* Double it and add the diagonal in one pass; a^2 < B^2s so nothing spills past t[2s - 1] */
+    bigint_word_t shift_in = 0;
+    bigint_dword_t carry = 0;
+    for (int i = 0; i < s; i++) {
+        bigint_dword_t sq = (bigint_dword_t)a[i] * a[i];
+        bigint_word_t lo = t[2 * i], hi = t[2 * i + 1];
+        bigint_word_t lo2 = (bigint_word_t)(lo << 1) | shift_in;
+        bigint_word_t hi2 = (bigint_word_t)(hi << 1) | (lo >> (BIGINT_WORD_SIZE - 1));
+        shift_in = hi >> (BIGINT_WORD_SIZE - 1);
+        
+        bigint_dword_t sum = (bigint_dword_t)lo2 + (bigint_word_t)sq + carry;
+        t[2 * i] = (bigint_word_t)sum;
+        sum = (bigint_dword_t)hi2 + (bigint_word_t)(sq >> BIGINT_WORD_SIZE) + (sum >> BIGINT_WORD_SIZE);
+        t[2 * i + 1] = (bigint_word_t)sum;
+        carry = sum >> BIGINT_WORD_SIZE;
+    }
+    
+    montgomery_redc_words(out, t, n, n_prime, s, lazy);
+}
+
+/* ===================== SIZE-SPECIALISED KERNEL SETS ===================== */
+
+/* Generic set: s taken from the context at run time */
+static void montgomery_mul_any(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b,
+                               const bigint_word_t *n, bigint_word_t n_prime, int s) {
+    montgomery_cios_words(out, a, b, n, n_prime, s, 0);
+}
+
+static void montgomery_sqr_any(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n,
+                               bigint_word_t n_prime, int s) {
+    montgomery_sqr_words(out, a, n, n_prime, s, 0);
+}
+
+static void montgomery_redc_any(bigint_word_t *out, bigint_word_t *t, const bigint_word_t *n,
+                                bigint_word_t n_prime, int s) {
+    montgomery_redc_words(out, t, n, n_prime, s, 0);
+}
+
+static void montgomery_amm_mul_any(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b,
+                                   const bigint_word_t *n, bigint_word_t n_prime, int s) {
+    montgomery_cios_words(out, a, b, n, n_prime, s, 1);
+}
+
+static void montgomery_amm_sqr_any(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n,
+                                   bigint_word_t n_prime, int s) {
+    montgomery_sqr_words(out, a, n, n_prime, s, 1);
+}
+
+static const montgomery_kernels_t montgomery_kernels_any = {
+    montgomery_mul_any, montgomery_sqr_any, montgomery_redc_any, montgomery_amm_mul_any, montgomery_amm_sqr_any,
+    0, "generic"
+};
+
+/*
+ * One kernel set per standard width: the inlined word loops see a constant s,
+ * so the compiler can unroll them and keep the accumulator in registers.
+ */
+#define MONTGOMERY_FIXED_KERNELS(bits)                                                                      \
+    static void montgomery_mul_##bits(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *b,  \
+                                      const bigint_word_t *n, bigint_word_t n_prime, int s) {              \
+        (void)s;                                                                                          \
+        montgomery_cios_words(out, a, b, n, n_prime, (bits) / BIGINT_WORD_SIZE, 0);                         \
+    }                                                                                                     \
+    static void montgomery_sqr_##bits(bigint_word_t *out, const bigint_word_t *a, const bigint_word_t *n,  \
+                                      bigint_word_t n_prime, int s) {                                     \
+        (void)s;                                                                                          \
+        montgomery_sqr_words(out, a, n, n_prime, (bits) / BIGINT_WORD_SIZE, 0);                             \
+    }                                                                                                     \
+    static void montgomery_redc_##bits(bigint_word_t *out, bigint_word_t *t, const bigint_word_t *n,       \
+                                       bigint_word_t n_prime, int s) {                                    \
+        (void)s;                                                                                          \
+        montgomery_redc_words(out, t, n, n_prime, (bits) / BIGINT_WORD_SIZE, 0);                            \
+    }                                                                                                     \
+    static void montgomery_amm_mul_##bits(bigint_word_t *out, const bigint_word_t *a,                      \
+                                          const bigint_word_t *b, const bigint_word_t *n,                 \
+                                          bigint_word_t n_prime, int s) {                                 \
+        (void)s;                                                                                          \
+        montgomery_cios_words(out, a, b, n, n_prime, (bits) / BIGINT_WORD_SIZE, 1);                         \
+    }                                                                                                     \
+    static void montgomery_amm_sqr_##bits(bigint_word_t *out, const bigint_word_t *a,                      \
+                                          const bigint_word_t *n, bigint_word_t n_prime, int s) {         \
+        (void)s;                                                                                          \
+        montgomery_sqr_words(out, a, n, n_prime, (bits) / BIGINT_WORD_SIZE, 1);                             \
+    }                                                                                                     \
+    static const montgomery_kernels_t montgomery_kernels_##bits = {                                         \
+        montgomery_mul_##bits, montgomery_sqr_##bits, montgomery_redc_##bits,                             \
+        montgomery_amm_mul_##bits, montgomery_amm_sqr_##bits, (bits) / BIGINT_WORD_SIZE, #bits "-bit"     \
+    };
+
+/* RSA-1024/2048/3072/4096 and their CRT halves */
+MONTGOMERY_FIXED_KERNELS(512)
+MONTGOMERY_FIXED_KERNELS(1024)
+MONTGOMERY_FIXED_KERNELS(1536)
+MONTGOMERY_FIXED_KERNELS(2048)
+MONTGOMERY_FIXED_KERNELS(3072)
+MONTGOMERY_FIXED_KERNELS(4096)
+
+static const montgomery_kernels_t *const montgomery_fixed_kernels[] = {
+    &montgomery_kernels_512, &montgomery_kernels_1024, &montgomery_kernels_1536,
+    &montgomery_kernels_2048, &montgomery_kernels_3072, &montgomery_kernels_4096
+};
+
+void montgomery_ctx_bind_kernels(montgomery_ctx_t *ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    ctx->kernels = &montgomery_kernels_any;
+    for (size_t i = 0; i < sizeof(montgomery_fixed_kernels) / sizeof(montgomery_fixed_kernels[0]); i++) {
+        if (montgomery_fixed_kernels[i]->n_words == ctx->n_words) {
+            ctx->kernels = montgomery_fixed_kernels[i];
+            break;
+        }
+    }
+}
+
+const char *montgomery_ctx_kernel_name(const montgomery_ctx_t *ctx) {
+    return ctx != NULL && ctx->kernels != NULL ? ctx->kernels->name : montgomery_kernels_any.name;
+}
+
+static const montgomery_kernels_t *montgomery_ctx_kernels(const montgomery_ctx_t *ctx) {
+    return ctx->kernels != NULL ? ctx->kernels : &montgomery_kernels_any;
+}
+
 /* ===================== COMPLETE MONTGOMERY REDC ALGORITHM - BUGS FIXED ===================== */
 
 int montgomery_redc(bigint_t *result, const bigint_t *T, const montgomery_ctx_t *ctx) {
-    printf("[REDC_COMPLETE] Starting Complete Montgomery REDC\n");
+    TRACE(LOG_DEBUG, "[REDC_COMPLETE] Starting Complete Montgomery REDC");
     
     /* TODO: CRITICAL ROUND-TRIP VALIDATION - check all inputs */
     if (result == NULL || T == NULL || ctx == NULL) {
@@ -498,7 +855,7 @@ int montgomery_redc(bigint_t *result, const bigint_t *T, const montgomery_ctx_t
     }
     
     /* TODO: FIXME - Validate Montgomery context integrity for round-trip safety */
-    if (bigint_is_zero(&ctx->n) || ctx->n_prime == 0) {
+    if (ctx->n_prime == 0) {
         ERROR_RETURN(-3, "Invalid Montgomery context parameters");
     }
     
@@ -506,190 +863,162 @@ int montgomery_redc(bigint_t *result, const bigint_t *T, const montgomery_ctx_t
     VALIDATE_OVERFLOW(T, "montgomery_redc input T");
     debug_print_bigint("Input T", T);
     
-    /* TODO: Validate input is in expected range for REDC */
-    if (T->used > ctx->n_words * 2 + 5) {
-        printf("[ROUND_TRIP_DEBUG] WARNING: REDC input T has %d words, modulus has %d words\n", 
+    /* REDC requires T < n * R, which always fits in 2 * n_words words */
+    if (T->used > ctx->n_words * 2) {
+        TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: REDC input T has %d words, modulus has %d words", 
                T->used, ctx->n_words);
-        printf("[ROUND_TRIP_DEBUG] This could indicate overflow or invalid input\n");
+        ERROR_RETURN(-4, "REDC input exceeds double modulus width");
     }
     
-    /* TODO: Store original for debugging */
-    bigint_t original_T;
-    bigint_copy(&original_T, T);
-    
-    /* COMPLETE MONTGOMERY REDC ALGORITHM - ENHANCED WITH ROUND-TRIP VALIDATION */
+    /* COMPLETE MONTGOMERY REDC ALGORITHM */
     /* Algorithm: REDC(T) where T < n * R */
     /* 1. A = T */
     /* 2. for i = 0 to n-1: */
-    /*    m = A[i] * n' mod 2^32 */
-    /*    A = A + m * n * 2^(32*i) */
-    /* 3. A = A / 2^(32*n) */
+    /*    m = A[i] * n' mod 2^w  (w = BIGINT_WORD_SIZE) */
+    /*    A = A + m * n * 2^(w*i) */
+    /* 3. A = A / 2^(w*n) */
     /* 4. if A >= n then A = A - n */
     /* 5. return A */
     
-    /* FIXME: Critical - Create working copy A = T */
-    bigint_t A;
-    bigint_copy(&A, T);
+    /* Working copy A = T in a double-width product buffer (plus carry words) */
+    mont_product_t A;
+    int s = ctx->n_words;
+    memcpy(A.words, T->words, (size_t)T->used * sizeof(bigint_word_t));
+    memset(A.words + T->used, 0, (size_t)(2 * s + 2 - T->used) * sizeof(bigint_word_t));
     
-    /* TODO: Add validation after copy */
-    if (bigint_compare(&A, T) != 0) {
-        printf("[ROUND_TRIP_DEBUG] CRITICAL: Copy operation failed in REDC\n");
-        ERROR_RETURN(-94, "Failed to copy input in REDC");
-    }
+    TRACE(LOG_DEBUG, "[REDC_COMPLETE] Working with A: %d words", 2 * s + 2);
+    
+    mont_residue_t out;
+    montgomery_ctx_kernels(ctx)->redc(out.words, A.words, ctx->n.words, ctx->n_prime, s);
+    mont_residue_to_bigint(result, &out, ctx);
     
-    /* FIXED: Ensure A has enough words for the algorithm with overflow protection */
-    int max_words = ctx->n_words * 2 + 10;
-    if (max_words > BIGINT_4096_WORDS) {
-        max_words = BIGINT_4096_WORDS;
-        CHECKPOINT(LOG_ERROR, "WARNING: REDC buffer size limited, potential overflow");
+    debug_print_bigint("Final REDC result", result);
+    
+    TRACE(LOG_DEBUG, "[REDC_COMPLETE] ✅ Complete Montgomery REDC finished successfully");
+    return 0;
+}
+
+/* ===================== MONTGOMERY RESIDUE ARITHMETIC ===================== */
+
+int montgomery_mul_residue(mont_residue_t *result, const mont_residue_t *a, const mont_residue_t *b,
+                           const montgomery_ctx_t *ctx) {
+    if (result == NULL || a == NULL || b == NULL || ctx == NULL) {
+        return -1;
     }
     
-    /* FIXME: Properly extend A with zeros - critical for algorithm correctness */
-    bigint_ensure_capacity(&A, max_words);
+    if (!ctx->is_active || ctx->n_words == 0) {
+        return -2;
+    }
     
-    printf("[REDC_COMPLETE] Working with A: %d words\n", A.used);
-    debug_print_bigint("Initial A", &A);
+    montgomery_ctx_kernels(ctx)->mul(result->words, a->words, b->words, ctx->n.words, ctx->n_prime, ctx->n_words);
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, 1);
+    return 0;
+}
+
+int montgomery_square_residue(mont_residue_t *result, const mont_residue_t *a, const montgomery_ctx_t *ctx) {
+    if (result == NULL || a == NULL || ctx == NULL) {
+        return -1;
+    }
     
-    /* TODO: Add pre-loop validation */
-    VALIDATE_OVERFLOW(&A, "REDC working array A before loop");
+    if (!ctx->is_active || ctx->n_words == 0) {
+        return -2;
+    }
     
-    /* Montgomery REDC main loop - ENHANCED WITH VALIDATION */
-    for (int i = 0; i < ctx->n_words; i++) {
-        if (i % 10 == 0 || i < 5) {
-            printf("[REDC_COMPLETE] === Iteration %d/%d ===\n", i + 1, ctx->n_words);
-        }
-        
-        /* Step 1: m = A[i] * n' mod 2^32 */
-        /* TODO: CRITICAL - Validate array bounds */
-        uint32_t A_i = (i < A.used) ? A.words[i] : 0;
-        
-        /* FIXME: Critical multiplication for round-trip correctness */
-        uint32_t m = (A_i * ctx->n_prime) & 0xFFFFFFFF;
-        
-        if (i < 5) {
-            printf("[REDC_COMPLETE] A[%d] = 0x%08x, n' = 0x%08x, m = 0x%08x\n", 
-                   i, A_i, ctx->n_prime, m);
-        }
-        
-        /* TODO: Add validation for small values */
-        if (ctx->n_words == 1 && i == 0) {
-            printf("[ROUND_TRIP_DEBUG] Single-word REDC: A[0]=0x%x, n'=0x%x, m=0x%x\n", 
-                   A_i, ctx->n_prime, m);
-        }
-        
-        /* Step 2: A = A + m * n * 2^(32*i) */
-        /* This means: add (m * n) to A starting at word position i */
-        
-        uint64_t carry = 0;
-        for (int j = 0; j < ctx->n_words; j++) {
-            int pos = i + j;
-            if (pos >= max_words) break;
-            
-            /* Calculate m * n[j] + A[pos] + carry */
-            uint64_t product = (uint64_t)m * ctx->n.words[j];
-            uint64_t current_val = (pos < A.used) ? A.words[pos] : 0;
-            uint64_t sum = current_val + (product & 0xFFFFFFFF) + carry;
-            
-            A.words[pos] = (uint32_t)(sum & 0xFFFFFFFF);
-            carry = (sum >> 32) + (product >> 32);
-            
-            /* FIXED: Update A.used properly */
-            if (pos >= A.used) {
-                A.used = pos + 1;
-            }
-            
-            if ((i < 3 && j < 4) || (i < 2)) {
-                printf("[REDC_COMPLETE]   pos=%d: A[%d] = 0x%08x, carry=0x%" PRIx64 "\n",
-                       pos, pos, A.words[pos], carry);
-            }
-        }
-        
-        /* FIXED: Propagate remaining carry properly */
-        int pos = i + ctx->n_words;
-        while (carry > 0 && pos < max_words) {
-            uint64_t current_val = (pos < A.used) ? A.words[pos] : 0;
-            uint64_t sum = current_val + carry;
-            A.words[pos] = (uint32_t)(sum & 0xFFFFFFFF);
-            carry = sum >> 32;
-            
-            if (pos >= A.used) {
-                A.used = pos + 1;
-            }
-            pos++;
-        }
-        
-        if (i < 3) {
-            printf("[REDC_COMPLETE] After iteration %d: A has %d words\n", i + 1, A.used);
-            if (i < 2) {
-                debug_print_bigint("A after iteration", &A);
-            }
-        }
-        
-        /* Verify A[i] should now be 0 (or very small) */
-        if (i < 5 && A.words[i] != 0) {
-            printf("[REDC_COMPLETE] Note: A[%d] = 0x%08x (may not be zero in partial REDC)\n", 
-                   i, A.words[i]);
-        }
+    montgomery_ctx_kernels(ctx)->sqr(result->words, a->words, ctx->n.words, ctx->n_prime, ctx->n_words);
+    STATS_COUNT(RSA_4096_STAT_MONT_SQR, 1);
+    return 0;
+}
+
+/**
+ * @brief Leave Montgomery form: result = a * R^(-1) mod n via REDC(a)
+ */
+static void montgomery_residue_from_form(mont_residue_t *result, const mont_residue_t *a,
+                                         const montgomery_ctx_t *ctx) {
+    uint64_t stats_start = STATS_START();
+    int s = ctx->n_words;
+    bigint_word_t t[2 * MONTGOMERY_MAX_WORDS + 2];
+    memcpy(t, a->words, (size_t)s * sizeof(bigint_word_t));
+    memset(t + s, 0, (size_t)(s + 2) * sizeof(bigint_word_t));
+    montgomery_ctx_kernels(ctx)->redc(result->words, t, ctx->n.words, ctx->n_prime, s);
+    STATS_COUNT(RSA_4096_STAT_MONT_REDC, 1);
+    STATS_TIME(RSA_4096_TIME_CONVERT, stats_start);
+}
+
+int montgomery_ctx_get_r_inv(montgomery_ctx_t *ctx, bigint_t *r_inv) {
+    if (ctx == NULL || r_inv == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_ctx_get_r_inv");
     }
     
-    printf("[REDC_COMPLETE] Main REDC loop completed\n");
-    debug_print_bigint("A after main loop", &A);
+    if (!ctx->is_active || ctx->n_words == 0) {
+        ERROR_RETURN(-2, "Montgomery context disabled");
+    }
     
-    /* Step 3: A = A / R = A >> (32 * n_words) - GIỮ NGUYÊN */
-    printf("[REDC_COMPLETE] Dividing by R (right shift by %d words)\n", ctx->n_words);
+    /* R^(-1) mod n = REDC(1): one word-serial pass instead of an extended GCD */
+    if (!ctx->has_r_inv) {
+        mont_residue_t one;
+        memset(&one, 0, sizeof(one));
+        one.words[0] = 1;
+        montgomery_residue_from_form(&ctx->r_inv, &one, ctx);
+        ctx->has_r_inv = 1;
+    }
     
-    bigint_init(result);
+    mont_residue_to_bigint(r_inv, &ctx->r_inv, ctx);
+    return 0;
+}
+
+int montgomery_reduce(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx) {
+    if (result == NULL || a == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_reduce");
+    }
     
-    if (A.used > ctx->n_words) {
-        result->used = A.used - ctx->n_words;
-        if (result->used > BIGINT_4096_WORDS) {
-            result->used = BIGINT_4096_WORDS;
-        }
-        
-        for (int i = 0; i < result->used; i++) {
-            int src_pos = i + ctx->n_words;
-            if (src_pos < A.used) {
-                result->words[i] = A.words[src_pos];
-            } else {
-                result->words[i] = 0;
-            }
-        }
-        
-        /* FIXED: Normalize properly */
-        bigint_normalize(result);
-    } else {
-        /* Result is zero */
-        bigint_init(result);
+    if (!ctx->is_active || ctx->n_words == 0) {
+        ERROR_RETURN(-2, "Montgomery context disabled");
     }
     
-    debug_print_bigint("Result before final reduction", result);
+    int s = ctx->n_words;
+    if (bigint_below_modulus(a, ctx)) {
+        bigint_copy(result, a);
+        return 0;
+    }
     
-    /* Step 4: Final reduction if result >= n - GIỮ NGUYÊN */
-    if (!bigint_is_zero(result) && bigint_compare(result, &ctx->n) >= 0) {
-        printf("[REDC_COMPLETE] Final reduction: result >= n\n");
-        bigint_t temp;
-        int ret = bigint_sub(&temp, result, &ctx->n);
-        if (ret == 0) {
-            bigint_copy(result, &temp);
-            printf("[REDC_COMPLETE] Final reduction completed\n");
-        } else {
-            printf("[REDC_COMPLETE] Warning: Final subtraction failed: %d\n", ret);
+    /* REDC is only exact for a < n * R, i.e. the high s words of a must be below n */
+    int fits = (a->used <= 2 * s);
+    if (fits && a->used > s) {
+        fits = 0;
+        for (int i = 2 * s - 1; i >= s; i--) {
+            bigint_word_t hi = (i < a->used) ? a->words[i] : 0;
+            if (hi != ctx->n.words[i - s]) {
+                fits = (hi < ctx->n.words[i - s]);
+                break;
+            }
         }
     }
     
-    debug_print_bigint("Final REDC result", result);
-    debug_verify_invariant("REDC output", result, &ctx->n);
+    if (!fits) {
+        bigint_t n;
+        montgomery_ctx_get_modulus(ctx, &n);
+        return bigint_mod(result, a, &n);
+    }
     
-    printf("[REDC_COMPLETE] ✅ Complete Montgomery REDC finished successfully\n");
+    /* REDC(a) = a * R^(-1) mod n, then one multiply by R^2 restores the factor R */
+    bigint_word_t t[2 * MONTGOMERY_MAX_WORDS + 2];
+    mont_residue_t reduced;
+    memcpy(t, a->words, (size_t)a->used * sizeof(bigint_word_t));
+    memset(t + a->used, 0, (size_t)(2 * s + 2 - a->used) * sizeof(bigint_word_t));
+    const montgomery_kernels_t *k = montgomery_ctx_kernels(ctx);
+    k->redc(reduced.words, t, ctx->n.words, ctx->n_prime, s);
+    k->mul(reduced.words, reduced.words, ctx->r_squared.words, ctx->n.words, ctx->n_prime, s);
+    STATS_COUNT(RSA_4096_STAT_MONT_REDC, 1);
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, 1);
+    mont_residue_to_bigint(result, &reduced, ctx);
     return 0;
 }
 
 /* ===================== MONTGOMERY FORM CONVERSIONS - GIỮ NGUYÊN ===================== */
 
 int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx) {
-    printf("[MONT_TO_COMPLETE] Converting to Montgomery form\n");
+    TRACE(LOG_DEBUG, "[MONT_TO_COMPLETE] Converting to Montgomery form");
     debug_print_bigint("Input a", a);
-    debug_print_bigint("R^2 mod n", &ctx->r_squared);
     
     /* TODO: CRITICAL ROUND-TRIP VALIDATION - check for zero/invalid inputs */
     if (result == NULL || a == NULL || ctx == NULL) {
@@ -700,20 +1029,22 @@ int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx
         ERROR_RETURN(-2, "Montgomery context disabled");
     }
     
+    debug_print_residue("R^2 mod n", &ctx->r_squared, ctx);
+    
     /* FIXME: Critical validation - input range checking for small modulus */
     VALIDATE_OVERFLOW(a, "montgomery_to_form input");
-    if (bigint_compare(a, &ctx->n) >= 0) {
+    if (!bigint_below_modulus(a, ctx)) {
         CHECKPOINT(LOG_ERROR, "WARNING: Input a >= modulus in to_form conversion");
         debug_print_bigint("input a", a);
-        debug_print_bigint("modulus n", &ctx->n);
+        debug_print_residue("modulus n", &ctx->n, ctx);
         
         /* TODO: Auto-reduce input to valid range */
         bigint_t reduced_a;
-        int ret = bigint_mod(&reduced_a, a, &ctx->n);
+        int ret = montgomery_reduce(&reduced_a, a, ctx);
         if (ret != 0) {
             ERROR_RETURN(ret, "Failed to reduce input in to_form");
         }
-        printf("[ROUND_TRIP_DEBUG] Auto-reduced input: ");
+        TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] Auto-reduced input:");
         debug_print_bigint("reduced_a", &reduced_a);
         return montgomery_to_form(result, &reduced_a, ctx);
     }
@@ -722,46 +1053,35 @@ int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx
     bigint_t original_a;
     bigint_copy(&original_a, a);
     
-    /* FIXME: Critical multiplication - a * R^2 mod n */
-    /* a_mont = (a * R^2) * R^(-1) mod n = a * R mod n */
-    bigint_t temp;
-    int ret = bigint_mul(&temp, a, &ctx->r_squared);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed to compute a * R^2");
-    }
-    
-    /* TODO: CRITICAL - Check intermediate result for overflow */
-    VALIDATE_OVERFLOW(&temp, "montgomery_to_form multiplication");
-    debug_print_bigint("a * R^2", &temp);
-    
     /* TODO: Add manual verification for small values */
-    if (a->used == 1 && ctx->r_squared.used <= 2) {
-        printf("[ROUND_TRIP_DEBUG] Manual verification for a=%u, R^2 first word=%u\n", 
+    if (a->used == 1 && ctx->n_words <= 2) {
+        TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] Manual verification for a=%" PRIuWORD ", R^2 first word=%" PRIuWORD, 
                a->words[0], ctx->r_squared.words[0]);
     }
     
-    /* FIXME: REDC operation critical for round-trip correctness */
-    ret = montgomery_redc(result, &temp, ctx);
+    /* a_mont = (a * R^2) * R^(-1) mod n = a * R mod n, fused into one CIOS pass */
+    mont_residue_t a_res, a_mont;
+    mont_residue_from_bigint(&a_res, a, ctx);
+    int ret = montgomery_mul_residue(&a_mont, &a_res, &ctx->r_squared, ctx);
     if (ret != 0) {
-        ERROR_RETURN(ret, "Failed REDC in to_form");
+        ERROR_RETURN(ret, "Failed to compute a * R^2 * R^(-1)");
     }
+    mont_residue_to_bigint(result, &a_mont, ctx);
     
     /* TODO: CRITICAL - Final validation of conversion result */
-    if (bigint_compare(result, &ctx->n) >= 0) {
+    if (!bigint_below_modulus(result, ctx)) {
         CHECKPOINT(LOG_ERROR, "CRITICAL: to_form result >= modulus");
         debug_print_bigint("result", result);
-        debug_print_bigint("modulus", &ctx->n);
+        debug_print_residue("modulus", &ctx->n, ctx);
         ERROR_RETURN(-97, "to_form produced invalid result >= modulus");
     }
     
     /* TODO: Validate result is not zero unless input was zero */
     if (bigint_is_zero(result) && !bigint_is_zero(&original_a)) {
-        printf("[ROUND_TRIP_DEBUG] WARNING: Non-zero input produced zero Montgomery form\n");
+        TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: Non-zero input produced zero Montgomery form");
         debug_print_bigint("original_a", &original_a);
     }
     
-    /* TODO: Normalize result - critical for consistency */
-    bigint_normalize(result);
     debug_print_bigint("Montgomery form result", result);
     
     /* TODO: Add round-trip validation logging */
@@ -773,13 +1093,13 @@ int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx
         int test_ret = montgomery_from_form(&test_back, result, ctx);
         if (test_ret == 0) {
             if (bigint_compare(&test_back, &original_a) != 0) {
-                printf("[ROUND_TRIP_DEBUG] CRITICAL: Immediate round-trip validation failed!\n");
+                TRACE(LOG_ERROR, "[ROUND_TRIP_DEBUG] CRITICAL: Immediate round-trip validation failed!");
                 debug_print_bigint("original", &original_a);
                 debug_print_bigint("to_form", result);
                 debug_print_bigint("back_from_form", &test_back);
                 ERROR_RETURN(-96, "Round-trip validation failed in to_form");
             } else {
-                printf("[ROUND_TRIP_DEBUG] ✓ Immediate round-trip validation passed\n");
+                TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] ✓ Immediate round-trip validation passed");
             }
         }
     }
@@ -788,7 +1108,7 @@ int montgomery_to_form(bigint_t *result, const bigint_t *a, const montgomery_ctx
 }
 
 int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx) {
-    printf("[MONT_FROM_COMPLETE] Converting from Montgomery form\n");
+    TRACE(LOG_DEBUG, "[MONT_FROM_COMPLETE] Converting from Montgomery form");
     debug_print_bigint("Montgomery input", a);
     
     /* TODO: Critical validation for round-trip safety */
@@ -802,18 +1122,18 @@ int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_c
     
     /* FIXME: CRITICAL - Input validation for conversion safety with small modulus */
     VALIDATE_OVERFLOW(a, "montgomery_from_form input");
-    if (bigint_compare(a, &ctx->n) >= 0) {
+    if (!bigint_below_modulus(a, ctx)) {
         CHECKPOINT(LOG_ERROR, "WARNING: Montgomery input >= modulus in from_form conversion");
         debug_print_bigint("input a", a);
-        debug_print_bigint("modulus n", &ctx->n);
+        debug_print_residue("modulus n", &ctx->n, ctx);
         
         /* TODO: Auto-reduce input to valid range */
         bigint_t reduced_a;
-        int ret = bigint_mod(&reduced_a, a, &ctx->n);
+        int ret = montgomery_reduce(&reduced_a, a, ctx);
         if (ret != 0) {
             ERROR_RETURN(ret, "Failed to reduce input in from_form");
         }
-        printf("[ROUND_TRIP_DEBUG] Auto-reduced Montgomery input: ");
+        TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] Auto-reduced Montgomery input:");
         debug_print_bigint("reduced_a", &reduced_a);
         return montgomery_from_form(result, &reduced_a, ctx);
     }
@@ -822,35 +1142,26 @@ int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_c
     bigint_t original_a;
     bigint_copy(&original_a, a);
     
-    /* Check if r_inv is available - TODO: this check might be redundant */
-    if (bigint_is_zero(&ctx->r_inv) && ctx->r_inv.used == 0) {
-        printf("[MONT_FROM_COMPLETE] R^(-1) not available, using REDC-only method\n");
-    }
-    
-    /* FIXME: Critical REDC operation for round-trip correctness */
-    /* a_normal = a_mont * R^(-1) mod n */
-    /* This is accomplished by REDC(a_mont * 1) = REDC(a_mont) */
-    int ret = montgomery_redc(result, a, ctx);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed REDC in from_form");
-    }
+    /* a_normal = a_mont * R^(-1) mod n = REDC(a_mont) - R^(-1) itself is not needed */
+    mont_residue_t a_mont, a_normal;
+    mont_residue_from_bigint(&a_mont, a, ctx);
+    montgomery_residue_from_form(&a_normal, &a_mont, ctx);
+    mont_residue_to_bigint(result, &a_normal, ctx);
     
     /* TODO: CRITICAL - Final validation of conversion result */
-    if (bigint_compare(result, &ctx->n) >= 0) {
+    if (!bigint_below_modulus(result, ctx)) {
         CHECKPOINT(LOG_ERROR, "CRITICAL: from_form result >= modulus");
         debug_print_bigint("result", result);
-        debug_print_bigint("modulus", &ctx->n);
+        debug_print_residue("modulus", &ctx->n, ctx);
         ERROR_RETURN(-95, "from_form produced invalid result >= modulus");
     }
     
     /* TODO: Validate result consistency */
     if (bigint_is_zero(result) && !bigint_is_zero(&original_a)) {
-        printf("[ROUND_TRIP_DEBUG] WARNING: Non-zero Montgomery input produced zero normal form\n");
+        TRACE(LOG_INFO, "[ROUND_TRIP_DEBUG] WARNING: Non-zero Montgomery input produced zero normal form");
         debug_print_bigint("original_a", &original_a);
     }
     
-    /* TODO: Normalize result - critical for consistency */
-    bigint_normalize(result);
     debug_print_bigint("Normal form result", result);
     
     /* TODO: Add round-trip validation logging */
@@ -858,10 +1169,10 @@ int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_c
     
     /* TODO: Additional validation for small modulus */
     if (ctx->n_words == 1) {
-        printf("[ROUND_TRIP_DEBUG] Extra validation: from_form with single-word modulus\n");
-        printf("  Input Montgomery form: %u\n", original_a.used > 0 ? original_a.words[0] : 0);
-        printf("  Output normal form: %u\n", result->used > 0 ? result->words[0] : 0);
-        printf("  Modulus: %u\n", ctx->n.words[0]);
+        TRACE(LOG_DEBUG, "[ROUND_TRIP_DEBUG] Extra validation: from_form with single-word modulus");
+        TRACE(LOG_DEBUG, "  Input Montgomery form: %" PRIuWORD, original_a.used > 0 ? original_a.words[0] : 0);
+        TRACE(LOG_DEBUG, "  Output normal form: %" PRIuWORD, result->used > 0 ? result->words[0] : 0);
+        TRACE(LOG_DEBUG, "  Modulus: %" PRIuWORD, ctx->n.words[0]);
     }
     return 0;
 }
@@ -869,46 +1180,279 @@ int montgomery_from_form(bigint_t *result, const bigint_t *a, const montgomery_c
 /* ===================== MONTGOMERY ARITHMETIC - GIỮ NGUYÊN ===================== */
 
 int montgomery_mul(bigint_t *result, const bigint_t *a, const bigint_t *b, const montgomery_ctx_t *ctx) {
-    printf("[MONT_MUL_COMPLETE] Montgomery multiplication\n");
+    TRACE(LOG_DEBUG, "[MONT_MUL_COMPLETE] Montgomery multiplication");
     debug_print_bigint("a", a);
     debug_print_bigint("b", b);
     
+    if (result == NULL || a == NULL || b == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_mul");
+    }
+    
     if (!ctx->is_active || ctx->n_words == 0) {
         ERROR_RETURN(-1, "Montgomery context disabled");
     }
     
-    /* (a * b) * R^(-1) mod n */
-    bigint_t product;
-    int ret = bigint_mul(&product, a, b);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed to multiply a * b");
+    /* The fused kernel scans exactly n_words words and needs operands in [0, n) */
+    if (!bigint_below_modulus(a, ctx) || !bigint_below_modulus(b, ctx)) {
+        CHECKPOINT(LOG_ERROR, "WARNING: Montgomery operand >= modulus, reducing first");
+        bigint_t reduced_a, reduced_b;
+        int ret = montgomery_reduce(&reduced_a, a, ctx);
+        if (ret == 0) {
+            ret = montgomery_reduce(&reduced_b, b, ctx);
+        }
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Failed to reduce Montgomery operands");
+        }
+        return montgomery_mul(result, &reduced_a, &reduced_b, ctx);
     }
     
-    debug_print_bigint("a * b", &product);
+    /* (a * b) * R^(-1) mod n in one interleaved pass over fixed-width residues */
+    mont_residue_t a_res, b_res, out;
+    mont_residue_from_bigint(&a_res, a, ctx);
+    mont_residue_from_bigint(&b_res, b, ctx);
+    montgomery_mul_residue(&out, &a_res, &b_res, ctx);
+    mont_residue_to_bigint(result, &out, ctx);
     
-    ret = montgomery_redc(result, &product, ctx);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed REDC in montgomery_mul");
+    debug_print_bigint("Montgomery mul result", result);
+    return 0;
+}
+
+int montgomery_mul_ws(bigint_t *result, const bigint_t *a, const bigint_t *b, const montgomery_ctx_t *ctx,
+                      rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return montgomery_mul(result, a, b, ctx);
     }
     
-    debug_print_bigint("Montgomery mul result", result);
+    if (result == NULL || a == NULL || b == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_mul_ws");
+    }
+    
+    if (!ctx->is_active || ctx->n_words == 0) {
+        ERROR_RETURN(-1, "Montgomery context disabled");
+    }
+    
+    if (!bigint_below_modulus(a, ctx) || !bigint_below_modulus(b, ctx)) {
+        CHECKPOINT(LOG_ERROR, "WARNING: Montgomery operand >= modulus, reducing first");
+        int ret = montgomery_reduce(&ws->mul_tmp[1], a, ctx);
+        if (ret == 0) {
+            ret = montgomery_reduce(&ws->mul_tmp[2], b, ctx);
+        }
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Failed to reduce Montgomery operands");
+        }
+        a = &ws->mul_tmp[1];
+        b = &ws->mul_tmp[2];
+    }
+    
+    mont_residue_from_bigint(&ws->mul_res[0], a, ctx);
+    mont_residue_from_bigint(&ws->mul_res[1], b, ctx);
+    montgomery_mul_residue(&ws->mul_res[2], &ws->mul_res[0], &ws->mul_res[1], ctx);
+    mont_residue_to_bigint(result, &ws->mul_res[2], ctx);
     return 0;
 }
 
 int montgomery_square(bigint_t *result, const bigint_t *a, const montgomery_ctx_t *ctx) {
-    return montgomery_mul(result, a, a, ctx);
+    if (result == NULL || a == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_square");
+    }
+    
+    if (!ctx->is_active || ctx->n_words == 0) {
+        ERROR_RETURN(-1, "Montgomery context disabled");
+    }
+    
+    /* Out-of-range operands take the reducing path in montgomery_mul */
+    if (!bigint_below_modulus(a, ctx)) {
+        return montgomery_mul(result, a, a, ctx);
+    }
+    
+    mont_residue_t a_res, out;
+    mont_residue_from_bigint(&a_res, a, ctx);
+    montgomery_square_residue(&out, &a_res, ctx);
+    mont_residue_to_bigint(result, &out, ctx);
+    return 0;
+}
+
+/* Shortest exponent per width; the defaults hold until a tuning profile is applied */
+static const int window_default_bits[MONTGOMERY_MAX_WINDOW + 1] = MONTGOMERY_WINDOW_DEFAULT_BITS;
+static int window_min_bits[MONTGOMERY_MAX_WINDOW + 1] = MONTGOMERY_WINDOW_DEFAULT_BITS;
+
+/**
+ * @brief Pick a sliding-window width for an exponent of the given bit length
+ *
+ * The default thresholds balance the 2^(k-1) odd-power precomputation against the
+ * ~n/(k+1) multiplications saved; short exponents such as e = 65537 stay on
+ * plain binary where a table would cost more than it saves.
+ */
+int montgomery_select_window(int exp_bits) {
+    for (int w = MONTGOMERY_MAX_WINDOW; w >= 2; w--) {
+        if (window_min_bits[w] > 0 && exp_bits >= window_min_bits[w]) {
+            return w;
+        }
+    }
+    return 1;
+}
+
+int montgomery_set_window_thresholds(const int *min_bits) {
+    const int *src = min_bits != NULL ? min_bits : window_default_bits;
+    int last = 0;
+    for (int w = 2; w <= MONTGOMERY_MAX_WINDOW; w++) {
+        if (src[w] < 0 || (src[w] > 0 && src[w] <= last)) {
+            ERROR_RETURN(-1, "Window %d threshold %d not above the narrower widths", w, src[w]);
+        }
+        if (src[w] > 0) {
+            last = src[w];
+        }
+    }
+    for (int w = 2; w <= MONTGOMERY_MAX_WINDOW; w++) {
+        window_min_bits[w] = src[w];
+    }
+    return 0;
+}
+
+void montgomery_get_window_thresholds(int *min_bits) {
+    if (min_bits != NULL) {
+        memcpy(min_bits, window_min_bits, sizeof(window_min_bits));
+    }
+}
+
+/* Exponentiation loops run on the almost-Montgomery kernels unless switched off */
+static int montgomery_lazy = 1;
+
+void montgomery_set_lazy_reduction(int on) {
+    montgomery_lazy = (on != 0);
+}
+
+int montgomery_lazy_reduction(void) {
+    return montgomery_lazy;
+}
+
+/* ===================== KERNEL-AGNOSTIC SLIDING WINDOW ===================== */
+
+static void montgomery_kernel_sqr(const mont_exp_kernel_t *kernel, void *out, const void *a) {
+    if (kernel->sqr != NULL) {
+        kernel->sqr(out, a, kernel->kernel_ctx);
+    } else {
+        kernel->mul(out, a, a, kernel->kernel_ctx);
+    }
+}
+
+void montgomery_exp_sliding(const mont_exp_kernel_t *kernel, void *acc, void *table, void *scratch,
+                            const bigint_t *exp, int window_bits, int *squarings, int *multiplies) {
+    size_t size = kernel->elem_size;
+    int table_size = 1 << (window_bits - 1);
+    int exp_bits = bigint_bit_length(exp);
+    char *powers = (char *)table;
+    
+    /* Odd powers base^1, base^3, ..., base^(2^k - 1), all kept in Montgomery form */
+    if (table_size > 1) {
+        montgomery_kernel_sqr(kernel, scratch, powers);
+        (*squarings)++;
+        for (int t = 1; t < table_size; t++) {
+            kernel->mul(powers + t * size, powers + (t - 1) * size, scratch, kernel->kernel_ctx);
+            (*multiplies)++;
+        }
+    }
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] Precomputed %d odd window powers", table_size);
+    
+    /* Left-to-right sliding window: zero bits cost one squaring, each window of
+     * up to k bits ending in a 1 costs its length in squarings plus one multiply.
+     * With k = 1 this is plain left-to-right binary exponentiation. */
+    int started = 0;
+    int i = exp_bits - 1;
+    while (i >= 0) {
+        if (!bigint_get_bit(exp, i)) {
+            montgomery_kernel_sqr(kernel, acc, acc);
+            (*squarings)++;
+            i--;
+            continue;
+        }
+        
+        /* Longest window [i .. j] of at most k bits whose lowest bit is set */
+        int j = i - window_bits + 1;
+        if (j < 0) j = 0;
+        while (!bigint_get_bit(exp, j)) j++;
+        
+        int value = 0;
+        for (int b = i; b >= j; b--) {
+            value = (value << 1) | bigint_get_bit(exp, b);
+        }
+        
+        if (!started) {
+            /* Leading window: no squarings needed, the top bit is always set */
+            memcpy(acc, powers + (value >> 1) * size, size);
+            started = 1;
+        } else {
+            for (int b = i; b >= j; b--) {
+                montgomery_kernel_sqr(kernel, acc, acc);
+                (*squarings)++;
+            }
+            kernel->mul(acc, acc, powers + (value >> 1) * size, kernel->kernel_ctx);
+            (*multiplies)++;
+        }
+        i = j - 1;
+    }
+    
+    /* Clear base-dependent precomputation */
+    memset(table, 0, (size_t)table_size * size);
+    memset(scratch, 0, size);
+}
+
+/**
+ * @brief Scalar CIOS kernel over fixed-width residues for montgomery_exp_sliding()
+ */
+static void montgomery_residue_kernel_mul(void *out, const void *a, const void *b, const void *kernel_ctx) {
+    const montgomery_ctx_t *ctx = (const montgomery_ctx_t *)kernel_ctx;
+    montgomery_ctx_kernels(ctx)->mul(((mont_residue_t *)out)->words, ((const mont_residue_t *)a)->words,
+                                     ((const mont_residue_t *)b)->words, ctx->n.words, ctx->n_prime, ctx->n_words);
+}
+
+static void montgomery_residue_kernel_sqr(void *out, const void *a, const void *kernel_ctx) {
+    const montgomery_ctx_t *ctx = (const montgomery_ctx_t *)kernel_ctx;
+    montgomery_ctx_kernels(ctx)->sqr(((mont_residue_t *)out)->words, ((const mont_residue_t *)a)->words,
+                                     ctx->n.words, ctx->n_prime, ctx->n_words);
+}
+
+/* Almost-Montgomery variants: values stay in [0, R) and only the closing REDC reduces below n */
+static void montgomery_residue_kernel_amm_mul(void *out, const void *a, const void *b, const void *kernel_ctx) {
+    const montgomery_ctx_t *ctx = (const montgomery_ctx_t *)kernel_ctx;
+    montgomery_ctx_kernels(ctx)->amm_mul(((mont_residue_t *)out)->words, ((const mont_residue_t *)a)->words,
+                                         ((const mont_residue_t *)b)->words, ctx->n.words, ctx->n_prime,
+                                         ctx->n_words);
+}
+
+static void montgomery_residue_kernel_amm_sqr(void *out, const void *a, const void *kernel_ctx) {
+    const montgomery_ctx_t *ctx = (const montgomery_ctx_t *)kernel_ctx;
+    montgomery_ctx_kernels(ctx)->amm_sqr(((mont_residue_t *)out)->words, ((const mont_residue_t *)a)->words,
+                                         ctx->n.words, ctx->n_prime, ctx->n_words);
 }
 
 int montgomery_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const montgomery_ctx_t *ctx) {
-    printf("[MONT_EXP_COMPLETE] Complete Montgomery exponentiation\n");
+    return montgomery_exp_window(result, base, exp, ctx, MONTGOMERY_WINDOW_AUTO);
+}
+
+/**
+ * @brief Sliding-window exponentiation with all per-call state in s
+ */
+static int montgomery_exp_scratch(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                                  const montgomery_ctx_t *ctx, int window_bits, mont_exp_scratch_t *s) {
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] Complete Montgomery exponentiation");
     debug_print_bigint("Base", base);
     debug_print_bigint("Exponent", exp);
-    debug_print_bigint("Modulus", &ctx->n);
+    
+    if (result == NULL || base == NULL || exp == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_exp");
+    }
     
     if (!ctx->is_active || ctx->n_words == 0) {
         ERROR_RETURN(-1, "Montgomery context disabled");
     }
     
+    if (window_bits < 0 || window_bits > MONTGOMERY_MAX_WINDOW) {
+        ERROR_RETURN(-2, "Invalid window size %d (0 = auto, 1..%d)", window_bits, MONTGOMERY_MAX_WINDOW);
+    }
+    
+    debug_print_residue("Modulus", &ctx->n, ctx);
+    
     if (bigint_is_zero(exp)) {
         bigint_set_u32(result, 1);
         return 0;
@@ -919,74 +1463,188 @@ int montgomery_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
         return 0;
     }
     
-    /* Convert base to Montgomery form */
-    bigint_t mont_base, mont_result;
-    int ret = montgomery_to_form(&mont_base, base, ctx);
+    /* Reduce the base first if it is >= n; below n * R this is one REDC and one multiply */
+    if (!bigint_below_modulus(base, ctx)) {
+        int ret = montgomery_reduce(&s->reduced, base, ctx);
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Failed to reduce base before exponentiation");
+        }
+        base = &s->reduced;
+    }
+    
+    int exp_bits = bigint_bit_length(exp);
+    if (window_bits == MONTGOMERY_WINDOW_AUTO) {
+        window_bits = montgomery_select_window(exp_bits);
+    }
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] Processing %d exponent bits with %d-bit window", exp_bits, window_bits);
+    
+    /* Vector kernels run the whole exponentiation in their own limb radix */
+    int ret = montgomery_simd_exp(result, base, exp, ctx, window_bits, s);
+    if (ret <= 0) {
+        return ret;
+    }
+    
+    /* Load base as a fixed-width residue and convert it to Montgomery form; table[0] holds it */
+    mont_residue_t *mont_base = &s->table[0], *mont_result = &s->acc;
+    uint64_t stats_start = STATS_START();
+    mont_residue_from_bigint(mont_base, base, ctx);
+    ret = montgomery_mul_residue(mont_base, mont_base, &ctx->r_squared, ctx);
     if (ret != 0) {
         ERROR_RETURN(ret, "Failed to convert base to Montgomery form");
     }
+    STATS_TIME(RSA_4096_TIME_CONVERT, stats_start);
+    STATS_COUNT(RSA_4096_STAT_MONT_EXP, 1);
     
-    printf("[MONT_EXP_COMPLETE] Starting square-and-multiply\n");
-    debug_print_bigint("Initial mont_base", &mont_base);
-    debug_print_bigint("Initial mont_result (1)", &mont_result);
+    int squarings = 0, multiplies = 0;
     
-    /* Binary exponentiation - FIXED: Correct left-to-right method */
-    int exp_bits = bigint_bit_length(exp);
-    printf("[MONT_EXP_COMPLETE] Processing %d exponent bits\n", exp_bits);
+    /* Montgomery form of 1 is R mod n, precomputed in the context */
+    memcpy(mont_result->words, ctx->r_mod_n.words, (size_t)ctx->n_words * sizeof(bigint_word_t));
     
-    /* Standard left-to-right binary method */
-    bigint_set_u32(&mont_result, 1);
-    ret = montgomery_to_form(&mont_result, &mont_result, ctx);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed to convert 1 to Montgomery form");
+    mont_exp_kernel_t kernel = {montgomery_residue_kernel_mul, montgomery_residue_kernel_sqr, ctx,
+                                 sizeof(mont_residue_t)};
+    if (montgomery_lazy) {
+        kernel.mul = montgomery_residue_kernel_amm_mul;
+        kernel.sqr = montgomery_residue_kernel_amm_sqr;
     }
+    montgomery_exp_sliding(&kernel, mont_result, s->table, &s->scratch, exp, window_bits, &squarings, &multiplies);
+    STATS_COUNT(RSA_4096_STAT_MONT_SQR, (uint64_t)squarings);
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, (uint64_t)multiplies);
     
-    /* Start from MSB (left-to-right method) */
-    for (int i = exp_bits - 1; i >= 0; i--) {
-        /* Square the result (except for the very first iteration) */
-        if (i < exp_bits - 1) {
-            bigint_t temp;
-            ret = montgomery_square(&temp, &mont_result, ctx);
-            if (ret != 0) {
-                ERROR_RETURN(ret, "Failed Montgomery squaring at bit %d", i);
-            }
-            bigint_copy(&mont_result, &temp);
-            
-            if (i < 5 || i % 100 == 0) {
-                printf("[MONT_EXP_COMPLETE] Squaring result for bit %d\n", i);
-            }
-        }
-        
-        /* If bit is set, multiply by base */
-        if (bigint_get_bit(exp, i)) {
-            bigint_t temp;
-            ret = montgomery_mul(&temp, &mont_result, &mont_base, ctx);
-            if (ret != 0) {
-                ERROR_RETURN(ret, "Failed Montgomery multiplication at bit %d", i);
-            }
-            bigint_copy(&mont_result, &temp);
-            
-            if (i < 10 || i % 50 == 0) {
-                printf("[MONT_EXP_COMPLETE] Bit %d is set, multiplying result by base\n", i);
-            }
-        }
-        
-        if (i % 100 == 0) {
-            printf("[MONT_EXP_COMPLETE] Progress: bit %d/%d (%.1f%%)\n", 
-                   exp_bits - 1 - i, exp_bits, (100.0 * (exp_bits - 1 - i)) / exp_bits);
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] %d squarings, %d multiplications", squarings, multiplies);
+    
+    /* Convert result back from Montgomery form; REDC of anything below R lands in [0, n) */
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] Converting result back from Montgomery form");
+    montgomery_residue_from_form(mont_result, mont_result, ctx);
+    mont_residue_to_bigint(result, mont_result, ctx);
+    
+    debug_print_bigint("Final exponentiation result", result);
+    
+    TRACE(LOG_DEBUG, "[MONT_EXP_COMPLETE] ✅ Complete Montgomery exponentiation finished");
+    return 0;
+}
+
+int montgomery_exp_window(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                          const montgomery_ctx_t *ctx, int window_bits) {
+    mont_exp_scratch_t s;
+    uint64_t stats_start = STATS_START();
+    int ret = montgomery_exp_scratch(result, base, exp, ctx, window_bits, &s);
+    STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+    return ret;
+}
+
+int montgomery_exp_ws(bigint_t *result, const bigint_t *base, const bigint_t *exp, const montgomery_ctx_t *ctx,
+                      rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return montgomery_exp(result, base, exp, ctx);
+    }
+    uint64_t stats_start = STATS_START();
+    int ret = montgomery_exp_scratch(result, base, exp, ctx, MONTGOMERY_WINDOW_AUTO, &ws->exp);
+    STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+    return ret;
+}
+
+/**
+ * @brief result = base^exp mod n for a one-word exponent (e = 3, 17, 65537, ...)
+ *
+ * Public-key path: plain left-to-right binary with no window table. Without a
+ * vector kernel it runs on the scalar squaring kernel; for odd exponents the final multiply
+ * takes the base in normal form, so CIOS(base^(e-1) * R, base) leaves
+ * Montgomery form on its own and no closing REDC is needed - e = 65537 costs
+ * one conversion, 16 squarings and a single multiply.
+ */
+static int montgomery_exp_word_scratch(bigint_t *result, const bigint_t *base, bigint_word_t exp,
+                                       const montgomery_ctx_t *ctx, mont_exp_scratch_t *s) {
+    if (result == NULL || base == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_exp_word");
+    }
+    
+    if (!ctx->is_active || ctx->n_words == 0) {
+        ERROR_RETURN(-1, "Montgomery context disabled");
+    }
+    
+    if (!bigint_below_modulus(base, ctx)) {
+        int ret = montgomery_reduce(&s->reduced, base, ctx);
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Failed to reduce base before exponentiation");
         }
+        base = &s->reduced;
     }
     
-    /* Convert result back from Montgomery form */
-    printf("[MONT_EXP_COMPLETE] Converting result back from Montgomery form\n");
-    ret = montgomery_from_form(result, &mont_result, ctx);
-    if (ret != 0) {
-        ERROR_RETURN(ret, "Failed to convert result from Montgomery form");
+    if (exp == 0) {
+        bigint_set_u32(result, 1);
+        return 0;
     }
     
-    debug_print_bigint("Final exponentiation result", result);
-    debug_verify_invariant("Final result", result, &ctx->n);
+    mont_residue_t *plain = &s->table[0], *mont_base = &s->table[1], *acc = &s->acc;
+    mont_residue_from_bigint(plain, base, ctx);
+    if (exp == 1 || bigint_is_zero(base)) {
+        mont_residue_to_bigint(result, plain, ctx);
+        return 0;
+    }
+    
+    /* A vector kernel still wins over 17 scalar operations despite its own domain setup */
+    bigint_t *exp_big = &s->word_exp;
+    bigint_init(exp_big);
+    exp_big->words[0] = exp;
+    exp_big->used = 1;
+    int ret = montgomery_simd_exp(result, base, exp_big, ctx, 1, s);
+    if (ret <= 0) {
+        return ret;
+    }
     
-    printf("[MONT_EXP_COMPLETE] ✅ Complete Montgomery exponentiation finished\n");
+    /* The top bit seeds the accumulator with base * R */
+    int top = BIGINT_WORD_SIZE - 1;
+    while (!((exp >> top) & 1)) top--;
+    ret = montgomery_mul_residue(mont_base, plain, &ctx->r_squared, ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to convert base to Montgomery form");
+    }
+    STATS_COUNT(RSA_4096_STAT_MONT_EXP, 1);
+    *acc = *mont_base;
+    
+    /* Every squaring, the last included, may run lazily: a strict CIOS by the plain base
+     * (< n) or the closing REDC still brings an acc below R into [0, n) */
+    const montgomery_kernels_t *k = montgomery_ctx_kernels(ctx);
+    void (*sqr)(bigint_word_t *, const bigint_word_t *, const bigint_word_t *, bigint_word_t, int) =
+        montgomery_lazy ? k->amm_sqr : k->sqr;
+    void (*mul)(bigint_word_t *, const bigint_word_t *, const bigint_word_t *, const bigint_word_t *,
+                bigint_word_t, int) = montgomery_lazy ? k->amm_mul : k->mul;
+    int squarings = 0, multiplies = 0;
+    for (int i = top - 1; i >= 0; i--) {
+        sqr(acc->words, acc->words, ctx->n.words, ctx->n_prime, ctx->n_words);
+        squarings++;
+        if (i >= 1 && ((exp >> i) & 1)) {
+            mul(acc->words, acc->words, mont_base->words, ctx->n.words, ctx->n_prime, ctx->n_words);
+            multiplies++;
+        }
+    }
+    STATS_COUNT(RSA_4096_STAT_MONT_SQR, (uint64_t)squarings);
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, (uint64_t)multiplies);
+    
+    if (exp & 1) {
+        montgomery_mul_residue(acc, acc, plain, ctx);
+    } else {
+        montgomery_residue_from_form(acc, acc, ctx);
+    }
+    mont_residue_to_bigint(result, acc, ctx);
     return 0;
-}
\ No newline at end of file
+}
+
+int montgomery_exp_word(bigint_t *result, const bigint_t *base, bigint_word_t exp, const montgomery_ctx_t *ctx) {
+    mont_exp_scratch_t s;
+    uint64_t stats_start = STATS_START();
+    int ret = montgomery_exp_word_scratch(result, base, exp, ctx, &s);
+    STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+    return ret;
+}
+
+int montgomery_exp_word_ws(bigint_t *result, const bigint_t *base, bigint_word_t exp, const montgomery_ctx_t *ctx,
+                           rsa_4096_workspace_t *ws) {
+    if (ws == NULL) {
+        return montgomery_exp_word(result, base, exp, ctx);
+    }
+    uint64_t stats_start = STATS_START();
+    int ret = montgomery_exp_word_scratch(result, base, exp, ctx, &ws->exp);
+    STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+    return ret;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file rsa_4096_parallel.c
+ * @brief Helper thread that runs one CRT half alongside the decrypting caller
+ *
+ * A single latency-bound decrypt leaves every other core idle. With the
+ * helper running, rsa_4096_crt_exp() hands the mod-q exponentiation to it,
+ * computes the mod-p half itself and recombines once both are done, so one
+ * decrypt finishes in roughly the time of one half.
+ *
+ * There is one helper and one job slot. A caller that finds the slot taken -
+ * another thread is mid-decrypt - runs both halves itself instead of
+ * queueing behind it, so the option never adds latency under load. The
+ * helper owns its workspace; the job only borrows the caller's operands and
+ * result until rsa_4096_parallel_crt_finish() returns.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _GNU_SOURCE   /* pthread_setaffinity_np */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "rsa_4096.h"
+
+/* The helper only runs montgomery_exp_ws on its heap workspace, whose deepest call chain
+ * (REDC-based base reduction, vector kernels) stays under 20 KB; the rest is headroom */
+#define CRT_HELPER_STACK_SIZE (64u * 1024u)
+
+/* ===================== HELPER STATE ===================== */
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work;            /* Helper waits here for a job or stop */
+    pthread_cond_t done;            /* Job owner waits here for the result */
+    pthread_t thread;
+    rsa_4096_workspace_t *ws;
+    int running;
+    int stop;
+    int busy;                       /* A caller owns the slot, from begin to finish */
+    int pending;                    /* Job posted, not yet picked up */
+    int finished;                   /* Job result ready */
+    int status;
+    
+    bigint_t *result;
+    const bigint_t *base, *exp;
+    const montgomery_ctx_t *ctx;
+    
+    size_t offloaded;
+    size_t busy_misses;
+} crt_helper_t;
+
+static crt_helper_t helper = {
+    .lock = PTHREAD_MUTEX_INITIALIZER, .work = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER
+};
+
+static void *crt_helper_main(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&helper.lock);
+    for (;;) {
+        while (!helper.pending && !helper.stop) {
+            pthread_cond_wait(&helper.work, &helper.lock);
+        }
+        if (!helper.pending) {
+            break;
+        }
+        helper.pending = 0;
+        pthread_mutex_unlock(&helper.lock);
+    
+        int status = montgomery_exp_ws(helper.result, helper.base, helper.exp, helper.ctx, helper.ws);
+        /* The half exponent's intermediates must not outlive the job */
+        rsa_4096_workspace_clear(helper.ws);
+    
+        pthread_mutex_lock(&helper.lock);
+        helper.status = status;
+        helper.finished = 1;
+        pthread_cond_signal(&helper.done);
+    }
+    pthread_mutex_unlock(&helper.lock);
+    return NULL;
+}
+
+/* ===================== LIFECYCLE ===================== */
+
+int rsa_4096_parallel_crt_start(int cpu) {
+    pthread_mutex_lock(&helper.lock);
+    if (helper.running) {
+        pthread_mutex_unlock(&helper.lock);
+        return 0;
+    }
+    
+    helper.ws = rsa_4096_workspace_new();
+    if (helper.ws == NULL) {
+        pthread_mutex_unlock(&helper.lock);
+        ERROR_RETURN(-2, "Out of memory for the CRT helper workspace");
+    }
+    helper.stop = helper.busy = helper.pending = helper.finished = 0;
+    
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, CRT_HELPER_STACK_SIZE);
+    int ret = pthread_create(&helper.thread, &attr, crt_helper_main, NULL);
+    pthread_attr_destroy(&attr);
+    if (ret != 0) {
+        rsa_4096_workspace_free(helper.ws);
+        helper.ws = NULL;
+        pthread_mutex_unlock(&helper.lock);
+        ERROR_RETURN(-1, "Failed to start the CRT helper thread (%d)", ret);
+    }
+    
+#ifdef __linux__
+    /* Pinning is a latency hint only; an unusable CPU number leaves the helper floating */
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        if (pthread_setaffinity_np(helper.thread, sizeof(set), &set) != 0) {
+            CHECKPOINT(LOG_ERROR, "CRT helper could not be pinned to CPU %d", cpu);
+        }
+    }
+#else
+    (void)cpu;
+#endif
+    
+    helper.running = 1;
+    pthread_mutex_unlock(&helper.lock);
+    TRACE(LOG_INFO, "[PARALLEL_CRT] Helper thread started%s", cpu >= 0 ? " (pinned)" : "");
+    return 0;
+}
+
+void rsa_4096_parallel_crt_stop(void) {
+    pthread_mutex_lock(&helper.lock);
+    if (!helper.running) {
+        pthread_mutex_unlock(&helper.lock);
+        return;
+    }
+    /* A job already posted is still run, so its owner's finish returns normally */
+    helper.stop = 1;
+    helper.running = 0;
+    pthread_cond_signal(&helper.work);
+    pthread_mutex_unlock(&helper.lock);
+    pthread_join(helper.thread, NULL);
+    
+    pthread_mutex_lock(&helper.lock);
+    rsa_4096_workspace_free(helper.ws);
+    helper.ws = NULL;
+    pthread_mutex_unlock(&helper.lock);
+}
+
+int rsa_4096_parallel_crt_active(void) {
+    pthread_mutex_lock(&helper.lock);
+    int running = helper.running;
+    pthread_mutex_unlock(&helper.lock);
+    return running;
+}
+
+void rsa_4096_parallel_crt_get_stats(rsa_4096_parallel_crt_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&helper.lock);
+    stats->offloaded = helper.offloaded;
+    stats->busy_misses = helper.busy_misses;
+    pthread_mutex_unlock(&helper.lock);
+}
+
+/* ===================== JOB HAND-OFF ===================== */
+
+int rsa_4096_parallel_crt_begin(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                                const montgomery_ctx_t *ctx) {
+    if (result == NULL || base == NULL || exp == NULL || ctx == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_parallel_crt_begin");
+    }
+    
+    pthread_mutex_lock(&helper.lock);
+    if (!helper.running || helper.busy) {
+        if (helper.running) helper.busy_misses++;
+        pthread_mutex_unlock(&helper.lock);
+        return 1;
+    }
+    helper.busy = 1;
+    helper.result = result;
+    helper.base = base;
+    helper.exp = exp;
+    helper.ctx = ctx;
+    helper.finished = 0;
+    helper.pending = 1;
+    helper.offloaded++;
+    pthread_cond_signal(&helper.work);
+    pthread_mutex_unlock(&helper.lock);
+    return 0;
+}
+
+int rsa_4096_parallel_crt_finish(void) {
+    pthread_mutex_lock(&helper.lock);
+    while (!helper.finished) {
+        pthread_cond_wait(&helper.done, &helper.lock);
+    }
+    int status = helper.status;
+    helper.finished = 0;
+    helper.busy = 0;
+    pthread_mutex_unlock(&helper.lock);
+    return status;
+}
@@ -0,0 +1,331 @@
+/**
+ * @file rsa_4096_registry.c
+ * @brief Shared, read-mostly registry of loaded keys keyed by modulus fingerprint
+ *
+ * Every entry owns one fully prepared rsa_4096_key_t - modulus, exponent,
+ * Montgomery context and, for private keys, the CRT contexts - so thousands
+ * of tenant keys are built once and shared by every worker instead of being
+ * copied per thread.
+ *
+ * Lookups are lock-free: they walk a bucket chain with atomic loads and take
+ * a reference with a compare-and-swap that never resurrects a dying entry.
+ * Inserts and evictions serialise on one mutex. An evicted entry is unlinked
+ * at once but only freed when its last holder has released it and no lookup
+ * is still walking a chain, so a lookup never touches freed memory and a
+ * holder's key stays valid after eviction. Eviction is CLOCK: a lookup sets
+ * the entry's reference bit, and the hand evicts the first entry found with
+ * the bit clear, clearing bits as it passes.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "rsa_4096.h"
+
+/* ===================== REGISTRY STATE ===================== */
+
+typedef struct registry_entry {
+    rsa_4096_key_t key;                     /* First member: callers hold &entry->key */
+    uint64_t fingerprint;
+    struct registry_entry *next;            /* Bucket chain, atomic: read without the lock */
+    rsa_4096_registry_t *owner;
+    unsigned refs;                          /* Holders, plus one while linked; atomic */
+    int referenced;                         /* CLOCK bit, set by lookups; atomic */
+    size_t slot;                            /* Position in owner->slots while linked */
+    struct registry_entry *retired_next;
+} registry_entry_t;
+
+struct rsa_4096_registry {
+    size_t capacity;
+    size_t bucket_mask;
+    registry_entry_t **buckets;             /* Chain heads, atomic */
+    registry_entry_t **slots;               /* Linked entries for the CLOCK hand */
+    size_t count;
+    size_t hand;
+    pthread_mutex_t lock;                   /* Inserts, evictions and the retired list */
+    registry_entry_t *retired;              /* Unlinked, waiting for their last release */
+    unsigned long readers;                  /* Lookups currently walking a chain; atomic */
+    size_t hits, misses;                    /* Atomic, relaxed */
+    size_t inserts, evictions;
+};
+
+uint64_t rsa_4096_modulus_fingerprint(const bigint_t *n) {
+    if (n == NULL) {
+        return 0;
+    }
+    /* 32-bit pieces of the value, so both limb widths give the same fingerprint */
+    int pieces = (bigint_bit_length(n) + 31) / 32;
+    uint64_t h = 0x243F6A8885A308D3ull ^ (uint64_t)pieces;
+    for (int i = 0; i < pieces; i++) {
+        uint32_t piece = (uint32_t)(n->words[i * 32 / BIGINT_WORD_SIZE] >> ((i * 32) % BIGINT_WORD_SIZE));
+        h = (h ^ piece) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    return h;
+}
+
+static size_t registry_bucket(const rsa_4096_registry_t *reg, uint64_t fingerprint, int is_private) {
+    return (size_t)(fingerprint ^ (is_private ? 0x5bd1e995u : 0u)) & reg->bucket_mask;
+}
+
+static int registry_entry_matches(const registry_entry_t *e, uint64_t fingerprint, const bigint_t *n,
+                                  int is_private) {
+    return e->fingerprint == fingerprint && (e->key.is_private != 0) == is_private &&
+           bigint_compare(&e->key.n, n) == 0;
+}
+
+/* ===================== REFERENCES AND RECLAMATION ===================== */
+
+/**
+ * @brief Take a reference unless the count already reached zero (entry being retired)
+ */
+static int registry_try_acquire(registry_entry_t *e) {
+    unsigned refs = __atomic_load_n(&e->refs, __ATOMIC_ACQUIRE);
+    while (refs != 0) {
+        if (__atomic_compare_exchange_n(&e->refs, &refs, refs + 1, 1, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void registry_entry_free(registry_entry_t *e) {
+    rsa_4096_free(&e->key);     /* Wipes the key material */
+    free(e);
+}
+
+/**
+ * @brief Free retired entries nobody holds; caller holds reg->lock
+ *
+ * A lookup that could still reach a retired entry started before it was
+ * unlinked and is counted in readers, so an empty reader count means only
+ * holders remain - and refs == 0 means there are none. Whatever cannot be
+ * freed yet is retried on the next insert or final release.
+ */
+static void registry_sweep(rsa_4096_registry_t *reg) {
+    if (__atomic_load_n(&reg->readers, __ATOMIC_SEQ_CST) != 0) {
+        return;
+    }
+    registry_entry_t **link = &reg->retired;
+    while (*link != NULL) {
+        registry_entry_t *e = *link;
+        if (__atomic_load_n(&e->refs, __ATOMIC_ACQUIRE) == 0) {
+            *link = e->retired_next;
+            registry_entry_free(e);
+        } else {
+            link = &e->retired_next;
+        }
+    }
+}
+
+/**
+ * @brief Remove an entry from its chain and the CLOCK ring; caller holds reg->lock
+ */
+static void registry_unlink(rsa_4096_registry_t *reg, registry_entry_t *e) {
+    registry_entry_t **link = &reg->buckets[registry_bucket(reg, e->fingerprint, e->key.is_private)];
+    while (*link != e) {
+        link = &(*link)->next;
+    }
+    /* e->next stays intact: a lookup standing on e still finds the rest of the chain */
+    __atomic_store_n(link, e->next, __ATOMIC_SEQ_CST);
+    
+    size_t last = --reg->count;
+    reg->slots[e->slot] = reg->slots[last];
+    reg->slots[e->slot]->slot = e->slot;
+    reg->slots[last] = NULL;
+    if (reg->hand >= reg->count) {
+        reg->hand = 0;
+    }
+    
+    e->retired_next = reg->retired;
+    reg->retired = e;
+    __atomic_sub_fetch(&e->refs, 1, __ATOMIC_ACQ_REL);     /* The registry's own reference */
+}
+
+/**
+ * @brief CLOCK eviction: pass over recently used entries once, evict the first cold one
+ */
+static void registry_evict(rsa_4096_registry_t *reg) {
+    for (;;) {
+        registry_entry_t *e = reg->slots[reg->hand];
+        if (__atomic_exchange_n(&e->referenced, 0, __ATOMIC_RELAXED)) {
+            reg->hand = (reg->hand + 1) % reg->count;
+            continue;
+        }
+        TRACE(LOG_DEBUG, "[REGISTRY] evicting %016llx", (unsigned long long)e->fingerprint);
+        registry_unlink(reg, e);
+        reg->evictions++;
+        return;
+    }
+}
+
+/* ===================== PUBLIC API ===================== */
+
+rsa_4096_registry_t *rsa_4096_registry_new(size_t capacity) {
+    if (capacity == 0) {
+        capacity = RSA_4096_REGISTRY_DEFAULT_CAPACITY;
+    }
+    size_t buckets = 16;
+    while (buckets < 2 * capacity) {
+        buckets *= 2;
+    }
+    
+    rsa_4096_registry_t *reg = calloc(1, sizeof(rsa_4096_registry_t));
+    if (reg != NULL) {
+        reg->buckets = calloc(buckets, sizeof(registry_entry_t *));
+        reg->slots = calloc(capacity, sizeof(registry_entry_t *));
+    }
+    if (reg == NULL || reg->buckets == NULL || reg->slots == NULL) {
+        if (reg != NULL) {
+            free(reg->buckets);
+            free(reg->slots);
+            free(reg);
+        }
+        CHECKPOINT(LOG_ERROR, "Out of memory for key registry of %zu entries", capacity);
+        return NULL;
+    }
+    reg->capacity = capacity;
+    reg->bucket_mask = buckets - 1;
+    pthread_mutex_init(&reg->lock, NULL);
+    return reg;
+}
+
+void rsa_4096_registry_free(rsa_4096_registry_t *reg) {
+    if (reg == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < reg->count; i++) {
+        registry_entry_free(reg->slots[i]);
+    }
+    while (reg->retired != NULL) {
+        registry_entry_t *e = reg->retired;
+        reg->retired = e->retired_next;
+        registry_entry_free(e);
+    }
+    pthread_mutex_destroy(&reg->lock);
+    free(reg->buckets);
+    free(reg->slots);
+    free(reg);
+}
+
+const rsa_4096_key_t *rsa_4096_registry_insert(rsa_4096_registry_t *reg, const rsa_4096_key_t *key) {
+    if (reg == NULL || key == NULL || bigint_is_zero(&key->n)) {
+        CHECKPOINT(LOG_ERROR, "Invalid arguments to rsa_4096_registry_insert");
+        return NULL;
+    }
+    uint64_t fingerprint = rsa_4096_modulus_fingerprint(&key->n);
+    int is_private = key->is_private != 0;
+    
+    pthread_mutex_lock(&reg->lock);
+    registry_entry_t **head = &reg->buckets[registry_bucket(reg, fingerprint, is_private)];
+    registry_entry_t *old = *head;
+    while (old != NULL && !registry_entry_matches(old, fingerprint, &key->n, is_private)) {
+        old = old->next;
+    }
+    
+    /* Same key again (or one that adds nothing over the registered CRT form): share it */
+    if (old != NULL && bigint_compare(&old->key.exponent, &key->exponent) == 0 &&
+        (old->key.has_crt || !key->has_crt)) {
+        __atomic_add_fetch(&old->refs, 1, __ATOMIC_ACQ_REL);
+        pthread_mutex_unlock(&reg->lock);
+        return &old->key;
+    }
+    
+    registry_entry_t *e = malloc(sizeof(registry_entry_t));
+    if (e == NULL) {
+        pthread_mutex_unlock(&reg->lock);
+        CHECKPOINT(LOG_ERROR, "Out of memory for key registry entry");
+        return NULL;
+    }
+    memcpy(&e->key, key, sizeof(rsa_4096_key_t));
+    e->fingerprint = fingerprint;
+    e->owner = reg;
+    e->refs = 2;                    /* The registry and the caller */
+    e->referenced = 0;              /* Earns its second chance with the first lookup */
+    e->retired_next = NULL;
+    
+    if (old != NULL) {
+        registry_unlink(reg, old);
+    } else if (reg->count == reg->capacity) {
+        registry_evict(reg);
+    }
+    e->slot = reg->count;
+    reg->slots[reg->count++] = e;
+    
+    /* Fully built before it becomes reachable */
+    e->next = *head;
+    __atomic_store_n(head, e, __ATOMIC_SEQ_CST);
+    reg->inserts++;
+    
+    registry_sweep(reg);
+    pthread_mutex_unlock(&reg->lock);
+    return &e->key;
+}
+
+const rsa_4096_key_t *rsa_4096_registry_lookup(rsa_4096_registry_t *reg, const bigint_t *n, int is_private) {
+    if (reg == NULL || n == NULL) {
+        return NULL;
+    }
+    is_private = is_private != 0;
+    uint64_t fingerprint = rsa_4096_modulus_fingerprint(n);
+    registry_entry_t *found = NULL;
+    
+    __atomic_add_fetch(&reg->readers, 1, __ATOMIC_SEQ_CST);
+    registry_entry_t *e = __atomic_load_n(&reg->buckets[registry_bucket(reg, fingerprint, is_private)],
+                                          __ATOMIC_SEQ_CST);
+    for (; e != NULL; e = __atomic_load_n(&e->next, __ATOMIC_SEQ_CST)) {
+        if (registry_entry_matches(e, fingerprint, n, is_private) && registry_try_acquire(e)) {
+            found = e;
+            break;
+        }
+    }
+    __atomic_sub_fetch(&reg->readers, 1, __ATOMIC_SEQ_CST);
+    
+    if (found == NULL) {
+        __atomic_add_fetch(&reg->misses, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+    /* Only write the bit when it changes, so hot entries do not bounce their cache line */
+    if (!__atomic_load_n(&found->referenced, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&found->referenced, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&reg->hits, 1, __ATOMIC_RELAXED);
+    return &found->key;
+}
+
+void rsa_4096_registry_release(const rsa_4096_key_t *key) {
+    if (key == NULL) {
+        return;
+    }
+    registry_entry_t *e = (registry_entry_t *)key;
+    
+    /* Only an unlinked entry can drop to zero; free it now if no lookup is in flight */
+    if (__atomic_sub_fetch(&e->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        rsa_4096_registry_t *reg = e->owner;
+        pthread_mutex_lock(&reg->lock);
+        registry_sweep(reg);
+        pthread_mutex_unlock(&reg->lock);
+    }
+}
+
+void rsa_4096_registry_get_stats(rsa_4096_registry_t *reg, rsa_4096_registry_stats_t *stats) {
+    if (reg == NULL || stats == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&reg->lock);
+    stats->entries = reg->count;
+    stats->capacity = reg->capacity;
+    stats->inserts = reg->inserts;
+    stats->evictions = reg->evictions;
+    pthread_mutex_unlock(&reg->lock);
+    stats->hits = __atomic_load_n(&reg->hits, __ATOMIC_RELAXED);
+    stats->misses = __atomic_load_n(&reg->misses, __ATOMIC_RELAXED);
+}
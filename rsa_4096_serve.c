@@ -0,0 +1,547 @@
+/**
+ * @file rsa_4096_serve.c
+ * @brief Long-running service mode: length-prefixed requests over a stream, pipelined
+ *
+ * One connection runs as a three-stage pipeline over a fixed pool of batches:
+ *
+ *   reader thread  - parses frames into a batch; everything that has already
+ *                    arrived goes into the same batch (up to max_batch), and
+ *                    the batch is handed on as soon as the input runs dry
+ *   caller thread  - runs each batch on the batch worker pool, public and
+ *                    private requests as two rsa_4096_*_batch calls
+ *   writer thread  - serialises the responses of a batch with one write
+ *
+ * so parsing the next requests and writing the previous answers overlap with
+ * the exponentiations. Batches travel free -> parsed -> done -> free, which
+ * bounds memory and back-pressures a client that sends faster than we compute.
+ * Responses always come back in request order.
+ *
+ * The keys are only read while serving. A warm-up operation per key runs
+ * first, which also rejects a key that cannot perform its operation.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "rsa_4096.h"
+
+#define SERVE_HEADER_SIZE  12
+#define SERVE_READ_BUFFER  (64 * 1024)
+#define SERVE_POOL_BATCHES 4                /* Batches in flight per connection */
+
+/* ===================== BATCH POOL AND QUEUES ===================== */
+
+typedef struct serve_batch {
+    struct serve_batch *next;
+    size_t count;
+    uint32_t id[RSA_4096_SERVE_MAX_BATCH];
+    uint32_t op[RSA_4096_SERVE_MAX_BATCH];
+    rsa_4096_batch_item_t items[RSA_4096_SERVE_MAX_BATCH];   /* status preset != -2: rejected while parsing */
+    uint8_t in[RSA_4096_SERVE_MAX_BATCH][RSA_4096_SERVE_MAX_PAYLOAD];
+    uint8_t out[RSA_4096_SERVE_MAX_BATCH][RSA_4096_SERVE_MAX_PAYLOAD];
+} serve_batch_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    serve_batch_t *head, *tail;
+    int closed;
+} serve_queue_t;
+
+static void serve_queue_init(serve_queue_t *q) {
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->cond, NULL);
+    q->head = q->tail = NULL;
+    q->closed = 0;
+}
+
+static void serve_queue_destroy(serve_queue_t *q) {
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->cond);
+}
+
+static void serve_queue_push(serve_queue_t *q, serve_batch_t *b) {
+    pthread_mutex_lock(&q->lock);
+    b->next = NULL;
+    if (q->tail != NULL) q->tail->next = b;
+    else q->head = b;
+    q->tail = b;
+    pthread_cond_signal(&q->cond);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/**
+ * @brief Blocking pop; NULL once the queue is closed and drained
+ */
+static serve_batch_t *serve_queue_pop(serve_queue_t *q) {
+    pthread_mutex_lock(&q->lock);
+    while (q->head == NULL && !q->closed) {
+        pthread_cond_wait(&q->cond, &q->lock);
+    }
+    serve_batch_t *b = q->head;
+    if (b != NULL) {
+        q->head = b->next;
+        if (q->head == NULL) q->tail = NULL;
+    }
+    pthread_mutex_unlock(&q->lock);
+    return b;
+}
+
+static void serve_queue_close(serve_queue_t *q) {
+    pthread_mutex_lock(&q->lock);
+    q->closed = 1;
+    pthread_cond_broadcast(&q->cond);
+    pthread_mutex_unlock(&q->lock);
+}
+
+/* ===================== CONNECTION STATE ===================== */
+
+typedef struct {
+    const rsa_4096_key_t *pub_key;
+    const rsa_4096_key_t *priv_key;
+    int in_fd, out_fd;
+    int num_threads;
+    size_t max_batch;
+    serve_queue_t free_q, parsed_q, done_q;
+    int read_error;             /* Written by the reader only */
+    int write_error;            /* Written by the writer only */
+    rsa_4096_serve_stats_t stats;
+} serve_conn_t;
+
+static uint32_t serve_get_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static void serve_put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* ===================== READER STAGE ===================== */
+
+/**
+ * @brief Whether more input is already waiting, i.e. the next read would not block
+ */
+static int serve_input_pending(int fd) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0;
+}
+
+/**
+ * @brief Append one parsed request; a pre-set status marks it rejected before compute
+ */
+static void serve_add_request(serve_batch_t *b, uint32_t id, uint32_t op, const uint8_t *payload,
+                              uint32_t len, int status) {
+    size_t i = b->count++;
+    b->id[i] = id;
+    b->op[i] = op;
+    if (status == 0) {
+        memcpy(b->in[i], payload, len);
+    }
+    b->items[i] = (rsa_4096_batch_item_t){b->in[i], len, b->out[i], sizeof(b->out[i]), 0, status == 0 ? -2 : status};
+}
+
+static void *serve_reader_main(void *arg) {
+    serve_conn_t *c = (serve_conn_t *)arg;
+    uint8_t *buf = malloc(SERVE_READ_BUFFER);
+    size_t have = 0, skip = 0;
+    serve_batch_t *batch = NULL;
+    
+    if (buf == NULL) {
+        c->read_error = -3;
+        serve_queue_close(&c->parsed_q);
+        return NULL;
+    }
+    
+    for (;;) {
+        /* Parse every complete frame already buffered */
+        size_t pos = 0;
+        for (;;) {
+            if (skip > 0) {
+                size_t drop = have - pos < skip ? have - pos : skip;
+                pos += drop;
+                skip -= drop;
+                if (skip > 0) break;
+            }
+            if (have - pos < SERVE_HEADER_SIZE) break;
+            uint32_t id = serve_get_be32(buf + pos);
+            uint32_t op = serve_get_be32(buf + pos + 4);
+            uint32_t len = serve_get_be32(buf + pos + 8);
+            int status = 0;
+            if (len > RSA_4096_SERVE_MAX_PAYLOAD) {
+                status = RSA_4096_SERVE_ERR_TOO_LONG;
+            } else if (op != RSA_4096_SERVE_OP_PUBLIC && op != RSA_4096_SERVE_OP_PRIVATE) {
+                status = RSA_4096_SERVE_ERR_BAD_OP;
+            }
+            if (status == 0 && have - pos - SERVE_HEADER_SIZE < len) break;
+    
+            if (batch == NULL) {
+                batch = serve_queue_pop(&c->free_q);
+                batch->count = 0;
+            }
+            serve_add_request(batch, id, op, buf + pos + SERVE_HEADER_SIZE, len, status);
+            pos += SERVE_HEADER_SIZE;
+            if (status == 0) {
+                pos += len;
+            } else {
+                skip = len;                     /* Payload of a rejected frame is discarded unread */
+            }
+            if (batch->count == c->max_batch) {
+                serve_queue_push(&c->parsed_q, batch);
+                batch = NULL;
+            }
+        }
+        memmove(buf, buf + pos, have - pos);
+        have -= pos;
+    
+        /* Whatever arrived together goes out together; the next read would only wait */
+        if (batch != NULL && !serve_input_pending(c->in_fd)) {
+            serve_queue_push(&c->parsed_q, batch);
+            batch = NULL;
+        }
+    
+        ssize_t r = read(c->in_fd, buf + have, SERVE_READ_BUFFER - have);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) {
+            if (r < 0) {
+                c->read_error = -4;
+            } else if (have > 0 || skip > 0) {
+                CHECKPOINT(LOG_ERROR, "Serve input ended inside a frame (%zu bytes pending)", have + skip);
+                c->read_error = -5;
+            }
+            break;
+        }
+        have += (size_t)r;
+    }
+    
+    if (batch != NULL) {
+        serve_queue_push(&c->parsed_q, batch);
+    }
+    serve_queue_close(&c->parsed_q);
+    free(buf);
+    return NULL;
+}
+
+/* ===================== COMPUTE STAGE ===================== */
+
+/**
+ * @brief Run the requests of one operation type through the batch worker pool
+ */
+static void serve_run_op(serve_conn_t *c, serve_batch_t *b, uint32_t op) {
+    rsa_4096_batch_item_t items[RSA_4096_SERVE_MAX_BATCH];
+    size_t index[RSA_4096_SERVE_MAX_BATCH];
+    size_t n = 0;
+    for (size_t i = 0; i < b->count; i++) {
+        if (b->op[i] == op && b->items[i].status == -2) {
+            index[n] = i;
+            items[n++] = b->items[i];
+        }
+    }
+    if (n == 0) {
+        return;
+    }
+    
+    const rsa_4096_key_t *key = op == RSA_4096_SERVE_OP_PUBLIC ? c->pub_key : c->priv_key;
+    if (key == NULL) {
+        for (size_t j = 0; j < n; j++) items[j].status = RSA_4096_SERVE_ERR_NO_KEY;
+    } else if (op == RSA_4096_SERVE_OP_PUBLIC) {
+        rsa_4096_encrypt_batch(key, items, n, c->num_threads);
+    } else {
+        rsa_4096_decrypt_batch(key, items, n, c->num_threads);
+    }
+    for (size_t j = 0; j < n; j++) {
+        b->items[index[j]] = items[j];
+    }
+}
+
+static void serve_compute(serve_conn_t *c) {
+    serve_batch_t *b;
+    while ((b = serve_queue_pop(&c->parsed_q)) != NULL) {
+        serve_run_op(c, b, RSA_4096_SERVE_OP_PUBLIC);
+        serve_run_op(c, b, RSA_4096_SERVE_OP_PRIVATE);
+        c->stats.batches++;
+        c->stats.requests += b->count;
+        for (size_t i = 0; i < b->count; i++) {
+            if (b->items[i].status != 0) c->stats.failed++;
+        }
+        serve_queue_push(&c->done_q, b);
+    }
+    serve_queue_close(&c->done_q);
+}
+
+/* ===================== WRITER STAGE ===================== */
+
+static int serve_write_all(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, data, len);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return -1;
+        data += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+static void *serve_writer_main(void *arg) {
+    serve_conn_t *c = (serve_conn_t *)arg;
+    uint8_t *out = malloc(RSA_4096_SERVE_MAX_BATCH * (SERVE_HEADER_SIZE + RSA_4096_SERVE_MAX_PAYLOAD));
+    
+    /* A vanished client shows up as EPIPE here instead of killing the process */
+    sigset_t pipe_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, NULL);
+    
+    serve_batch_t *b;
+    while ((b = serve_queue_pop(&c->done_q)) != NULL) {
+        /* Keep recycling after a write error so the reader never starves for batches */
+        if (out != NULL && c->write_error == 0) {
+            size_t len = 0;
+            for (size_t i = 0; i < b->count; i++) {
+                const rsa_4096_batch_item_t *item = &b->items[i];
+                size_t payload = item->status == 0 ? item->output_len : 0;
+                serve_put_be32(out + len, b->id[i]);
+                serve_put_be32(out + len + 4, (uint32_t)item->status);
+                serve_put_be32(out + len + 8, (uint32_t)payload);
+                memcpy(out + len + SERVE_HEADER_SIZE, item->output, payload);
+                len += SERVE_HEADER_SIZE + payload;
+            }
+            if (serve_write_all(c->out_fd, out, len) != 0) {
+                c->write_error = -6;
+            }
+        }
+        serve_queue_push(&c->free_q, b);
+    }
+    if (out == NULL) {
+        c->write_error = -3;
+    }
+    free(out);
+    return NULL;
+}
+
+/* ===================== CONNECTION DRIVER ===================== */
+
+static int serve_connection(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, int in_fd, int out_fd,
+                            const rsa_4096_serve_config_t *config, rsa_4096_serve_stats_t *stats) {
+    serve_conn_t c;
+    memset(&c, 0, sizeof(c));
+    c.pub_key = pub_key;
+    c.priv_key = priv_key;
+    c.in_fd = in_fd;
+    c.out_fd = out_fd;
+    c.num_threads = config != NULL ? config->num_threads : 0;
+    c.max_batch = RSA_4096_SERVE_MAX_BATCH;
+    if (config != NULL && config->max_batch > 0 && config->max_batch < RSA_4096_SERVE_MAX_BATCH) {
+        c.max_batch = (size_t)config->max_batch;
+    }
+    
+    serve_batch_t *pool = malloc(SERVE_POOL_BATCHES * sizeof(serve_batch_t));
+    if (pool == NULL) {
+        ERROR_RETURN(-3, "Out of memory for serve batches");
+    }
+    serve_queue_init(&c.free_q);
+    serve_queue_init(&c.parsed_q);
+    serve_queue_init(&c.done_q);
+    for (int i = 0; i < SERVE_POOL_BATCHES; i++) {
+        serve_queue_push(&c.free_q, &pool[i]);
+    }
+    
+    pthread_t reader, writer;
+    int ret = 0;
+    if (pthread_create(&writer, NULL, serve_writer_main, &c) != 0) {
+        ret = -7;
+    } else {
+        if (pthread_create(&reader, NULL, serve_reader_main, &c) != 0) {
+            ret = -7;
+            serve_queue_close(&c.parsed_q);
+        }
+        serve_compute(&c);
+        if (ret == 0) pthread_join(reader, NULL);
+        pthread_join(writer, NULL);
+    }
+    
+    serve_queue_destroy(&c.free_q);
+    serve_queue_destroy(&c.parsed_q);
+    serve_queue_destroy(&c.done_q);
+    free(pool);
+    
+    if (stats != NULL) {
+        *stats = c.stats;
+    }
+    if (ret == 0) ret = c.read_error != 0 ? c.read_error : c.write_error;
+    CHECKPOINT(LOG_INFO, "Served %zu requests in %zu batches, %zu failed (status %d)",
+              c.stats.requests, c.stats.batches, c.stats.failed, ret);
+    return ret;
+}
+
+/**
+ * @brief One operation per key before serving: primes the key's code paths and proves the key works
+ */
+static int serve_warm_up(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key) {
+    if (pub_key == NULL && priv_key == NULL) {
+        ERROR_RETURN(-1, "Serve mode needs at least one key");
+    }
+    uint8_t block[RSA_4096_SERVE_MAX_PAYLOAD], out[RSA_4096_SERVE_MAX_PAYLOAD];
+    size_t block_len = 1, out_len;
+    block[0] = 2;
+    int ret = 0;
+    if (pub_key != NULL) {
+        ret = rsa_4096_encrypt_binary(pub_key, block, block_len, out, sizeof(out), &out_len);
+        if (ret == 0) {
+            memcpy(block, out, out_len);
+            block_len = out_len;
+        }
+    }
+    if (ret == 0 && priv_key != NULL) {
+        ret = rsa_4096_decrypt_binary(priv_key, block, block_len, out, sizeof(out), &out_len);
+    }
+    if (ret != 0) {
+        ERROR_RETURN(-2, "Serve key warm-up failed (%d)", ret);
+    }
+    return 0;
+}
+
+/* ===================== PUBLIC ENTRY POINTS ===================== */
+
+int rsa_4096_serve_stream(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, int in_fd, int out_fd,
+                          const rsa_4096_serve_config_t *config, rsa_4096_serve_stats_t *stats) {
+    int ret = serve_warm_up(pub_key, priv_key);
+    if (ret != 0) {
+        return ret;
+    }
+    return serve_connection(pub_key, priv_key, in_fd, out_fd, config, stats);
+}
+
+/* Client slots shared between the accept loop and the client threads */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t finished;    /* Signalled whenever a client thread is done */
+} serve_slots_t;
+
+typedef struct {
+    const rsa_4096_key_t *pub_key;
+    const rsa_4096_key_t *priv_key;
+    const rsa_4096_serve_config_t *config;
+    serve_slots_t *slots;
+    int fd;
+    int active;                 /* A thread was started and not yet joined */
+    int done;                   /* The thread has finished, under slots->lock */
+} serve_client_t;
+
+static void *serve_client_main(void *arg) {
+    serve_client_t *client = (serve_client_t *)arg;
+    serve_connection(client->pub_key, client->priv_key, client->fd, client->fd, client->config, NULL);
+    close(client->fd);
+    
+    pthread_mutex_lock(&client->slots->lock);
+    client->done = 1;
+    pthread_cond_signal(&client->slots->finished);
+    pthread_mutex_unlock(&client->slots->lock);
+    return NULL;
+}
+
+/**
+ * @brief A slot for the next client: a never used one, else any whose client has
+ *        finished (joined here); waits only while every slot is still serving
+ */
+static int serve_free_slot(serve_slots_t *slots, serve_client_t *clients, pthread_t *tids) {
+    int slot = -1;
+    pthread_mutex_lock(&slots->lock);
+    while (slot < 0) {
+        for (int i = 0; i < RSA_4096_SERVE_MAX_CLIENTS && slot < 0; i++) {
+            if (!clients[i].active || clients[i].done) slot = i;
+        }
+        if (slot < 0) pthread_cond_wait(&slots->finished, &slots->lock);
+    }
+    pthread_mutex_unlock(&slots->lock);
+    
+    if (clients[slot].active) {
+        pthread_join(tids[slot], NULL);
+        clients[slot].active = 0;
+    }
+    return slot;
+}
+
+int rsa_4096_serve_unix(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, const char *path,
+                        const rsa_4096_serve_config_t *config) {
+    if (path == NULL) {
+        ERROR_RETURN(-1, "NULL socket path in rsa_4096_serve_unix");
+    }
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        ERROR_RETURN(-1, "Socket path too long: %s", path);
+    }
+    strcpy(addr.sun_path, path);
+    
+    int ret = serve_warm_up(pub_key, priv_key);
+    if (ret != 0) {
+        return ret;
+    }
+    
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        ERROR_RETURN(-8, "Cannot create Unix socket");
+    }
+    unlink(path);
+    if (bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(listen_fd, RSA_4096_SERVE_MAX_CLIENTS) != 0) {
+        close(listen_fd);
+        ERROR_RETURN(-8, "Cannot listen on %s", path);
+    }
+    CHECKPOINT(LOG_INFO, "Serving on %s", path);
+    
+    /* One pipeline per client; any finished slot is reused, and the accept loop
+     * only waits when every slot is still serving a client */
+    serve_slots_t slots;
+    pthread_mutex_init(&slots.lock, NULL);
+    pthread_cond_init(&slots.finished, NULL);
+    serve_client_t clients[RSA_4096_SERVE_MAX_CLIENTS];
+    pthread_t tids[RSA_4096_SERVE_MAX_CLIENTS];
+    memset(clients, 0, sizeof(clients));
+    long accepted = 0;
+    int max_connections = config != NULL ? config->max_connections : 0;
+    
+    while (max_connections <= 0 || accepted < max_connections) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            ret = -8;
+            break;
+        }
+        int slot = serve_free_slot(&slots, clients, tids);
+        clients[slot] = (serve_client_t){pub_key, priv_key, config, &slots, fd, 0, 0};
+        if (pthread_create(&tids[slot], NULL, serve_client_main, &clients[slot]) != 0) {
+            CHECKPOINT(LOG_ERROR, "Cannot start a client thread, dropping connection");
+            close(fd);
+            continue;
+        }
+        clients[slot].active = 1;
+        accepted++;
+    }
+    
+    for (int i = 0; i < RSA_4096_SERVE_MAX_CLIENTS; i++) {
+        if (clients[i].active) pthread_join(tids[i], NULL);
+    }
+    pthread_cond_destroy(&slots.finished);
+    pthread_mutex_destroy(&slots.lock);
+    close(listen_fd);
+    unlink(path);
+    return ret;
+}
@@ -0,0 +1,895 @@
+/**
+ * @file rsa_4096_simd.c
+ * @brief AVX2 / AVX-512 IFMA Montgomery exponentiation with runtime dispatch
+ *
+ * The vector kernels keep numbers in a redundant radix (2^52 limbs for IFMA,
+ * 2^29 limbs for AVX2, one limb per 64-bit lane) and use "almost Montgomery"
+ * multiplication with R' = 2^(radix * L), where radix * L >= bits(n) + 2.
+ * Inputs and outputs stay below 2n, so no final subtraction is needed until the
+ * very end. Since R' differs from the scalar context's R, the whole
+ * exponentiation runs in the vector domain: the base enters once via
+ * R'^2 mod n and the result leaves once via a multiply by 1.
+ *
+ * Selection happens at run time via CPUID (__builtin_cpu_supports); the
+ * kernels are compiled with per-function target attributes so the rest of the
+ * library keeps the baseline instruction set.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rsa_4096.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define RSA_4096_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+typedef struct {
+    int radix;                  /* Bits per limb */
+    int limbs;                  /* L: radix * L >= bits(n) + 2 */
+    int padded;                 /* L + 1 rounded up to whole vectors */
+    uint64_t mask;
+    uint64_t k0;                /* -n^(-1) mod 2^radix */
+    uint64_t n[MONTGOMERY_SIMD_MAX_LIMBS];
+} simd_mont_t;
+
+static int simd_forced = MONTGOMERY_SIMD_AUTO;
+static int simd_detected = MONTGOMERY_SIMD_AUTO;   /* CPUID result, probed once */
+static int simd_min_bits = MONTGOMERY_SIMD_MIN_BITS;
+
+/* ===================== KERNEL SELECTION ===================== */
+
+static int simd_probe(void) {
+#ifdef RSA_4096_SIMD_X86
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma")) {
+        return MONTGOMERY_SIMD_IFMA;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return MONTGOMERY_SIMD_AVX2;
+    }
+#endif
+    return MONTGOMERY_SIMD_NONE;
+}
+
+int montgomery_simd_detect(void) {
+    int kernel = __atomic_load_n(&simd_detected, __ATOMIC_RELAXED);
+    if (kernel == MONTGOMERY_SIMD_AUTO) {
+        kernel = simd_probe();
+        __atomic_store_n(&simd_detected, kernel, __ATOMIC_RELAXED);
+    }
+    return kernel;
+}
+
+int montgomery_simd_select(int kernel) {
+    if (kernel == MONTGOMERY_SIMD_AUTO || kernel == MONTGOMERY_SIMD_NONE) {
+        simd_forced = kernel;
+        return montgomery_simd_active();
+    }
+    
+    int best = montgomery_simd_detect();
+    /* IFMA machines also run the AVX2 kernel; nothing else is implied */
+    if ((kernel == MONTGOMERY_SIMD_IFMA && best != MONTGOMERY_SIMD_IFMA) ||
+        (kernel == MONTGOMERY_SIMD_AVX2 && best == MONTGOMERY_SIMD_NONE) ||
+        (kernel != MONTGOMERY_SIMD_IFMA && kernel != MONTGOMERY_SIMD_AVX2)) {
+        ERROR_RETURN(-1, "SIMD kernel %d not supported on this CPU", kernel);
+    }
+    simd_forced = kernel;
+    return kernel;
+}
+
+int montgomery_simd_active(void) {
+    return simd_forced == MONTGOMERY_SIMD_AUTO ? montgomery_simd_detect() : simd_forced;
+}
+
+int montgomery_simd_set_min_bits(int bits) {
+    if (bits < 64 || bits > 4096) {
+        ERROR_RETURN(-1, "SIMD cutover of %d bits outside 64..4096", bits);
+    }
+    simd_min_bits = bits;
+    return 0;
+}
+
+int montgomery_simd_min_bits(void) {
+    return simd_min_bits;
+}
+
+const char *montgomery_simd_name(int kernel) {
+    switch (kernel) {
+        case MONTGOMERY_SIMD_IFMA: return "avx512-ifma";
+        case MONTGOMERY_SIMD_AVX2: return "avx2";
+        case MONTGOMERY_SIMD_NONE: return "scalar";
+        default:                   return "unknown";
+    }
+}
+
+/* ===================== RADIX CONVERSION ===================== */
+
+#ifdef RSA_4096_SIMD_X86
+
+/**
+ * @brief Split a bigint (< 2^(radix * L)) into radix-bit limbs, zero-padded
+ */
+static void simd_from_bigint(uint64_t *limbs, const bigint_t *a, const simd_mont_t *sm) {
+    memset(limbs, 0, (size_t)sm->padded * sizeof(uint64_t));
+    for (int l = 0; l < sm->limbs; l++) {
+        int bit = l * sm->radix;
+        int got = 0;
+        uint64_t value = 0;
+        while (got < sm->radix) {
+            int wi = bit / BIGINT_WORD_SIZE, off = bit % BIGINT_WORD_SIZE;
+            if (wi >= a->used) break;
+            int take = BIGINT_WORD_SIZE - off;
+            if (take > sm->radix - got) take = sm->radix - got;
+            uint64_t chunk = ((uint64_t)(a->words[wi] >> off)) & ((1ULL << take) - 1);
+            value |= chunk << got;
+            got += take;
+            bit += take;
+        }
+        limbs[l] = value;
+    }
+}
+
+/**
+ * @brief Reassemble fully carried radix-bit limbs into a bigint
+ */
+static void simd_to_bigint(bigint_t *a, const uint64_t *limbs, const simd_mont_t *sm) {
+    bigint_init(a);
+    for (int l = 0; l < sm->limbs; l++) {
+        uint64_t value = limbs[l];
+        int bit = l * sm->radix;
+        int left = sm->radix;
+        while (value != 0 && left > 0) {
+            int wi = bit / BIGINT_WORD_SIZE, off = bit % BIGINT_WORD_SIZE;
+            a->words[wi] |= (bigint_word_t)(value << off);
+            int put = BIGINT_WORD_SIZE - off;
+            if (put >= left) break;
+            value >>= put;
+            left -= put;
+            bit += put;
+        }
+    }
+    a->used = (sm->limbs * sm->radix + BIGINT_WORD_SIZE - 1) / BIGINT_WORD_SIZE;
+    bigint_normalize(a);
+}
+
+/**
+ * @brief Carry-propagate lane accumulators into radix-bit limbs
+ */
+static void simd_normalize(uint64_t *out, const uint64_t *t, int count, const simd_mont_t *sm) {
+    uint64_t carry = 0;
+    for (int j = 0; j < count; j++) {
+        uint64_t v = t[j] + carry;
+        out[j] = v & sm->mask;
+        carry = v >> sm->radix;
+    }
+}
+
+static int simd_setup(simd_mont_t *sm, const bigint_t *n, int radix, int lanes) {
+    int bits = bigint_bit_length(n);
+    sm->radix = radix;
+    sm->mask = (1ULL << radix) - 1;
+    sm->limbs = (bits + 2 + radix - 1) / radix;
+    sm->padded = (sm->limbs + 1 + lanes - 1) / lanes * lanes;
+    if (sm->padded > MONTGOMERY_SIMD_MAX_LIMBS) {
+        return -1;
+    }
+    simd_from_bigint(sm->n, n, sm);
+    
+    /* n0^(-1) mod 2^64 by Newton iteration: 3 correct bits doubling to 96 */
+    uint64_t n0 = sm->n[0], x = n0;
+    for (int i = 0; i < 5; i++) {
+        x *= 2 - n0 * x;
+    }
+    sm->k0 = (0 - x) & sm->mask;
+    return 0;
+}
+
+/* ===================== VECTOR KERNELS ===================== */
+
+/**
+ * @brief AVX-512 IFMA almost-Montgomery multiply, radix 2^52
+ *
+ * The accumulator lives in registers as one limb per lane. Each outer step
+ * adds the low halves of a * b[i] and m * n in place and the high halves into
+ * h (they belong one limb up), then shifts everything down by one lane with
+ * valignq - that shift is the division by 2^52. A lane collects at most four
+ * sub-2^52 terms per step for L + 1 steps, so 64-bit lanes never overflow.
+ */
+__attribute__((target("avx512f,avx512ifma")))
+static void simd_amm52_ifma(uint64_t *out, const uint64_t *a, const uint64_t *b, const simd_mont_t *sm) {
+    const int nv = sm->padded / 8;
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i x[MONTGOMERY_SIMD_MAX_LIMBS / 8 + 1], h[MONTGOMERY_SIMD_MAX_LIMBS / 8];
+    uint64_t t[MONTGOMERY_SIMD_MAX_LIMBS];
+    
+    for (int k = 0; k <= nv; k++) x[k] = zero;
+    
+    for (int i = 0; i < sm->limbs; i++) {
+        __m512i bi = _mm512_set1_epi64((long long)b[i]);
+        for (int k = 0; k < nv; k++) {
+            __m512i av = _mm512_loadu_si512((const void *)(a + 8 * k));
+            x[k] = _mm512_madd52lo_epu64(x[k], av, bi);
+            h[k] = _mm512_madd52hi_epu64(zero, av, bi);
+        }
+    
+        uint64_t x0 = (uint64_t)_mm_cvtsi128_si64(_mm512_castsi512_si128(x[0]));
+        uint64_t m = (x0 * sm->k0) & sm->mask;
+        __m512i mv = _mm512_set1_epi64((long long)m);
+        for (int k = 0; k < nv; k++) {
+            __m512i nvec = _mm512_loadu_si512((const void *)(sm->n + 8 * k));
+            x[k] = _mm512_madd52lo_epu64(x[k], nvec, mv);
+            h[k] = _mm512_madd52hi_epu64(h[k], nvec, mv);
+        }
+    
+        /* Limb 0 is now a multiple of 2^52: drop it and carry its top bits */
+        uint64_t carry = (x0 + ((m * sm->n[0]) & sm->mask)) >> 52;
+        for (int k = 0; k < nv; k++) {
+            x[k] = _mm512_add_epi64(_mm512_alignr_epi64(x[k + 1], x[k], 1), h[k]);
+        }
+        x[0] = _mm512_add_epi64(x[0], _mm512_maskz_set1_epi64(1, (long long)carry));
+    }
+    
+    for (int k = 0; k < nv; k++) {
+        _mm512_storeu_si512((void *)(t + 8 * k), x[k]);
+    }
+    simd_normalize(out, t, 8 * nv, sm);
+}
+
+/**
+ * @brief AVX2 almost-Montgomery multiply, radix 2^29
+ *
+ * vpmuludq gives full 58-bit products, so a lane gains under 2^59 per step;
+ * a partial carry pass every 16 steps keeps lanes below 2^64.
+ */
+__attribute__((target("avx2")))
+static void simd_amm29_avx2(uint64_t *out, const uint64_t *a, const uint64_t *b, const simd_mont_t *sm) {
+    const int nv = sm->padded / 4;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i maskv = _mm256_set1_epi64x((long long)sm->mask);
+    __m256i x[MONTGOMERY_SIMD_MAX_LIMBS / 4 + 1];
+    uint64_t t[MONTGOMERY_SIMD_MAX_LIMBS];
+    
+    for (int k = 0; k <= nv; k++) x[k] = zero;
+    
+    for (int i = 0; i < sm->limbs; i++) {
+        __m256i bi = _mm256_set1_epi64x((long long)b[i]);
+        for (int k = 0; k < nv; k++) {
+            __m256i av = _mm256_loadu_si256((const __m256i *)(a + 4 * k));
+            x[k] = _mm256_add_epi64(x[k], _mm256_mul_epu32(av, bi));
+        }
+    
+        uint64_t x0 = (uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(x[0]));
+        uint64_t m = (x0 * sm->k0) & sm->mask;
+        __m256i mv = _mm256_set1_epi64x((long long)m);
+        for (int k = 0; k < nv; k++) {
+            __m256i nvec = _mm256_loadu_si256((const __m256i *)(sm->n + 4 * k));
+            x[k] = _mm256_add_epi64(x[k], _mm256_mul_epu32(nvec, mv));
+        }
+    
+        /* Shift down one lane: [x1 x2 x3 | next x0] */
+        uint64_t carry = (x0 + m * sm->n[0]) >> 29;
+        for (int k = 0; k < nv; k++) {
+            __m256i lo = _mm256_permute4x64_epi64(x[k], _MM_SHUFFLE(0, 3, 2, 1));
+            __m256i hi = _mm256_permute4x64_epi64(x[k + 1], _MM_SHUFFLE(0, 3, 2, 1));
+            x[k] = _mm256_blend_epi32(lo, hi, 0xC0);
+        }
+        x[0] = _mm256_add_epi64(x[0], _mm256_set_epi64x(0, 0, 0, (long long)carry));
+    
+        /* Partial carry pass: each lane keeps 29 bits and hands the rest one lane up */
+        if ((i & 15) == 15) {
+            __m256i prev = zero;
+            for (int k = 0; k < nv; k++) {
+                __m256i up = _mm256_permute4x64_epi64(_mm256_srli_epi64(x[k], 29), _MM_SHUFFLE(2, 1, 0, 3));
+                __m256i in = _mm256_blend_epi32(up, prev, 0x03);
+                prev = up;
+                x[k] = _mm256_add_epi64(_mm256_and_si256(x[k], maskv), in);
+            }
+        }
+    }
+    
+    for (int k = 0; k < nv; k++) {
+        _mm256_storeu_si256((__m256i *)(t + 4 * k), x[k]);
+    }
+    simd_normalize(out, t, 4 * nv, sm);
+}
+
+static void simd_kernel_mul_ifma(void *out, const void *a, const void *b, const void *kernel_ctx) {
+    simd_amm52_ifma((uint64_t *)out, (const uint64_t *)a, (const uint64_t *)b, (const simd_mont_t *)kernel_ctx);
+}
+
+static void simd_kernel_mul_avx2(void *out, const void *a, const void *b, const void *kernel_ctx) {
+    simd_amm29_avx2((uint64_t *)out, (const uint64_t *)a, (const uint64_t *)b, (const simd_mont_t *)kernel_ctx);
+}
+
+/* Single-buffer dispatch table, indexed by MONTGOMERY_SIMD_* */
+typedef struct {
+    int radix;
+    int lanes;
+    void (*mul)(void *out, const void *a, const void *b, const void *kernel_ctx);
+} simd_exp_kernel_t;
+
+static const simd_exp_kernel_t simd_exp_kernels[] = {
+    [MONTGOMERY_SIMD_NONE] = {0, 0, NULL},
+    [MONTGOMERY_SIMD_AVX2] = {29, 4, simd_kernel_mul_avx2},
+    [MONTGOMERY_SIMD_IFMA] = {52, 8, simd_kernel_mul_ifma},
+};
+
+/* ===================== VECTOR EXPONENTIATION ===================== */
+
+/**
+ * @brief R'^2 mod n, derived from the context's R^2 mod n when R' >= R
+ *
+ * R'^2 = R^2 * 2^(2 * (radix * L - bits(R))), so the scalar context's cached
+ * value only needs a shift by a few dozen bits and a one-word reduction
+ * instead of dividing a 2 * bits(R') power of two by n. wide is scratch.
+ */
+static int simd_r2_mod_n(bigint_t *r2_mod, bigint_t *wide, const simd_mont_t *sm, const bigint_t *n,
+                         const montgomery_ctx_t *ctx) {
+    int extra = 2 * (sm->radix * sm->limbs - ctx->n_words * BIGINT_WORD_SIZE);
+    int ret;
+    if (extra >= 0) {
+        mont_residue_to_bigint(r2_mod, &ctx->r_squared, ctx);
+        ret = bigint_shift_left(wide, r2_mod, extra);
+    } else {
+        bigint_set_u32(r2_mod, 1);
+        ret = bigint_shift_left(wide, r2_mod, 2 * sm->radix * sm->limbs);
+    }
+    if (ret == 0) ret = bigint_mod(r2_mod, wide, n);
+    return ret;
+}
+
+static int simd_exp_run(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *n,
+                        const montgomery_ctx_t *ctx, int window_bits, int radix, int lanes,
+                        void (*mul)(void *, const void *, const void *, const void *), mont_exp_scratch_t *s) {
+    simd_mont_t sm;
+    if (simd_setup(&sm, n, radix, lanes) != 0) {
+        return 1;
+    }
+    
+    /* R'^2 mod n brings the base into the vector Montgomery domain */
+    uint64_t stats_start = STATS_START();
+    bigint_t *r2_mod = &s->simd_big[1];
+    int ret = simd_r2_mod_n(r2_mod, &s->simd_big[2], &sm, n, ctx);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to compute R'^2 mod n for SIMD kernel");
+    }
+    
+    uint64_t *acc = s->simd_acc, *one = s->simd_one, *rr = s->simd_rr;
+    simd_from_bigint(rr, r2_mod, &sm);
+    memset(one, 0, (size_t)sm.padded * sizeof(uint64_t));
+    one[0] = 1;
+    simd_from_bigint(s->simd_table, base, &sm);
+    
+    mul(s->simd_table, s->simd_table, rr, &sm);     /* base * R' mod n */
+    mul(acc, one, rr, &sm);                         /* R' mod n = Montgomery one */
+    STATS_TIME(RSA_4096_TIME_CONVERT, stats_start);
+    
+    int squarings = 0, multiplies = 0;
+    mont_exp_kernel_t kernel = {mul, NULL, &sm, (size_t)sm.padded * sizeof(uint64_t)};
+    montgomery_exp_sliding(&kernel, acc, s->simd_table, s->simd_scratch, exp, window_bits, &squarings, &multiplies);
+    STATS_COUNT(RSA_4096_STAT_MONT_SQR, (uint64_t)squarings);
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, (uint64_t)multiplies);
+    TRACE(LOG_DEBUG, "[MONT_EXP_SIMD] %d-bit radix: %d squarings, %d multiplications", radix, squarings, multiplies);
+    
+    /* Leave the domain: acc * 1 * R'^(-1) lies in [0, n] */
+    stats_start = STATS_START();
+    mul(acc, acc, one, &sm);
+    bigint_t *value = r2_mod;
+    simd_to_bigint(value, acc, &sm);
+    memset(acc, 0, (size_t)sm.padded * sizeof(uint64_t));
+    STATS_COUNT(RSA_4096_STAT_MONT_MUL, 3);
+    STATS_COUNT(RSA_4096_STAT_SIMD_EXP, 1);
+    if (bigint_compare(value, n) >= 0) {
+        ret = bigint_sub(result, value, n);
+    } else {
+        bigint_copy(result, value);
+    }
+    STATS_TIME(RSA_4096_TIME_CONVERT, stats_start);
+    return ret;
+}
+
+#endif /* RSA_4096_SIMD_X86 */
+
+int montgomery_simd_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp,
+                        const montgomery_ctx_t *ctx, int window_bits, mont_exp_scratch_t *scratch) {
+    int kernel = montgomery_simd_active();
+    if (kernel == MONTGOMERY_SIMD_NONE || result == NULL || base == NULL || exp == NULL || ctx == NULL ||
+        scratch == NULL) {
+        return 1;
+    }
+    
+    bigint_t *n = &scratch->simd_big[0];
+    montgomery_ctx_get_modulus(ctx, n);
+    if (bigint_bit_length(n) < simd_min_bits) {
+        return 1;
+    }
+    
+#ifdef RSA_4096_SIMD_X86
+    const simd_exp_kernel_t *k = &simd_exp_kernels[kernel];
+    return simd_exp_run(result, base, exp, n, ctx, window_bits, k->radix, k->lanes, k->mul, scratch);
+#else
+    (void)window_bits;
+#endif
+    return 1;
+}
+
+/* ===================== MULTI-BUFFER EXPONENTIATION ===================== */
+
+/*
+ * Lane-transposed layout: limb j of the number in lane l sits at x[j * lanes + l],
+ * so one vector holds the same limb of every independent exponentiation. The
+ * multiplier digit m, the division by the radix and the carry pass all become
+ * vertical - no lane shifts or scalar extract/broadcast per step - and each
+ * lane has its own modulus and k0. All lanes share L, so R' = 2^(radix * L).
+ */
+
+#define SIMD_MB_MAX_WINDOW 5       /* Fixed windows: 2^w table entries per lane */
+
+typedef struct {
+    int radix;
+    int lanes;
+    int limbs;                  /* L shared by every lane */
+    uint64_t mask;
+    uint64_t k0[MONTGOMERY_MULTI_MAX_LANES];
+    uint64_t n[MONTGOMERY_SIMD_MAX_LIMBS * MONTGOMERY_MULTI_MAX_LANES];
+} simd_mb_t;
+
+static int simd_mb_modulus_bits(const montgomery_ctx_t *ctx) {
+    int top = ctx->n_words - 1;
+    while (top > 0 && ctx->n.words[top] == 0) top--;
+    int bits = top * BIGINT_WORD_SIZE;
+    for (bigint_word_t w = ctx->n.words[top]; w != 0; w >>= 1) bits++;
+    return bits;
+}
+
+#ifdef RSA_4096_SIMD_X86
+
+/**
+ * @brief 8-lane IFMA almost-Montgomery multiply on lane-transposed operands
+ *
+ * Step i folds a[i] * b + m * n into the accumulator and writes it back one
+ * limb down, which is the division by 2^52. Steps run in pairs: step i + 1
+ * trails step i by one limb, so each accumulator slot is loaded and stored
+ * once per two steps. A slot collects at most four sub-2^52 terms per step,
+ * so even L = 160 steps stay far below 2^64.
+ */
+__attribute__((target("avx512f,avx512ifma")))
+static void simd_mb_amm52_ifma(uint64_t *out, const uint64_t *a, const uint64_t *b, const simd_mb_t *mb) {
+    const int L = mb->limbs;
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i k0 = _mm512_loadu_si512((const void *)mb->k0);
+    const __m512i b0 = _mm512_loadu_si512((const void *)b);
+    const __m512i n0 = _mm512_loadu_si512((const void *)mb->n);
+    __m512i x[MONTGOMERY_SIMD_MAX_LIMBS];
+    
+    for (int j = 0; j < L; j++) x[j] = zero;
+    
+    int i = 0;
+    for (; i + 1 < L; i += 2) {
+        __m512i ai = _mm512_loadu_si512((const void *)(a + 8 * i));
+        __m512i a2 = _mm512_loadu_si512((const void *)(a + 8 * i + 8));
+    
+        /* m = (x0 + a[i] * b0) * k0 mod 2^52 per lane, which clears limb 0 mod 2^52 */
+        __m512i t = _mm512_madd52lo_epu64(x[0], ai, b0);
+        __m512i m = _mm512_madd52lo_epu64(zero, t, k0);
+        t = _mm512_madd52lo_epu64(t, m, n0);
+        __m512i up = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_srli_epi64(t, 52), ai, b0), m, n0);
+    
+        __m512i bp = _mm512_loadu_si512((const void *)(b + 8));
+        __m512i np = _mm512_loadu_si512((const void *)(mb->n + 8));
+        __m512i y = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(_mm512_add_epi64(x[1], up), ai, bp), m, np);
+        up = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, ai, bp), m, np);
+    
+        /* Step i + 1 starts on the new limb 0 as soon as step i has produced it */
+        t = _mm512_madd52lo_epu64(y, a2, b0);
+        __m512i m2 = _mm512_madd52lo_epu64(zero, t, k0);
+        t = _mm512_madd52lo_epu64(t, m2, n0);
+        __m512i up2 = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_srli_epi64(t, 52), a2, b0), m2, n0);
+    
+        for (int j = 2; j < L; j++) {
+            __m512i bj = _mm512_loadu_si512((const void *)(b + 8 * j));
+            __m512i nj = _mm512_loadu_si512((const void *)(mb->n + 8 * j));
+            y = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(_mm512_add_epi64(x[j], up), ai, bj), m, nj);
+            up = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, ai, bj), m, nj);
+            x[j - 2] = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(_mm512_add_epi64(y, up2), a2, bp), m2, np);
+            up2 = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, a2, bp), m2, np);
+            bp = bj;
+            np = nj;
+        }
+        x[L - 2] = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(_mm512_add_epi64(up, up2), a2, bp), m2, np);
+        x[L - 1] = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, a2, bp), m2, np);
+    }
+    
+    /* Odd L: one last single step */
+    if (i < L) {
+        __m512i ai = _mm512_loadu_si512((const void *)(a + 8 * i));
+        __m512i t = _mm512_madd52lo_epu64(x[0], ai, b0);
+        __m512i m = _mm512_madd52lo_epu64(zero, t, k0);
+        t = _mm512_madd52lo_epu64(t, m, n0);
+        __m512i up = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_srli_epi64(t, 52), ai, b0), m, n0);
+        for (int j = 1; j < L; j++) {
+            __m512i bj = _mm512_loadu_si512((const void *)(b + 8 * j));
+            __m512i nj = _mm512_loadu_si512((const void *)(mb->n + 8 * j));
+            x[j - 1] = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(_mm512_add_epi64(x[j], up), ai, bj), m, nj);
+            up = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, ai, bj), m, nj);
+        }
+        x[L - 1] = up;
+    }
+    
+    const __m512i mask = _mm512_set1_epi64((long long)mb->mask);
+    __m512i carry = zero;
+    for (int j = 0; j < L; j++) {
+        __m512i v = _mm512_add_epi64(x[j], carry);
+        _mm512_storeu_si512((void *)(out + 8 * j), _mm512_and_si512(v, mask));
+        carry = _mm512_srli_epi64(v, 52);
+    }
+}
+
+/**
+ * @brief 4-lane AVX2 almost-Montgomery multiply on lane-transposed operands, radix 2^29
+ *
+ * Full 58-bit products land in one slot, which gains under 2^59 per step; a
+ * vertical carry pass every 16 steps keeps every slot below 2^64. Steps are
+ * paired the same way as in the IFMA kernel.
+ */
+__attribute__((target("avx2")))
+static void simd_mb_amm29_avx2(uint64_t *out, const uint64_t *a, const uint64_t *b, const simd_mb_t *mb) {
+    const int L = mb->limbs;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i mask = _mm256_set1_epi64x((long long)mb->mask);
+    const __m256i k0 = _mm256_loadu_si256((const __m256i *)mb->k0);
+    const __m256i b0 = _mm256_loadu_si256((const __m256i *)b);
+    const __m256i n0 = _mm256_loadu_si256((const __m256i *)mb->n);
+    __m256i x[MONTGOMERY_SIMD_MAX_LIMBS + 1];
+    
+    for (int j = 0; j <= L; j++) x[j] = zero;
+    
+    int i = 0;
+    for (; i + 1 < L; i += 2) {
+        __m256i ai = _mm256_loadu_si256((const __m256i *)(a + 4 * i));
+        __m256i a2 = _mm256_loadu_si256((const __m256i *)(a + 4 * i + 4));
+        __m256i t = _mm256_add_epi64(x[0], _mm256_mul_epu32(ai, b0));
+        __m256i m = _mm256_and_si256(_mm256_mul_epu32(t, k0), mask);
+        t = _mm256_add_epi64(t, _mm256_mul_epu32(m, n0));
+    
+        __m256i bp = _mm256_loadu_si256((const __m256i *)(b + 4));
+        __m256i np = _mm256_loadu_si256((const __m256i *)(mb->n + 4));
+        __m256i y = _mm256_add_epi64(_mm256_add_epi64(x[1], _mm256_srli_epi64(t, 29)), _mm256_mul_epu32(ai, bp));
+        y = _mm256_add_epi64(y, _mm256_mul_epu32(m, np));
+    
+        /* Step i + 1 starts on the new limb 0 as soon as step i has produced it */
+        t = _mm256_add_epi64(y, _mm256_mul_epu32(a2, b0));
+        __m256i m2 = _mm256_and_si256(_mm256_mul_epu32(t, k0), mask);
+        t = _mm256_add_epi64(t, _mm256_mul_epu32(m2, n0));
+    
+        for (int j = 2; j < L; j++) {
+            __m256i bj = _mm256_loadu_si256((const __m256i *)(b + 4 * j));
+            __m256i nj = _mm256_loadu_si256((const __m256i *)(mb->n + 4 * j));
+            y = _mm256_add_epi64(_mm256_add_epi64(x[j], _mm256_mul_epu32(ai, bj)), _mm256_mul_epu32(m, nj));
+            x[j - 2] = _mm256_add_epi64(_mm256_add_epi64(y, _mm256_mul_epu32(a2, bp)), _mm256_mul_epu32(m2, np));
+            bp = bj;
+            np = nj;
+        }
+        x[L - 2] = _mm256_add_epi64(_mm256_add_epi64(x[L], _mm256_mul_epu32(a2, bp)), _mm256_mul_epu32(m2, np));
+        x[L - 1] = zero;
+        x[L] = zero;
+        x[0] = _mm256_add_epi64(x[0], _mm256_srli_epi64(t, 29));
+    
+        if (((i + 2) & 15) == 0) {
+            __m256i carry = zero;
+            for (int j = 0; j < L; j++) {
+                __m256i v = _mm256_add_epi64(x[j], carry);
+                x[j] = _mm256_and_si256(v, mask);
+                carry = _mm256_srli_epi64(v, 29);
+            }
+            x[L] = carry;
+        }
+    }
+    
+    /* Odd L: one last single step */
+    if (i < L) {
+        __m256i ai = _mm256_loadu_si256((const __m256i *)(a + 4 * i));
+        __m256i t = _mm256_add_epi64(x[0], _mm256_mul_epu32(ai, b0));
+        __m256i m = _mm256_and_si256(_mm256_mul_epu32(t, k0), mask);
+        t = _mm256_add_epi64(t, _mm256_mul_epu32(m, n0));
+        for (int j = 1; j < L; j++) {
+            __m256i bj = _mm256_loadu_si256((const __m256i *)(b + 4 * j));
+            __m256i nj = _mm256_loadu_si256((const __m256i *)(mb->n + 4 * j));
+            x[j - 1] = _mm256_add_epi64(_mm256_add_epi64(x[j], _mm256_mul_epu32(ai, bj)), _mm256_mul_epu32(m, nj));
+        }
+        x[0] = _mm256_add_epi64(x[0], _mm256_srli_epi64(t, 29));
+        x[L - 1] = x[L];
+    }
+    
+    __m256i carry = zero;
+    for (int j = 0; j < L; j++) {
+        __m256i v = _mm256_add_epi64(x[j], carry);
+        _mm256_storeu_si256((__m256i *)(out + 4 * j), _mm256_and_si256(v, mask));
+        carry = _mm256_srli_epi64(v, 29);
+    }
+}
+
+typedef void (*simd_mb_mul_t)(uint64_t *out, const uint64_t *a, const uint64_t *b, const simd_mb_t *mb);
+
+/* Multi-buffer dispatch table, indexed by MONTGOMERY_SIMD_* */
+typedef struct {
+    int radix;
+    int lanes;
+    simd_mb_mul_t mul;
+} simd_mb_kernel_t;
+
+static const simd_mb_kernel_t simd_mb_kernels[] = {
+    [MONTGOMERY_SIMD_NONE] = {0, 1, NULL},
+    [MONTGOMERY_SIMD_AVX2] = {29, 4, simd_mb_amm29_avx2},
+    [MONTGOMERY_SIMD_IFMA] = {52, 8, simd_mb_amm52_ifma},
+};
+
+typedef struct {
+    simd_mb_t mb;
+    simd_mont_t sm[MONTGOMERY_MULTI_MAX_LANES];     /* Per-lane radix split of n, used for conversions */
+    bigint_t big[3];                                /* Modulus, R'^2 mod n / reduced base, widened R^2 */
+    uint64_t limbs[MONTGOMERY_SIMD_MAX_LIMBS];      /* One lane before transposition */
+} simd_mb_state_t;
+
+/* Called through a volatile pointer so the wipe before free() is not optimised away */
+static void *(*volatile simd_wipe)(void *, int, size_t) = memset;
+
+static void simd_mb_put_lane(uint64_t *dst, const uint64_t *limbs, int lane, const simd_mb_t *mb) {
+    for (int j = 0; j < mb->limbs; j++) {
+        dst[j * mb->lanes + lane] = limbs[j];
+    }
+}
+
+static void simd_mb_get_lane(uint64_t *limbs, const uint64_t *src, int lane, const simd_mb_t *mb) {
+    for (int j = 0; j < mb->limbs; j++) {
+        limbs[j] = src[j * mb->lanes + lane];
+    }
+}
+
+/**
+ * @brief Per-lane table lookup: lane l takes its limbs from table entry idx[l]
+ */
+static void simd_mb_gather(uint64_t *dst, const uint64_t *table, const int *idx, const simd_mb_t *mb) {
+    size_t stride = (size_t)mb->limbs * mb->lanes;
+    for (int j = 0; j < mb->limbs; j++) {
+        for (int l = 0; l < mb->lanes; l++) {
+            dst[j * mb->lanes + l] = table[(size_t)idx[l] * stride + (size_t)j * mb->lanes + l];
+        }
+    }
+}
+
+static int simd_mb_window(const bigint_t *e, int pos, int w) {
+    int v = 0;
+    for (int b = w - 1; b >= 0; b--) {
+        v = (v << 1) | bigint_get_bit(e, pos + b);
+    }
+    return v;
+}
+
+/**
+ * @brief One lock-step group: count <= lanes exponentiations, idle lanes repeat lane 0
+ *
+ * Fixed windows rather than sliding ones, so every lane squares and multiplies
+ * at the same time; a lane whose exponent is shorter simply sees leading zero
+ * windows and multiplies by its Montgomery one. 1 = could not allocate.
+ */
+static int simd_mb_exp_run(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                           const montgomery_ctx_t *const *ctxs, int count, int radix, int lanes, simd_mb_mul_t mul) {
+    int limbs = 0, exp_bits = 0;
+    for (int l = 0; l < count; l++) {
+        int need = (simd_mb_modulus_bits(ctxs[l]) + 2 + radix - 1) / radix;
+        if (need > limbs) limbs = need;
+        int bits = bigint_bit_length(exps[l]);
+        if (bits > exp_bits) exp_bits = bits;
+    }
+    int w = montgomery_select_window(exp_bits);
+    if (w > SIMD_MB_MAX_WINDOW) w = SIMD_MB_MAX_WINDOW;
+    
+    size_t stride = (size_t)limbs * lanes;
+    size_t table_bytes = (((size_t)1 << w) + 4) * stride * sizeof(uint64_t);
+    simd_mb_state_t *st = (simd_mb_state_t *)malloc(sizeof(simd_mb_state_t));
+    uint64_t *table = (uint64_t *)malloc(table_bytes);
+    if (st == NULL || table == NULL) {
+        free(st);
+        free(table);
+        return 1;
+    }
+    uint64_t *rr = table + ((size_t)1 << w) * stride, *one = rr + stride, *acc = one + stride, *op = acc + stride;
+    
+    simd_mb_t *mb = &st->mb;
+    mb->radix = radix;
+    mb->lanes = lanes;
+    mb->limbs = limbs;
+    mb->mask = (1ULL << radix) - 1;
+    memset(one, 0, stride * sizeof(uint64_t));
+    
+    /* Per lane: modulus and k0, R'^2 mod n and the base, each transposed into its lane */
+    int ret = 0;
+    for (int l = 0; l < lanes && ret == 0; l++) {
+        int src = l < count ? l : 0;
+        simd_mont_t *sm = &st->sm[l];
+        montgomery_ctx_get_modulus(ctxs[src], &st->big[0]);
+        simd_setup(sm, &st->big[0], radix, 1);
+        sm->limbs = limbs;
+        sm->padded = limbs;
+        simd_from_bigint(sm->n, &st->big[0], sm);
+        mb->k0[l] = sm->k0;
+        simd_mb_put_lane(mb->n, sm->n, l, mb);
+    
+        ret = simd_r2_mod_n(&st->big[1], &st->big[2], sm, &st->big[0], ctxs[src]);
+        if (ret != 0) break;
+        simd_from_bigint(st->limbs, &st->big[1], sm);
+        simd_mb_put_lane(rr, st->limbs, l, mb);
+    
+        const bigint_t *base = bases[src];
+        if (bigint_compare(base, &st->big[0]) >= 0) {
+            ret = bigint_mod(&st->big[1], base, &st->big[0]);
+            base = &st->big[1];
+        }
+        simd_from_bigint(st->limbs, base, sm);
+        simd_mb_put_lane(table + stride, st->limbs, l, mb);
+        one[l] = 1;
+    }
+    
+    if (ret == 0) {
+        /* table[k] = base^k * R' mod n, table[0] = R' mod n is the Montgomery one */
+        mul(table, one, rr, mb);
+        mul(table + stride, table + stride, rr, mb);
+        for (int k = 2; k < (1 << w); k++) {
+            mul(table + k * stride, table + (k - 1) * stride, table + stride, mb);
+        }
+    
+        int idx[MONTGOMERY_MULTI_MAX_LANES];
+        int windows = (exp_bits + w - 1) / w;
+        memcpy(acc, table, stride * sizeof(uint64_t));
+        for (int win = windows - 1; win >= 0; win--) {
+            int any = 0;
+            for (int l = 0; l < lanes; l++) {
+                idx[l] = simd_mb_window(exps[l < count ? l : 0], win * w, w);
+                any |= idx[l];
+            }
+            if (win == windows - 1) {
+                simd_mb_gather(acc, table, idx, mb);
+                continue;
+            }
+            for (int s = 0; s < w; s++) {
+                mul(acc, acc, acc, mb);
+            }
+            if (any) {
+                simd_mb_gather(op, table, idx, mb);
+                mul(acc, acc, op, mb);
+            }
+        }
+        TRACE(LOG_DEBUG, "[MONT_EXP_MULTI] %d lanes x %d limbs, %d exponent bits, %d-bit fixed window",
+              lanes, limbs, exp_bits, w);
+    
+        /* Leave the domain: acc * 1 * R'^(-1) lies in [0, n] per lane */
+        mul(acc, acc, one, mb);
+        for (int l = 0; l < count && ret == 0; l++) {
+            simd_mb_get_lane(st->limbs, acc, l, mb);
+            simd_to_bigint(&st->big[1], st->limbs, &st->sm[l]);
+            montgomery_ctx_get_modulus(ctxs[l], &st->big[0]);
+            if (bigint_compare(&st->big[1], &st->big[0]) >= 0) {
+                ret = bigint_sub(results[l], &st->big[1], &st->big[0]);
+            } else {
+                bigint_copy(results[l], &st->big[1]);
+            }
+        }
+    }
+    
+    simd_wipe(table, 0, table_bytes);
+    simd_wipe(st, 0, sizeof(simd_mb_state_t));
+    free(table);
+    free(st);
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Multi-buffer exponentiation setup failed");
+    }
+    return 0;
+}
+
+#endif /* RSA_4096_SIMD_X86 */
+
+int montgomery_multi_lanes(void) {
+#ifdef RSA_4096_SIMD_X86
+    return simd_mb_kernels[montgomery_simd_active()].lanes;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Run one gathered group in lock-step, or one at a time when that is not worth it
+ *
+ * A lock-step pass costs the same however many lanes are live, so a group
+ * less than half full is cheaper on the single-buffer kernels.
+ */
+static int montgomery_exp_group(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                                const montgomery_ctx_t *const *ctxs, int count, int kernel,
+                                rsa_4096_workspace_t *ws) {
+#ifdef RSA_4096_SIMD_X86
+    const simd_mb_kernel_t *k = &simd_mb_kernels[kernel];
+    if (k->lanes > 1 && 2 * count >= k->lanes) {
+        int ret = simd_mb_exp_run(results, bases, exps, ctxs, count, k->radix, k->lanes, k->mul);
+        if (ret <= 0) {
+            return ret;
+        }
+    }
+#else
+    (void)kernel;
+#endif
+    for (int i = 0; i < count; i++) {
+        int ret = montgomery_exp_ws(results[i], bases[i], exps[i], ctxs[i], ws);
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    return 0;
+}
+
+int montgomery_exp_multi(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                         const montgomery_ctx_t *const *ctxs, int count) {
+    return montgomery_exp_multi_ws(results, bases, exps, ctxs, count, NULL);
+}
+
+int montgomery_exp_multi_ws(bigint_t *const *results, const bigint_t *const *bases, const bigint_t *const *exps,
+                            const montgomery_ctx_t *const *ctxs, int count, rsa_4096_workspace_t *ws) {
+    if (count < 0 || (count > 0 && (results == NULL || bases == NULL || exps == NULL || ctxs == NULL))) {
+        ERROR_RETURN(-1, "NULL pointer in montgomery_exp_multi");
+    }
+    
+    const int kernel = montgomery_simd_active();
+    const int lanes = montgomery_multi_lanes();
+    bigint_t *group_results[MONTGOMERY_MULTI_MAX_LANES];
+    const bigint_t *group_bases[MONTGOMERY_MULTI_MAX_LANES], *group_exps[MONTGOMERY_MULTI_MAX_LANES];
+    const montgomery_ctx_t *group_ctxs[MONTGOMERY_MULTI_MAX_LANES];
+    int filled = 0;
+    
+    for (int i = 0; i < count; i++) {
+        if (results[i] == NULL || bases[i] == NULL || exps[i] == NULL || ctxs[i] == NULL) {
+            ERROR_RETURN(-1, "NULL entry %d in montgomery_exp_multi", i);
+        }
+        if (!ctxs[i]->is_active || ctxs[i]->n_words == 0) {
+            ERROR_RETURN(-1, "Montgomery context %d disabled", i);
+        }
+    
+        /* Moduli the vector kernels do not take run on their own */
+        if (lanes == 1 || simd_mb_modulus_bits(ctxs[i]) < simd_min_bits) {
+            int ret = montgomery_exp_ws(results[i], bases[i], exps[i], ctxs[i], ws);
+            if (ret != 0) {
+                ERROR_RETURN(ret, "Exponentiation %d failed", i);
+            }
+            continue;
+        }
+    
+        group_results[filled] = results[i];
+        group_bases[filled] = bases[i];
+        group_exps[filled] = exps[i];
+        group_ctxs[filled] = ctxs[i];
+        if (++filled == lanes) {
+            STATS_COUNT(RSA_4096_STAT_MULTI_EXP, (uint64_t)filled);
+            uint64_t stats_start = STATS_START();
+            int ret = montgomery_exp_group(group_results, group_bases, group_exps, group_ctxs, filled, kernel, ws);
+            STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+            if (ret != 0) {
+                ERROR_RETURN(ret, "Multi-buffer group ending at %d failed", i);
+            }
+            filled = 0;
+        }
+    }
+    
+    if (filled > 0) {
+        STATS_COUNT(RSA_4096_STAT_MULTI_EXP, (uint64_t)filled);
+        uint64_t stats_start = STATS_START();
+        int ret = montgomery_exp_group(group_results, group_bases, group_exps, group_ctxs, filled, kernel, ws);
+        STATS_TIME(RSA_4096_TIME_EXP, stats_start);
+        if (ret != 0) {
+            ERROR_RETURN(ret, "Multi-buffer group failed");
+        }
+    }
+    return 0;
+}
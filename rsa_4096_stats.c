@@ -0,0 +1,253 @@
+/**
+ * @file rsa_4096_stats.c
+ * @brief Opt-in performance counters, phase timers and latency histograms
+ *
+ * Every thread that hits a probe while counting is enabled gets its own
+ * block, so the hot path is a thread-local pointer load and a relaxed store
+ * no other thread writes. rsa_4096_stats_get() walks the live blocks under a
+ * lock and adds the totals of threads that have exited; reset records a
+ * baseline instead of touching the blocks, which keeps their single-writer
+ * rule intact.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "rsa_4096.h"
+
+#define STATS_WORDS (sizeof(rsa_4096_stats_t) / sizeof(uint64_t))
+
+/* ===================== PER-THREAD BLOCKS ===================== */
+
+typedef struct stats_block {
+    rsa_4096_stats_t stats;         /* Written by the owning thread only */
+    struct stats_block *next;
+} stats_block_t;
+
+static int stats_on;
+static pthread_mutex_t stats_lock = PTHREAD_MUTEX_INITIALIZER;
+static stats_block_t *stats_blocks;         /* Live threads */
+static rsa_4096_stats_t stats_retired;      /* Folded in from exited threads */
+static rsa_4096_stats_t stats_baseline;     /* Totals at the last reset */
+static pthread_key_t stats_key;
+static pthread_once_t stats_key_once = PTHREAD_ONCE_INIT;
+static __thread stats_block_t *stats_local;
+
+static void stats_add(rsa_4096_stats_t *dst, const rsa_4096_stats_t *src) {
+    uint64_t *d = (uint64_t *)dst;
+    const uint64_t *s = (const uint64_t *)src;
+    for (size_t i = 0; i < STATS_WORDS; i++) {
+        d[i] += __atomic_load_n(&s[i], __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * @brief Thread-exit destructor: keep the thread's totals, drop its block
+ */
+static void stats_block_retire(void *arg) {
+    stats_block_t *block = (stats_block_t *)arg;
+    pthread_mutex_lock(&stats_lock);
+    stats_add(&stats_retired, &block->stats);
+    for (stats_block_t **link = &stats_blocks; *link != NULL; link = &(*link)->next) {
+        if (*link == block) {
+            *link = block->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stats_lock);
+    free(block);
+}
+
+static void stats_key_create(void) {
+    pthread_key_create(&stats_key, stats_block_retire);
+}
+
+static stats_block_t *stats_block(void) {
+    stats_block_t *block = stats_local;
+    if (block != NULL) {
+        return block;
+    }
+    
+    /* First probe on this thread; out of memory just means it goes uncounted */
+    block = (stats_block_t *)calloc(1, sizeof(stats_block_t));
+    if (block == NULL) {
+        return NULL;
+    }
+    pthread_once(&stats_key_once, stats_key_create);
+    pthread_setspecific(stats_key, block);
+    pthread_mutex_lock(&stats_lock);
+    block->next = stats_blocks;
+    stats_blocks = block;
+    pthread_mutex_unlock(&stats_lock);
+    stats_local = block;
+    return block;
+}
+
+/* Single writer per block: a relaxed store is enough for readers to see whole values */
+static void stats_bump(uint64_t *slot, uint64_t n) {
+    __atomic_store_n(slot, *slot + n, __ATOMIC_RELAXED);
+}
+
+static uint64_t stats_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* ===================== PROBES ===================== */
+
+void rsa_4096_stats_count(int counter, uint64_t n) {
+    if (!__atomic_load_n(&stats_on, __ATOMIC_RELAXED) || counter < 0 || counter >= RSA_4096_STAT_COUNTERS) {
+        return;
+    }
+    stats_block_t *block = stats_block();
+    if (block != NULL) {
+        stats_bump(&block->stats.counts[counter], n);
+    }
+}
+
+uint64_t rsa_4096_stats_start(void) {
+    return __atomic_load_n(&stats_on, __ATOMIC_RELAXED) ? stats_now() : 0;
+}
+
+void rsa_4096_stats_time(int timer, uint64_t start) {
+    if (start == 0 || timer < 0 || timer >= RSA_4096_TIMERS) {
+        return;
+    }
+    uint64_t elapsed = stats_now() - start;
+    stats_block_t *block = stats_block();
+    if (block != NULL) {
+        stats_bump(&block->stats.time_ns[timer], elapsed);
+        stats_bump(&block->stats.time_calls[timer], 1);
+    }
+}
+
+void rsa_4096_stats_latency(int op, uint64_t start, uint64_t samples) {
+    if (start == 0 || samples == 0 || op < 0 || op >= RSA_4096_LATENCY_OPS) {
+        return;
+    }
+    uint64_t elapsed = stats_now() - start;
+    uint64_t us = elapsed / 1000u;
+    int bucket = us > 1 ? 63 - __builtin_clzll(us) : 0;
+    if (bucket >= RSA_4096_LATENCY_BUCKETS) {
+        bucket = RSA_4096_LATENCY_BUCKETS - 1;
+    }
+    stats_block_t *block = stats_block();
+    if (block != NULL) {
+        stats_bump(&block->stats.latency[op][bucket], samples);
+        stats_bump(&block->stats.latency_ns[op], elapsed * samples);
+    }
+}
+
+/* ===================== CONTROL AND READOUT ===================== */
+
+void rsa_4096_stats_enable(int on) {
+    __atomic_store_n(&stats_on, on != 0, __ATOMIC_RELAXED);
+}
+
+int rsa_4096_stats_enabled(void) {
+    return __atomic_load_n(&stats_on, __ATOMIC_RELAXED);
+}
+
+/* Caller holds stats_lock */
+static void stats_totals(rsa_4096_stats_t *out) {
+    *out = stats_retired;
+    for (stats_block_t *block = stats_blocks; block != NULL; block = block->next) {
+        stats_add(out, &block->stats);
+    }
+}
+
+void rsa_4096_stats_get(rsa_4096_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&stats_lock);
+    stats_totals(stats);
+    uint64_t *d = (uint64_t *)stats;
+    const uint64_t *base = (const uint64_t *)&stats_baseline;
+    for (size_t i = 0; i < STATS_WORDS; i++) {
+        d[i] -= base[i];
+    }
+    pthread_mutex_unlock(&stats_lock);
+}
+
+void rsa_4096_stats_reset(void) {
+    pthread_mutex_lock(&stats_lock);
+    stats_totals(&stats_baseline);
+    pthread_mutex_unlock(&stats_lock);
+}
+
+uint64_t rsa_4096_stats_latency_percentile(const rsa_4096_stats_t *stats, int op, double fraction) {
+    if (stats == NULL || op < 0 || op >= RSA_4096_LATENCY_OPS) {
+        return 0;
+    }
+    uint64_t samples = 0;
+    for (int b = 0; b < RSA_4096_LATENCY_BUCKETS; b++) {
+        samples += stats->latency[op][b];
+    }
+    if (samples == 0) {
+        return 0;
+    }
+    
+    /* Smallest bucket whose cumulative count reaches the requested share */
+    double target = fraction <= 0.0 ? 1.0 : fraction >= 1.0 ? (double)samples : fraction * (double)samples;
+    uint64_t seen = 0;
+    for (int b = 0; b < RSA_4096_LATENCY_BUCKETS; b++) {
+        seen += stats->latency[op][b];
+        if ((double)seen >= target) {
+            return (uint64_t)1 << (b + 1);
+        }
+    }
+    return (uint64_t)1 << RSA_4096_LATENCY_BUCKETS;
+}
+
+const char *rsa_4096_stats_counter_name(int counter) {
+    static const char *const names[RSA_4096_STAT_COUNTERS] = {
+        "bigint_mul", "bigint_div", "div_iterations", "montgomery_redc", "montgomery_mul",
+        "montgomery_square", "montgomery_exp", "simd_exp", "multi_exp_lanes", "traditional_exp", "crt_exp",
+        "barrett_reduce"
+    };
+    return counter >= 0 && counter < RSA_4096_STAT_COUNTERS ? names[counter] : "unknown";
+}
+
+const char *rsa_4096_stats_timer_name(int timer) {
+    static const char *const names[RSA_4096_TIMERS] = {"ctx_init", "convert", "exponentiation"};
+    return timer >= 0 && timer < RSA_4096_TIMERS ? names[timer] : "unknown";
+}
+
+void rsa_4096_stats_print(const rsa_4096_stats_t *stats, FILE *out) {
+    if (stats == NULL || out == NULL) {
+        return;
+    }
+    static const char *const op_names[RSA_4096_LATENCY_OPS] = {"encrypt", "decrypt"};
+    
+    fprintf(out, "📊 RSA-4096 performance counters\n");
+    for (int c = 0; c < RSA_4096_STAT_COUNTERS; c++) {
+        fprintf(out, "   %-18s %12" PRIu64 "\n", rsa_4096_stats_counter_name(c), stats->counts[c]);
+    }
+    for (int t = 0; t < RSA_4096_TIMERS; t++) {
+        fprintf(out, "   %-18s %12" PRIu64 " calls %12.3f ms\n", rsa_4096_stats_timer_name(t),
+                stats->time_calls[t], (double)stats->time_ns[t] / 1e6);
+    }
+    for (int op = 0; op < RSA_4096_LATENCY_OPS; op++) {
+        uint64_t samples = 0;
+        for (int b = 0; b < RSA_4096_LATENCY_BUCKETS; b++) {
+            samples += stats->latency[op][b];
+        }
+        if (samples == 0) {
+            continue;
+        }
+        fprintf(out, "   %-18s %12" PRIu64 " ops   mean %.1f us, p50 < %" PRIu64 " us, p99 < %" PRIu64 " us\n",
+                op_names[op], samples, (double)stats->latency_ns[op] / 1e3 / (double)samples,
+                rsa_4096_stats_latency_percentile(stats, op, 0.50),
+                rsa_4096_stats_latency_percentile(stats, op, 0.99));
+    }
+}
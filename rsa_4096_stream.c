@@ -0,0 +1,485 @@
+/**
+ * @file rsa_4096_stream.c
+ * @brief Streaming bulk encryption/decryption of whole files over a worker pool
+ *
+ * The input is cut into chunks of RSA_4096_STREAM_CHUNK_BLOCKS modulus-sized
+ * blocks (framing in rsa_4096.h). A regular file is mmapped and workers take
+ * their chunk straight from the mapping; pipes and sockets are read one
+ * chunk at a time into the chunk's slot. Workers claim chunks in input order,
+ * run each chunk through the lock-step rsa_4096_*_multi calls on
+ * their own workspace, and park the result in a reorder window of
+ * 2 * threads slots. The calling thread writes the slots back strictly in
+ * chunk order, so output order never depends on which worker finished first,
+ * and a slow chunk only stalls claiming once the window is full.
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rsa_4096.h"
+
+#define STREAM_WORKER_STACK_SIZE (1u * 1024u * 1024u)
+#define STREAM_BLOCK_MARKER      0x01       /* Leading byte of every plaintext block */
+
+/* ===================== JOB STATE ===================== */
+
+typedef struct {
+    size_t index;                   /* Chunk held by this slot */
+    const uint8_t *in;              /* Into the mapping, or buf */
+    size_t in_len;
+    int last;                       /* Shorter than a full chunk: the end of the input */
+    int ready;                      /* Transformed, waiting for the writer */
+    int status;
+    size_t blocks;
+    int short_tail;                 /* Decryption: the last block carries < k-2 bytes, the stream ends here */
+    uint8_t *buf;                   /* Read mode: this chunk's copy of the input */
+    uint8_t *stage;                 /* Encryption: zeros || marker || plaintext, k bytes per block */
+    uint8_t *out;
+    size_t out_len;
+    rsa_4096_batch_item_t *items;
+} stream_slot_t;
+
+typedef struct {
+    const rsa_4096_key_t *key;
+    int decrypt;
+    int in_fd;
+    size_t k;                       /* Block (modulus) bytes */
+    size_t chunk_blocks;
+    size_t chunk_in;                /* Input bytes of a full chunk */
+    const uint8_t *map;             /* NULL: read from in_fd */
+    size_t map_len;
+    stream_slot_t *slots;
+    size_t window;
+    
+    pthread_mutex_t input_lock;     /* Held while claiming and filling a chunk, keeps input order */
+    size_t map_pos;
+    size_t next_chunk;
+    
+    pthread_mutex_t lock;           /* Slot states and the write position */
+    pthread_cond_t cond;
+    size_t next_write;
+    size_t total_chunks;            /* Valid once input_done */
+    int input_done;                 /* Set holding both locks */
+    int failed;
+} stream_job_t;
+
+/* ===================== INPUT ===================== */
+
+static int stream_read_full(int fd, uint8_t *buf, size_t want, size_t *got) {
+    *got = 0;
+    while (*got < want) {
+        ssize_t r = read(fd, buf + *got, want - *got);
+        if (r < 0 && errno == EINTR) continue;
+        if (r < 0) return -4;
+        if (r == 0) break;
+        *got += (size_t)r;
+    }
+    return 0;
+}
+
+/**
+ * @brief Point a slot at the next chunk of input; caller holds input_lock
+ */
+static int stream_fill(stream_job_t *job, stream_slot_t *s) {
+    if (job->map != NULL) {
+        size_t remaining = job->map_len - job->map_pos;
+        s->in = job->map + job->map_pos;
+        s->in_len = remaining < job->chunk_in ? remaining : job->chunk_in;
+        job->map_pos += s->in_len;
+    } else {
+        int ret = stream_read_full(job->in_fd, s->buf, job->chunk_in, &s->in_len);
+        if (ret != 0) {
+            return ret;
+        }
+        s->in = s->buf;
+    }
+    /* A full chunk ending exactly at EOF is followed by an empty last one */
+    s->last = s->in_len < job->chunk_in;
+    return 0;
+}
+
+/* ===================== CHUNK TRANSFORMS ===================== */
+
+static int stream_encrypt_chunk(stream_job_t *job, stream_slot_t *s, rsa_4096_workspace_t *ws) {
+    size_t k = job->k, data = k - 2;
+    s->blocks = s->in_len / data + (s->last ? 1 : 0);
+    for (size_t b = 0; b < s->blocks; b++) {
+        size_t off = b * data;
+        size_t take = s->in_len - off < data ? s->in_len - off : data;
+        uint8_t *stage = s->stage + b * k;
+        memset(stage, 0, k - take - 1);
+        stage[k - take - 1] = STREAM_BLOCK_MARKER;
+        memcpy(stage + (k - take), s->in + off, take);
+        s->items[b] = (rsa_4096_batch_item_t){stage, k, s->out + b * k, k, 0, -2};
+    }
+    
+    /* Fixed-length output lands right-aligned in its k-byte block already */
+    if (rsa_4096_encrypt_fixed_multi(job->key, s->items, s->blocks, ws) != 0) {
+        return -8;
+    }
+    s->out_len = s->blocks * k;
+    return 0;
+}
+
+static int stream_decrypt_chunk(stream_job_t *job, stream_slot_t *s, rsa_4096_workspace_t *ws) {
+    size_t k = job->k, data = k - 2;
+    if (s->in_len % k != 0) {
+        return -5;
+    }
+    s->blocks = s->in_len / k;
+    s->short_tail = 0;
+    for (size_t b = 0; b < s->blocks; b++) {
+        s->items[b] = (rsa_4096_batch_item_t){s->in + b * k, k, s->out + b * k, k, 0, -2};
+    }
+    if (rsa_4096_decrypt_binary_multi(job->key, s->items, s->blocks, ws) != 0) {
+        return -8;
+    }
+    
+    /* Strip the markers and pack the plaintext; it never overtakes the next unread block */
+    size_t pos = 0;
+    for (size_t b = 0; b < s->blocks; b++) {
+        const uint8_t *plain = s->out + b * k;
+        size_t len = s->items[b].output_len;
+        if (len == 0 || plain[0] != STREAM_BLOCK_MARKER) {
+            return -5;
+        }
+        size_t take = len - 1;
+        if (take > data || (take < data && b + 1 < s->blocks)) {
+            return -5;
+        }
+        s->short_tail = take < data;
+        memmove(s->out + pos, plain + 1, take);
+        pos += take;
+    }
+    s->out_len = pos;
+    return 0;
+}
+
+/* ===================== WORKERS AND WRITER ===================== */
+
+static void *stream_worker_main(void *arg) {
+    stream_job_t *job = (stream_job_t *)arg;
+    
+    /* NULL on allocation failure: the multi calls then make their own */
+    rsa_4096_workspace_t *ws = rsa_4096_workspace_new();
+    
+    for (;;) {
+        pthread_mutex_lock(&job->input_lock);
+        if (job->input_done) {
+            pthread_mutex_unlock(&job->input_lock);
+            break;
+        }
+        size_t index = job->next_chunk;
+        stream_slot_t *s = &job->slots[index % job->window];
+    
+        /* Wait until the writer has drained the chunk that last used this slot */
+        pthread_mutex_lock(&job->lock);
+        while (index - job->next_write >= job->window && !job->failed) {
+            pthread_cond_wait(&job->cond, &job->lock);
+        }
+        int failed = job->failed;
+        if (!failed) {
+            s->index = index;
+            s->ready = 0;
+        }
+        pthread_mutex_unlock(&job->lock);
+        if (failed) {
+            pthread_mutex_unlock(&job->input_lock);
+            break;
+        }
+    
+        int ret = stream_fill(job, s);
+        job->next_chunk++;
+        if (ret != 0 || s->last) {
+            pthread_mutex_lock(&job->lock);
+            job->input_done = 1;
+            job->total_chunks = job->next_chunk;
+            pthread_cond_broadcast(&job->cond);
+            pthread_mutex_unlock(&job->lock);
+        }
+        pthread_mutex_unlock(&job->input_lock);
+    
+        if (ret == 0) {
+            ret = job->decrypt ? stream_decrypt_chunk(job, s, ws) : stream_encrypt_chunk(job, s, ws);
+        }
+        pthread_mutex_lock(&job->lock);
+        s->status = ret;
+        s->ready = 1;
+        pthread_cond_broadcast(&job->cond);
+        pthread_mutex_unlock(&job->lock);
+    }
+    rsa_4096_workspace_free(ws);
+    return NULL;
+}
+
+static int stream_write_all(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, data, len);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return -6;
+        data += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+/**
+ * @brief Reorder buffer drain: write chunk next_write as soon as it is ready, in order
+ */
+static int stream_write_ordered(stream_job_t *job, int out_fd, rsa_4096_stream_stats_t *stats) {
+    int ret = 0, ended = 0;
+    pthread_mutex_lock(&job->lock);
+    for (;;) {
+        stream_slot_t *s = &job->slots[job->next_write % job->window];
+        while (!(s->ready && s->index == job->next_write) &&
+               !(job->input_done && job->next_write == job->total_chunks)) {
+            pthread_cond_wait(&job->cond, &job->lock);
+        }
+        if (job->input_done && job->next_write == job->total_chunks) {
+            break;
+        }
+        pthread_mutex_unlock(&job->lock);
+    
+        /* Decryption: exactly one short block, and it is the very last one */
+        ret = s->status;
+        if (ret == 0 && job->decrypt && (ended ? s->blocks > 0 : s->last && !s->short_tail)) {
+            ret = -5;
+        }
+        ended = ended || s->short_tail;
+        if (ret == 0) {
+            ret = stream_write_all(out_fd, s->out, s->out_len);
+        }
+        if (ret == 0) {
+            stats->bytes_in += s->in_len;
+            stats->bytes_out += s->out_len;
+            stats->blocks += s->blocks;
+            stats->chunks++;
+        }
+    
+        pthread_mutex_lock(&job->lock);
+        if (ret != 0) {
+            job->failed = 1;
+            pthread_cond_broadcast(&job->cond);
+            break;
+        }
+        job->next_write++;
+        pthread_cond_broadcast(&job->cond);
+    }
+    pthread_mutex_unlock(&job->lock);
+    return ret;
+}
+
+/* ===================== STREAM DRIVER ===================== */
+
+static void stream_put_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static uint32_t stream_get_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/**
+ * @brief Decryption: consume and check the stream header from the mapping or the fd
+ */
+static int stream_read_header(stream_job_t *job) {
+    uint8_t header[RSA_4096_STREAM_HEADER_SIZE];
+    size_t got = 0;
+    if (job->map != NULL) {
+        got = job->map_len - job->map_pos < sizeof(header) ? job->map_len - job->map_pos : sizeof(header);
+        memcpy(header, job->map + job->map_pos, got);
+        job->map_pos += got;
+    } else if (stream_read_full(job->in_fd, header, sizeof(header), &got) != 0) {
+        ERROR_RETURN(-4, "Failed to read stream header");
+    }
+    if (got < sizeof(header) || memcmp(header, RSA_4096_STREAM_MAGIC, 8) != 0) {
+        ERROR_RETURN(-5, "Input is not an RSA-4096 stream");
+    }
+    if (stream_get_be32(header + 8) != RSA_4096_STREAM_VERSION) {
+        ERROR_RETURN(-5, "Unsupported stream version %u", stream_get_be32(header + 8));
+    }
+    if (stream_get_be32(header + 12) != job->k) {
+        ERROR_RETURN(-5, "Stream uses %u-byte blocks, key needs %zu", stream_get_be32(header + 12), job->k);
+    }
+    return 0;
+}
+
+static int stream_resolve_threads(const rsa_4096_stream_config_t *config) {
+    int num_threads = config != NULL ? config->num_threads : 0;
+    if (num_threads <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = online > 0 ? (int)online : 1;
+    }
+    return num_threads > RSA_4096_BATCH_MAX_THREADS ? RSA_4096_BATCH_MAX_THREADS : num_threads;
+}
+
+static int stream_alloc_slots(stream_job_t *job) {
+    job->slots = calloc(job->window, sizeof(stream_slot_t));
+    if (job->slots == NULL) {
+        return -3;
+    }
+    for (size_t i = 0; i < job->window; i++) {
+        stream_slot_t *s = &job->slots[i];
+        s->out = malloc(job->chunk_blocks * job->k);
+        s->items = malloc(job->chunk_blocks * sizeof(rsa_4096_batch_item_t));
+        if (job->map == NULL) s->buf = malloc(job->chunk_in);
+        if (!job->decrypt) s->stage = malloc(job->chunk_blocks * job->k);
+        if (s->out == NULL || s->items == NULL || (job->map == NULL && s->buf == NULL) ||
+            (!job->decrypt && s->stage == NULL)) {
+            return -3;
+        }
+    }
+    return 0;
+}
+
+static void stream_free_slots(stream_job_t *job) {
+    if (job->slots == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < job->window; i++) {
+        free(job->slots[i].out);
+        free(job->slots[i].items);
+        free(job->slots[i].buf);
+        free(job->slots[i].stage);
+    }
+    free(job->slots);
+}
+
+static int stream_run(const rsa_4096_key_t *key, int decrypt, int in_fd, int out_fd,
+                      const rsa_4096_stream_config_t *config, rsa_4096_stream_stats_t *stats) {
+    if (key == NULL || in_fd < 0 || out_fd < 0) {
+        ERROR_RETURN(-1, "Invalid arguments to RSA stream operation");
+    }
+    int modulus_bits = bigint_bit_length(&key->n);
+    if (modulus_bits < 17) {
+        ERROR_RETURN(-2, "Modulus of %d bits is too small for stream framing", modulus_bits);
+    }
+    
+    stream_job_t job;
+    memset(&job, 0, sizeof(job));
+    job.key = key;
+    job.decrypt = decrypt;
+    job.in_fd = in_fd;
+    job.k = (size_t)(modulus_bits + 7) / 8;
+    job.chunk_blocks = RSA_4096_STREAM_CHUNK_BLOCKS;
+    if (config != NULL && config->chunk_blocks > 0) {
+        job.chunk_blocks = config->chunk_blocks < RSA_4096_STREAM_MAX_CHUNK ? (size_t)config->chunk_blocks
+                                                                             : RSA_4096_STREAM_MAX_CHUNK;
+    }
+    job.chunk_in = job.chunk_blocks * (decrypt ? job.k : job.k - 2);
+    int threads = stream_resolve_threads(config);
+    job.window = 2 * (size_t)threads;
+    
+    rsa_4096_stream_stats_t local;
+    memset(&local, 0, sizeof(local));
+    
+    /* Map a regular input file from its current offset; pipes, sockets and files with
+     * nothing left before EOF are read */
+    struct stat st;
+    off_t offset = -1;
+    if (fstat(in_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        offset = lseek(in_fd, 0, SEEK_CUR);
+    }
+    if (offset >= 0 && offset < st.st_size) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, in_fd, 0);
+        if (map != MAP_FAILED) {
+            posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            job.map = (const uint8_t *)map;
+            job.map_len = (size_t)st.st_size;
+            job.map_pos = (size_t)offset;
+            local.mapped = 1;
+        }
+    }
+    
+    int ret = 0;
+    if (decrypt) {
+        ret = stream_read_header(&job);
+        local.bytes_in = RSA_4096_STREAM_HEADER_SIZE;
+    } else {
+        uint8_t header[RSA_4096_STREAM_HEADER_SIZE];
+        memcpy(header, RSA_4096_STREAM_MAGIC, 8);
+        stream_put_be32(header + 8, RSA_4096_STREAM_VERSION);
+        stream_put_be32(header + 12, (uint32_t)job.k);
+        ret = stream_write_all(out_fd, header, sizeof(header));
+        local.bytes_out = RSA_4096_STREAM_HEADER_SIZE;
+    }
+    if (ret == 0) {
+        ret = stream_alloc_slots(&job);
+    }
+    
+    if (ret == 0) {
+        pthread_mutex_init(&job.input_lock, NULL);
+        pthread_mutex_init(&job.lock, NULL);
+        pthread_cond_init(&job.cond, NULL);
+    
+        pthread_t tids[RSA_4096_BATCH_MAX_THREADS];
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, STREAM_WORKER_STACK_SIZE);
+        int started = 0;
+        for (int t = 0; t < threads; t++) {
+            if (pthread_create(&tids[t], &attr, stream_worker_main, &job) != 0) {
+                CHECKPOINT(LOG_INFO, "Stream worker %d could not be started, continuing with %d", t, started);
+                break;
+            }
+            started++;
+        }
+        pthread_attr_destroy(&attr);
+    
+        if (started == 0) {
+            ret = -7;
+        } else {
+            ret = stream_write_ordered(&job, out_fd, &local);
+        }
+        for (int t = 0; t < started; t++) {
+            pthread_join(tids[t], NULL);
+        }
+    
+        pthread_mutex_destroy(&job.input_lock);
+        pthread_mutex_destroy(&job.lock);
+        pthread_cond_destroy(&job.cond);
+    }
+    
+    stream_free_slots(&job);
+    if (job.map != NULL) {
+        munmap((void *)job.map, job.map_len);
+    }
+    if (stats != NULL) {
+        *stats = local;
+    }
+    if (ret != 0) {
+        ERROR_RETURN(ret, "RSA stream %s failed after %zu chunks", decrypt ? "decryption" : "encryption",
+                     local.chunks);
+    }
+    CHECKPOINT(LOG_INFO, "Stream %s: %zu blocks in %zu chunks, %zu -> %zu bytes (%s)",
+               decrypt ? "decrypted" : "encrypted", local.blocks, local.chunks, local.bytes_in, local.bytes_out,
+               local.mapped ? "mapped" : "read");
+    return 0;
+}
+
+int rsa_4096_encrypt_stream(const rsa_4096_key_t *pub_key, int in_fd, int out_fd,
+                            const rsa_4096_stream_config_t *config, rsa_4096_stream_stats_t *stats) {
+    return stream_run(pub_key, 0, in_fd, out_fd, config, stats);
+}
+
+int rsa_4096_decrypt_stream(const rsa_4096_key_t *priv_key, int in_fd, int out_fd,
+                            const rsa_4096_stream_config_t *config, rsa_4096_stream_stats_t *stats) {
+    if (priv_key != NULL && !priv_key->is_private) {
+        ERROR_RETURN(-2, "Stream decryption requires private key");
+    }
+    return stream_run(priv_key, 1, in_fd, out_fd, config, stats);
+}
@@ -7,10 +7,18 @@
  * @version FINAL_COMPLETE_FIXED_v8.4
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/stat.h>
 #include "rsa_4096.h"
 
 /* ===================== VERIFICATION TESTS ===================== */
@@ -265,7 +273,7 @@ int run_benchmarks(void) {
     printf("User: RSAhardcore\n\n");
     
     printf("ℹ️  Running encryption benchmark with small modulus (n=35)\n");
-    printf("⚠️  For production use, implement 4096-bit key generation\n\n");
+    printf("ℹ️  Per-primitive timings on real 1024-4096-bit keys: make bench\n\n");
     
     rsa_4096_key_t key;
     rsa_4096_init(&key);
@@ -1142,7 +1150,7 @@ int validate_all_algorithms_round_trip(void) {
     if (ret1 == 0 && ret2 == 0 && ret3 == 0) {
         if (bigint_compare(&result_trad, &result_mont) == 0 &&
             bigint_compare(&result_trad, &result_hybrid) == 0) {
-            printf("   ✅ All algorithms produce consistent result: %u\n", result_trad.words[0]);
+            printf("   ✅ All algorithms produce consistent result: %" PRIuWORD "\n", result_trad.words[0]);
             passed++;
         } else {
             printf("   ❌ Algorithms produce inconsistent results:\n");
@@ -1165,41 +1173,3978 @@ int validate_all_algorithms_round_trip(void) {
     return passed == total ? 0 : -1;
 }
 
-/* ===================== ROUND-TRIP VALIDATION HELPER FUNCTIONS ===================== */
+/* ===================== FUSED MONTGOMERY KERNEL TESTING ===================== */
 
 /**
- * @brief Validate Montgomery round-trip conversion
- * TODO: This helper function validates that a value survives Montgomery conversion
+ * @brief Fill a bigint with pseudo-random words below the modulus (deterministic LCG)
  */
-int validate_montgomery_round_trip(const bigint_t *value, const montgomery_ctx_t *ctx) {
-    if (value == NULL || ctx == NULL || !ctx->is_active) {
+static void test_fill_below(bigint_t *a, const bigint_t *mod, uint32_t *seed) {
+    bigint_init(a);
+    for (int i = 0; i < mod->used; i++) {
+        bigint_word_t w = 0;
+        for (int k = 0; k < BIGINT_WORD_BYTES / 4; k++) {
+            *seed = *seed * 1664525u + 1013904223u;
+            w = (w << 16 << 16) | *seed;  /* Two steps: no UB for 32-bit limbs */
+        }
+        a->words[i] = w;
+    }
+    a->words[mod->used - 1] %= mod->words[mod->used - 1];
+    a->used = mod->used;
+    bigint_normalize(a);
+}
+
+/**
+ * @brief Cross-check the fused CIOS montgomery_mul against bigint_mul + montgomery_redc
+ */
+int test_montgomery_cios(void) {
+    printf("===============================================\n");
+    printf("🔍 FUSED CIOS MONTGOMERY MULTIPLICATION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    
+    /* Mersenne primes keep montgomery_ctx_init cheap while exercising multi-word REDC */
+    const char *moduli_hex[] = {
+        "7fffffffffffffffffffffffffffffff",
+        "1" "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+        "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+    };
+    int num_moduli = sizeof(moduli_hex) / sizeof(moduli_hex[0]);
+    uint32_t seed = 0x12345678u;
+    
+    for (int m = 0; m < num_moduli; m++) {
+        bigint_t mod;
+        montgomery_ctx_t ctx;
+        bigint_from_hex(&mod, moduli_hex[m]);
+        
+        printf("\n🧪 Test %d: %d-bit modulus\n", m + 1, bigint_bit_length(&mod));
+        total++;
+        
+        if (montgomery_ctx_init(&ctx, &mod) != 0 || !ctx.is_active) {
+            printf("   ❌ Montgomery context initialization failed\n");
+            continue;
+        }
+        
+        int ok = 1;
+        for (int i = 0; i < 8 && ok; i++) {
+            bigint_t a, b, fused, product, reference;
+            test_fill_below(&a, &mod, &seed);
+            test_fill_below(&b, &mod, &seed);
+            
+            /* Reference: two-pass schoolbook product followed by standalone REDC */
+            if (montgomery_mul(&fused, &a, &b, &ctx) != 0 ||
+                bigint_mul(&product, &a, &b) != 0 ||
+                montgomery_redc(&reference, &product, &ctx) != 0) {
+                printf("   ❌ Montgomery operation failed at sample %d\n", i);
+                ok = 0;
+            } else if (bigint_compare(&fused, &reference) != 0) {
+                printf("   ❌ Fused result differs from REDC(a * b) at sample %d\n", i);
+                debug_print_bigint("fused", &fused);
+                debug_print_bigint("reference", &reference);
+                ok = 0;
+            }
+        }
+        
+        /* Exponentiation through the fused kernel must agree with the traditional path */
+        if (ok) {
+            bigint_t base, exp, mont_result, trad_result;
+            test_fill_below(&base, &mod, &seed);
+            bigint_set_u32(&exp, 65537);
+            if (montgomery_exp(&mont_result, &base, &exp, &ctx) != 0 ||
+                bigint_mod_exp(&trad_result, &base, &exp, &mod) != 0 ||
+                bigint_compare(&mont_result, &trad_result) != 0) {
+                printf("   ❌ Montgomery exponentiation disagrees with traditional path\n");
+                ok = 0;
+            }
+        }
+
+        /* Fixed-width residues must round-trip and reject values wider than n */
+        if (ok) {
+            bigint_t value, back, modulus, wide;
+            mont_residue_t res;
+            test_fill_below(&value, &mod, &seed);
+            montgomery_ctx_get_modulus(&ctx, &modulus);
+            bigint_shift_left(&wide, &mod, BIGINT_WORD_SIZE);
+            if (mont_residue_from_bigint(&res, &value, &ctx) != 0) {
+                printf("   ❌ Residue load failed\n");
+                ok = 0;
+            } else {
+                mont_residue_to_bigint(&back, &res, &ctx);
+                if (bigint_compare(&back, &value) != 0 || bigint_compare(&modulus, &mod) != 0 ||
+                    !montgomery_ctx_matches(&ctx, &mod) ||
+                    mont_residue_from_bigint(&res, &wide, &ctx) == 0) {
+                    printf("   ❌ Residue conversion mismatch\n");
+                    ok = 0;
+                }
+            }
+        }
+
+        /* R^(-1) is only derived on demand and must satisfy R * R^(-1) == 1 (mod n) */
+        if (ok) {
+            bigint_t r_inv, r, product, check, value;
+            bigint_t one;
+            bigint_set_u32(&one, 1);
+            bigint_shift_left(&r, &one, BIGINT_WORD_SIZE * ctx.n_words);
+            int lazy = !ctx.has_r_inv;
+            if (!lazy || montgomery_ctx_get_r_inv(&ctx, &r_inv) != 0 || !ctx.has_r_inv ||
+                bigint_mul(&product, &r_inv, &r) != 0 || bigint_mod(&check, &product, &mod) != 0 ||
+                bigint_compare(&check, &one) != 0) {
+                printf("   ❌ Lazy R^(-1) mod n missing or wrong\n");
+                ok = 0;
+            } else {
+                test_fill_below(&value, &mod, &seed);
+                if (validate_montgomery_round_trip(&value, &ctx) != 0) {
+                    printf("   ❌ Round-trip validation against R^(-1) failed\n");
+                    ok = 0;
+                }
+            }
+        }
+
+        if (ok) {
+            printf("✅ Test %d PASSED: fused kernel matches two-pass REDC\n", m + 1);
+            passed++;
+        }
+        montgomery_ctx_free(&ctx);
+    }
+    
+    printf("\n===============================================\n");
+    printf("FUSED CIOS SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Cross-check sliding-window montgomery_exp against the binary ladder
+ */
+int test_montgomery_sliding_window(void) {
+    printf("===============================================\n");
+    printf("🔍 SLIDING-WINDOW MONTGOMERY EXPONENTIATION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x9e3779b9u;
+    
+    /* 2^521 - 1: large enough for every window width, cheap to set up */
+    bigint_t mod;
+    montgomery_ctx_t ctx;
+    bigint_from_hex(&mod, "1" "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"
+                              "fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    if (montgomery_ctx_init(&ctx, &mod) != 0 || !ctx.is_active) {
+        printf("❌ Montgomery context initialization failed\n");
         return -1;
     }
     
-    bigint_t mont_form, recovered;
-    bigint_init(&mont_form);
-    bigint_init(&recovered);
+    /* Exponent shapes: full-width random, single high bit (long zero runs), all ones */
+    bigint_t exps[3], one;
+    test_fill_below(&exps[0], &mod, &seed);
+    bigint_set_u32(&one, 1);
+    bigint_shift_left(&exps[1], &one, 300);
+    bigint_sub(&exps[2], &mod, &exps[1]);  /* 2^521 - 1 - 2^300 */
+    const char *names[] = {"random", "2^300", "dense"};
+    
+    for (int e = 0; e < 3; e++) {
+        bigint_t base, reference;
+        test_fill_below(&base, &mod, &seed);
+        total++;
+        printf("\n🧪 Test %d: %s exponent (%d bits, auto window %d)\n", e + 1, names[e],
+               bigint_bit_length(&exps[e]), montgomery_select_window(bigint_bit_length(&exps[e])));
+        
+        if (montgomery_exp_window(&reference, &base, &exps[e], &ctx, 1) != 0) {
+            printf("   ❌ Binary ladder failed\n");
+            continue;
+        }
+        
+        int ok = 1;
+        for (int w = MONTGOMERY_WINDOW_AUTO; w <= MONTGOMERY_MAX_WINDOW && ok; w++) {
+            bigint_t windowed;
+            if (w == 1) continue;
+            if (montgomery_exp_window(&windowed, &base, &exps[e], &ctx, w) != 0 ||
+                bigint_compare(&windowed, &reference) != 0) {
+                printf("   ❌ Window %d disagrees with binary ladder\n", w);
+                ok = 0;
+            }
+        }
+        
+        if (ok) {
+            printf("✅ Test %d PASSED: all window widths agree\n", e + 1);
+            passed++;
+        }
+    }
     
-    /* Convert to Montgomery form */
-    int ret = montgomery_to_form(&mont_form, value, ctx);
-    if (ret != 0) {
-        CHECKPOINT(LOG_ERROR, "Montgomery to_form failed in validation");
-        return -2;
+    /* Windowed path against the independent traditional implementation */
+    {
+        bigint_t base, exp, windowed, traditional;
+        test_fill_below(&base, &mod, &seed);
+        bigint_from_hex(&exp, "c3a5c85c97cb3127");
+        total++;
+        printf("\n🧪 Test %d: 64-bit exponent vs bigint_mod_exp\n", total);
+        if (montgomery_exp_window(&windowed, &base, &exp, &ctx, 4) == 0 &&
+            bigint_mod_exp(&traditional, &base, &exp, &mod) == 0 &&
+            bigint_compare(&windowed, &traditional) == 0) {
+            printf("✅ Test %d PASSED: matches traditional path\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Windowed result differs from traditional path\n");
+        }
     }
     
-    /* Convert back from Montgomery form */
-    ret = montgomery_from_form(&recovered, &mont_form, ctx);
-    if (ret != 0) {
-        CHECKPOINT(LOG_ERROR, "Montgomery from_form failed in validation");
-        return -3;
+    /* Out-of-range window sizes are rejected */
+    {
+        bigint_t out;
+        total++;
+        if (montgomery_exp_window(&out, &one, &one, &ctx, MONTGOMERY_MAX_WINDOW + 1) != 0 &&
+            montgomery_exp_window(&out, &one, &one, &ctx, -1) != 0) {
+            printf("✅ Test %d PASSED: invalid window sizes rejected\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Invalid window size accepted\n");
+        }
     }
     
-    /* Compare original and recovered */
-    if (bigint_compare(value, &recovered) != 0) {
-        CHECKPOINT(LOG_ERROR, "Montgomery round-trip validation FAILED");
-        debug_print_bigint("original", value);
-        debug_print_bigint("recovered", &recovered);
-        return -4;
+    montgomery_ctx_free(&ctx);
+    
+    printf("\n===============================================\n");
+    printf("SLIDING WINDOW SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* 1024-bit key: n = p * q with dP, dQ, qInv as in PKCS#1 - shared by the CRT and key blob tests */
+static const char *const n_1024 = "12340249724648615726206755177797777191878037686268223731927894518405687584467790"
+    "73375344406444494688722065513791763831577959041274758651042527988730450184826258"
+    "61944163126600955809510425568986576309928086056546444861626261774678606879732330"
+    "983726965731786427626697805229595302127825765691108504270204003364699";
+static const char *const d_1024 = "11288437237627739466283491457713269457410016285906682956998477261286591946174352"
+    "23277313159142986421160207968282497420799399155949510290197149632305098173812942"
+    "34565617637589227717771316749904415154030026595878823136595100979999366280270895"
+    "223941294878943704762766092459332479799271904341413906354069904197873";
+static const char *const p_1024 = "11745706414669401774809289352026651351349127252184876698596104694652382663721247"
+    "707164064242364126601698521433178871872439598504808963392178641321370774851";
+static const char *const q_1024 = "10506179270100501782573986929949253101096710295693126369000499137191735491750606"
+    "585830456515833069525047381233310758195369600013976113160385265474527447049";
+static const char *const dp_1024 = "55351083649030288907519430603779712274755702283668421190997771852487020490160827"
+    "34761355571069375863510034575007953963538528773403116184812322177841753673";
+static const char *const dq_1024 = "69962109297912034239451597967078948355594951054311216716651629361325925863402348"
+    "69139765068037701149154184838856647529827732178920999291171914427564991441";
+static const char *const qinv_1024 = "35932488877603476091004439279316386080661090108079434495280713134711438807129092"
+    "00747889084840151770668188644541422960041329931528587026644459663282137188";
+
+/**
+ * @brief CRT decryption must match the full-size path and reject inconsistent components
+ */
+int test_rsa_crt_decryption(void) {
+    printf("===============================================\n");
+    printf("🔍 CRT PRIVATE-KEY DECRYPTION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    
+    struct {
+        const char *name, *n, *e, *d, *p, *q, *dp, *dq, *qinv;
+        const char *messages[3];
+    } keys[] = {
+        {"143 = 11 * 13", "143", "7", "103", "11", "13", "3", "7", "6", {"2", "42", "142"}},
+        {"1024-bit", n_1024, "65537", d_1024, p_1024, q_1024, dp_1024, dq_1024, qinv_1024,
+         {"2", "123456789123456789", "98765432109876543210987654321"}}
+    };
+    int num_keys = sizeof(keys) / sizeof(keys[0]);
+    
+    for (int k = 0; k < num_keys; k++) {
+        rsa_4096_key_t pub_key, priv_key, crt_key;
+        printf("\n🧪 Key %d: %s\n", k + 1, keys[k].name);
+        total++;
+        
+        if (rsa_4096_load_key(&pub_key, keys[k].n, keys[k].e, 0) != 0 ||
+            rsa_4096_load_key(&priv_key, keys[k].n, keys[k].d, 1) != 0 ||
+            rsa_4096_load_key(&crt_key, keys[k].n, keys[k].d, 1) != 0 ||
+            rsa_4096_load_key_crt(&crt_key, keys[k].p, keys[k].q, keys[k].dp, keys[k].dq, keys[k].qinv) != 0 ||
+            !crt_key.has_crt) {
+            printf("   ❌ Key loading failed\n");
+            continue;
+        }
+        
+        int ok = 1;
+        for (int m = 0; m < 3 && ok; m++) {
+            char encrypted_hex[1100], plain[700], plain_crt[700];
+            if (rsa_4096_encrypt(&pub_key, keys[k].messages[m], encrypted_hex, sizeof(encrypted_hex)) != 0 ||
+                rsa_4096_decrypt(&priv_key, encrypted_hex, plain, sizeof(plain)) != 0 ||
+                rsa_4096_decrypt(&crt_key, encrypted_hex, plain_crt, sizeof(plain_crt)) != 0) {
+                printf("   ❌ RSA operation failed for message %s\n", keys[k].messages[m]);
+                ok = 0;
+            } else if (strcmp(plain_crt, keys[k].messages[m]) != 0 || strcmp(plain, plain_crt) != 0) {
+                printf("   ❌ CRT decrypt mismatch: got %s, expected %s\n", plain_crt, keys[k].messages[m]);
+                ok = 0;
+            }
+        }
+        
+        /* Binary loader and binary decrypt follow the same CRT path */
+        if (ok) {
+            uint8_t buf[5][256], msg[1] = {0x5a}, ct[256], pt[256];
+            size_t len[5], ct_len, pt_len;
+            const bigint_t *parts[5] = {&crt_key.p, &crt_key.q, &crt_key.dp, &crt_key.dq, &crt_key.qinv};
+            rsa_4096_key_t bin_key;
+            for (int i = 0; i < 5; i++) {
+                bigint_to_binary(parts[i], buf[i], sizeof(buf[i]), &len[i]);
+            }
+            if (rsa_4096_load_key(&bin_key, keys[k].n, keys[k].d, 1) != 0 ||
+                rsa_4096_load_key_crt_binary(&bin_key, buf[0], len[0], buf[1], len[1], buf[2], len[2],
+                                             buf[3], len[3], buf[4], len[4]) != 0 ||
+                rsa_4096_encrypt_binary(&pub_key, msg, 1, ct, sizeof(ct), &ct_len) != 0 ||
+                rsa_4096_decrypt_binary(&bin_key, ct, ct_len, pt, sizeof(pt), &pt_len) != 0 ||
+                pt_len != 1 || pt[0] != msg[0]) {
+                printf("   ❌ Binary CRT round-trip failed\n");
+                ok = 0;
+            }
+            rsa_4096_free(&bin_key);
+        }
+        
+        if (ok) {
+            printf("✅ Key %d PASSED: CRT decrypt matches full-size decrypt\n", k + 1);
+            passed++;
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+        rsa_4096_free(&crt_key);
+    }
+    
+    /* Inconsistent components are rejected and the key stays on the full-size path */
+    {
+        rsa_4096_key_t key;
+        char plain[16];
+        total++;
+        printf("\n🧪 Test %d: invalid CRT components\n", total);
+        rsa_4096_load_key(&key, "143", "103", 1);
+        int bad_qinv = rsa_4096_load_key_crt(&key, "11", "13", "3", "7", "5");
+        int bad_primes = rsa_4096_load_key_crt(&key, "11", "17", "3", "7", "6");
+        if (bad_qinv != 0 && bad_primes != 0 && !key.has_crt &&
+            rsa_4096_decrypt(&key, "2a", plain, sizeof(plain)) == 0) {
+            printf("✅ Test %d PASSED: bad qInv / primes rejected, fallback decrypt works\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Invalid CRT components were accepted\n");
+        }
+        rsa_4096_free(&key);
+    }
+    
+    printf("\n===============================================\n");
+    printf("CRT DECRYPTION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Check q * b + r == a and r < b for one division
+ */
+static int test_check_division(const bigint_t *a, const bigint_t *b) {
+    bigint_t q, r, qb, back;
+    if (bigint_div(&q, &r, a, b) != 0) return 0;
+    if (bigint_compare(&r, b) >= 0) return 0;
+    if (bigint_mul(&qb, &q, b) != 0 || bigint_add(&back, &qb, &r) != 0) return 0;
+    return bigint_compare(&back, a) == 0;
+}
+
+/**
+ * @brief Word-level Knuth division against the q * b + r identity
+ */
+int test_bigint_division(void) {
+    printf("===============================================\n");
+    printf("🔍 KNUTH ALGORITHM D DIVISION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x2545f491u;
+    
+    /* Test 1: add-back case - the first qhat estimate overshoots by one */
+    {
+        bigint_t a, b;
+        bigint_init(&a);
+        bigint_init(&b);
+        bigint_word_t top = (bigint_word_t)1 << (BIGINT_WORD_SIZE - 1);
+        a.words[2] = top;
+        a.words[3] = top - 1;
+        a.used = 4;
+        b.words[0] = 1;
+        b.words[2] = top;
+        b.used = 3;
+        total++;
+        if (test_check_division(&a, &b)) {
+            printf("✅ Test %d PASSED: add-back correction\n", total);
+            passed++;
+        } else {
+            printf("❌ Test %d FAILED: add-back correction\n", total);
+        }
+    }
+    
+    /* Test 2: all-ones divisor and dividend (qhat = B - 1 branch) */
+    {
+        bigint_t a, b;
+        bigint_init(&a);
+        bigint_init(&b);
+        for (int i = 0; i < 8; i++) a.words[i] = BIGINT_WORD_MASK;
+        for (int i = 0; i < 4; i++) b.words[i] = BIGINT_WORD_MASK;
+        a.used = 8;
+        b.used = 4;
+        total++;
+        if (test_check_division(&a, &b)) {
+            printf("✅ Test %d PASSED: all-ones operands\n", total);
+            passed++;
+        } else {
+            printf("❌ Test %d FAILED: all-ones operands\n", total);
+        }
+    }
+    
+    /* Test 3: exact multiple gives zero remainder */
+    {
+        bigint_t a, b, k, q, r;
+        bigint_from_hex(&b, "d3c21bcecceda1000001c3a5c85c97cb3127b1c9a1e2f3");
+        bigint_from_hex(&k, "fedcba9876543210fedcba98765432");
+        bigint_mul(&a, &b, &k);
+        total++;
+        if (bigint_div(&q, &r, &a, &b) == 0 && bigint_is_zero(&r) && bigint_compare(&q, &k) == 0) {
+            printf("✅ Test %d PASSED: exact multiple\n", total);
+            passed++;
+        } else {
+            printf("❌ Test %d FAILED: exact multiple\n", total);
+        }
+    }
+    
+    /* Test 4: random operands from 2 to 2 * MONTGOMERY_MAX_WORDS words (8192-by-4096 bits at the top) */
+    {
+        int ok = 1, count = 0;
+        for (int a_words = 2; a_words <= 2 * MONTGOMERY_MAX_WORDS && ok; a_words += 7) {
+            for (int b_words = 2; b_words <= a_words && b_words <= MONTGOMERY_MAX_WORDS && ok; b_words += 11) {
+                bigint_t a, b, limit;
+                bigint_init(&limit);
+                limit.words[a_words - 1] = BIGINT_WORD_MASK;
+                limit.used = a_words;
+                test_fill_below(&a, &limit, &seed);
+                limit.used = b_words;
+                limit.words[b_words - 1] = BIGINT_WORD_MASK;
+                test_fill_below(&b, &limit, &seed);
+                if (bigint_is_zero(&b)) continue;
+                ok = test_check_division(&a, &b);
+                if (!ok) {
+                    printf("   ❌ Mismatch for %d-word / %d-word\n", a_words, b_words);
+                }
+                count++;
+            }
+        }
+        total++;
+        if (ok) {
+            printf("✅ Test %d PASSED: %d random divisions\n", total, count);
+            passed++;
+        } else {
+            printf("❌ Test %d FAILED: random divisions\n", total);
+        }
+    }
+    
+    /* Test 5: single-word divisors above the old 16-bit fast-path limit */
+    {
+        bigint_t a, b, limit;
+        bigint_init(&limit);
+        limit.words[20] = BIGINT_WORD_MASK;
+        limit.used = 21;
+        test_fill_below(&a, &limit, &seed);
+        bigint_set_u32(&b, 0xfffffffbu);
+        total++;
+        if (test_check_division(&a, &b)) {
+            printf("✅ Test %d PASSED: full-width single-word divisor\n", total);
+            passed++;
+        } else {
+            printf("❌ Test %d FAILED: full-width single-word divisor\n", total);
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("DIVISION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Key blob round-trip, file persistence and rejection of damaged blobs
+ */
+int test_key_blob(void) {
+    printf("===============================================\n");
+    printf("🔍 KEY BLOB PERSISTENCE TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    
+    struct {
+        const char *name, *n, *e, *d, *p, *q, *dp, *dq, *qinv, *message;
+    } keys[] = {
+        {"143 = 11 * 13", "143", "7", "103", "11", "13", "3", "7", "6", "42"},
+        {"1024-bit", n_1024, "65537", d_1024, p_1024, q_1024, dp_1024, dq_1024, qinv_1024, "123456789123456789"}
+    };
+    int num_keys = sizeof(keys) / sizeof(keys[0]);
+    
+    /* Serialize freshly loaded public and CRT keys, reload, and decrypt through the restored state */
+    for (int k = 0; k < num_keys; k++) {
+        rsa_4096_key_t pub_key, crt_key, pub_blob, crt_blob;
+        uint8_t *buf = NULL;
+        size_t size = 0, written = 0;
+        int ok = 1;
+        total++;
+        printf("\n🧪 Key %d: %s\n", k + 1, keys[k].name);
+        
+        if (rsa_4096_load_key(&pub_key, keys[k].n, keys[k].e, 0) != 0 ||
+            rsa_4096_load_key(&crt_key, keys[k].n, keys[k].d, 1) != 0 ||
+            rsa_4096_load_key_crt(&crt_key, keys[k].p, keys[k].q, keys[k].dp, keys[k].dq, keys[k].qinv) != 0) {
+            printf("   ❌ Key loading failed\n");
+            continue;
+        }
+        
+        rsa_4096_init(&pub_blob);
+        rsa_4096_init(&crt_blob);
+        if (rsa_4096_key_serialize(&crt_key, NULL, 0, &size) != 0 || (buf = malloc(size)) == NULL ||
+            rsa_4096_key_serialize(&crt_key, buf, size, &written) != 0 || written != size ||
+            rsa_4096_key_serialize(&crt_key, buf, size - 1, &written) == 0 ||
+            rsa_4096_key_deserialize(&crt_blob, buf, size) != 0 || !crt_blob.has_crt) {
+            printf("   ❌ CRT key serialize/deserialize failed\n");
+            ok = 0;
+        }
+        free(buf);
+        
+        if (ok && (rsa_4096_key_save_blob(&pub_key, "test_key_blob.bin") != 0 ||
+                   rsa_4096_key_load_blob(&pub_blob, "test_key_blob.bin") != 0 ||
+                   bigint_compare(&pub_blob.n, &pub_key.n) != 0 || pub_blob.is_private)) {
+            printf("   ❌ Public key file round-trip failed\n");
+            ok = 0;
+        }
+        
+        /* Private blobs are owner-only, also when they replace a more open file */
+        struct stat st;
+        if (ok && (chmod("test_key_blob.bin", 0644) != 0 || rsa_4096_key_save_blob(&crt_key, "test_key_blob.bin") != 0 ||
+                   stat("test_key_blob.bin", &st) != 0 || (st.st_mode & 077) != 0)) {
+            printf("   ❌ Private key blob is readable by others\n");
+            ok = 0;
+        }
+        remove("test_key_blob.bin");
+        
+        if (ok) {
+            char encrypted_hex[1100], plain[700];
+            if (rsa_4096_encrypt(&pub_blob, keys[k].message, encrypted_hex, sizeof(encrypted_hex)) != 0 ||
+                rsa_4096_decrypt(&crt_blob, encrypted_hex, plain, sizeof(plain)) != 0 ||
+                strcmp(plain, keys[k].message) != 0) {
+                printf("   ❌ Round-trip through restored keys failed\n");
+                ok = 0;
+            }
+        }
+        
+        if (ok) {
+            printf("✅ Key %d PASSED: %zu-byte blob restores encrypt and CRT decrypt\n", k + 1, size);
+            passed++;
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&crt_key);
+        rsa_4096_free(&pub_blob);
+        rsa_4096_free(&crt_blob);
+    }
+    
+    /* Damaged blobs: flipped byte, truncation, bad magic, inconsistent contents with a valid checksum */
+    {
+        rsa_4096_key_t key, out;
+        uint8_t buf[4096];
+        size_t size = 0;
+        total++;
+        printf("\n🧪 Test %d: damaged key blobs\n", total);
+        
+        rsa_4096_load_key(&key, "143", "103", 1);
+        rsa_4096_load_key_crt(&key, "11", "13", "3", "7", "6");
+        int ret = rsa_4096_key_serialize(&key, buf, sizeof(buf), &size);
+        
+        int rejected = 0;
+        if (ret == 0) {
+            buf[size - 1] ^= 0x01;
+            rejected += rsa_4096_key_deserialize(&out, buf, size) != 0;
+            buf[size - 1] ^= 0x01;
+            rejected += rsa_4096_key_deserialize(&out, buf, size - 1) != 0;
+            buf[0] ^= 0xff;
+            rejected += rsa_4096_key_deserialize(&out, buf, size) != 0;
+            buf[0] ^= 0xff;
+            
+            /* Corrupt n' and re-seal the checksum: only the structural validation can catch it */
+            rsa_4096_key_t bad = key;
+            bad.mont_ctx.n_prime ^= 0x02;
+            uint8_t bad_buf[4096];
+            size_t bad_size = 0;
+            if (rsa_4096_key_serialize(&bad, bad_buf, sizeof(bad_buf), &bad_size) == 0) {
+                rejected += rsa_4096_key_deserialize(&out, bad_buf, bad_size) != 0;
+            }
+            
+            /* Re-sealed CRT and context edits that pass the range checks: wrong R^2, a prime that
+             * does not divide n (with a matching context), a wrong qInv, a wrong qInv * R */
+            for (int v = 0; v < 4; v++) {
+                bad = key;
+                if (v == 0) {
+                    bad.mont_ctx.r_squared.words[0] ^= 0x01;
+                } else if (v == 1) {
+                    bigint_set_u32(&bad.q, 17);
+                    montgomery_ctx_init(&bad.q_ctx, &bad.q);
+                } else if (v == 2) {
+                    bigint_set_u32(&bad.qinv, 5);
+                    montgomery_to_form(&bad.qinv_mont, &bad.qinv, &bad.p_ctx);
+                } else {
+                    bigint_set_u32(&bad.qinv_mont, (bad.qinv_mont.words[0] + 1) % 11);
+                }
+                if (rsa_4096_key_serialize(&bad, bad_buf, sizeof(bad_buf), &bad_size) == 0) {
+                    rejected += rsa_4096_key_deserialize(&out, bad_buf, bad_size) != 0;
+                }
+            }
+        }
+        
+        if (ret == 0 && rejected == 8 && rsa_4096_key_deserialize(&out, buf, size) == 0) {
+            printf("✅ Test %d PASSED: corrupted, truncated and inconsistent blobs rejected\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Damaged blob accepted (%d/8 rejected)\n", rejected);
+        }
+        rsa_4096_free(&key);
+        rsa_4096_free(&out);
+    }
+    
+    printf("\n===============================================\n");
+    printf("KEY BLOB SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Trace sink that counts lines and remembers the last one
+ */
+typedef struct {
+    int lines, errors;
+    char last_func[64];
+} test_trace_capture_t;
+
+static void test_trace_capture(int level, const char *func, int line, const char *message, void *user) {
+    test_trace_capture_t *cap = (test_trace_capture_t *)user;
+    (void)line;
+    (void)message;
+    cap->lines++;
+    if (level >= LOG_ERROR) cap->errors++;
+    snprintf(cap->last_func, sizeof(cap->last_func), "%s", func);
+}
+
+/**
+ * @brief Trace sink redirection and compile-time removal of hot-path traces
+ */
+int test_trace_sink(void) {
+    printf("===============================================\n");
+    printf("🔍 TRACE SINK TESTING (TRACE_LEVEL=%d)\n", TRACE_LEVEL);
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    test_trace_capture_t cap;
+    
+    /* Errors reach a custom sink with their origin */
+    {
+        montgomery_ctx_t ctx;
+        bigint_t even;
+        total++;
+        printf("\n🧪 Test %d: error reports go through the sink\n", total);
+        memset(&cap, 0, sizeof(cap));
+        bigint_set_u32(&even, 1000);
+        rsa_4096_trace_set_sink(test_trace_capture, &cap);
+        int ret = montgomery_ctx_init(&ctx, &even);
+        rsa_4096_trace_set_sink(NULL, NULL);
+        if (ret != 0 && cap.errors > 0 && strcmp(cap.last_func, "montgomery_ctx_init") == 0) {
+            printf("✅ Test %d PASSED: %d line(s) captured from %s\n", total, cap.lines, cap.last_func);
+            passed++;
+        } else {
+            printf("   ❌ Sink missed the error (ret=%d, lines=%d)\n", ret, cap.lines);
+        }
+    }
+    
+    /* A full Montgomery exponentiation traces only when DEBUG traces are compiled in */
+    {
+        montgomery_ctx_t ctx;
+        bigint_t mod, base, exp, result;
+        total++;
+        printf("\n🧪 Test %d: hot-path traces %s\n", total, TRACE_ENABLED(LOG_DEBUG) ? "compiled in" : "compiled out");
+        memset(&cap, 0, sizeof(cap));
+        bigint_from_decimal(&mod, "340282366920938463463374607431768211297");
+        bigint_set_u32(&base, 12345);
+        bigint_set_u32(&exp, 65537);
+        int ret = montgomery_ctx_init(&ctx, &mod);
+        rsa_4096_trace_set_sink(test_trace_capture, &cap);
+        if (ret == 0) ret = montgomery_exp(&result, &base, &exp, &ctx);
+        rsa_4096_trace_set_sink(NULL, NULL);
+        int expected_quiet = !TRACE_ENABLED(LOG_DEBUG);
+        if (ret == 0 && (expected_quiet ? cap.lines == 0 : cap.lines > 0)) {
+            printf("✅ Test %d PASSED: %d trace line(s) during montgomery_exp\n", total, cap.lines);
+            passed++;
+        } else {
+            printf("   ❌ Unexpected trace output (ret=%d, lines=%d)\n", ret, cap.lines);
+        }
+        montgomery_ctx_free(&ctx);
+    }
+    
+    printf("\n===============================================\n");
+    printf("TRACE SINK SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Batch encrypt/decrypt on a worker pool against single-block calls
+ */
+int test_batch_operations(void) {
+    printf("===============================================\n");
+    printf("🔍 BATCH WORKER POOL TESTING\n");
+    printf("===============================================\n");
+    
+    enum { BATCH_ITEMS = 24 };
+    int passed = 0, total = 0;
+    rsa_4096_key_t pub_key, crt_key;
+    
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Key loading failed\n");
+        return -1;
+    }
+    
+    static uint8_t plain[BATCH_ITEMS][8], cipher[BATCH_ITEMS][256], back[BATCH_ITEMS][256];
+    rsa_4096_batch_item_t enc[BATCH_ITEMS], dec[BATCH_ITEMS];
+    for (int i = 0; i < BATCH_ITEMS; i++) {
+        for (int j = 0; j < 8; j++) plain[i][j] = (uint8_t)(0x41 + i + 7 * j);
+        enc[i] = (rsa_4096_batch_item_t){plain[i], sizeof(plain[i]), cipher[i], sizeof(cipher[i]), 0, 0};
+    }
+    
+    /* Encrypt on 4 workers; textbook RSA is deterministic, so compare with the single-block call */
+    {
+        total++;
+        printf("\n🧪 Test %d: encrypt batch of %d on 4 threads\n", total, BATCH_ITEMS);
+        int ret = rsa_4096_encrypt_batch(&pub_key, enc, BATCH_ITEMS, 4);
+        int ok = (ret == 0);
+        for (int i = 0; i < BATCH_ITEMS && ok; i++) {
+            uint8_t single[256];
+            size_t single_len;
+            ok = enc[i].status == 0 &&
+                 rsa_4096_encrypt_binary(&pub_key, plain[i], sizeof(plain[i]), single, sizeof(single), &single_len) == 0 &&
+                 single_len == enc[i].output_len && memcmp(single, cipher[i], single_len) == 0;
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED: batch ciphertexts match single-block encryption\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Batch encryption mismatch (ret=%d)\n", ret);
+        }
+    }
+    
+    /* Decrypt with the CRT key on an automatic and an oversized pool */
+    int thread_counts[2] = {0, 3 * BATCH_ITEMS};
+    for (int c = 0; c < 2; c++) {
+        total++;
+        printf("\n🧪 Test %d: decrypt batch with %d requested threads\n", total, thread_counts[c]);
+        for (int i = 0; i < BATCH_ITEMS; i++) {
+            dec[i] = (rsa_4096_batch_item_t){cipher[i], enc[i].output_len, back[i], sizeof(back[i]), 0, 0};
+        }
+        int ret = rsa_4096_decrypt_batch(&crt_key, dec, BATCH_ITEMS, thread_counts[c]);
+        int ok = (ret == 0);
+        for (int i = 0; i < BATCH_ITEMS && ok; i++) {
+            ok = dec[i].status == 0 && dec[i].output_len == sizeof(plain[i]) &&
+                 memcmp(back[i], plain[i], sizeof(plain[i])) == 0;
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED: all %d blocks recovered\n", total, BATCH_ITEMS);
+            passed++;
+        } else {
+            printf("   ❌ Batch decryption mismatch (ret=%d)\n", ret);
+        }
+    }
+    
+    /* Failures are reported per item and do not stop the rest of the batch */
+    {
+        uint8_t too_big[128];
+        memset(too_big, 0xff, sizeof(too_big));
+        total++;
+        printf("\n🧪 Test %d: per-item status\n", total);
+        for (int i = 0; i < BATCH_ITEMS; i++) {
+            dec[i] = (rsa_4096_batch_item_t){cipher[i], enc[i].output_len, back[i], sizeof(back[i]), 0, 0};
+        }
+        dec[3].input = too_big;
+        dec[3].input_len = sizeof(too_big);
+        dec[17].output = NULL;
+        int ret = rsa_4096_decrypt_batch(&crt_key, dec, BATCH_ITEMS, 4);
+        int good = 0;
+        for (int i = 0; i < BATCH_ITEMS; i++) {
+            if (dec[i].status == 0 && memcmp(back[i], plain[i], sizeof(plain[i])) == 0) good++;
+        }
+        if (ret == -3 && dec[3].status != 0 && dec[17].status != 0 && good == BATCH_ITEMS - 2 &&
+            rsa_4096_decrypt_batch(&pub_key, dec, BATCH_ITEMS, 4) != 0) {
+            printf("✅ Test %d PASSED: bad items flagged, %d others decrypted\n", total, good);
+            passed++;
+        } else {
+            printf("   ❌ Per-item status wrong (ret=%d, good=%d)\n", ret, good);
+        }
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&crt_key);
+    
+    printf("\n===============================================\n");
+    printf("BATCH SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Fill a hex buffer with a deterministic odd value of exactly the given bit length
+ */
+static void simd_test_hex(char *hex, int bits, uint32_t *seed) {
+    static const char digits[] = "0123456789abcdef";
+    int n = (bits + 3) / 4;
+    for (int i = 0; i < n; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        hex[i] = digits[(*seed >> 16) & 0xf];
+    }
+    int top_bits = bits - 4 * (n - 1);
+    hex[0] = digits[(1 << (top_bits - 1)) | ((*seed >> 20) & ((1 << (top_bits - 1)) - 1))];
+    hex[n - 1] = digits[(*seed >> 24 & 0xe) | 1];
+    hex[n] = '\0';
+}
+
+int test_montgomery_simd(void) {
+    printf("===============================================\n");
+    printf("🔍 SIMD MONTGOMERY KERNEL TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    int detected = montgomery_simd_detect();
+    printf("CPU best kernel: %s\n", montgomery_simd_name(detected));
+    
+    /* Odd moduli around the radix boundaries plus real key sizes */
+    static const int sizes[] = {512, 521, 1000, 1024, 1536, 2047, 2048, 3071, 4096};
+    const int num_sizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    const int kernels[2] = {MONTGOMERY_SIMD_AVX2, MONTGOMERY_SIMD_IFMA};
+    
+    for (int k = 0; k < 2; k++) {
+        total++;
+        printf("\n🧪 Test %d: %s kernel against scalar CIOS\n", total, montgomery_simd_name(kernels[k]));
+        if (montgomery_simd_select(kernels[k]) != kernels[k]) {
+            printf("⏭️  Test %d SKIPPED: %s not available, selection refused\n", total, montgomery_simd_name(kernels[k]));
+            passed++;
+            continue;
+        }
+        
+        int ok = 1;
+        uint32_t seed = 0x5EED0000u + (uint32_t)k;
+        for (int s = 0; s < num_sizes && ok; s++) {
+            static char hex[1100];
+            bigint_t n, base, exp, n_minus_1, expected, got;
+            montgomery_ctx_t ctx;
+            simd_test_hex(hex, sizes[s], &seed);
+            bigint_from_hex(&n, hex);
+            simd_test_hex(hex, sizes[s] - 3, &seed);
+            bigint_from_hex(&base, hex);
+            simd_test_hex(hex, sizes[s] < 1024 ? sizes[s] : 1024, &seed);
+            bigint_from_hex(&exp, hex);
+            if (montgomery_ctx_init(&ctx, &n) != 0) {
+                printf("   ❌ Context init failed for %d bits\n", sizes[s]);
+                ok = 0;
+                break;
+            }
+            
+            /* Random base, then the edge values 0, 1 and n - 1 with exponents 0..2 */
+            bigint_t one;
+            bigint_set_u32(&one, 1);
+            bigint_sub(&n_minus_1, &n, &one);
+            const bigint_t *bases[4] = {&base, &one, &n_minus_1, &base};
+            for (int c = 0; c < 4 && ok; c++) {
+                bigint_t e;
+                if (c == 3) {
+                    bigint_set_u32(&e, 2);
+                } else {
+                    bigint_copy(&e, &exp);
+                }
+                montgomery_simd_select(MONTGOMERY_SIMD_NONE);
+                int r1 = montgomery_exp_window(&expected, bases[c], &e, &ctx, MONTGOMERY_WINDOW_AUTO);
+                montgomery_simd_select(kernels[k]);
+                int r2 = montgomery_exp_window(&got, bases[c], &e, &ctx, MONTGOMERY_WINDOW_AUTO);
+                if (r1 != 0 || r2 != 0 || bigint_compare(&expected, &got) != 0) {
+                    printf("   ❌ Mismatch at %d bits, case %d (ret %d/%d)\n", sizes[s], c, r1, r2);
+                    ok = 0;
+                }
+            }
+            
+            /* Exponent 0 must give exactly 1, including when the base is 0 */
+            bigint_t zero;
+            bigint_init(&zero);
+            if (ok && (montgomery_exp_window(&got, &zero, &zero, &ctx, MONTGOMERY_WINDOW_AUTO) != 0 ||
+                       bigint_compare(&got, &one) != 0)) {
+                printf("   ❌ 0^0 != 1 at %d bits\n", sizes[s]);
+                ok = 0;
+            }
+            montgomery_ctx_free(&ctx);
+        }
+        
+        if (ok) {
+            printf("✅ Test %d PASSED: %d modulus sizes match\n", total, num_sizes);
+            passed++;
+        }
+    }
+    
+    /* Full CRT decryption through whatever the CPU picks */
+    {
+        total++;
+        printf("\n🧪 Test %d: CRT decryption with automatic kernel selection\n", total);
+        montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+        rsa_4096_key_t pub_key, crt_key;
+        char cipher[1024], plain[1024];
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0 &&
+                 rsa_4096_encrypt(&pub_key, "123456789012345678901234567890", cipher, sizeof(cipher)) == 0 &&
+                 rsa_4096_decrypt(&crt_key, cipher, plain, sizeof(plain)) == 0 &&
+                 strcmp(plain, "123456789012345678901234567890") == 0;
+        if (ok) {
+            printf("✅ Test %d PASSED: round trip on %s\n", total, montgomery_simd_name(montgomery_simd_active()));
+            passed++;
+        } else {
+            printf("   ❌ CRT round trip failed\n");
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&crt_key);
+    }
+    
+    /* Unknown kernels are refused and leave the selection alone */
+    {
+        total++;
+        printf("\n🧪 Test %d: reject unknown kernel\n", total);
+        int before = montgomery_simd_active();
+        if (montgomery_simd_select(42) < 0 && montgomery_simd_active() == before) {
+            printf("✅ Test %d PASSED: selection refused\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Unknown kernel accepted\n");
+        }
+    }
+    montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+    
+    printf("\n===============================================\n");
+    printf("SIMD SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Deterministic n-word operand; pattern 1 = all ones, 2 = sparse words
+ */
+static void karatsuba_test_operand(bigint_t *a, int words, int pattern, uint32_t *seed) {
+    bigint_init(a);
+    for (int i = 0; i < words; i++) {
+        bigint_word_t w = 0;
+        for (int k = 0; k < BIGINT_WORD_SIZE; k += 16) {
+            *seed = *seed * 1103515245u + 12345u;
+            w |= (bigint_word_t)((*seed >> 8) & 0xffff) << k;
+        }
+        if (pattern == 1) w = (bigint_word_t)BIGINT_WORD_MASK;
+        if (pattern == 2 && i % 3 != 0) w = 0;
+        a->words[i] = w;
+    }
+    a->words[words - 1] |= 1;
+    a->used = words;
+}
+
+int test_bigint_karatsuba(void) {
+    printf("===============================================\n");
+    printf("🔍 KARATSUBA MULTIPLICATION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    const int cut = bigint_karatsuba_cutoff();
+    const int max_words = BIGINT_4096_WORDS / 2 - 8;  /* Products stay clear of VALIDATE_OVERFLOW */
+    uint32_t seed = 0x4B415241u;
+    
+    /* Balanced and unbalanced shapes around the cutover and up to the widest product */
+    const int shapes[][2] = {
+        {cut - 1, cut - 1}, {cut, cut}, {cut + 1, cut + 1}, {2 * cut + 1, 2 * cut + 1},
+        {MONTGOMERY_MAX_WORDS / 2, MONTGOMERY_MAX_WORDS / 2}, {MONTGOMERY_MAX_WORDS, MONTGOMERY_MAX_WORDS},
+        {max_words, max_words}, {max_words, cut}, {max_words - 3, cut + 5}, {3 * cut + 2, cut}, {max_words, 1}
+    };
+    const int num_shapes = (int)(sizeof(shapes) / sizeof(shapes[0]));
+    
+    for (int pattern = 0; pattern < 3; pattern++) {
+        total++;
+        printf("\n🧪 Test %d: a * b / b == a over %d shapes (pattern %d)\n", total, num_shapes, pattern);
+        int ok = 1;
+        for (int s = 0; s < num_shapes && ok; s++) {
+            bigint_t a, b, ab, ba, q, rem;
+            karatsuba_test_operand(&a, shapes[s][0], pattern, &seed);
+            karatsuba_test_operand(&b, shapes[s][1], pattern, &seed);
+            if (bigint_mul(&ab, &a, &b) != 0 || bigint_mul(&ba, &b, &a) != 0 ||
+                bigint_compare(&ab, &ba) != 0 ||
+                bigint_div(&q, &rem, &ab, &b) != 0 || bigint_compare(&q, &a) != 0 || !bigint_is_zero(&rem)) {
+                printf("   ❌ Product check failed for %d x %d words\n", shapes[s][0], shapes[s][1]);
+                ok = 0;
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* (B^n - 1)^2 = B^2n - 2 B^n + 1 exercises every carry in the middle product */
+    {
+        total++;
+        printf("\n🧪 Test %d: all-ones square against closed form\n", total);
+        bigint_t a, sq, one, top, mid, diff, expected;
+        karatsuba_test_operand(&a, max_words, 1, &seed);
+        bigint_set_u32(&one, 1);
+        bigint_shift_left(&top, &one, 2 * max_words * BIGINT_WORD_SIZE);
+        bigint_shift_left(&mid, &one, max_words * BIGINT_WORD_SIZE + 1);
+        bigint_sub(&diff, &top, &mid);
+        bigint_add(&expected, &diff, &one);
+        if (bigint_mul(&sq, &a, &a) == 0 && bigint_compare(&sq, &expected) == 0) {
+            printf("✅ Test %d PASSED: %d-word square exact\n", total, max_words);
+            passed++;
+        } else {
+            printf("   ❌ All-ones square mismatch\n");
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("KARATSUBA SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_montgomery_squaring(void) {
+    printf("===============================================\n");
+    printf("🔍 MONTGOMERY SQUARING KERNEL TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x53515541u;
+    static const int sizes[] = {17, 64, 100, 521, 1024, 2048, 4095, 4096};
+    const int num_sizes = (int)(sizeof(sizes) / sizeof(sizes[0]));
+    
+    /* montgomery_square must agree with montgomery_mul(a, a) on random and edge operands */
+    {
+        total++;
+        printf("\n🧪 Test %d: square == mul(a, a) over %d modulus sizes\n", total, num_sizes);
+        int ok = 1;
+        for (int s = 0; s < num_sizes && ok; s++) {
+            static char hex[1100];
+            bigint_t n, one, operands[4], sq, mul;
+            montgomery_ctx_t ctx;
+            simd_test_hex(hex, sizes[s], &seed);
+            bigint_from_hex(&n, hex);
+            simd_test_hex(hex, sizes[s] - 1, &seed);
+            bigint_from_hex(&operands[0], hex);
+            bigint_set_u32(&one, 1);
+            bigint_sub(&operands[1], &n, &one);           /* n - 1: every word near full */
+            bigint_copy(&operands[2], &one);
+            bigint_init(&operands[3]);
+            if (montgomery_ctx_init(&ctx, &n) != 0) {
+                printf("   ❌ Context init failed for %d bits\n", sizes[s]);
+                ok = 0;
+                break;
+            }
+            for (int c = 0; c < 4 && ok; c++) {
+                if (montgomery_square(&sq, &operands[c], &ctx) != 0 ||
+                    montgomery_mul(&mul, &operands[c], &operands[c], &ctx) != 0 ||
+                    bigint_compare(&sq, &mul) != 0) {
+                    printf("   ❌ Mismatch at %d bits, operand %d\n", sizes[s], c);
+                    ok = 0;
+                }
+            }
+            montgomery_ctx_free(&ctx);
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* The scalar exponentiation loop squares through the new kernel */
+    {
+        total++;
+        printf("\n🧪 Test %d: scalar exponentiation against bigint_mod_exp\n", total);
+        montgomery_simd_select(MONTGOMERY_SIMD_NONE);
+        static char hex[1100];
+        bigint_t n, base, exp, mont, plain;
+        montgomery_ctx_t ctx;
+        simd_test_hex(hex, 1024, &seed);
+        bigint_from_hex(&n, hex);
+        simd_test_hex(hex, 1000, &seed);
+        bigint_from_hex(&base, hex);
+        simd_test_hex(hex, 256, &seed);
+        bigint_from_hex(&exp, hex);
+        int ok = montgomery_ctx_init(&ctx, &n) == 0 &&
+                 montgomery_exp(&mont, &base, &exp, &ctx) == 0 &&
+                 bigint_mod_exp(&plain, &base, &exp, &n) == 0 &&
+                 bigint_compare(&mont, &plain) == 0;
+        montgomery_ctx_free(&ctx);
+        montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Exponentiation mismatch\n");
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("SQUARING SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_short_exponent(void) {
+    printf("===============================================\n");
+    printf("🔍 SHORT PUBLIC EXPONENT FAST PATH TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    bigint_t n, m;
+    bigint_from_decimal(&n, n_1024);
+    bigint_from_decimal(&m, "98765432109876543210987654321098765432109876543210");
+    
+    /* Loaders classify the exponent; d stays on the general path */
+    {
+        total++;
+        printf("\n🧪 Test %d: exponent classification\n", total);
+        rsa_4096_key_t pub_key, priv_key;
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) == 0 &&
+                 pub_key.short_exponent == 65537 && priv_key.short_exponent == 0;
+        
+        /* Key blobs recompute it on load */
+        uint8_t blob[16384];
+        size_t blob_len = 0;
+        rsa_4096_key_t restored;
+        ok = ok && rsa_4096_key_serialize(&pub_key, blob, sizeof(blob), &blob_len) == 0 &&
+             rsa_4096_key_deserialize(&restored, blob, blob_len) == 0 && restored.short_exponent == 65537;
+        if (ok) {
+            printf("✅ Test %d PASSED: e = 65537 short, d general, blob keeps it\n", total);
+            passed++;
+            rsa_4096_free(&restored);
+        } else {
+            printf("   ❌ Classification wrong (pub=%" PRIuWORD ", priv=%" PRIuWORD ")\n",
+                   pub_key.short_exponent, priv_key.short_exponent);
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+    }
+    
+    /* One-word exponents, odd and even, on the scalar and the best vector kernel */
+    const bigint_word_t exps[] = {1, 2, 3, 17, 65537, 65536, (bigint_word_t)BIGINT_WORD_MASK};
+    const int num_exps = (int)(sizeof(exps) / sizeof(exps[0]));
+    const int kernels[2] = {MONTGOMERY_SIMD_NONE, montgomery_simd_detect()};
+    for (int k = 0; k < 2; k++) {
+        total++;
+        printf("\n🧪 Test %d: montgomery_exp_word on %s against bigint_mod_exp\n", total, montgomery_simd_name(kernels[k]));
+        montgomery_simd_select(kernels[k]);
+        montgomery_ctx_t ctx;
+        int ok = montgomery_ctx_init(&ctx, &n) == 0;
+        for (int i = 0; i < num_exps && ok; i++) {
+            bigint_t e, expected, got;
+            bigint_init(&e);
+            e.words[0] = exps[i];
+            e.used = 1;
+            ok = bigint_mod_exp(&expected, &m, &e, &n) == 0 &&
+                 montgomery_exp_word(&got, &m, exps[i], &ctx) == 0 &&
+                 bigint_compare(&expected, &got) == 0;
+            if (!ok) {
+                printf("   ❌ Mismatch for e = %" PRIuWORD "\n", exps[i]);
+            }
+        }
+        montgomery_ctx_free(&ctx);
+        if (ok) {
+            printf("✅ Test %d PASSED: %d exponents match\n", total, num_exps);
+            passed++;
+        }
+    }
+    montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+    
+    /* e = 3 and e = 17 keys through the public API round trip with the matching d */
+    {
+        total++;
+        printf("\n🧪 Test %d: encrypt with e = 3, 17 matches hybrid_mod_exp\n", total);
+        const char *small_e[2] = {"3", "17"};
+        int ok = 1;
+        for (int i = 0; i < 2 && ok; i++) {
+            rsa_4096_key_t key;
+            uint8_t msg[16], out[256];
+            size_t out_len = 0;
+            for (int j = 0; j < 16; j++) msg[j] = (uint8_t)(0xA0 + j);
+            bigint_t mb, expected, got;
+            ok = rsa_4096_load_key(&key, n_1024, small_e[i], 0) == 0 &&
+                 rsa_4096_encrypt_binary(&key, msg, sizeof(msg), out, sizeof(out), &out_len) == 0 &&
+                 bigint_from_binary(&mb, msg, sizeof(msg)) == 0 &&
+                 hybrid_mod_exp(&expected, &mb, &key.exponent, &key.n, NULL) == 0 &&
+                 bigint_from_binary(&got, out, out_len) == 0 &&
+                 bigint_compare(&expected, &got) == 0;
+            rsa_4096_free(&key);
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Small exponent encryption mismatch\n");
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("SHORT EXPONENT SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_chunked_conversion(void) {
+    printf("===============================================\n");
+    printf("🔍 CHUNKED DECIMAL / HEX CONVERSION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    static char dec[6000], hex[6000];
+    
+    /* Known values across the chunk and limb boundaries */
+    {
+        total++;
+        printf("\n🧪 Test %d: known values\n", total);
+        static const char *const cases[][2] = {
+            {"1", "1"},
+            {"999999999", "3b9ac9ff"},
+            {"1000000000", "3b9aca00"},
+            {"18446744073709551615", "ffffffffffffffff"},
+            {"18446744073709551616", "10000000000000000"},
+            {"10000000000000000000000000000000000000", "785ee10d5da46d900f436a000000000"}
+        };
+        int ok = 1;
+        for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]) && ok; i++) {
+            bigint_t a, b;
+            ok = bigint_from_decimal(&a, cases[i][0]) == 0 && bigint_from_hex(&b, cases[i][1]) == 0 &&
+                 bigint_compare(&a, &b) == 0 &&
+                 bigint_to_decimal(&b, dec, sizeof(dec)) == 0 && strcmp(dec, cases[i][0]) == 0 &&
+                 bigint_to_hex(&a, hex, sizeof(hex)) == 0 && strcmp(hex, cases[i][1]) == 0;
+            if (!ok) printf("   ❌ Case %s failed (got %s / %s)\n", cases[i][0], dec, hex);
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Round trips from one word up to the full 16384-bit capacity, through the divide-and-conquer path */
+    {
+        total++;
+        printf("\n🧪 Test %d: round trips up to %d bits\n", total, BIGINT_4096_WORDS * BIGINT_WORD_SIZE);
+        uint32_t seed = 0x44454331u;
+        int ok = 1;
+        for (int words = 1; words <= BIGINT_4096_WORDS && ok; words += (words < 40 ? 1 : 37)) {
+            for (int pattern = 0; pattern < 3 && ok; pattern++) {
+                bigint_t a, b, c;
+                bigint_init(&a);
+                for (int i = 0; i < words; i++) {
+                    seed = seed * 1103515245u + 12345u;
+                    bigint_word_t w = (bigint_word_t)seed * (bigint_word_t)0x9E3779B9u;
+                    if (pattern == 1) w = (bigint_word_t)BIGINT_WORD_MASK;
+                    if (pattern == 2) w = (i == words - 1) ? 1 : 0;    /* exact power of two */
+                    a.words[i] = w;
+                }
+                a.used = words;
+                bigint_normalize(&a);
+                ok = bigint_to_decimal(&a, dec, sizeof(dec)) == 0 && bigint_from_decimal(&b, dec) == 0 &&
+                     bigint_compare(&a, &b) == 0 &&
+                     bigint_to_hex(&a, hex, sizeof(hex)) == 0 && bigint_from_hex(&c, hex) == 0 &&
+                     bigint_compare(&a, &c) == 0 && dec[0] != '0' && hex[0] != '0';
+                if (!ok) printf("   ❌ Round trip failed at %d words, pattern %d\n", words, pattern);
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Separators and leading zeros are skipped, over-long input is refused */
+    {
+        total++;
+        printf("\n🧪 Test %d: separators, leading zeros and overflow\n", total);
+        bigint_t a, b;
+        int ok = bigint_from_decimal(&a, "000012,345 678") == 0 && bigint_from_decimal(&b, "12345678") == 0 &&
+                 bigint_compare(&a, &b) == 0 &&
+                 bigint_from_hex(&a, "0x00bc614e") == 0 && bigint_compare(&a, &b) == 0;
+        memset(dec, '9', 5000);
+        dec[5000] = '\0';
+        memset(hex, 'f', 4097);
+        hex[4097] = '\0';
+        ok = ok && bigint_from_decimal(&a, dec) != 0 && bigint_from_hex(&b, hex) != 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Input filtering or overflow check wrong\n");
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("CONVERSION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+typedef struct {
+    const rsa_4096_key_t *pub_key;
+    const rsa_4096_key_t *priv_key;
+    const rsa_4096_key_t *blinded_key;
+    int ok;
+    size_t left;                        /* Nonzero thread-workspace bytes after the decrypts */
+} workspace_small_stack_t;
+
+/* Plain calls on a stack smaller than one rsa_4096_workspace_t */
+static void *workspace_small_stack_main(void *arg) {
+    workspace_small_stack_t *t = (workspace_small_stack_t *)arg;
+    uint8_t msg[32], enc[256], dec[256];
+    size_t enc_len = 0, dec_len = 0;
+    for (int j = 0; j < (int)sizeof(msg); j++) msg[j] = (uint8_t)(j * 13 + 5);
+    t->ok = rsa_4096_encrypt_binary(t->pub_key, msg, sizeof(msg), enc, sizeof(enc), &enc_len) == 0 &&
+            rsa_4096_decrypt_binary(t->priv_key, enc, enc_len, dec, sizeof(dec), &dec_len) == 0 &&
+            dec_len == sizeof(msg) && memcmp(dec, msg, sizeof(msg)) == 0;
+    
+    /* Enough blinded decrypts that the thread's pair is derived and then refreshed */
+    for (int i = 0; t->ok && i < RSA_4096_BLINDING_REFRESH + 2; i++) {
+        t->ok = rsa_4096_decrypt_binary(t->blinded_key, enc, enc_len, dec, sizeof(dec), &dec_len) == 0 &&
+                dec_len == sizeof(msg) && memcmp(dec, msg, sizeof(msg)) == 0;
+    }
+    
+    const uint8_t *bytes = (const uint8_t *)rsa_4096_thread_workspace();
+    t->left = bytes == NULL ? 1 : 0;
+    for (size_t i = 0; bytes != NULL && i < sizeof(rsa_4096_workspace_t); i++) {
+        if (bytes[i] != 0) t->left++;
+    }
+    return NULL;
+}
+
+int test_workspace_api(void) {
+    printf("===============================================\n");
+    printf("🔍 CALLER-OWNED WORKSPACE API TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    rsa_4096_workspace_t *ws = rsa_4096_workspace_new();
+    if (ws == NULL) {
+        printf("❌ Workspace allocation failed\n");
+        return -1;
+    }
+    printf("   Workspace size: %zu bytes\n", sizeof(rsa_4096_workspace_t));
+    
+    bigint_t n, p, m, d, big;
+    bigint_from_decimal(&n, n_1024);
+    bigint_from_decimal(&p, p_1024);
+    bigint_from_decimal(&d, d_1024);
+    bigint_from_decimal(&m, "98765432109876543210987654321098765432109876543210");
+    bigint_shift_left(&big, &n, 3);          /* Operand >= n exercises the reduction paths */
+    bigint_add_word(&big, &big, 12345);
+    
+    /* One workspace reused across moduli of different widths, on scalar and vector kernels */
+    const int kernels[2] = {MONTGOMERY_SIMD_NONE, montgomery_simd_detect()};
+    for (int k = 0; k < 2; k++) {
+        total++;
+        printf("\n🧪 Test %d: *_ws Montgomery calls on %s match the plain calls\n", total, montgomery_simd_name(kernels[k]));
+        montgomery_simd_select(kernels[k]);
+        const bigint_t *moduli[2] = {&n, &p};
+        int ok = 1;
+        for (int i = 0; i < 2 && ok; i++) {
+            montgomery_ctx_t ctx;
+            bigint_t expected, got;
+            ok = montgomery_ctx_init(&ctx, moduli[i]) == 0;
+            ok = ok && montgomery_exp(&expected, &m, &d, &ctx) == 0 &&
+                 montgomery_exp_ws(&got, &m, &d, &ctx, ws) == 0 && bigint_compare(&expected, &got) == 0;
+            ok = ok && montgomery_exp(&expected, &big, &d, &ctx) == 0 &&
+                 montgomery_exp_ws(&got, &big, &d, &ctx, ws) == 0 && bigint_compare(&expected, &got) == 0;
+            ok = ok && montgomery_exp_word(&expected, &big, 65537, &ctx) == 0 &&
+                 montgomery_exp_word_ws(&got, &big, 65537, &ctx, ws) == 0 && bigint_compare(&expected, &got) == 0;
+            ok = ok && montgomery_mul(&expected, &m, &big, &ctx) == 0 &&
+                 montgomery_mul_ws(&got, &m, &big, &ctx, ws) == 0 && bigint_compare(&expected, &got) == 0;
+            montgomery_ctx_free(&ctx);
+            if (!ok) {
+                printf("   ❌ Mismatch for the %d-bit modulus\n", bigint_bit_length(moduli[i]));
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+    
+    /* hybrid_mod_exp_ws copies its inputs only when result aliases one; NULL ws is the plain call */
+    {
+        total++;
+        printf("\n🧪 Test %d: hybrid_mod_exp_ws with aliased result and NULL workspace\n", total);
+        montgomery_ctx_t ctx;
+        bigint_t expected, got, aliased;
+        bigint_copy(&aliased, &m);
+        int ok = montgomery_ctx_init(&ctx, &n) == 0 &&
+                 bigint_mod_exp(&expected, &m, &d, &n) == 0 &&
+                 hybrid_mod_exp_ws(&aliased, &aliased, &d, &n, &ctx, ws) == 0 &&
+                 bigint_compare(&expected, &aliased) == 0 &&
+                 hybrid_mod_exp_ws(&got, &m, &d, &n, &ctx, NULL) == 0 &&
+                 bigint_compare(&expected, &got) == 0;
+        montgomery_ctx_free(&ctx);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ hybrid_mod_exp_ws result differs from bigint_mod_exp\n");
+        }
+    }
+    
+    /* RSA entry points: same workspace for the public, full-size private and CRT keys */
+    {
+        total++;
+        printf("\n🧪 Test %d: RSA *_ws round trips produce the plain calls' bytes\n", total);
+        rsa_4096_key_t pub_key, priv_key, crt_key;
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0;
+        
+        uint8_t msg[64], enc[256], enc_ws[256], dec[256], dec_crt[256];
+        size_t enc_len = 0, enc_ws_len = 0, dec_len = 0, dec_crt_len = 0;
+        for (int j = 0; j < (int)sizeof(msg); j++) msg[j] = (uint8_t)(j * 37 + 11);
+        ok = ok && rsa_4096_encrypt_binary(&pub_key, msg, sizeof(msg), enc, sizeof(enc), &enc_len) == 0 &&
+             rsa_4096_encrypt_binary_ws(&pub_key, msg, sizeof(msg), enc_ws, sizeof(enc_ws), &enc_ws_len, ws) == 0 &&
+             enc_len == enc_ws_len && memcmp(enc, enc_ws, enc_len) == 0;
+        ok = ok && rsa_4096_decrypt_binary_ws(&priv_key, enc_ws, enc_ws_len, dec, sizeof(dec), &dec_len, ws) == 0 &&
+             rsa_4096_decrypt_binary_ws(&crt_key, enc_ws, enc_ws_len, dec_crt, sizeof(dec_crt), &dec_crt_len, ws) == 0 &&
+             dec_len == sizeof(msg) && memcmp(dec, msg, sizeof(msg)) == 0 &&
+             dec_crt_len == sizeof(msg) && memcmp(dec_crt, msg, sizeof(msg)) == 0;
+        
+        /* Decimal/hex string variants */
+        char enc_hex[1024], dec_str[1024];
+        const char *msg_dec = "123456789012345678901234567890";
+        ok = ok && rsa_4096_encrypt_ws(&pub_key, msg_dec, enc_hex, sizeof(enc_hex), ws) == 0 &&
+             rsa_4096_decrypt_ws(&crt_key, enc_hex, dec_str, sizeof(dec_str), ws) == 0 &&
+             strcmp(dec_str, msg_dec) == 0;
+        
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+        rsa_4096_free(&crt_key);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ RSA workspace round trip failed\n");
+        }
+    }
+    
+    /* Clearing wipes the key-dependent intermediates */
+    {
+        total++;
+        printf("\n🧪 Test %d: rsa_4096_workspace_clear wipes the scratch\n", total);
+        rsa_4096_workspace_clear(ws);
+        const uint8_t *bytes = (const uint8_t *)ws;
+        size_t nonzero = 0;
+        for (size_t i = 0; i < sizeof(*ws); i++) {
+            if (bytes[i] != 0) nonzero++;
+        }
+        if (nonzero == 0) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ %zu bytes left after clear\n", nonzero);
+        }
+    }
+    rsa_4096_workspace_free(ws);
+    
+    /* The plain calls keep their workspace off the stack and wipe it after a private operation */
+    {
+        total++;
+        printf("\n🧪 Test %d: Plain calls on a 64 KB thread stack, blinded key included\n", total);
+        rsa_4096_key_t pub_key, crt_key, blinded_key;
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0 &&
+                 rsa_4096_load_key(&blinded_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&blinded_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0 &&
+                 rsa_4096_key_enable_blinding(&blinded_key) == 0;
+        workspace_small_stack_t t = {&pub_key, &crt_key, &blinded_key, 0, 0};
+        pthread_attr_t attr;
+        pthread_t tid;
+        ok = ok && pthread_attr_init(&attr) == 0;
+        ok = ok && pthread_attr_setstacksize(&attr, 64 * 1024) == 0 &&
+             pthread_create(&tid, &attr, workspace_small_stack_main, &t) == 0;
+        if (ok) {
+            pthread_join(tid, NULL);
+            pthread_attr_destroy(&attr);
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&crt_key);
+        rsa_4096_free(&blinded_key);
+        if (ok && t.ok && t.left == 0) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Round trip %s, %zu workspace bytes left\n", t.ok ? "ok" : "failed", t.left);
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("WORKSPACE API SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_montgomery_exp_multi(void) {
+    printf("===============================================\n");
+    printf("🔍 MULTI-BUFFER EXPONENTIATION TESTING\n");
+    printf("===============================================\n");
+    
+    enum { MULTI_ITEMS = 13 };
+    int passed = 0, total = 0;
+    bigint_t n, p, q, d, dp, dq;
+    bigint_from_decimal(&n, n_1024);
+    bigint_from_decimal(&p, p_1024);
+    bigint_from_decimal(&q, q_1024);
+    bigint_from_decimal(&d, d_1024);
+    bigint_from_decimal(&dp, dp_1024);
+    bigint_from_decimal(&dq, dq_1024);
+    
+    montgomery_ctx_t n_ctx, p_ctx, q_ctx;
+    if (montgomery_ctx_init(&n_ctx, &n) != 0 || montgomery_ctx_init(&p_ctx, &p) != 0 ||
+        montgomery_ctx_init(&q_ctx, &q) != 0) {
+        printf("❌ Context setup failed\n");
+        return -1;
+    }
+    
+    /* Mixed moduli and exponents: full d, CRT halves, 0, 1, 65537, zero and >= n bases */
+    static bigint_t bases[MULTI_ITEMS], exps[MULTI_ITEMS], expected[MULTI_ITEMS], got[MULTI_ITEMS];
+    bigint_t *results[MULTI_ITEMS];
+    const bigint_t *base_ptrs[MULTI_ITEMS], *exp_ptrs[MULTI_ITEMS];
+    const montgomery_ctx_t *ctxs[MULTI_ITEMS];
+    const montgomery_ctx_t *ctx_cycle[3] = {&n_ctx, &p_ctx, &q_ctx};
+    const bigint_t *exp_cycle[3] = {&d, &dp, &dq};
+    for (int i = 0; i < MULTI_ITEMS; i++) {
+        ctxs[i] = ctx_cycle[i % 3];
+        bigint_from_decimal(&bases[i], "98765432109876543210987654321098765432109876543210");
+        bigint_add_word(&bases[i], &bases[i], (bigint_word_t)(i * 7919));
+        bigint_copy(&exps[i], exp_cycle[i % 3]);
+        results[i] = &got[i];
+        base_ptrs[i] = &bases[i];
+        exp_ptrs[i] = &exps[i];
+    }
+    bigint_init(&exps[3]);
+    bigint_set_u32(&exps[7], 1);
+    bigint_set_u32(&exps[8], 65537);
+    bigint_init(&bases[5]);
+    bigint_shift_left(&bases[10], &n, 2);       /* >= every modulus */
+    bigint_add_word(&bases[10], &bases[10], 3);
+    
+    for (int i = 0; i < MULTI_ITEMS; i++) {
+        montgomery_simd_select(MONTGOMERY_SIMD_NONE);
+        montgomery_exp(&expected[i], &bases[i], &exps[i], ctxs[i]);
+    }
+    
+    /* Every kernel this CPU runs, lanes of 1 (scalar), 4 (AVX2) and 8 (IFMA) */
+    int best = montgomery_simd_detect();
+    int kernels[3] = {MONTGOMERY_SIMD_NONE, MONTGOMERY_SIMD_AVX2, MONTGOMERY_SIMD_IFMA};
+    for (int k = 0; k < 3; k++) {
+        if ((kernels[k] == MONTGOMERY_SIMD_AVX2 && best == MONTGOMERY_SIMD_NONE) ||
+            (kernels[k] == MONTGOMERY_SIMD_IFMA && best != MONTGOMERY_SIMD_IFMA)) {
+            printf("\n   ⚠️  %s not supported on this CPU, skipped\n", montgomery_simd_name(kernels[k]));
+            continue;
+        }
+        total++;
+        montgomery_simd_select(kernels[k]);
+        printf("\n🧪 Test %d: montgomery_exp_multi on %s (%d lanes), %d mixed entries\n", total,
+               montgomery_simd_name(kernels[k]), montgomery_multi_lanes(), MULTI_ITEMS);
+        int ok = 1;
+        for (int count = 1; count <= MULTI_ITEMS && ok; count += 4) {
+            for (int i = 0; i < count; i++) bigint_init(&got[i]);
+            ok = montgomery_exp_multi(results, base_ptrs, exp_ptrs, ctxs, count) == 0;
+            for (int i = 0; i < count && ok; i++) {
+                /* Zero has two encodings (used 0 or 1), so compare zeros by value */
+                ok = bigint_compare(&expected[i], &got[i]) == 0 ||
+                     (bigint_is_zero(&expected[i]) && bigint_is_zero(&got[i]));
+                if (!ok) printf("   ❌ Entry %d of %d differs\n", i, count);
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Batch decrypt through the lock-step blocks: CRT and full-size keys, with bad items mixed in */
+    {
+        total++;
+        montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+        printf("\n🧪 Test %d: batch decrypt in %d-lane blocks matches single-block calls\n", total,
+               montgomery_multi_lanes());
+        rsa_4096_key_t pub_key, priv_key, crt_key;
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0;
+        
+        static uint8_t plain[MULTI_ITEMS][16], cipher[MULTI_ITEMS][256], back[MULTI_ITEMS][256];
+        size_t cipher_len[MULTI_ITEMS];
+        rsa_4096_batch_item_t items[MULTI_ITEMS];
+        for (int i = 0; i < MULTI_ITEMS && ok; i++) {
+            for (int j = 0; j < 16; j++) plain[i][j] = (uint8_t)(0x30 + 3 * i + j);
+            ok = rsa_4096_encrypt_binary(&pub_key, plain[i], sizeof(plain[i]), cipher[i], sizeof(cipher[i]),
+                                         &cipher_len[i]) == 0;
+        }
+        memset(cipher[4], 0xFF, 128);                /* >= n */
+        cipher_len[4] = 128;
+        
+        const rsa_4096_key_t *keys[2] = {&crt_key, &priv_key};
+        for (int k = 0; k < 2 && ok; k++) {
+            for (int i = 0; i < MULTI_ITEMS; i++) {
+                items[i] = (rsa_4096_batch_item_t){cipher[i], cipher_len[i], back[i], sizeof(back[i]), 0, 0};
+            }
+            items[9].output = NULL;
+            ok = rsa_4096_decrypt_batch(keys[k], items, MULTI_ITEMS, 1) == -3;
+            for (int i = 0; i < MULTI_ITEMS && ok; i++) {
+                if (i == 4 || i == 9) {
+                    ok = items[i].status != 0 && items[i].output_len == 0;
+                } else {
+                    ok = items[i].status == 0 && items[i].output_len == sizeof(plain[i]) &&
+                         memcmp(back[i], plain[i], sizeof(plain[i])) == 0;
+                }
+                if (!ok) printf("   ❌ Item %d wrong with the %s key\n", i, k == 0 ? "CRT" : "full-size");
+            }
+        }
+        
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+        rsa_4096_free(&crt_key);
+        if (ok) {
+            printf("✅ Test %d PASSED: bad items flagged, the others recovered\n", total);
+            passed++;
+        }
+    }
+    
+    /* Throughput: one 8-entry pass against the same exponentiations one at a time */
+    {
+        montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+        const int runs = 8;
+        clock_t start = clock();
+        for (int r = 0; r < runs; r++) {
+            for (int i = 0; i < 8; i++) montgomery_exp(&expected[i], &bases[0], &d, &n_ctx);
+        }
+        clock_t mid = clock();
+        for (int i = 0; i < 8; i++) {
+            base_ptrs[i] = &bases[0];
+            exp_ptrs[i] = &d;
+            ctxs[i] = &n_ctx;
+        }
+        for (int r = 0; r < runs; r++) {
+            montgomery_exp_multi(results, base_ptrs, exp_ptrs, ctxs, 8);
+        }
+        clock_t end = clock();
+        double single_ms = (double)(mid - start) * 1000.0 / CLOCKS_PER_SEC / (runs * 8);
+        double multi_ms = (double)(end - mid) * 1000.0 / CLOCKS_PER_SEC / (runs * 8);
+        printf("\n   ⏱️  1024-bit exponentiation on %s: %.3f ms one at a time, %.3f ms in lock-step\n",
+               montgomery_simd_name(montgomery_simd_active()), single_ms, multi_ms);
+    }
+    
+    montgomery_ctx_free(&n_ctx);
+    montgomery_ctx_free(&p_ctx);
+    montgomery_ctx_free(&q_ctx);
+    
+    printf("\n===============================================\n");
+    printf("MULTI-BUFFER SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Generated keys: exact size, consistent CRT parts, round trips, bad arguments rejected
+ */
+static int keygen_check_key(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, int bits) {
+    if (bigint_bit_length(&pub_key->n) != bits || bigint_compare(&pub_key->n, &priv_key->n) != 0 ||
+        !priv_key->is_private || !priv_key->has_crt || pub_key->short_exponent != 65537) {
+        printf("   ❌ Key shape wrong: %d-bit n, has_crt=%d\n", bigint_bit_length(&pub_key->n), priv_key->has_crt);
+        return 0;
+    }
+    if (bigint_bit_length(&priv_key->p) != bits / 2 || bigint_bit_length(&priv_key->q) != bits / 2 ||
+        bigint_compare(&priv_key->p, &priv_key->q) <= 0) {
+        printf("   ❌ Primes are not two %d-bit factors with p > q\n", bits / 2);
+        return 0;
+    }
+    
+    /* The CRT path and the full-size d must both invert the public operation */
+    rsa_4096_key_t full_key;
+    uint8_t n_bytes[512], d_bytes[512];
+    size_t n_len, d_len;
+    int ok = bigint_to_binary(&priv_key->n, n_bytes, sizeof(n_bytes), &n_len) == 0 &&
+             bigint_to_binary(&priv_key->exponent, d_bytes, sizeof(d_bytes), &d_len) == 0 &&
+             rsa_4096_load_key_binary(&full_key, n_bytes, n_len, d_bytes, d_len, 1) == 0;
+    for (int i = 0; i < 3 && ok; i++) {
+        uint8_t message[48], cipher[512], back[512], back_full[512];
+        size_t cipher_len, back_len, back_full_len;
+        for (size_t j = 0; j < sizeof(message); j++) message[j] = (uint8_t)(0x11 * i + 7 * j + 1);
+        ok = rsa_4096_encrypt_binary(pub_key, message, sizeof(message), cipher, sizeof(cipher), &cipher_len) == 0 &&
+             rsa_4096_decrypt_binary(priv_key, cipher, cipher_len, back, sizeof(back), &back_len) == 0 &&
+             rsa_4096_decrypt_binary(&full_key, cipher, cipher_len, back_full, sizeof(back_full),
+                                     &back_full_len) == 0 &&
+             back_len == sizeof(message) && memcmp(back, message, sizeof(message)) == 0 &&
+             back_full_len == sizeof(message) && memcmp(back_full, message, sizeof(message)) == 0;
+    }
+    rsa_4096_free(&full_key);
+    if (!ok) printf("   ❌ Round trip through the generated key failed\n");
+    return ok;
+}
+
+int test_key_generation(void) {
+    printf("===============================================\n");
+    printf("🔍 KEY GENERATION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    rsa_4096_key_t pub_key, priv_key;
+    
+    /* Test 1: arguments outside the supported range */
+    {
+        total++;
+        printf("\n🧪 Test %d: Invalid sizes and exponents are rejected\n", total);
+        int ok = rsa_4096_generate_key(&pub_key, &priv_key, 512, 65537, 1) < 0 &&
+                 rsa_4096_generate_key(&pub_key, &priv_key, 2047, 65537, 1) < 0 &&
+                 rsa_4096_generate_key(&pub_key, &priv_key, 8192, 65537, 1) < 0 &&
+                 rsa_4096_generate_key(&pub_key, &priv_key, 2048, 65536, 1) < 0 &&
+                 rsa_4096_generate_key(&pub_key, &priv_key, 2048, 1, 1) < 0 &&
+                 rsa_4096_generate_key(NULL, NULL, 2048, 65537, 1) < 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Tests 2-4: one thread, more threads than cores (cancellation), and all online CPUs */
+    const int sizes[3] = {1024, 2048, 4096};
+    const int threads[3] = {1, 4, 0};
+    uint8_t first_n[128];
+    size_t first_n_len = 0;
+    for (int t = 0; t < 3; t++) {
+        total++;
+        printf("\n🧪 Test %d: %d-bit key on %d thread(s)\n", total, sizes[t], threads[t]);
+        clock_t start = clock();
+        int ret = rsa_4096_generate_key(&pub_key, &priv_key, sizes[t], 65537, threads[t]);
+        double ms = (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+        int ok = ret == 0 && keygen_check_key(&pub_key, &priv_key, sizes[t]);
+        if (ok) {
+            printf("   ⏱️  Generated in %.1f ms CPU\n", ms);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+            if (t == 0) bigint_to_binary(&pub_key.n, first_n, sizeof(first_n), &first_n_len);
+        } else {
+            printf("❌ Test %d FAILED (ret=%d)\n", total, ret);
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+    }
+    
+    /* Test 5: a second run draws fresh primes, and a NULL public output is allowed */
+    {
+        total++;
+        printf("\n🧪 Test %d: Repeated 1024-bit generation yields a different modulus\n", total);
+        uint8_t n[128];
+        size_t n_len = 0;
+        int ok = rsa_4096_generate_key(NULL, &priv_key, 1024, 65537, 1) == 0 &&
+                 bigint_to_binary(&priv_key.n, n, sizeof(n), &n_len) == 0 && priv_key.has_crt &&
+                 (n_len != first_n_len || memcmp(n, first_n, n_len) != 0);
+        rsa_4096_free(&priv_key);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("KEY GENERATION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== SERVICE MODE TEST HELPERS ===================== */
+
+typedef struct {
+    const rsa_4096_key_t *pub_key;
+    const rsa_4096_key_t *priv_key;
+    int fd;
+    const char *path;                   /* Non-NULL: run the Unix socket listener instead */
+    rsa_4096_serve_config_t config;
+    rsa_4096_serve_stats_t stats;
+    int ret;
+} serve_test_server_t;
+
+static void *serve_test_server_main(void *arg) {
+    serve_test_server_t *srv = (serve_test_server_t *)arg;
+    if (srv->path != NULL) {
+        srv->ret = rsa_4096_serve_unix(srv->pub_key, srv->priv_key, srv->path, &srv->config);
+    } else {
+        srv->ret = rsa_4096_serve_stream(srv->pub_key, srv->priv_key, srv->fd, srv->fd, &srv->config, &srv->stats);
+        shutdown(srv->fd, SHUT_WR);     /* The client reads until EOF */
+    }
+    return NULL;
+}
+
+static size_t serve_test_frame(uint8_t *buf, uint32_t id, uint32_t op, const uint8_t *payload, uint32_t len) {
+    const uint32_t fields[3] = {id, op, len};
+    for (int f = 0; f < 3; f++) {
+        for (int b = 0; b < 4; b++) buf[4 * f + b] = (uint8_t)(fields[f] >> (24 - 8 * b));
+    }
+    if (payload != NULL) memcpy(buf + 12, payload, len);
+    return 12 + (size_t)len;
+}
+
+static uint32_t serve_test_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/**
+ * @brief Send all requests in one write, half-close, and collect the whole response stream
+ */
+static size_t serve_test_exchange(int fd, const uint8_t *req, size_t req_len, uint8_t *resp, size_t resp_size) {
+    size_t sent = 0, got = 0;
+    while (sent < req_len) {
+        ssize_t w = write(fd, req + sent, req_len - sent);
+        if (w <= 0) return 0;
+        sent += (size_t)w;
+    }
+    shutdown(fd, SHUT_WR);
+    for (;;) {
+        ssize_t r = read(fd, resp + got, resp_size - got);
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+    return got;
+}
+
+/**
+ * @brief Walk a response stream: ids must follow expected_ids, statuses and payloads are returned
+ */
+static int serve_test_parse(const uint8_t *resp, size_t len, const uint32_t *expected_ids, int count,
+                            int *status, const uint8_t **payload, uint32_t *payload_len) {
+    size_t pos = 0;
+    for (int i = 0; i < count; i++) {
+        if (len - pos < 12) return 0;
+        payload_len[i] = serve_test_be32(resp + pos + 8);
+        if (serve_test_be32(resp + pos) != expected_ids[i] || len - pos - 12 < payload_len[i]) return 0;
+        status[i] = (int)serve_test_be32(resp + pos + 4);
+        payload[i] = resp + pos + 12;
+        pos += 12 + payload_len[i];
+    }
+    return pos == len;
+}
+
+/**
+ * @brief Connect to the listener on path, retrying while it is still starting up
+ */
+static int serve_test_connect(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    for (int attempt = 0; attempt < 500; attempt++) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) == 0) return fd;
+        if (fd >= 0) close(fd);
+        struct timespec pause = {0, 10 * 1000 * 1000};
+        nanosleep(&pause, NULL);
+    }
+    return -1;
+}
+
+int test_serve_mode(void) {
+    printf("===============================================\n");
+    printf("🔍 SERVICE MODE TESTING\n");
+    printf("===============================================\n");
+    
+    enum { SERVE_GOOD = 40, SERVE_TOTAL = SERVE_GOOD + 4 };
+    int passed = 0, total = 0;
+    rsa_4096_key_t pub_key, priv_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Key setup failed\n");
+        return -1;
+    }
+    
+    static uint8_t req[SERVE_TOTAL * 700], resp[SERVE_TOTAL * 700];
+    static uint8_t message[SERVE_GOOD][24], cipher[SERVE_GOOD][128];
+    uint32_t ids[SERVE_TOTAL];
+    int status[SERVE_TOTAL];
+    const uint8_t *payload[SERVE_TOTAL];
+    uint32_t payload_len[SERVE_TOTAL];
+    size_t cipher_len[SERVE_GOOD];
+    
+    /* Even requests encrypt, odd ones decrypt a ciphertext prepared here */
+    for (int i = 0; i < SERVE_GOOD; i++) {
+        for (int j = 0; j < 24; j++) message[i][j] = (uint8_t)(i * 5 + j + 1);
+        rsa_4096_encrypt_binary(&pub_key, message[i], sizeof(message[i]), cipher[i], sizeof(cipher[i]), &cipher_len[i]);
+    }
+    
+    /* Test 1: a mixed burst over a socket pair, with malformed frames in the middle */
+    {
+        total++;
+        printf("\n🧪 Test %d: %d mixed requests in one burst come back in order\n", total, SERVE_TOTAL);
+        size_t len = 0;
+        int n = 0;
+        for (int i = 0; i < SERVE_GOOD; i++) {
+            ids[n] = 1000u + (uint32_t)i;
+            if (i % 2 == 0) {
+                len += serve_test_frame(req + len, ids[n++], RSA_4096_SERVE_OP_PUBLIC, message[i], sizeof(message[i]));
+            } else {
+                len += serve_test_frame(req + len, ids[n++], RSA_4096_SERVE_OP_PRIVATE, cipher[i], (uint32_t)cipher_len[i]);
+            }
+            if (i == 10) {
+                uint8_t junk[600];
+                memset(junk, 0xFF, sizeof(junk));
+                ids[n] = 7;
+                len += serve_test_frame(req + len, ids[n++], 9, junk, 3);                       /* Unknown op */
+                ids[n] = 8;
+                len += serve_test_frame(req + len, ids[n++], RSA_4096_SERVE_OP_PRIVATE, junk, 600);  /* Too long */
+                ids[n] = 9;
+                len += serve_test_frame(req + len, ids[n++], RSA_4096_SERVE_OP_PRIVATE, junk, 128);  /* >= n */
+                ids[n] = 10;
+                len += serve_test_frame(req + len, ids[n++], RSA_4096_SERVE_OP_PUBLIC, NULL, 0);     /* Empty */
+            }
+        }
+        
+        int sv[2];
+        int ok = socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0;
+        serve_test_server_t srv = {&pub_key, &priv_key, ok ? sv[1] : -1, NULL, {2, 0, 0}, {0, 0, 0}, -1};
+        pthread_t tid;
+        ok = ok && pthread_create(&tid, NULL, serve_test_server_main, &srv) == 0;
+        size_t got = ok ? serve_test_exchange(sv[0], req, len, resp, sizeof(resp)) : 0;
+        if (ok) {
+            pthread_join(tid, NULL);
+            close(sv[0]);
+            close(sv[1]);
+        }
+        ok = ok && srv.ret == 0 && serve_test_parse(resp, got, ids, n, status, payload, payload_len);
+        
+        for (int k = 0, i = 0; ok && k < n; k++) {
+            if (ids[k] < 1000) {
+                ok = status[k] != 0 && payload_len[k] == 0 &&
+                     (ids[k] != 7 || status[k] == RSA_4096_SERVE_ERR_BAD_OP) &&
+                     (ids[k] != 8 || status[k] == RSA_4096_SERVE_ERR_TOO_LONG);
+                continue;
+            }
+            uint8_t back[128];
+            size_t back_len = 0;
+            if (i % 2 == 0) {
+                ok = status[k] == 0 &&
+                     rsa_4096_decrypt_binary(&priv_key, payload[k], payload_len[k], back, sizeof(back), &back_len) == 0 &&
+                     back_len == sizeof(message[i]) && memcmp(back, message[i], back_len) == 0;
+            } else {
+                ok = status[k] == 0 && payload_len[k] == sizeof(message[i]) &&
+                     memcmp(payload[k], message[i], payload_len[k]) == 0;
+            }
+            if (!ok) printf("   ❌ Response %d (id %u) wrong, status %d\n", k, ids[k], status[k]);
+            i++;
+        }
+        if (ok) {
+            printf("   📦 %zu requests in %zu batches, %zu rejected\n", srv.stats.requests, srv.stats.batches,
+                   srv.stats.failed);
+            ok = srv.stats.requests == (size_t)n && srv.stats.failed == 4 && srv.stats.batches < (size_t)n;
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: public key only, and input cut off inside a frame */
+    {
+        total++;
+        printf("\n🧪 Test %d: Missing private key and a truncated final frame\n", total);
+        size_t len = 0;
+        ids[0] = 1;
+        len += serve_test_frame(req + len, 1, RSA_4096_SERVE_OP_PUBLIC, message[0], sizeof(message[0]));
+        ids[1] = 2;
+        len += serve_test_frame(req + len, 2, RSA_4096_SERVE_OP_PRIVATE, cipher[0], (uint32_t)cipher_len[0]);
+        len += serve_test_frame(req + len, 3, RSA_4096_SERVE_OP_PUBLIC, message[1], sizeof(message[1])) - 5;
+        
+        int sv[2];
+        int ok = socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0;
+        serve_test_server_t srv = {&pub_key, NULL, ok ? sv[1] : -1, NULL, {1, 0, 0}, {0, 0, 0}, 0};
+        pthread_t tid;
+        ok = ok && pthread_create(&tid, NULL, serve_test_server_main, &srv) == 0;
+        size_t got = ok ? serve_test_exchange(sv[0], req, len, resp, sizeof(resp)) : 0;
+        if (ok) {
+            pthread_join(tid, NULL);
+            close(sv[0]);
+            close(sv[1]);
+        }
+        ok = ok && srv.ret < 0 && serve_test_parse(resp, got, ids, 2, status, payload, payload_len) &&
+             status[0] == 0 && status[1] == RSA_4096_SERVE_ERR_NO_KEY;
+        if (ok) {
+            printf("✅ Test %d PASSED: complete frames answered, truncation reported (%d)\n", total, srv.ret);
+            passed++;
+        }
+    }
+    
+    /* Test 3: the Unix socket listener, stopping after one client */
+    {
+        total++;
+        char path[64];
+        snprintf(path, sizeof(path), "/tmp/rsa_4096_serve_test_%ld.sock", (long)getpid());
+        printf("\n🧪 Test %d: Unix socket listener on %s\n", total, path);
+        serve_test_server_t srv = {&pub_key, &priv_key, -1, path, {0, 0, 1}, {0, 0, 0}, -1};
+        pthread_t tid;
+        int ok = pthread_create(&tid, NULL, serve_test_server_main, &srv) == 0;
+        
+        int fd = ok ? serve_test_connect(path) : -1;
+        ok = ok && fd >= 0;
+        
+        size_t len = 0;
+        for (int i = 0; i < 6; i++) {
+            ids[i] = 50u + (uint32_t)i;
+            len += serve_test_frame(req + len, ids[i], RSA_4096_SERVE_OP_PRIVATE, cipher[i], (uint32_t)cipher_len[i]);
+        }
+        size_t got = ok ? serve_test_exchange(fd, req, len, resp, sizeof(resp)) : 0;
+        if (fd >= 0) close(fd);
+        pthread_join(tid, NULL);
+        ok = ok && srv.ret == 0 && serve_test_parse(resp, got, ids, 6, status, payload, payload_len);
+        for (int i = 0; ok && i < 6; i++) {
+            ok = status[i] == 0 && payload_len[i] == sizeof(message[i]) && memcmp(payload[i], message[i], 24) == 0;
+        }
+        ok = ok && access(path, F_OK) != 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 4: one client stays connected while more than a full round of slots comes and goes */
+    {
+        total++;
+        char path[64];
+        snprintf(path, sizeof(path), "/tmp/rsa_4096_serve_test_%ld_idle.sock", (long)getpid());
+        printf("\n🧪 Test %d: %d short clients served while the first one idles\n", total, RSA_4096_SERVE_MAX_CLIENTS);
+        serve_test_server_t srv = {&pub_key, &priv_key, -1, path, {0, 0, RSA_4096_SERVE_MAX_CLIENTS + 1}, {0, 0, 0}, -1};
+        pthread_t tid;
+        int ok = pthread_create(&tid, NULL, serve_test_server_main, &srv) == 0;
+        int idle_fd = ok ? serve_test_connect(path) : -1;
+        ok = ok && idle_fd >= 0;
+        
+        /* Without slot reuse the client landing on the idle one's slot would wait for it */
+        size_t len = serve_test_frame(req, 60, RSA_4096_SERVE_OP_PUBLIC, message[0], sizeof(message[0]));
+        int served = 0;
+        for (int c = 0; ok && c < RSA_4096_SERVE_MAX_CLIENTS; c++) {
+            int fd = serve_test_connect(path);
+            struct timeval limit = {5, 0};
+            ok = fd >= 0 && setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &limit, sizeof(limit)) == 0;
+            ids[0] = 60;
+            size_t got = ok ? serve_test_exchange(fd, req, len, resp, sizeof(resp)) : 0;
+            ok = ok && serve_test_parse(resp, got, ids, 1, status, payload, payload_len) && status[0] == 0;
+            if (fd >= 0) close(fd);
+            if (ok) served++;
+        }
+        printf("   📦 %d/%d short clients answered\n", served, RSA_4096_SERVE_MAX_CLIENTS);
+        
+        size_t got = idle_fd >= 0 ? serve_test_exchange(idle_fd, req, len, resp, sizeof(resp)) : 0;
+        if (idle_fd >= 0) close(idle_fd);
+        pthread_join(tid, NULL);
+        ok = ok && srv.ret == 0 && serve_test_parse(resp, got, ids, 1, status, payload, payload_len) && status[0] == 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("SERVICE MODE SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== STREAMING FILE ENCRYPTION TEST HELPERS ===================== */
+
+static int stream_test_write(int fd, const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t w = write(fd, data, len);
+        if (w <= 0) return -1;
+        data += w;
+        len -= (size_t)w;
+    }
+    return 0;
+}
+
+/**
+ * @brief Read a whole (rewound) file back into buf
+ */
+static size_t stream_test_slurp(int fd, uint8_t *buf, size_t size) {
+    size_t got = 0;
+    lseek(fd, 0, SEEK_SET);
+    for (;;) {
+        ssize_t r = read(fd, buf + got, size - got);
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+    return got;
+}
+
+/**
+ * @brief Encrypt through a temp file, decrypt through another, and compare with the input
+ */
+static int stream_test_round_trip(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key,
+                                  const uint8_t *data, size_t len, const rsa_4096_stream_config_t *config,
+                                  uint8_t *scratch, size_t scratch_size) {
+    FILE *plain = tmpfile(), *cipher = tmpfile(), *back = tmpfile();
+    int ok = plain != NULL && cipher != NULL && back != NULL;
+    size_t data_per_block = (size_t)(bigint_bit_length(&pub_key->n) + 7) / 8 - 2;
+    size_t blocks = len / data_per_block + 1;
+    rsa_4096_stream_stats_t enc_stats, dec_stats;
+    
+    ok = ok && stream_test_write(fileno(plain), data, len) == 0 && lseek(fileno(plain), 0, SEEK_SET) == 0;
+    ok = ok && rsa_4096_encrypt_stream(pub_key, fileno(plain), fileno(cipher), config, &enc_stats) == 0;
+    ok = ok && lseek(fileno(cipher), 0, SEEK_SET) == 0;
+    ok = ok && rsa_4096_decrypt_stream(priv_key, fileno(cipher), fileno(back), config, &dec_stats) == 0;
+    ok = ok && enc_stats.blocks == blocks && dec_stats.blocks == blocks &&
+         enc_stats.bytes_out == RSA_4096_STREAM_HEADER_SIZE + blocks * (data_per_block + 2) &&
+         dec_stats.bytes_out == len && enc_stats.mapped == (len > 0) && dec_stats.mapped == 1;
+    ok = ok && stream_test_slurp(fileno(back), scratch, scratch_size) == len && memcmp(scratch, data, len) == 0;
+    
+    if (plain != NULL) fclose(plain);
+    if (cipher != NULL) fclose(cipher);
+    if (back != NULL) fclose(back);
+    return ok;
+}
+
+int test_stream_encryption(void) {
+    printf("===============================================\n");
+    printf("🔍 STREAMING FILE ENCRYPTION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    rsa_4096_key_t pub_key, priv_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Key setup failed\n");
+        return -1;
+    }
+    
+    /* 126 plaintext bytes per 128-byte block; leading zero runs must survive the framing */
+    enum { STREAM_DATA = 126 * 37 + 5 };
+    static uint8_t data[STREAM_DATA], scratch[2 * STREAM_DATA + 4096];
+    uint32_t seed = 0x5eed1234u;
+    for (size_t i = 0; i < STREAM_DATA; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (i % 126) < 3 ? 0 : (uint8_t)(seed >> 16);
+    }
+    
+    /* Test 1: lengths around block and chunk boundaries through the mmap path */
+    {
+        total++;
+        printf("\n🧪 Test %d: Round trips around block and chunk boundaries\n", total);
+        const size_t lengths[] = {0, 1, 125, 126, 127, 126 * 4, 126 * 4 + 1, STREAM_DATA};
+        const rsa_4096_stream_config_t configs[] = {{1, 0}, {3, 4}, {2, 1}};
+        int ok = 1;
+        for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+            for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+                if (!stream_test_round_trip(&pub_key, &priv_key, data, lengths[l], &configs[c], scratch,
+                                            sizeof(scratch))) {
+                    printf("   ❌ %zu bytes, %d threads, %d-block chunks\n", lengths[l], configs[c].num_threads,
+                           configs[c].chunk_blocks);
+                    ok = 0;
+                }
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: unmappable input, read chunk by chunk from a pipe */
+    {
+        total++;
+        printf("\n🧪 Test %d: Pipe input is read in chunks and decrypts back\n", total);
+        int fds[2];
+        FILE *cipher = tmpfile(), *back = tmpfile();
+        rsa_4096_stream_config_t config = {2, 3};
+        rsa_4096_stream_stats_t stats;
+        size_t len = 126 * 9 + 40;      /* Well inside the pipe buffer, so one write cannot block */
+        int ok = cipher != NULL && back != NULL && pipe(fds) == 0;
+        if (ok) {
+            ok = stream_test_write(fds[1], data, len) == 0;
+            close(fds[1]);
+            ok = ok && rsa_4096_encrypt_stream(&pub_key, fds[0], fileno(cipher), &config, &stats) == 0 &&
+                 stats.mapped == 0 && stats.bytes_in == len && stats.chunks == 4;
+            close(fds[0]);
+        }
+        ok = ok && lseek(fileno(cipher), 0, SEEK_SET) == 0 &&
+             rsa_4096_decrypt_stream(&priv_key, fileno(cipher), fileno(back), &config, &stats) == 0 &&
+             stream_test_slurp(fileno(back), scratch, sizeof(scratch)) == len && memcmp(scratch, data, len) == 0;
+        if (cipher != NULL) fclose(cipher);
+        if (back != NULL) fclose(back);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: damaged streams and unsuitable keys are rejected */
+    {
+        total++;
+        printf("\n🧪 Test %d: Truncated, tampered and mis-keyed streams fail\n", total);
+        FILE *plain = tmpfile(), *cipher = tmpfile(), *sink = tmpfile();
+        rsa_4096_stream_config_t config = {2, 2};
+        int ok = plain != NULL && cipher != NULL && sink != NULL &&
+                 stream_test_write(fileno(plain), data, 126 * 6) == 0 && lseek(fileno(plain), 0, SEEK_SET) == 0 &&
+                 rsa_4096_encrypt_stream(&pub_key, fileno(plain), fileno(cipher), &config, NULL) == 0;
+        size_t len = ok ? stream_test_slurp(fileno(cipher), scratch, sizeof(scratch)) : 0;
+        ok = ok && len == RSA_4096_STREAM_HEADER_SIZE + 7 * 128;
+        
+        struct {
+            const char *what;
+            size_t length;                  /* Bytes of the stream kept */
+            size_t flip;                    /* Byte to corrupt, 0: none */
+            int expected;
+        } cases[] = {
+            {"final block dropped", len - 128, 0, -5},
+            {"half a block missing", len - 64, 0, -5},
+            {"bad magic", len, 3, -5},
+            {"wrong block size", len, 15, -5},
+            {"corrupted block", len, RSA_4096_STREAM_HEADER_SIZE + 128 * 2 + 60, -5},
+            {"header only", RSA_4096_STREAM_HEADER_SIZE, 0, -5},
+        };
+        for (size_t c = 0; ok && c < sizeof(cases) / sizeof(cases[0]); c++) {
+            uint8_t saved = scratch[cases[c].flip];
+            if (cases[c].flip != 0) scratch[cases[c].flip] ^= 0x40;
+            ok = ftruncate(fileno(cipher), 0) == 0 && lseek(fileno(cipher), 0, SEEK_SET) == 0 &&
+                 stream_test_write(fileno(cipher), scratch, cases[c].length) == 0 &&
+                 lseek(fileno(cipher), 0, SEEK_SET) == 0;
+            int ret = rsa_4096_decrypt_stream(&priv_key, fileno(cipher), fileno(sink), &config, NULL);
+            /* A flipped bit in a block decrypts to garbage: a bad marker, or rarely a value >= n */
+            if (ret != cases[c].expected && !(cases[c].flip > RSA_4096_STREAM_HEADER_SIZE && ret == -8)) {
+                printf("   ❌ %s: got %d, expected %d\n", cases[c].what, ret, cases[c].expected);
+                ok = 0;
+            }
+            scratch[cases[c].flip] = saved;
+        }
+        
+        rsa_4096_key_t small_key;
+        ok = ok && rsa_4096_decrypt_stream(&pub_key, fileno(cipher), fileno(sink), &config, NULL) == -2;
+        ok = ok && rsa_4096_load_key(&small_key, "3233", "17", 0) == 0;
+        if (ok) {
+            ok = rsa_4096_encrypt_stream(&small_key, fileno(plain), fileno(sink), &config, NULL) == -2;
+            rsa_4096_free(&small_key);
+        }
+        if (plain != NULL) fclose(plain);
+        if (cipher != NULL) fclose(cipher);
+        if (sink != NULL) fclose(sink);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 4: a file descriptor already moved into or past the end of its file */
+    {
+        total++;
+        printf("\n🧪 Test %d: Input is taken from the current offset, none at EOF\n", total);
+        FILE *plain = tmpfile(), *cipher = tmpfile(), *back = tmpfile();
+        rsa_4096_stream_config_t config = {2, 2};
+        rsa_4096_stream_stats_t stats;
+        size_t len = 126 * 5 + 17, skip = 126 * 2 + 3;
+        int ok = plain != NULL && cipher != NULL && back != NULL &&
+                 stream_test_write(fileno(plain), data, len) == 0 && lseek(fileno(plain), (off_t)skip, SEEK_SET) >= 0 &&
+                 rsa_4096_encrypt_stream(&pub_key, fileno(plain), fileno(cipher), &config, &stats) == 0 &&
+                 stats.mapped == 1 && stats.bytes_in == len - skip;
+        ok = ok && lseek(fileno(cipher), 0, SEEK_SET) == 0 &&
+             rsa_4096_decrypt_stream(&priv_key, fileno(cipher), fileno(back), &config, NULL) == 0 &&
+             stream_test_slurp(fileno(back), scratch, sizeof(scratch)) == len - skip &&
+             memcmp(scratch, data + skip, len - skip) == 0;
+        
+        /* At EOF there is nothing left: an empty stream, not the file again from byte 0 */
+        ok = ok && ftruncate(fileno(cipher), 0) == 0 && lseek(fileno(cipher), 0, SEEK_SET) == 0 &&
+             lseek(fileno(plain), 0, SEEK_END) == (off_t)len &&
+             rsa_4096_encrypt_stream(&pub_key, fileno(plain), fileno(cipher), &config, &stats) == 0 &&
+             stats.mapped == 0 && stats.bytes_in == 0 && stats.blocks == 1 &&
+             stream_test_slurp(fileno(cipher), scratch, sizeof(scratch)) == RSA_4096_STREAM_HEADER_SIZE + 128;
+        if (plain != NULL) fclose(plain);
+        if (cipher != NULL) fclose(cipher);
+        if (back != NULL) fclose(back);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("STREAMING FILE ENCRYPTION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== SHARED KEY REGISTRY TEST HELPERS ===================== */
+
+static const char *const registry_test_moduli[] = {"3233", "3127", "2773", "4087", "5183", "6557"};
+#define REGISTRY_TEST_KEYS ((int)(sizeof(registry_test_moduli) / sizeof(registry_test_moduli[0])))
+
+typedef struct {
+    rsa_4096_registry_t *reg;
+    const bigint_t *moduli;
+    int seed;
+    int lookups;
+    int hits;
+    int wrong;
+} registry_test_reader_t;
+
+static void *registry_test_reader_main(void *arg) {
+    registry_test_reader_t *r = (registry_test_reader_t *)arg;
+    uint32_t x = (uint32_t)r->seed * 2654435761u + 1u;
+    for (int i = 0; i < r->lookups; i++) {
+        x = x * 1103515245u + 12345u;
+        int which = (int)((x >> 16) % REGISTRY_TEST_KEYS);
+        const rsa_4096_key_t *key = rsa_4096_registry_lookup(r->reg, &r->moduli[which], 0);
+        if (key != NULL) {
+            r->hits++;
+            if (bigint_compare(&key->n, &r->moduli[which]) != 0 || key->is_private) r->wrong++;
+            rsa_4096_registry_release(key);
+        }
+    }
+    return NULL;
+}
+
+int test_key_registry(void) {
+    printf("===============================================\n");
+    printf("🔍 SHARED KEY REGISTRY TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    rsa_4096_key_t pub_key, priv_key, plain_priv;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0 ||
+        rsa_4096_load_key(&plain_priv, n_1024, d_1024, 1) != 0) {
+        printf("❌ Key setup failed\n");
+        return -1;
+    }
+    static bigint_t moduli[REGISTRY_TEST_KEYS];
+    static rsa_4096_key_t small_keys[REGISTRY_TEST_KEYS];
+    for (int i = 0; i < REGISTRY_TEST_KEYS; i++) {
+        bigint_from_decimal(&moduli[i], registry_test_moduli[i]);
+        rsa_4096_load_key(&small_keys[i], registry_test_moduli[i], "17", 0);
+    }
+    
+    /* Test 1: shared lookups, duplicates and the fingerprint itself */
+    {
+        total++;
+        printf("\n🧪 Test %d: Insert, look up and share public and CRT private keys\n", total);
+        rsa_4096_registry_t *reg = rsa_4096_registry_new(0);
+        const rsa_4096_key_t *pub = reg != NULL ? rsa_4096_registry_insert(reg, &pub_key) : NULL;
+        const rsa_4096_key_t *priv = reg != NULL ? rsa_4096_registry_insert(reg, &priv_key) : NULL;
+        int ok = pub != NULL && priv != NULL && pub != priv && priv->has_crt;
+        
+        /* Same value whatever the limb width */
+        uint64_t fingerprint = rsa_4096_modulus_fingerprint(&pub_key.n);
+        printf("   🔑 Fingerprint of the 1024-bit modulus: %016llx\n", (unsigned long long)fingerprint);
+        ok = ok && fingerprint == 0x8be4b2fa11116837ull;
+        
+        const rsa_4096_key_t *again = ok ? rsa_4096_registry_lookup(reg, &pub_key.n, 0) : NULL;
+        const rsa_4096_key_t *again_priv = ok ? rsa_4096_registry_lookup(reg, &pub_key.n, 1) : NULL;
+        const rsa_4096_key_t *dup = ok ? rsa_4096_registry_insert(reg, &plain_priv) : NULL;
+        ok = ok && again == pub && again_priv == priv && dup == priv;
+        ok = ok && rsa_4096_registry_lookup(reg, &moduli[0], 0) == NULL;
+        
+        uint8_t message[32] = {0x42, 7, 7, 7}, cipher[128], back[128];
+        size_t cipher_len = 0, back_len = 0;
+        ok = ok && rsa_4096_encrypt_binary(again, message, sizeof(message), cipher, sizeof(cipher), &cipher_len) == 0 &&
+             rsa_4096_decrypt_binary(again_priv, cipher, cipher_len, back, sizeof(back), &back_len) == 0 &&
+             back_len == sizeof(message) && memcmp(back, message, back_len) == 0;
+        
+        rsa_4096_registry_stats_t stats;
+        rsa_4096_registry_get_stats(reg, &stats);
+        ok = ok && stats.entries == 2 && stats.inserts == 2 && stats.hits == 2 && stats.misses == 1;
+        rsa_4096_registry_release(pub);
+        rsa_4096_registry_release(priv);
+        rsa_4096_registry_release(again);
+        rsa_4096_registry_release(again_priv);
+        rsa_4096_registry_release(dup);
+        rsa_4096_registry_free(reg);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: CLOCK keeps the recently used key; a held key survives its eviction */
+    {
+        total++;
+        printf("\n🧪 Test %d: CLOCK eviction and keys held across eviction\n", total);
+        rsa_4096_registry_t *reg = rsa_4096_registry_new(4);
+        int ok = reg != NULL;
+        for (int i = 0; ok && i < 4; i++) {
+            const rsa_4096_key_t *key = rsa_4096_registry_insert(reg, &small_keys[i]);
+            ok = key != NULL;
+            rsa_4096_registry_release(key);
+        }
+        const rsa_4096_key_t *hot = ok ? rsa_4096_registry_lookup(reg, &moduli[0], 0) : NULL;
+        rsa_4096_registry_release(hot);
+        const rsa_4096_key_t *added = ok ? rsa_4096_registry_insert(reg, &small_keys[4]) : NULL;
+        rsa_4096_registry_release(added);
+        const rsa_4096_key_t *evicted = ok ? rsa_4096_registry_lookup(reg, &moduli[1], 0) : NULL;
+        const rsa_4096_key_t *kept = ok ? rsa_4096_registry_lookup(reg, &moduli[0], 0) : NULL;
+        ok = ok && hot != NULL && added != NULL && evicted == NULL && kept == hot;
+        rsa_4096_registry_release(kept);
+        rsa_4096_registry_free(reg);
+        
+        /* Capacity 1: inserting a second key evicts the first while we still use it */
+        reg = rsa_4096_registry_new(1);
+        const rsa_4096_key_t *held = reg != NULL ? rsa_4096_registry_insert(reg, &pub_key) : NULL;
+        const rsa_4096_key_t *other = held != NULL ? rsa_4096_registry_insert(reg, &small_keys[0]) : NULL;
+        uint8_t message[16] = {1, 2, 3}, cipher[128];
+        size_t cipher_len = 0;
+        ok = ok && held != NULL && other != NULL && rsa_4096_registry_lookup(reg, &pub_key.n, 0) == NULL &&
+             bigint_compare(&held->n, &pub_key.n) == 0 &&
+             rsa_4096_encrypt_binary(held, message, sizeof(message), cipher, sizeof(cipher), &cipher_len) == 0;
+        rsa_4096_registry_stats_t stats;
+        rsa_4096_registry_get_stats(reg, &stats);
+        ok = ok && stats.evictions == 1 && stats.entries == 1;
+        rsa_4096_registry_release(held);
+        rsa_4096_registry_release(other);
+        rsa_4096_registry_free(reg);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: lock-free readers racing a writer that keeps evicting and replacing */
+    {
+        total++;
+        printf("\n🧪 Test %d: Concurrent lookups during constant eviction\n", total);
+        rsa_4096_registry_t *reg = rsa_4096_registry_new(3);
+        registry_test_reader_t readers[3];
+        pthread_t tids[3];
+        int started = 0, ok = reg != NULL;
+        for (int t = 0; ok && t < 3; t++) {
+            readers[t] = (registry_test_reader_t){reg, moduli, t + 1, 20000, 0, 0};
+            if (pthread_create(&tids[t], NULL, registry_test_reader_main, &readers[t]) != 0) break;
+            started++;
+        }
+        for (int i = 0; ok && i < 3000; i++) {
+            const rsa_4096_key_t *key = rsa_4096_registry_insert(reg, &small_keys[i % REGISTRY_TEST_KEYS]);
+            ok = key != NULL;
+            rsa_4096_registry_release(key);
+        }
+        int hits = 0, wrong = 0;
+        for (int t = 0; t < started; t++) {
+            pthread_join(tids[t], NULL);
+            hits += readers[t].hits;
+            wrong += readers[t].wrong;
+        }
+        rsa_4096_registry_stats_t stats;
+        if (reg != NULL) rsa_4096_registry_get_stats(reg, &stats);
+        ok = ok && started == 3 && wrong == 0 && stats.entries == 3 && stats.hits == (size_t)hits &&
+             stats.hits + stats.misses == 3 * 20000;
+        if (ok) {
+            printf("   📊 %zu hits, %zu misses, %zu inserts, %zu evictions\n", stats.hits, stats.misses,
+                   stats.inserts, stats.evictions);
+        }
+        rsa_4096_registry_free(reg);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    for (int i = 0; i < REGISTRY_TEST_KEYS; i++) {
+        rsa_4096_free(&small_keys[i]);
+    }
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    rsa_4096_free(&plain_priv);
+    
+    printf("\n===============================================\n");
+    printf("SHARED KEY REGISTRY SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== AUTOTUNING TEST HELPERS ===================== */
+
+/**
+ * @brief Encrypt then decrypt one block with the CRT key under the settings in force
+ */
+static int tuning_round_trip(const rsa_4096_key_t *pub_key, const rsa_4096_key_t *priv_key, const uint8_t *msg,
+                             size_t msg_len, uint8_t *cipher) {
+    uint8_t back[RSA_4096_SERVE_MAX_PAYLOAD];
+    size_t cipher_len = 0, back_len = 0;
+    if (rsa_4096_encrypt_binary(pub_key, msg, msg_len, cipher, RSA_4096_SERVE_MAX_PAYLOAD, &cipher_len) != 0 ||
+        rsa_4096_decrypt_binary(priv_key, cipher, cipher_len, back, sizeof(back), &back_len) != 0) {
+        return 0;
+    }
+    return back_len == msg_len && memcmp(back, msg, msg_len) == 0;
+}
+
+static int tuning_write_file(const char *path, const char *text) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) return -1;
+    fputs(text, f);
+    return fclose(f);
+}
+
+int test_tuning(void) {
+    printf("===============================================\n");
+    printf("🔍 AUTOTUNING TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    rsa_4096_tuning_t defaults;
+    rsa_4096_tuning_defaults(&defaults);
+    
+    /* Test 1: the runtime cutovers drive the dispatch and reject unusable values */
+    {
+        total++;
+        printf("\n🧪 Test %d: Window table, Karatsuba cutoff and cutover setters\n", total);
+        const int table[MONTGOMERY_MAX_WINDOW + 1] = {0, 0, 10, 0, 100, 0, 1000};
+        const int unordered[MONTGOMERY_MAX_WINDOW + 1] = {0, 0, 50, 40, 0, 0, 0};
+        int ok = montgomery_set_window_thresholds(table) == 0 && montgomery_select_window(9) == 1 &&
+                 montgomery_select_window(10) == 2 && montgomery_select_window(999) == 4 &&
+                 montgomery_select_window(1000) == 6;
+        ok = ok && montgomery_set_window_thresholds(unordered) != 0 && montgomery_select_window(99) == 2;
+        ok = ok && montgomery_set_window_thresholds(NULL) == 0 && montgomery_select_window(17) == 1 &&
+             montgomery_select_window(2048) == 6;
+        
+        /* Products agree whatever the cutoff, down to the smallest one that still terminates */
+        uint32_t seed = 0x54554E31u;
+        bigint_t a, b, expected, product;
+        karatsuba_test_operand(&a, MONTGOMERY_MAX_WORDS, 0, &seed);
+        karatsuba_test_operand(&b, MONTGOMERY_MAX_WORDS, 0, &seed);
+        bigint_mul(&expected, &a, &b);
+        for (int cutoff = 4; ok && cutoff <= MONTGOMERY_MAX_WORDS + 1; cutoff += 9) {
+            ok = bigint_set_karatsuba_cutoff(cutoff) == 0 && bigint_mul(&product, &a, &b) == 0 &&
+                 bigint_compare(&product, &expected) == 0;
+        }
+        ok = ok && bigint_set_karatsuba_cutoff(3) != 0 && bigint_set_karatsuba_cutoff(BIGINT_4096_WORDS + 1) != 0 &&
+             montgomery_simd_set_min_bits(32) != 0 && hybrid_set_montgomery_min_bits(4) != 0 &&
+             rsa_4096_set_crt_min_bits(-1) != 0;
+        rsa_4096_tuning_apply(&defaults);
+        ok = ok && bigint_karatsuba_cutoff() == BIGINT_KARATSUBA_CUTOFF;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_key_t pub_key, priv_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Key setup failed\n");
+        return -1;
+    }
+    uint8_t msg[64], reference[RSA_4096_SERVE_MAX_PAYLOAD], cipher[RSA_4096_SERVE_MAX_PAYLOAD];
+    for (size_t i = 0; i < sizeof(msg); i++) {
+        msg[i] = (uint8_t)(i * 37 + 11);
+    }
+    tuning_round_trip(&pub_key, &priv_key, msg, sizeof(msg), reference);
+    
+    /* Test 2: calibrate, leave the active settings alone, and keep results identical once applied */
+    rsa_4096_tuning_t tuned;
+    {
+        total++;
+        printf("\n🧪 Test %d: Calibrate on this machine and apply the profile\n", total);
+        rsa_4096_tuning_t before, after;
+        rsa_4096_tuning_active(&before);
+        int ok = rsa_4096_tuning_calibrate(&tuned) == 0 && tuned.calibrated == 1;
+        rsa_4096_tuning_active(&after);
+        ok = ok && memcmp(&before, &after, sizeof(before)) == 0;
+        if (ok) {
+            const int *w = tuned.window_min_bits;
+            printf("   📊 %s kernel from %d bits, windows 2..6 from %d/%d/%d/%d/%d bits\n",
+                   montgomery_simd_name(tuned.simd_kernel), tuned.simd_min_bits, w[2], w[3], w[4], w[5], w[6]);
+            printf("   📊 Karatsuba from %d words, Montgomery from %d bits, CRT from %d bits\n",
+                   tuned.karatsuba_cutoff, tuned.montgomery_min_bits, tuned.crt_min_bits);
+        }
+        
+        ok = ok && rsa_4096_tuning_apply(&tuned) == 0 &&
+             tuning_round_trip(&pub_key, &priv_key, msg, sizeof(msg), cipher) &&
+             memcmp(cipher, reference, 128) == 0;
+        /* The full-size private path must agree with CRT when the cutover switches CRT off */
+        ok = ok && rsa_4096_set_crt_min_bits(4097) == 0 &&
+             tuning_round_trip(&pub_key, &priv_key, msg, sizeof(msg), cipher);
+        rsa_4096_tuning_apply(&defaults);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: profiles survive a save/load round trip; foreign or damaged ones are refused */
+    char path[64];
+    snprintf(path, sizeof(path), "/tmp/rsa_4096_tuning_test_%ld.prof", (long)getpid());
+    {
+        total++;
+        printf("\n🧪 Test %d: Save, reload and reject tuning profiles\n", total);
+        rsa_4096_tuning_t loaded;
+        int ok = rsa_4096_tuning_save(&tuned, path) == 0 && rsa_4096_tuning_load(&loaded, path) == 0 &&
+                 memcmp(&loaded, &tuned, sizeof(tuned)) == 0;
+        
+        char text[512];
+        snprintf(text, sizeof(text),
+                 "version 1\nlimb_bits %d\nsimd_kernel 0\nsimd_min_bits 512\nwindow_min_bits 0 24 80 240 672\n"
+                 "karatsuba_cutoff 8\nmontgomery_min_bits 64\ncrt_min_bits 0\n", 96 - BIGINT_WORD_SIZE);
+        ok = ok && tuning_write_file(path, text) == 0 && rsa_4096_tuning_load(&loaded, path) == -3;
+        snprintf(text, sizeof(text),
+                 "version 1\nlimb_bits %d\nsimd_kernel 7\nsimd_min_bits 512\nwindow_min_bits 0 24 80 240 672\n"
+                 "karatsuba_cutoff 8\nmontgomery_min_bits 64\ncrt_min_bits 0\n", BIGINT_WORD_SIZE);
+        ok = ok && tuning_write_file(path, text) == 0 && rsa_4096_tuning_load(&loaded, path) == -5;
+        ok = ok && tuning_write_file(path, "version 1\nthreads 4\n") == 0 && rsa_4096_tuning_load(&loaded, path) == -3;
+        ok = ok && rsa_4096_tuning_load(&loaded, "/nonexistent/rsa_4096.prof") == -2;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 4: startup hook calibrates and saves once, then loads */
+    {
+        total++;
+        printf("\n🧪 Test %d: Startup calibrates once, then reuses the saved profile\n", total);
+        unlink(path);
+        rsa_4096_tuning_t first, second, active;
+        int ok = rsa_4096_tuning_init(path, &first) == 1 && rsa_4096_tuning_init(path, &second) == 0 &&
+                 memcmp(&first, &second, sizeof(first)) == 0;
+        rsa_4096_tuning_active(&active);
+        ok = ok && active.karatsuba_cutoff == second.karatsuba_cutoff && active.crt_min_bits == second.crt_min_bits &&
+             active.simd_kernel == (second.simd_kernel == MONTGOMERY_SIMD_AUTO ? montgomery_simd_detect()
+                                                                                 : second.simd_kernel) &&
+             tuning_round_trip(&pub_key, &priv_key, msg, sizeof(msg), cipher) && memcmp(cipher, reference, 128) == 0;
+        rsa_4096_tuning_apply(&defaults);
+        unlink(path);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("AUTOTUNING SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== SIZE-SPECIALISED KERNEL TEST HELPERS ===================== */
+
+/**
+ * @brief Odd modulus of exactly bits bits plus a reduced base for it
+ */
+static void fixed_kernel_operands(bigint_t *n, bigint_t *base, int bits, uint32_t *seed) {
+    int words = (bits + BIGINT_WORD_SIZE - 1) / BIGINT_WORD_SIZE;
+    karatsuba_test_operand(n, words, 0, seed);
+    bigint_word_t top = (bigint_word_t)1 << ((bits - 1) % BIGINT_WORD_SIZE);
+    n->words[words - 1] = (n->words[words - 1] & (top - 1)) | top;
+    n->words[0] |= 1;
+    karatsuba_test_operand(base, words, 0, seed);
+    bigint_mod(base, base, n);
+}
+
+int test_fixed_kernels(void) {
+    printf("===============================================\n");
+    printf("🔍 SIZE-SPECIALISED MONTGOMERY KERNEL TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    static const int fixed_bits[] = {512, 1024, 1536, 2048, 3072, 4096};
+    static const int odd_bits[] = {1184, 2592};   /* Widths no fixed set covers at either limb size */
+    const int num_fixed = (int)(sizeof(fixed_bits) / sizeof(fixed_bits[0]));
+    uint32_t seed = 0x4649584Bu;
+    
+    /* Test 1: the standard widths bind their own set, everything else the generic one */
+    {
+        total++;
+        printf("\n🧪 Test %d: Kernel binding by modulus width\n", total);
+        int ok = 1;
+        for (int i = 0; i < num_fixed + 2 && ok; i++) {
+            int bits = i < num_fixed ? fixed_bits[i] : odd_bits[i - num_fixed];
+            bigint_t n, base;
+            montgomery_ctx_t ctx;
+            fixed_kernel_operands(&n, &base, bits, &seed);
+            char expected[16];
+            snprintf(expected, sizeof(expected), "%d-bit", bits);
+            ok = montgomery_ctx_init(&ctx, &n) == 0 && ctx.kernels != NULL &&
+                 strcmp(montgomery_ctx_kernel_name(&ctx), i < num_fixed ? expected : "generic") == 0;
+            printf("   %s %d-bit modulus -> %s kernels\n", ok ? "✅" : "❌", bits, montgomery_ctx_kernel_name(&ctx));
+            montgomery_ctx_free(&ctx);
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: specialised and generic sets agree, and exponentiation matches square-and-multiply */
+    {
+        total++;
+        printf("\n🧪 Test %d: Fixed-width mul/square/REDC against the generic set and bigint_mod_exp\n", total);
+        int ok = 1;
+        for (int i = 0; i < num_fixed + 2 && ok; i++) {
+            int bits = i < num_fixed ? fixed_bits[i] : odd_bits[i - num_fixed];
+            bigint_t n, base, other, exp, got, want, wide;
+            montgomery_ctx_t ctx, generic;
+            fixed_kernel_operands(&n, &base, bits, &seed);
+            fixed_kernel_operands(&other, &other, bits, &seed);
+            bigint_mod(&other, &other, &n);
+            bigint_set_u32(&exp, 0x9E3779B9u);
+            if (montgomery_ctx_init(&ctx, &n) != 0 || !ctx.is_active) {
+                ok = 0;
+                break;
+            }
+            generic = ctx;
+            generic.kernels = NULL;
+            
+            mont_residue_t a, b, fixed_out, generic_out;
+            mont_residue_from_bigint(&a, &base, &ctx);
+            mont_residue_from_bigint(&b, &other, &ctx);
+            size_t bytes = (size_t)ctx.n_words * sizeof(bigint_word_t);
+            montgomery_mul_residue(&fixed_out, &a, &b, &ctx);
+            montgomery_mul_residue(&generic_out, &a, &b, &generic);
+            ok = memcmp(fixed_out.words, generic_out.words, bytes) == 0;
+            montgomery_square_residue(&fixed_out, &a, &ctx);
+            montgomery_square_residue(&generic_out, &a, &generic);
+            ok = ok && memcmp(fixed_out.words, generic_out.words, bytes) == 0;
+            
+            /* REDC path: a double-width value below n * R */
+            bigint_mul(&wide, &base, &other);
+            ok = ok && montgomery_reduce(&got, &wide, &ctx) == 0 && bigint_mod(&want, &wide, &n) == 0 &&
+                 bigint_compare(&got, &want) == 0;
+            ok = ok && montgomery_exp(&got, &base, &exp, &ctx) == 0 &&
+                 bigint_mod_exp(&want, &base, &exp, &n) == 0 && bigint_compare(&got, &want) == 0;
+            printf("   %s %d-bit: %s kernels agree\n", ok ? "✅" : "❌", bits, montgomery_ctx_kernel_name(&ctx));
+            montgomery_ctx_free(&ctx);
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: contexts restored from a key blob come back bound to the same sets */
+    {
+        total++;
+        printf("\n🧪 Test %d: Key blob round trip rebinds the kernels\n", total);
+        rsa_4096_key_t key, loaded;
+        static uint8_t blob[16384];
+        size_t size = 0;
+        int ok = rsa_4096_load_key(&key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0 &&
+                 rsa_4096_key_serialize(&key, blob, sizeof(blob), &size) == 0 &&
+                 rsa_4096_key_deserialize(&loaded, blob, size) == 0;
+        ok = ok && loaded.mont_ctx.kernels == key.mont_ctx.kernels && loaded.p_ctx.kernels == key.p_ctx.kernels &&
+             loaded.q_ctx.kernels == key.q_ctx.kernels &&
+             strcmp(montgomery_ctx_kernel_name(&loaded.mont_ctx), "1024-bit") == 0 &&
+             strcmp(montgomery_ctx_kernel_name(&loaded.p_ctx), "512-bit") == 0;
+        if (ok) {
+            printf("   🔑 n: %s, p: %s, q: %s\n", montgomery_ctx_kernel_name(&loaded.mont_ctx),
+                   montgomery_ctx_kernel_name(&loaded.p_ctx), montgomery_ctx_kernel_name(&loaded.q_ctx));
+            rsa_4096_free(&loaded);
+        }
+        rsa_4096_free(&key);
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("SIZE-SPECIALISED MONTGOMERY KERNEL SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+typedef struct {
+    const rsa_4096_key_t *priv;
+    const uint8_t (*ciphers)[128];
+    const size_t *cipher_lens;
+    int count;
+    int rounds;
+    int wrong;
+} parallel_crt_test_worker_t;
+
+static void *parallel_crt_test_worker_main(void *arg) {
+    parallel_crt_test_worker_t *w = (parallel_crt_test_worker_t *)arg;
+    for (int i = 0; i < w->rounds; i++) {
+        int which = i % w->count;
+        uint8_t back[128];
+        size_t back_len = 0;
+        if (rsa_4096_decrypt_binary(w->priv, w->ciphers[which], w->cipher_lens[which], back, sizeof(back),
+                                    &back_len) != 0 || back_len != 1 || back[0] != (uint8_t)(which + 1)) {
+            w->wrong++;
+        }
+    }
+    return NULL;
+}
+
+int test_parallel_crt(void) {
+    printf("===============================================\n");
+    printf("🔍 PARALLEL CRT HELPER TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    enum { MESSAGES = 6 };
+    rsa_4096_key_t pub_key, priv_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Failed to load the 1024-bit test key\n");
+        return -1;
+    }
+    
+    /* Single-byte messages keep the worker check trivial; the exponentiations are full size */
+    static uint8_t ciphers[MESSAGES][128];
+    size_t cipher_lens[MESSAGES];
+    uint8_t inline_out[MESSAGES][128];
+    size_t inline_lens[MESSAGES];
+    int ready = 1;
+    rsa_4096_parallel_crt_stop();
+    for (int i = 0; i < MESSAGES && ready; i++) {
+        uint8_t message[1] = {(uint8_t)(i + 1)};
+        ready = rsa_4096_encrypt_binary(&pub_key, message, sizeof(message), ciphers[i], sizeof(ciphers[i]),
+                                        &cipher_lens[i]) == 0 &&
+                rsa_4096_decrypt_binary(&priv_key, ciphers[i], cipher_lens[i], inline_out[i], sizeof(inline_out[i]),
+                                        &inline_lens[i]) == 0;
+    }
+    
+    /* Test 1: offloading mod q gives the same plaintexts as the inline path */
+    {
+        total++;
+        printf("\n🧪 Test %d: Helper-thread decrypts match inline CRT\n", total);
+        rsa_4096_parallel_crt_stats_t before, after;
+        rsa_4096_parallel_crt_get_stats(&before);
+        int ok = ready && rsa_4096_parallel_crt_start(-1) == 0 && rsa_4096_parallel_crt_active() &&
+                 rsa_4096_parallel_crt_start(-1) == 0;
+        for (int i = 0; i < MESSAGES && ok; i++) {
+            uint8_t back[128];
+            size_t back_len = 0;
+            ok = rsa_4096_decrypt_binary(&priv_key, ciphers[i], cipher_lens[i], back, sizeof(back), &back_len) == 0 &&
+                 back_len == inline_lens[i] && memcmp(back, inline_out[i], back_len) == 0;
+        }
+        rsa_4096_parallel_crt_get_stats(&after);
+        ok = ok && after.offloaded - before.offloaded == MESSAGES && after.busy_misses == before.busy_misses;
+        if (ok) {
+            printf("   📊 %zu mod-q halves offloaded\n", after.offloaded - before.offloaded);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: a stopped helper takes no work and decrypts fall back to the caller */
+    {
+        total++;
+        printf("\n🧪 Test %d: Stop, fallback and restart\n", total);
+        rsa_4096_parallel_crt_stop();
+        rsa_4096_parallel_crt_stop();
+        rsa_4096_parallel_crt_stats_t before, after;
+        rsa_4096_parallel_crt_get_stats(&before);
+        bigint_t out, base;
+        bigint_set_u32(&base, 12345);
+        uint8_t back[128];
+        size_t back_len = 0;
+        int ok = ready && !rsa_4096_parallel_crt_active() &&
+                 rsa_4096_parallel_crt_begin(&out, &base, &priv_key.dq, &priv_key.q_ctx) == 1 &&
+                 rsa_4096_decrypt_binary(&priv_key, ciphers[0], cipher_lens[0], back, sizeof(back), &back_len) == 0 &&
+                 back_len == inline_lens[0] && memcmp(back, inline_out[0], back_len) == 0;
+        rsa_4096_parallel_crt_get_stats(&after);
+        ok = ok && after.offloaded == before.offloaded && after.busy_misses == before.busy_misses;
+        
+        /* Restarted helper (pinned to CPU 0 as a hint) takes work again */
+        ok = ok && rsa_4096_parallel_crt_start(0) == 0 &&
+             rsa_4096_decrypt_binary(&priv_key, ciphers[1], cipher_lens[1], back, sizeof(back), &back_len) == 0 &&
+             back_len == inline_lens[1] && memcmp(back, inline_out[1], back_len) == 0;
+        rsa_4096_parallel_crt_get_stats(&after);
+        ok = ok && after.offloaded == before.offloaded + 1;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: callers racing for the one slot either offload or run inline, never wait or mix jobs */
+    {
+        total++;
+        printf("\n🧪 Test %d: Concurrent decrypts sharing one helper\n", total);
+        parallel_crt_test_worker_t workers[3];
+        pthread_t tids[3];
+        int started = 0, wrong = 0, ok = ready && rsa_4096_parallel_crt_active();
+        rsa_4096_parallel_crt_stats_t before, after;
+        rsa_4096_parallel_crt_get_stats(&before);
+        for (int t = 0; ok && t < 3; t++) {
+            workers[t] = (parallel_crt_test_worker_t){&priv_key, (const uint8_t (*)[128])ciphers, cipher_lens,
+                                                      MESSAGES, 40, 0};
+            if (pthread_create(&tids[t], NULL, parallel_crt_test_worker_main, &workers[t]) != 0) break;
+            started++;
+        }
+        for (int t = 0; t < started; t++) {
+            pthread_join(tids[t], NULL);
+            wrong += workers[t].wrong;
+        }
+        rsa_4096_parallel_crt_get_stats(&after);
+        size_t offloaded = after.offloaded - before.offloaded, misses = after.busy_misses - before.busy_misses;
+        ok = ok && started == 3 && wrong == 0 && offloaded + misses == 3 * 40 && offloaded > 0;
+        if (ok) {
+            printf("   📊 %zu offloaded, %zu ran inline (helper busy)\n", offloaded, misses);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+        rsa_4096_parallel_crt_stop();
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("PARALLEL CRT HELPER SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+typedef struct {
+    int muls;
+} stats_test_worker_t;
+
+static void *stats_test_worker_main(void *arg) {
+    stats_test_worker_t *w = (stats_test_worker_t *)arg;
+    bigint_t a, b, r;
+    bigint_set_u32(&a, 0x12345u);
+    bigint_set_u32(&b, 0x6789u);
+    for (int i = 0; i < w->muls; i++) {
+        bigint_mul(&r, &a, &b);
+    }
+    return NULL;
+}
+
+int test_perf_stats(void) {
+    printf("===============================================\n");
+    printf("🔍 PERFORMANCE COUNTER TESTING\n");
+    printf("===============================================\n");
+    
+#if !RSA_4096_STATS
+    printf("⚠️  Counters compiled out (RSA_4096_STATS=0), nothing to test\n");
+    return 0;
+#endif
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x53544154u;
+    rsa_4096_key_t pub_key, priv_key;
+    int ready = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) == 0 &&
+                rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0;
+    
+    /* Test 1: nothing is counted while disabled; exact counts for single calls once enabled */
+    {
+        total++;
+        printf("\n🧪 Test %d: Off by default, exact bigint_mul / bigint_div counts when on\n", total);
+        bigint_t a, b, q, r;
+        karatsuba_test_operand(&a, 8, 0, &seed);
+        karatsuba_test_operand(&b, 3, 0, &seed);
+        rsa_4096_stats_t before, after;
+        rsa_4096_stats_get(&before);
+        int ok = !rsa_4096_stats_enabled();
+        bigint_mul(&q, &a, &b);
+        rsa_4096_stats_get(&after);
+        ok = ok && memcmp(&before, &after, sizeof(before)) == 0;
+        
+        rsa_4096_stats_enable(1);
+        rsa_4096_stats_reset();
+        ok = ok && bigint_mul(&q, &a, &b) == 0 && bigint_div(&q, &r, &a, &b) == 0;
+        rsa_4096_stats_get(&after);
+        ok = ok && rsa_4096_stats_enabled() && after.counts[RSA_4096_STAT_BIGINT_MUL] == 1 &&
+             after.counts[RSA_4096_STAT_BIGINT_DIV] == 1 && after.counts[RSA_4096_STAT_DIV_ITERATIONS] == 8 - 3 + 1;
+        if (ok) {
+            printf("   📊 8-by-3-word division: %" PRIu64 " quotient-word iterations\n",
+                   after.counts[RSA_4096_STAT_DIV_ITERATIONS]);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: an encrypt/decrypt pair lands in the right paths, timers and histograms */
+    {
+        total++;
+        printf("\n🧪 Test %d: Path counters, phase timers and latency histograms\n", total);
+        uint8_t message[16] = {0x5A, 1, 2, 3}, cipher[128], back[128];
+        size_t cipher_len = 0, back_len = 0;
+        rsa_4096_stats_reset();
+        int ok = ready &&
+                 rsa_4096_encrypt_binary(&pub_key, message, sizeof(message), cipher, sizeof(cipher), &cipher_len) == 0 &&
+                 rsa_4096_decrypt_binary(&priv_key, cipher, cipher_len, back, sizeof(back), &back_len) == 0 &&
+                 back_len == sizeof(message) && memcmp(back, message, back_len) == 0;
+        rsa_4096_stats_t s;
+        rsa_4096_stats_get(&s);
+        uint64_t enc = 0, dec = 0;
+        for (int b = 0; b < RSA_4096_LATENCY_BUCKETS; b++) {
+            enc += s.latency[RSA_4096_LATENCY_ENCRYPT][b];
+            dec += s.latency[RSA_4096_LATENCY_DECRYPT][b];
+        }
+        /* One public exponentiation plus the two CRT halves, none on the traditional path */
+        ok = ok && enc == 1 && dec == 1 && s.counts[RSA_4096_STAT_CRT_EXP] == 1 &&
+             s.counts[RSA_4096_STAT_MONT_EXP] + s.counts[RSA_4096_STAT_SIMD_EXP] == 3 &&
+             s.counts[RSA_4096_STAT_TRADITIONAL_EXP] == 0 && s.counts[RSA_4096_STAT_MONT_SQR] > 0 &&
+             s.time_calls[RSA_4096_TIME_EXP] == 3 && s.time_ns[RSA_4096_TIME_EXP] > 0 &&
+             s.time_calls[RSA_4096_TIME_CONVERT] > 0 && s.time_calls[RSA_4096_TIME_CTX_INIT] == 0;
+        ok = ok && rsa_4096_stats_latency_percentile(&s, RSA_4096_LATENCY_DECRYPT, 0.5) > 0;
+        
+        /* Context setup is timed; an even modulus is forced onto the traditional fallback */
+        montgomery_ctx_t ctx;
+        bigint_t n, base, exp, out;
+        karatsuba_test_operand(&n, 8, 0, &seed);
+        bigint_set_u32(&base, 3);
+        bigint_set_u32(&exp, 1000);
+        n.words[0] |= 1;
+        ok = ok && montgomery_ctx_init(&ctx, &n) == 0;
+        n.words[0] &= ~(bigint_word_t)1;
+        ok = ok && hybrid_mod_exp(&out, &base, &exp, &n, NULL) == 0;
+        rsa_4096_stats_get(&s);
+        ok = ok && s.time_calls[RSA_4096_TIME_CTX_INIT] == 1 && s.counts[RSA_4096_STAT_TRADITIONAL_EXP] == 1;
+        if (ok) {
+            rsa_4096_stats_print(&s, stdout);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+        montgomery_ctx_free(&ctx);
+    }
+    
+    /* Test 3: per-thread blocks are merged on read, also after their threads exit */
+    {
+        total++;
+        printf("\n🧪 Test %d: Counts from exited worker threads survive the merge\n", total);
+        stats_test_worker_t workers[3];
+        pthread_t tids[3];
+        int started = 0;
+        rsa_4096_stats_reset();
+        for (int t = 0; t < 3; t++) {
+            workers[t].muls = 1000 * (t + 1);
+            if (pthread_create(&tids[t], NULL, stats_test_worker_main, &workers[t]) != 0) break;
+            started++;
+        }
+        for (int t = 0; t < started; t++) {
+            pthread_join(tids[t], NULL);
+        }
+        rsa_4096_stats_t s;
+        rsa_4096_stats_get(&s);
+        int ok = started == 3 && s.counts[RSA_4096_STAT_BIGINT_MUL] == 6000;
+        rsa_4096_stats_reset();
+        rsa_4096_stats_get(&s);
+        ok = ok && s.counts[RSA_4096_STAT_BIGINT_MUL] == 0;
+        if (ok) {
+            printf("   📊 6000 multiplies from 3 threads merged, reset back to 0\n");
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 4: percentiles come from the bucket bounds */
+    {
+        total++;
+        printf("\n🧪 Test %d: Latency percentiles from histogram buckets\n", total);
+        rsa_4096_stats_t s;
+        memset(&s, 0, sizeof(s));
+        s.latency[RSA_4096_LATENCY_ENCRYPT][3] = 90;     /* [8, 16) us */
+        s.latency[RSA_4096_LATENCY_ENCRYPT][10] = 10;    /* [1024, 2048) us */
+        int ok = rsa_4096_stats_latency_percentile(&s, RSA_4096_LATENCY_ENCRYPT, 0.5) == 16 &&
+                 rsa_4096_stats_latency_percentile(&s, RSA_4096_LATENCY_ENCRYPT, 0.9) == 16 &&
+                 rsa_4096_stats_latency_percentile(&s, RSA_4096_LATENCY_ENCRYPT, 0.99) == 2048 &&
+                 rsa_4096_stats_latency_percentile(&s, RSA_4096_LATENCY_DECRYPT, 0.5) == 0 &&
+                 strcmp(rsa_4096_stats_counter_name(RSA_4096_STAT_TRADITIONAL_EXP), "traditional_exp") == 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_stats_enable(0);
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("PERFORMANCE COUNTER SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/**
+ * @brief Reference base^exp mod n by square-and-multiply with a full division per step
+ */
+static int barrett_test_reference_exp(bigint_t *result, const bigint_t *base, const bigint_t *exp, const bigint_t *n) {
+    bigint_t acc, t;
+    bigint_set_u32(&acc, 1);   /* n > 1 in every caller */
+    int ret = 0;
+    for (int i = bigint_bit_length(exp) - 1; i >= 0 && ret == 0; i--) {
+        ret = bigint_mul(&t, &acc, &acc);
+        if (ret == 0) ret = bigint_mod(&acc, &t, n);
+        if (ret == 0 && bigint_get_bit(exp, i)) {
+            ret = bigint_mul(&t, &acc, base);
+            if (ret == 0) ret = bigint_mod(&acc, &t, n);
+        }
+    }
+    bigint_copy(result, &acc);
+    return ret;
+}
+
+int test_barrett(void) {
+    printf("===============================================\n");
+    printf("🔍 BARRETT REDUCTION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x42415252u;
+    const int widths[] = {1, 2, 3, 7, 16, MONTGOMERY_MAX_WORDS / 2, MONTGOMERY_MAX_WORDS, BARRETT_MAX_WORDS};
+    const int num_widths = (int)(sizeof(widths) / sizeof(widths[0]));
+    
+    /* Test 1: reductions agree with bigint_mod for odd and even moduli, edge inputs and aliasing */
+    {
+        total++;
+        printf("\n🧪 Test %d: barrett_reduce matches bigint_mod across widths and parities\n", total);
+        int ok = 1, cases = 0;
+        for (int w = 0; w < num_widths && ok; w++) {
+            for (int pattern = 0; pattern < 3 && ok; pattern++) {
+                for (int parity = 0; parity < 2 && ok; parity++) {
+                    int k = widths[w];
+                    bigint_t n, a, b, x, got, want, one;
+                    barrett_ctx_t ctx;
+                    karatsuba_test_operand(&n, k, pattern, &seed);
+                    n.words[0] = parity ? (n.words[0] | 1) : (n.words[0] & ~(bigint_word_t)1);
+                    bigint_normalize(&n);
+                    if (bigint_is_zero(&n) || barrett_ctx_init(&ctx, &n) != 0) {
+                        ok = 0;
+                        break;
+                    }
+                    
+                    /* Random double-width values, the all-ones maximum, n itself, n - 1 and 2n */
+                    bigint_set_u32(&one, 1);
+                    for (int c = 0; c < 6 && ok; c++) {
+                        switch (c) {
+                        case 0:
+                        case 1:
+                            karatsuba_test_operand(&a, k, 0, &seed);
+                            karatsuba_test_operand(&b, k, 0, &seed);
+                            bigint_mul(&x, &a, &b);
+                            break;
+                        case 2:
+                            karatsuba_test_operand(&x, 2 * k, 1, &seed);
+                            break;
+                        case 3:
+                            bigint_copy(&x, &n);
+                            break;
+                        case 4:
+                            bigint_sub(&x, &n, &one);
+                            break;
+                        default:
+                            bigint_add(&x, &n, &n);
+                            break;
+                        }
+                        ok = barrett_reduce(&got, &x, &ctx) == 0 && bigint_mod(&want, &x, &n) == 0 &&
+                             bigint_compare(&got, &want) == 0;
+                        ok = ok && barrett_reduce(&x, &x, &ctx) == 0 && bigint_compare(&x, &want) == 0;
+                        cases++;
+                    }
+                    barrett_ctx_free(&ctx);
+                }
+            }
+        }
+        
+        /* Inputs wider than b^(2k) take the division fallback */
+        if (ok) {
+            bigint_t n, x, got, want;
+            barrett_ctx_t ctx;
+            karatsuba_test_operand(&n, 4, 0, &seed);
+            karatsuba_test_operand(&x, 11, 0, &seed);
+            ok = barrett_ctx_init(&ctx, &n) == 0 && barrett_reduce(&got, &x, &ctx) == 0 &&
+                 bigint_mod(&want, &x, &n) == 0 && bigint_compare(&got, &want) == 0;
+            bigint_init(&n);
+            ok = ok && barrett_ctx_init(&ctx, &n) != 0;
+        }
+        if (ok) {
+            printf("   📊 %d reductions checked against bigint_mod\n", cases);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: exponentiation agrees with Montgomery on odd moduli and a plain reference on even ones */
+    {
+        total++;
+        printf("\n🧪 Test %d: barrett_exp against montgomery_exp and a division-based reference\n", total);
+        const int exp_widths[] = {2, 5, 16, MONTGOMERY_MAX_WORDS / 4};
+        int ok = 1;
+        for (int w = 0; w < 4 && ok; w++) {
+            int k = exp_widths[w];
+            bigint_t n, base, exp, got, want;
+            barrett_ctx_t bctx;
+            karatsuba_test_operand(&n, k, 0, &seed);
+            karatsuba_test_operand(&base, k, 0, &seed);
+            karatsuba_test_operand(&exp, k, 0, &seed);
+            
+            n.words[0] |= 1;
+            montgomery_ctx_t mctx;
+            ok = barrett_ctx_init(&bctx, &n) == 0 && montgomery_ctx_init(&mctx, &n) == 0 &&
+                 barrett_exp(&got, &base, &exp, &bctx) == 0 && montgomery_exp(&want, &base, &exp, &mctx) == 0 &&
+                 bigint_compare(&got, &want) == 0;
+            montgomery_ctx_free(&mctx);
+            
+            n.words[0] &= ~(bigint_word_t)1;
+            ok = ok && barrett_ctx_init(&bctx, &n) == 0 && barrett_exp(&got, &base, &exp, &bctx) == 0 &&
+                 barrett_test_reference_exp(&want, &base, &exp, &n) == 0 && bigint_compare(&got, &want) == 0;
+            
+            /* Result aliasing the exponent, and the zero exponent */
+            ok = ok && barrett_exp(&exp, &base, &exp, &bctx) == 0 && bigint_compare(&exp, &want) == 0;
+            bigint_init(&exp);
+            ok = ok && barrett_exp(&got, &base, &exp, &bctx) == 0 && bigint_is_one(&got);
+            barrett_ctx_free(&bctx);
+            if (!ok) {
+                printf("   ❌ Mismatch for %d-word modulus\n", k);
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: the even-modulus hybrid fallback runs on Barrett, not on per-step division */
+    {
+        total++;
+        printf("\n🧪 Test %d: hybrid_mod_exp with an even modulus reduces by Barrett\n", total);
+        bigint_t n, base, exp, got, want;
+        karatsuba_test_operand(&n, 16, 0, &seed);
+        karatsuba_test_operand(&base, 15, 0, &seed);
+        karatsuba_test_operand(&exp, 16, 0, &seed);
+        n.words[0] &= ~(bigint_word_t)1;
+        int ok = barrett_test_reference_exp(&want, &base, &exp, &n) == 0;
+        
+        rsa_4096_stats_enable(1);
+        rsa_4096_stats_reset();
+        ok = ok && hybrid_mod_exp(&got, &base, &exp, &n, NULL) == 0 && bigint_compare(&got, &want) == 0;
+        rsa_4096_stats_t s;
+        rsa_4096_stats_get(&s);
+        rsa_4096_stats_enable(0);
+#if RSA_4096_STATS
+        /* One division builds mu; every other reduction is a Barrett pass */
+        ok = ok && s.counts[RSA_4096_STAT_TRADITIONAL_EXP] == 1 && s.counts[RSA_4096_STAT_BIGINT_DIV] == 1 &&
+             s.counts[RSA_4096_STAT_BARRETT_REDUCE] >= (uint64_t)bigint_bit_length(&exp) - 1;
+        printf("   📊 %" PRIu64 " Barrett reductions, %" PRIu64 " division(s)\n",
+               s.counts[RSA_4096_STAT_BARRETT_REDUCE], s.counts[RSA_4096_STAT_BIGINT_DIV]);
+#endif
+        
+        /* Single-word moduli keep the original path */
+        bigint_t small_n, small_base, small_exp;
+        bigint_set_u32(&small_n, 1000);
+        bigint_set_u32(&small_base, 7);
+        bigint_set_u32(&small_exp, 5);
+        ok = ok && bigint_mod_exp(&got, &small_base, &small_exp, &small_n) == 0 &&
+             got.used == 1 && got.words[0] == 807;   /* 7^5 = 16807 */
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    printf("\n===============================================\n");
+    printf("BARRETT REDUCTION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_lazy_reduction(void) {
+    printf("===============================================\n");
+    printf("🔍 ALMOST-MONTGOMERY LAZY REDUCTION TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x4C415A59u;
+    int saved_lazy = montgomery_lazy_reduction();
+    montgomery_simd_select(MONTGOMERY_SIMD_NONE);   /* The scalar kernels are the ones under test */
+    
+    /* Generic width, fixed kernel widths, and moduli just below R and just above R / 2 */
+    const int widths[] = {3, 512 / BIGINT_WORD_SIZE, 1024 / BIGINT_WORD_SIZE, 2048 / BIGINT_WORD_SIZE,
+                          MONTGOMERY_MAX_WORDS};
+    const int num_widths = (int)(sizeof(widths) / sizeof(widths[0]));
+    
+    /* Test 1: kernel outputs stay below R and agree with the strict kernels modulo n */
+    {
+        total++;
+        printf("\n🧪 Test %d: amm_mul / amm_sqr stay below R and match the strict kernels mod n\n", total);
+        int ok = 1, cases = 0;
+        for (int w = 0; w < num_widths && ok; w++) {
+            for (int shape = 0; shape < 3 && ok; shape++) {
+                int k = widths[w];
+                bigint_t n, x, y, got, want, big;
+                karatsuba_test_operand(&n, k, shape == 1 ? 1 : 0, &seed);
+                if (shape == 2) n.words[k - 1] = (bigint_word_t)1 << (BIGINT_WORD_SIZE - 1);
+                n.words[0] |= 1;
+                montgomery_ctx_t ctx;
+                if (montgomery_ctx_init(&ctx, &n) != 0) {
+                    ok = 0;
+                    break;
+                }
+                const montgomery_kernels_t *kern = ctx.kernels;
+                
+                for (int c = 0; c < 8 && ok; c++) {
+                    /* Unreduced operands anywhere in [0, R), the all-ones maximum included */
+                    mont_residue_t a, b, lazy_out, strict_out, a_red, b_red;
+                    karatsuba_test_operand(&x, k, c == 0 ? 1 : 0, &seed);
+                    karatsuba_test_operand(&y, k, c < 2 ? 1 : 0, &seed);
+                    memset(&a, 0, sizeof(a));
+                    memset(&b, 0, sizeof(b));
+                    memcpy(a.words, x.words, (size_t)k * sizeof(bigint_word_t));
+                    memcpy(b.words, y.words, (size_t)k * sizeof(bigint_word_t));
+                    bigint_mod(&big, &x, &n);
+                    mont_residue_from_bigint(&a_red, &big, &ctx);
+                    bigint_mod(&big, &y, &n);
+                    mont_residue_from_bigint(&b_red, &big, &ctx);
+                    
+                    for (int op = 0; op < 2 && ok; op++) {
+                        if (op == 0) {
+                            kern->amm_mul(lazy_out.words, a.words, b.words, ctx.n.words, ctx.n_prime, k);
+                            kern->mul(strict_out.words, a_red.words, b_red.words, ctx.n.words, ctx.n_prime, k);
+                        } else {
+                            kern->amm_sqr(lazy_out.words, a.words, ctx.n.words, ctx.n_prime, k);
+                            kern->sqr(strict_out.words, a_red.words, ctx.n.words, ctx.n_prime, k);
+                        }
+                        bigint_init(&big);
+                        memcpy(big.words, lazy_out.words, (size_t)k * sizeof(bigint_word_t));
+                        big.used = k;
+                        bigint_normalize(&big);
+                        bigint_mod(&got, &big, &n);
+                        mont_residue_to_bigint(&want, &strict_out, &ctx);
+                        ok = bigint_compare(&got, &want) == 0;
+                        cases++;
+                    }
+                }
+                montgomery_ctx_free(&ctx);
+                if (!ok) {
+                    printf("   ❌ Mismatch for %d-word modulus, shape %d\n", k, shape);
+                }
+            }
+        }
+        if (ok) {
+            printf("   📊 %d kernel results congruent to the strict ones\n", cases);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: lazy and strict exponentiation agree, full-length and one-word exponents */
+    {
+        total++;
+        printf("\n🧪 Test %d: montgomery_exp / montgomery_exp_word agree with lazy reduction on and off\n", total);
+        int ok = 1;
+        for (int w = 0; w < num_widths && ok; w++) {
+            for (int shape = 0; shape < 2 && ok; shape++) {
+                int k = widths[w];
+                bigint_t n, wide, base, exp, lazy_res, strict_res;
+                karatsuba_test_operand(&n, k, shape, &seed);
+                n.words[0] |= 1;
+                karatsuba_test_operand(&wide, k, 0, &seed);
+                karatsuba_test_operand(&exp, k < 16 ? k : 16, 0, &seed);
+                bigint_mod(&base, &wide, &n);
+                montgomery_ctx_t ctx;
+                ok = montgomery_ctx_init(&ctx, &n) == 0;
+                
+                montgomery_set_lazy_reduction(1);
+                ok = ok && montgomery_exp(&lazy_res, &base, &exp, &ctx) == 0;
+                montgomery_set_lazy_reduction(0);
+                ok = ok && montgomery_exp(&strict_res, &base, &exp, &ctx) == 0 &&
+                     bigint_compare(&lazy_res, &strict_res) == 0 && bigint_compare(&lazy_res, &n) < 0;
+                
+                const bigint_word_t words[] = {2, 3, 17, 65537, 65536};
+                for (int e = 0; e < 5 && ok; e++) {
+                    montgomery_set_lazy_reduction(1);
+                    ok = montgomery_exp_word(&lazy_res, &base, words[e], &ctx) == 0;
+                    montgomery_set_lazy_reduction(0);
+                    ok = ok && montgomery_exp_word(&strict_res, &base, words[e], &ctx) == 0 &&
+                         bigint_compare(&lazy_res, &strict_res) == 0 && bigint_compare(&lazy_res, &n) < 0;
+                }
+                montgomery_ctx_free(&ctx);
+                if (!ok) {
+                    printf("   ❌ Mismatch for %d-word modulus, shape %d\n", k, shape);
+                }
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: a full RSA round trip with lazy reduction, and the strict loop's cost for reference */
+    {
+        total++;
+        printf("\n🧪 Test %d: 1024-bit round trip, lazy against strict timing\n", total);
+        rsa_4096_key_t pub_key, priv_key;
+        int ok = rsa_4096_load_key(&pub_key, n_1024, "65537", 0) == 0 &&
+                 rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) == 0 &&
+                 rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) == 0;
+        uint8_t message[16] = {0x4C, 0x41, 0x5A, 0x59}, cipher[128], back[128];
+        clock_t t_lazy = 0, t_strict = 0;
+        for (int mode = 1; mode >= 0 && ok; mode--) {
+            montgomery_set_lazy_reduction(mode);
+            clock_t start = clock();
+            for (int r = 0; r < 4 && ok; r++) {
+                size_t cipher_len = 0, back_len = 0;
+                ok = rsa_4096_encrypt_binary(&pub_key, message, sizeof(message), cipher, sizeof(cipher),
+                                             &cipher_len) == 0 &&
+                     rsa_4096_decrypt_binary(&priv_key, cipher, cipher_len, back, sizeof(back), &back_len) == 0 &&
+                     back_len == sizeof(message) && memcmp(back, message, back_len) == 0;
+            }
+            *(mode ? &t_lazy : &t_strict) = clock() - start;
+        }
+        if (ok) {
+            printf("   📊 4 round trips: lazy %.2f ms, strict %.2f ms\n",
+                   1000.0 * (double)t_lazy / CLOCKS_PER_SEC, 1000.0 * (double)t_strict / CLOCKS_PER_SEC);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+        rsa_4096_free(&pub_key);
+        rsa_4096_free(&priv_key);
+    }
+    
+    montgomery_set_lazy_reduction(saved_lazy);
+    montgomery_simd_select(MONTGOMERY_SIMD_AUTO);
+    
+    printf("\n===============================================\n");
+    printf("LAZY REDUCTION SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+typedef struct {
+    const rsa_4096_key_t *priv;
+    const uint8_t (*ciphers)[128];
+    const size_t *cipher_lens;
+    int count;
+    int rounds;
+    int wrong;
+    bigint_t vf;    /* Thread's pair after its last decrypt, normal form */
+} blinding_test_worker_t;
+
+static void *blinding_test_worker_main(void *arg) {
+    blinding_test_worker_t *w = (blinding_test_worker_t *)arg;
+    for (int i = 0; i < w->rounds; i++) {
+        int which = i % w->count;
+        uint8_t back[128];
+        size_t back_len = 0;
+        if (rsa_4096_decrypt_binary(w->priv, w->ciphers[which], w->cipher_lens[which], back, sizeof(back),
+                                    &back_len) != 0 || back_len != 1 || back[0] != (uint8_t)(which + 1)) {
+            w->wrong++;
+        }
+    }
+    mont_residue_t vf, vi;
+    bigint_t form;
+    bigint_init(&w->vf);
+    if (rsa_4096_blinding_next(w->priv, &vf, &vi, NULL) == 0) {
+        mont_residue_to_bigint(&form, &vf, &w->priv->mont_ctx);
+        montgomery_from_form(&w->vf, &form, &w->priv->mont_ctx);
+    }
+    return NULL;
+}
+
+int test_blinding(void) {
+    printf("===============================================\n");
+    printf("🔍 RSA BLINDING TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x424C4E44u;
+    enum { MESSAGES = 5 };
+    rsa_4096_key_t pub_key, plain_key, crt_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&plain_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key(&crt_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&crt_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Failed to load the 1024-bit test key\n");
+        return -1;
+    }
+    uint8_t ciphers[MESSAGES][128];
+    size_t cipher_lens[MESSAGES];
+    for (int i = 0; i < MESSAGES; i++) {
+        uint8_t message = (uint8_t)(i + 1);
+        if (rsa_4096_encrypt_binary(&pub_key, &message, 1, ciphers[i], sizeof(ciphers[i]), &cipher_lens[i]) != 0) {
+            printf("❌ Failed to encrypt the test messages\n");
+            return -1;
+        }
+    }
+    
+    /* Test 1: the binary inverse across widths, plus the non-invertible cases */
+    {
+        total++;
+        printf("\n🧪 Test %d: bigint_mod_inverse_odd against a * a^(-1) = 1 mod m\n", total);
+        const int widths[] = {1, 3, 16, 1024 / BIGINT_WORD_SIZE, MONTGOMERY_MAX_WORDS};
+        int ok = 1, checked = 0;
+        for (int w = 0; w < 5 && ok; w++) {
+            for (int c = 0; c < 6 && ok; c++) {
+                bigint_t m, a, inv, product, rem;
+                karatsuba_test_operand(&m, widths[w], c == 0 ? 1 : 0, &seed);
+                m.words[0] |= 1;
+                karatsuba_test_operand(&a, widths[w], c == 1 ? 1 : 0, &seed);
+                int ret = bigint_mod_inverse_odd(&inv, &a, &m);
+                if (ret == -3) {
+                    continue;   /* Random a shared a factor with m */
+                }
+                ok = ret == 0 && bigint_compare(&inv, &m) < 0 && bigint_mul(&product, &a, &inv) == 0 &&
+                     bigint_mod(&rem, &product, &m) == 0 && bigint_is_one(&rem);
+                checked++;
+                if (!ok) {
+                    printf("   ❌ Wrong inverse for %d-word modulus, case %d\n", widths[w], c);
+                }
+            }
+        }
+        
+        /* 7 * 13 = 91 = 1 mod 15; 6 and 0 have no inverse; even moduli are refused */
+        bigint_t m, a, inv;
+        bigint_set_u32(&m, 15);
+        bigint_set_u32(&a, 7);
+        ok = ok && bigint_mod_inverse_odd(&inv, &a, &m) == 0 && inv.used == 1 && inv.words[0] == 13;
+        bigint_set_u32(&a, 6);
+        ok = ok && bigint_mod_inverse_odd(&inv, &a, &m) == -3;
+        bigint_set_u32(&a, 30);
+        ok = ok && bigint_mod_inverse_odd(&inv, &a, &m) == -3;
+        bigint_set_u32(&m, 16);
+        bigint_set_u32(&a, 7);
+        ok = ok && bigint_mod_inverse_odd(&inv, &a, &m) == -2;
+        if (ok) {
+            printf("   📊 %d random inverses verified\n", checked);
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 2: blinded decrypts match the plaintexts, through several per-thread refreshes */
+    {
+        total++;
+        printf("\n🧪 Test %d: Blinded decrypt, CRT and full-size, single and lock-step, across refreshes\n", total);
+        int ok = rsa_4096_key_enable_blinding(&pub_key) == -2 && !pub_key.has_blinding &&
+                 rsa_4096_key_enable_blinding(&plain_key) == 0 && rsa_4096_key_enable_blinding(&crt_key) == 0 &&
+                 plain_key.blinding_id != crt_key.blinding_id;
+        rsa_4096_key_t *keys[2] = {&plain_key, &crt_key};
+        int rounds = 2 * RSA_4096_BLINDING_REFRESH + 3;
+        for (int k = 0; k < 2 && ok; k++) {
+            for (int i = 0; i < rounds && ok; i++) {
+                uint8_t back[128];
+                size_t back_len = 0;
+                int which = i % MESSAGES;
+                ok = rsa_4096_decrypt_binary(keys[k], ciphers[which], cipher_lens[which], back, sizeof(back),
+                                             &back_len) == 0 && back_len == 1 && back[0] == (uint8_t)(which + 1);
+            }
+            
+            /* The lock-step batch path blinds each lane itself */
+            rsa_4096_batch_item_t items[MESSAGES];
+            uint8_t outs[MESSAGES][128];
+            for (int i = 0; i < MESSAGES; i++) {
+                items[i] = (rsa_4096_batch_item_t){ciphers[i], cipher_lens[i], outs[i], sizeof(outs[i]), 0, -2};
+            }
+            ok = ok && rsa_4096_decrypt_binary_multi(keys[k], items, MESSAGES, NULL) == 0;
+            for (int i = 0; i < MESSAGES && ok; i++) {
+                ok = items[i].output_len == 1 && outs[i][0] == (uint8_t)(i + 1);
+            }
+            if (!ok) {
+                printf("   ❌ Blinded decrypt failed for the %s key\n", k ? "CRT" : "full-size");
+            }
+        }
+        
+        /* Disabling falls back to the plain path */
+        rsa_4096_key_disable_blinding(&plain_key);
+        uint8_t back[128];
+        size_t back_len = 0;
+        ok = ok && !plain_key.has_blinding &&
+             rsa_4096_decrypt_binary(&plain_key, ciphers[0], cipher_lens[0], back, sizeof(back), &back_len) == 0 &&
+             back_len == 1 && back[0] == 1;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: every pair handed out satisfies vf^d * vi = 1, successive pairs are squares */
+    {
+        total++;
+        printf("\n🧪 Test %d: Pair relation and squaring updates\n", total);
+        const montgomery_ctx_t *ctx = &crt_key.mont_ctx;
+        rsa_4096_blinding_thread_clear();
+        bigint_t prev, first;
+        bigint_init(&prev);
+        bigint_init(&first);
+        int ok = 1;
+        for (int i = 0; i < RSA_4096_BLINDING_REFRESH + 2 && ok; i++) {
+            mont_residue_t vf, vi;
+            bigint_t form, f, v, fd, product, rem;
+            ok = rsa_4096_blinding_next(&crt_key, &vf, &vi, NULL) == 0;
+            mont_residue_to_bigint(&form, &vf, ctx);
+            ok = ok && montgomery_from_form(&f, &form, ctx) == 0;
+            mont_residue_to_bigint(&form, &vi, ctx);
+            ok = ok && montgomery_from_form(&v, &form, ctx) == 0 &&
+                 montgomery_exp(&fd, &f, &crt_key.exponent, ctx) == 0 && bigint_mul(&product, &fd, &v) == 0 &&
+                 bigint_mod(&rem, &product, &crt_key.n) == 0 && bigint_is_one(&rem);
+            if (ok && i > 0 && i < RSA_4096_BLINDING_REFRESH) {
+                /* Within one derivation each pair is the previous one squared */
+                ok = bigint_mul(&product, &prev, &prev) == 0 && bigint_mod(&rem, &product, &crt_key.n) == 0 &&
+                     bigint_compare(&rem, &f) == 0;
+            }
+            if (i == 0) {
+                bigint_copy(&first, &f);
+            }
+            ok = ok && bigint_compare(&f, &crt_key.blind_vf) != 0;
+            bigint_copy(&prev, &f);
+        }
+        
+        /* A cleared thread draws a fresh exponent */
+        mont_residue_t vf, vi;
+        bigint_t form, f;
+        rsa_4096_blinding_thread_clear();
+        ok = ok && rsa_4096_blinding_next(&crt_key, &vf, &vi, NULL) == 0;
+        mont_residue_to_bigint(&form, &vf, ctx);
+        ok = ok && montgomery_from_form(&f, &form, ctx) == 0 && bigint_compare(&f, &first) != 0;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ Pair relation broken\n");
+        }
+    }
+    
+    /* Test 4: threads sharing the key decrypt correctly, each with a pair of its own */
+    {
+        total++;
+        printf("\n🧪 Test %d: Four threads decrypting with one blinded key\n", total);
+        enum { THREADS = 4 };
+        blinding_test_worker_t workers[THREADS];
+        pthread_t tids[THREADS];
+        int started = 0, ok = 1;
+        for (int t = 0; t < THREADS; t++) {
+            workers[t] = (blinding_test_worker_t){&crt_key, (const uint8_t (*)[128])ciphers, cipher_lens,
+                                                  MESSAGES, RSA_4096_BLINDING_REFRESH + 8, 0, {{0}, 0, 0}};
+            if (pthread_create(&tids[t], NULL, blinding_test_worker_main, &workers[t]) != 0) break;
+            started++;
+        }
+        int wrong = 0;
+        for (int t = 0; t < started; t++) {
+            pthread_join(tids[t], NULL);
+            wrong += workers[t].wrong;
+        }
+        ok = started == THREADS && wrong == 0;
+        for (int t = 0; t < THREADS && ok; t++) {
+            ok = !bigint_is_zero(&workers[t].vf);
+            for (int u = 0; u < t && ok; u++) {
+                ok = bigint_compare(&workers[t].vf, &workers[u].vf) != 0;
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        } else {
+            printf("   ❌ %d wrong decrypts from %d threads\n", wrong, started);
+        }
+    }
+    
+    rsa_4096_blinding_thread_clear();
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&plain_key);
+    rsa_4096_free(&crt_key);
+    
+    printf("\n===============================================\n");
+    printf("BLINDING SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+int test_fixed_io(void) {
+    printf("===============================================\n");
+    printf("🔍 FIXED-LENGTH BLOCK I/O TESTING\n");
+    printf("===============================================\n");
+    
+    int passed = 0, total = 0;
+    uint32_t seed = 0x46495845u;
+    
+    /* Test 1: word-wide conversions against a byte-at-a-time reference, every alignment */
+    {
+        total++;
+        printf("\n🧪 Test %d: Word-wide big-endian import/export against a bytewise reference\n", total);
+        int ok = 1;
+        for (size_t len = 1; len <= 3 * BIGINT_WORD_BYTES + 1 && ok; len++) {
+            for (int c = 0; c < 4 && ok; c++) {
+                uint8_t bytes[3 * BIGINT_WORD_BYTES + 1], out[4 * BIGINT_WORD_BYTES + 3];
+                for (size_t i = 0; i < len; i++) {
+                    seed = seed * 1103515245u + 12345u;
+                    bytes[i] = (uint8_t)(seed >> 16);
+                }
+                if (c == 1 && len > 0) bytes[0] = 0;   /* Leading zero bytes */
+                if (c == 2) memset(bytes, 0xFF, len);
+                if (c == 3) memset(bytes, 0, len);
+                
+                bigint_t got, want;
+                bigint_init(&want);
+                for (size_t i = 0; i < len; i++) {
+                    size_t pos = len - 1 - i;
+                    want.words[pos / BIGINT_WORD_BYTES] |= (bigint_word_t)bytes[i] << (8 * (pos % BIGINT_WORD_BYTES));
+                }
+                want.used = (int)((len + BIGINT_WORD_BYTES - 1) / BIGINT_WORD_BYTES);
+                bigint_normalize(&want);
+                ok = bigint_from_binary(&got, bytes, len) == 0 && bigint_compare(&got, &want) == 0;
+                
+                /* Fixed export: zero padding in front, exact fit, one byte short */
+                size_t sig = (size_t)(bigint_bit_length(&want) + 7) / 8;
+                for (size_t pad = 0; pad <= BIGINT_WORD_BYTES + 1 && ok; pad++) {
+                    memset(out, 0xA5, sizeof(out));
+                    ok = bigint_to_binary_fixed(&got, out, len + pad) == 0 && out[len + pad] == 0xA5;
+                    for (size_t i = 0; i < pad && ok; i++) ok = out[i] == 0;
+                    ok = ok && memcmp(out + pad, bytes, len) == 0;
+                }
+                ok = ok && (sig == 0 || bigint_to_binary_fixed(&got, out, sig - 1) == -2);
+                
+                /* Variable export: minimal form at the front, the rest zeroed */
+                size_t written = 0;
+                memset(out, 0xA5, sizeof(out));
+                ok = ok && bigint_to_binary(&got, out, len + 2, &written) == 0 && written == (sig ? sig : 1) &&
+                     memcmp(out, bytes + (len - sig), sig) == 0 && out[written] == 0 && out[len + 1] == 0 &&
+                     out[len + 2] == 0xA5;
+                if (!ok) {
+                    printf("   ❌ Mismatch for %zu bytes, case %d\n", len, c);
+                }
+            }
+        }
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_key_t pub_key, priv_key;
+    if (rsa_4096_load_key(&pub_key, n_1024, "65537", 0) != 0 ||
+        rsa_4096_load_key(&priv_key, n_1024, d_1024, 1) != 0 ||
+        rsa_4096_load_key_crt(&priv_key, p_1024, q_1024, dp_1024, dq_1024, qinv_1024) != 0) {
+        printf("❌ Failed to load the 1024-bit test key\n");
+        return -1;
+    }
+    size_t k = rsa_4096_key_bytes(&pub_key);
+    
+    /* Test 2: single blocks match the variable-length calls, in place too, and reject bad blocks */
+    {
+        total++;
+        printf("\n🧪 Test %d: rsa_4096_encrypt_fixed / rsa_4096_decrypt_fixed on %zu-byte blocks\n", total, k);
+        int ok = k == 128;
+        for (int r = 0; r < 6 && ok; r++) {
+            uint8_t block[128], cipher[128], back[128], var[128];
+            memset(block, 0, sizeof(block));
+            for (size_t i = (size_t)(r * 20) + 1; i < k; i++) {
+                seed = seed * 1103515245u + 12345u;
+                block[i] = (uint8_t)(seed >> 16);
+            }
+            size_t var_len = 0;
+            ok = rsa_4096_encrypt_fixed(&pub_key, block, cipher, k) == 0 &&
+                 rsa_4096_encrypt_binary(&pub_key, block, k, var, sizeof(var), &var_len) == 0 && var_len <= k;
+            for (size_t i = 0; i < k - var_len && ok; i++) ok = cipher[i] == 0;
+            ok = ok && memcmp(cipher + (k - var_len), var, var_len) == 0;
+            
+            /* Decrypt in place: the leading zeros of the plaintext block come back */
+            memcpy(back, cipher, k);
+            ok = ok && rsa_4096_decrypt_fixed(&priv_key, back, back, k) == 0 && memcmp(back, block, k) == 0;
+        }
+        
+        uint8_t block[129], out[129];
+        memset(block, 0xFF, sizeof(block));
+        ok = ok && rsa_4096_encrypt_fixed(&pub_key, block, out, k) == -4 &&
+             rsa_4096_encrypt_fixed(&pub_key, block, out, k - 1) == -3 &&
+             rsa_4096_encrypt_fixed(&pub_key, block, out, k + 1) == -3 &&
+             rsa_4096_decrypt_fixed(&pub_key, block, out, k) == -2 &&
+             rsa_4096_decrypt_fixed_ws(&priv_key, NULL, out, k, NULL) == -1;
+        if (ok) {
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    /* Test 3: lock-step fixed blocks, more items than lanes, one malformed item */
+    {
+        total++;
+        printf("\n🧪 Test %d: Fixed-length multi-buffer blocks\n", total);
+        enum { ITEMS = 11, BAD = 7 };
+        uint8_t plain[ITEMS][128], cipher[ITEMS][128], back[ITEMS][128], single[128];
+        rsa_4096_batch_item_t items[ITEMS];
+        for (int i = 0; i < ITEMS; i++) {
+            memset(plain[i], 0, k);
+            for (size_t j = (size_t)i; j < k; j++) {
+                seed = seed * 1103515245u + 12345u;
+                plain[i][j] = (uint8_t)(seed >> 16);
+            }
+            plain[i][i] = 0;
+            items[i] = (rsa_4096_batch_item_t){plain[i], i == BAD ? k - 1 : k, cipher[i], k, 0, -2};
+        }
+        rsa_4096_workspace_t *ws = rsa_4096_workspace_new();
+        int ok = ws != NULL && rsa_4096_encrypt_fixed_multi(&pub_key, items, ITEMS, ws) == -3;
+        for (int i = 0; i < ITEMS && ok; i++) {
+            if (i == BAD) {
+                ok = items[i].status == -3 && items[i].output_len == 0;
+                continue;
+            }
+            ok = items[i].status == 0 && items[i].output_len == k &&
+                 rsa_4096_encrypt_fixed(&pub_key, plain[i], single, k) == 0 && memcmp(single, cipher[i], k) == 0;
+        }
+        for (int i = 0; i < ITEMS; i++) {
+            items[i] = (rsa_4096_batch_item_t){cipher[i], k, back[i], k, 0, -2};
+        }
+        memcpy(cipher[BAD], cipher[0], k);
+        ok = ok && rsa_4096_decrypt_fixed_multi(&priv_key, items, ITEMS, ws) == 0;
+        for (int i = 0; i < ITEMS && ok; i++) {
+            ok = items[i].status == 0 && items[i].output_len == k && memcmp(back[i], plain[i == BAD ? 0 : i], k) == 0;
+        }
+        rsa_4096_workspace_free(ws);
+        if (ok) {
+            printf("   📊 %d lock-step lanes\n", montgomery_multi_lanes());
+            printf("✅ Test %d PASSED\n", total);
+            passed++;
+        }
+    }
+    
+    rsa_4096_free(&pub_key);
+    rsa_4096_free(&priv_key);
+    
+    printf("\n===============================================\n");
+    printf("FIXED-LENGTH I/O SUMMARY:\n");
+    printf("  Tests passed: %d/%d\n", passed, total);
+    printf("  Status: %s\n", passed == total ? "✅ ALL TESTS PASSED" : "❌ SOME TESTS FAILED");
+    printf("===============================================\n");
+    
+    return passed == total ? 0 : -1;
+}
+
+/* ===================== ROUND-TRIP VALIDATION HELPER FUNCTIONS ===================== */
+
+/**
+ * @brief Validate Montgomery round-trip conversion
+ * TODO: This helper function validates that a value survives Montgomery conversion
+ */
+int validate_montgomery_round_trip(const bigint_t *value, const montgomery_ctx_t *ctx) {
+    if (value == NULL || ctx == NULL || !ctx->is_active) {
+        return -1;
+    }
+    
+    bigint_t mont_form, recovered;
+    bigint_init(&mont_form);
+    bigint_init(&recovered);
+    
+    /* Convert to Montgomery form */
+    int ret = montgomery_to_form(&mont_form, value, ctx);
+    if (ret != 0) {
+        CHECKPOINT(LOG_ERROR, "Montgomery to_form failed in validation");
+        return -2;
+    }
+    
+    /* Convert back from Montgomery form */
+    ret = montgomery_from_form(&recovered, &mont_form, ctx);
+    if (ret != 0) {
+        CHECKPOINT(LOG_ERROR, "Montgomery from_form failed in validation");
+        return -3;
+    }
+    
+    /* Compare original and recovered */
+    if (bigint_compare(value, &recovered) != 0) {
+        CHECKPOINT(LOG_ERROR, "Montgomery round-trip validation FAILED");
+        debug_print_bigint("original", value);
+        debug_print_bigint("recovered", &recovered);
+        return -4;
+    }
+    
+    /* Independent check of from_form: mont_form * R^(-1) mod n, with R^(-1) derived on a local copy */
+    montgomery_ctx_t local_ctx = *ctx;
+    bigint_t r_inv, n, product, expected;
+    montgomery_ctx_get_modulus(ctx, &n);
+    if (montgomery_ctx_get_r_inv(&local_ctx, &r_inv) != 0 ||
+        bigint_mul(&product, &mont_form, &r_inv) != 0 ||
+        bigint_mod(&expected, &product, &n) != 0 ||
+        bigint_compare(&expected, &recovered) != 0) {
+        CHECKPOINT(LOG_ERROR, "Montgomery from_form disagrees with multiplication by R^(-1)");
+        return -5;
     }
     
     CHECKPOINT(LOG_DEBUG, "Montgomery round-trip validation PASSED");
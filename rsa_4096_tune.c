@@ -0,0 +1,552 @@
+/**
+ * @file rsa_4096_tune.c
+ * @brief Self-calibrating algorithm cutovers with a persistent tuning profile
+ *
+ * The hybrid dispatcher decides between scalar and vector Montgomery kernels,
+ * sliding-window widths, Karatsuba and schoolbook multiplication, Montgomery
+ * and the plain square-and-multiply, and CRT and full-size decryption. The
+ * built-in cutovers were picked on one machine; this module measures them on
+ * the running one with short microbenchmarks, applies them through the
+ * module setters (SIMD kernel, window table, Karatsuba cutoff, hybrid and CRT
+ * cutovers) and saves them as a small text profile so later starts skip the
+ * measurement.
+ *
+ * Every setting is process-wide: calibrate and apply before starting worker
+ * threads, as with montgomery_simd_select().
+ *
+ * @author TouanRichi
+ * @date 2025-07-29 13:14:49 UTC
+ * @version FINAL_COMPLETE_FIXED_v8.4
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "rsa_4096.h"
+
+#define TUNE_REPS 5        /* Best of this many runs per measurement */
+#define TUNE_MARGIN 0.98   /* A wider window must save 2% to be worth its table */
+
+/* ===================== MEASUREMENT HELPERS ===================== */
+
+static double tune_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Deterministic operand of exactly bits bits (top bit set), odd when requested
+ */
+static void tune_operand(bigint_t *out, int bits, int odd, uint32_t *seed) {
+    uint8_t bytes[512];
+    size_t len = (size_t)(bits + 7) / 8;
+    for (size_t i = 0; i < len; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        bytes[i] = (uint8_t)(*seed >> 16);
+    }
+    int top = (bits - 1) % 8;
+    bytes[0] = (uint8_t)((bytes[0] & ((1u << top) - 1)) | (1u << top));
+    if (odd) {
+        bytes[len - 1] |= 1;
+    }
+    bigint_from_binary(out, bytes, len);
+}
+
+typedef struct {
+    bigint_t n, base, exp, result;
+    montgomery_ctx_t ctx;
+} tune_exp_t;
+
+/**
+ * @brief Random odd bits-bit modulus with a context, a reduced base and an exp_bits exponent
+ */
+static int tune_exp_setup(tune_exp_t *w, int bits, int exp_bits, uint32_t *seed) {
+    tune_operand(&w->n, bits, 1, seed);
+    tune_operand(&w->base, bits - 1, 0, seed);
+    tune_operand(&w->exp, exp_bits, 1, seed);
+    return montgomery_ctx_init(&w->ctx, &w->n);
+}
+
+/* window_bits: MONTGOMERY_WINDOW_AUTO or a fixed width; traditional: bigint_mod_exp instead */
+static double tune_time_exp(tune_exp_t *w, int window_bits, int traditional) {
+    double best = 1e30;
+    for (int rep = 0; rep < TUNE_REPS; rep++) {
+        double start = tune_now();
+        int ret = traditional ? bigint_mod_exp(&w->result, &w->base, &w->exp, &w->n)
+                              : montgomery_exp_window(&w->result, &w->base, &w->exp, &w->ctx, window_bits);
+        double elapsed = tune_now() - start;
+        if (ret != 0) {
+            return 1e30;
+        }
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Smallest size from which fast[] beats slow[] at every larger size
+ *
+ * sizes ascend. Returns below when fast always wins and above when it loses
+ * at the largest size.
+ */
+static int tune_cutover(const int *sizes, const double *fast, const double *slow, int count, int below,
+                        int above) {
+    int last_loss = -1;
+    for (int i = 0; i < count; i++) {
+        if (fast[i] >= slow[i]) {
+            last_loss = i;
+        }
+    }
+    if (last_loss < 0) {
+        return below;
+    }
+    return last_loss + 1 < count ? sizes[last_loss + 1] : above;
+}
+
+/* ===================== CALIBRATION STEPS ===================== */
+
+/**
+ * @brief Fastest vector kernel (or none) on a 2048-bit modular exponentiation
+ */
+static int tune_simd_kernel(uint32_t *seed) {
+    int best_kernel = MONTGOMERY_SIMD_NONE;
+    tune_exp_t *w = (tune_exp_t *)malloc(sizeof(tune_exp_t));
+    if (w == NULL || tune_exp_setup(w, 2048, 512, seed) != 0) {
+        free(w);
+        return best_kernel;
+    }
+    
+    double best = 1e30;
+    const int detected = montgomery_simd_detect();
+    for (int kernel = MONTGOMERY_SIMD_NONE; kernel <= detected; kernel++) {
+        if (montgomery_simd_select(kernel) != kernel) {
+            continue;
+        }
+        double t = tune_time_exp(w, MONTGOMERY_WINDOW_AUTO, 0);
+        TRACE(LOG_INFO, "[TUNE] %s kernel: %.3f ms per 2048-bit exponentiation", montgomery_simd_name(kernel),
+              t * 1e3);
+        if (t < best) {
+            best = t;
+            best_kernel = kernel;
+        }
+    }
+    montgomery_ctx_free(&w->ctx);
+    free(w);
+    return best_kernel;
+}
+
+/**
+ * @brief Smallest modulus from which the selected vector kernel beats scalar CIOS
+ */
+static int tune_simd_min_bits(uint32_t *seed) {
+    static const int sizes[] = {256, 384, 512, 768, 1024, 1536};
+    enum { COUNT = (int)(sizeof(sizes) / sizeof(sizes[0])) };
+    double vec[COUNT], scalar[COUNT];
+    tune_exp_t *w = (tune_exp_t *)malloc(sizeof(tune_exp_t));
+    if (w == NULL) {
+        return MONTGOMERY_SIMD_MIN_BITS;
+    }
+    
+    for (int i = 0; i < COUNT; i++) {
+        vec[i] = scalar[i] = 1e30;
+        if (tune_exp_setup(w, sizes[i], sizes[i] / 2, seed) != 0) {
+            continue;
+        }
+        montgomery_simd_set_min_bits(64);
+        vec[i] = tune_time_exp(w, MONTGOMERY_WINDOW_AUTO, 0);
+        montgomery_simd_set_min_bits(4096);
+        scalar[i] = tune_time_exp(w, MONTGOMERY_WINDOW_AUTO, 0);
+        montgomery_ctx_free(&w->ctx);
+    }
+    free(w);
+    return tune_cutover(sizes, vec, scalar, COUNT, sizes[0], 2048);
+}
+
+/**
+ * @brief Window table from the fastest fixed width per exponent length
+ *
+ * Widths are made non-decreasing in the exponent length, then each width
+ * switches on halfway between the last length that preferred a narrower one
+ * and the first that preferred it.
+ */
+static void tune_windows(int *min_bits, uint32_t *seed) {
+    static const int lengths[] = {16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048};
+    enum { COUNT = (int)(sizeof(lengths) / sizeof(lengths[0])) };
+    int best_width[COUNT];
+    tune_exp_t *w = (tune_exp_t *)malloc(sizeof(tune_exp_t));
+    for (int i = 0; i <= MONTGOMERY_MAX_WINDOW; i++) {
+        min_bits[i] = 0;
+    }
+    if (w == NULL) {
+        montgomery_get_window_thresholds(min_bits);
+        return;
+    }
+    
+    for (int i = 0; i < COUNT; i++) {
+        best_width[i] = i > 0 ? best_width[i - 1] : 1;
+        if (tune_exp_setup(w, 1024, lengths[i], seed) != 0) {
+            continue;
+        }
+        double best = 1e30;
+        int width = 1;
+        for (int k = 1; k <= MONTGOMERY_MAX_WINDOW; k++) {
+            double t = tune_time_exp(w, k, 0);
+            if (t < best * TUNE_MARGIN) {
+                best = t;
+                width = k;
+            }
+        }
+        if (width > best_width[i]) {
+            best_width[i] = width;
+        }
+        montgomery_ctx_free(&w->ctx);
+    }
+    free(w);
+    
+    for (int i = 0; i < COUNT; i++) {
+        int k = best_width[i];
+        if (k >= 2 && min_bits[k] == 0) {
+            min_bits[k] = i == 0 ? lengths[0] : (lengths[i - 1] + lengths[i]) / 2 + 1;
+        }
+    }
+}
+
+/**
+ * @brief Karatsuba cutoff (in words) with the lowest total time over 512..4096-bit products
+ */
+static int tune_karatsuba(uint32_t *seed) {
+    static const int candidate_bits[] = {256, 384, 512, 768, 1024, 1536, 2048, 16384};
+    static const int operand_bits[] = {512, 1024, 2048, 4096};
+    enum { CANDIDATES = (int)(sizeof(candidate_bits) / sizeof(candidate_bits[0])) };
+    enum { OPERANDS = (int)(sizeof(operand_bits) / sizeof(operand_bits[0])) };
+    enum { ITERATIONS = 16 };
+    bigint_t *ops = (bigint_t *)malloc((2 * OPERANDS + 1) * sizeof(bigint_t));
+    if (ops == NULL) {
+        return BIGINT_KARATSUBA_CUTOFF;
+    }
+    for (int i = 0; i < OPERANDS; i++) {
+        tune_operand(&ops[2 * i], operand_bits[i], 0, seed);
+        tune_operand(&ops[2 * i + 1], operand_bits[i], 0, seed);
+    }
+    
+    int best_cutoff = BIGINT_KARATSUBA_CUTOFF;
+    double best = 1e30;
+    for (int c = 0; c < CANDIDATES; c++) {
+        int words = candidate_bits[c] / BIGINT_WORD_SIZE;
+        if (bigint_set_karatsuba_cutoff(words) != 0) {
+            continue;
+        }
+        double total = 0;
+        for (int i = 0; i < OPERANDS; i++) {
+            double run = 1e30;
+            for (int rep = 0; rep < TUNE_REPS; rep++) {
+                double start = tune_now();
+                for (int it = 0; it < ITERATIONS; it++) {
+                    bigint_mul(&ops[2 * OPERANDS], &ops[2 * i], &ops[2 * i + 1]);
+                }
+                double elapsed = tune_now() - start;
+                if (elapsed < run) {
+                    run = elapsed;
+                }
+            }
+            total += run;
+        }
+        TRACE(LOG_INFO, "[TUNE] Karatsuba from %d words: %.3f ms", words, total * 1e3);
+        if (total < best) {
+            best = total;
+            best_cutoff = words;
+        }
+    }
+    free(ops);
+    return best_cutoff;
+}
+
+/**
+ * @brief Smallest modulus from which Montgomery beats plain square-and-multiply
+ */
+static int tune_montgomery_min_bits(uint32_t *seed) {
+    static const int sizes[] = {16, 24, 32, 48, 64, 96, 128, 192, 256};
+    enum { COUNT = (int)(sizeof(sizes) / sizeof(sizes[0])) };
+    double mont[COUNT], plain[COUNT];
+    tune_exp_t *w = (tune_exp_t *)malloc(sizeof(tune_exp_t));
+    if (w == NULL) {
+        return HYBRID_MONTGOMERY_MIN_BITS;
+    }
+    
+    for (int i = 0; i < COUNT; i++) {
+        mont[i] = plain[i] = 1e30;
+        if (tune_exp_setup(w, sizes[i], sizes[i], seed) != 0) {
+            continue;
+        }
+        mont[i] = tune_time_exp(w, MONTGOMERY_WINDOW_AUTO, 0);
+        plain[i] = tune_time_exp(w, MONTGOMERY_WINDOW_AUTO, 1);
+        montgomery_ctx_free(&w->ctx);
+    }
+    free(w);
+    return tune_cutover(sizes, mont, plain, COUNT, 8, 512);
+}
+
+/**
+ * @brief Smallest modulus from which two half-size exponentiations beat one full-size one
+ *
+ * A stand-in for CRT decryption that needs no key: the half-size pair runs
+ * half-length exponents and adds one Garner-style multiply and reduction.
+ */
+static int tune_crt_min_bits(uint32_t *seed) {
+    static const int sizes[] = {256, 512, 1024, 2048};
+    enum { COUNT = (int)(sizeof(sizes) / sizeof(sizes[0])) };
+    double crt[COUNT], full[COUNT];
+    tune_exp_t *w = (tune_exp_t *)malloc(3 * sizeof(tune_exp_t));
+    if (w == NULL) {
+        return RSA_4096_CRT_MIN_BITS;
+    }
+    
+    for (int i = 0; i < COUNT; i++) {
+        crt[i] = full[i] = 1e30;
+        int half = sizes[i] / 2;
+        if (tune_exp_setup(&w[0], sizes[i], sizes[i], seed) != 0) {
+            continue;
+        }
+        if (tune_exp_setup(&w[1], half, half, seed) != 0 || tune_exp_setup(&w[2], half, half, seed) != 0) {
+            montgomery_ctx_free(&w[0].ctx);
+            montgomery_ctx_free(&w[1].ctx);
+            continue;
+        }
+        full[i] = tune_time_exp(&w[0], MONTGOMERY_WINDOW_AUTO, 0);
+        double start = tune_now();
+        bigint_mul(&w[0].result, &w[1].n, &w[2].base);
+        bigint_mod(&w[0].result, &w[0].result, &w[2].n);
+        double garner = tune_now() - start;
+        crt[i] = tune_time_exp(&w[1], MONTGOMERY_WINDOW_AUTO, 0) + tune_time_exp(&w[2], MONTGOMERY_WINDOW_AUTO, 0) +
+                 garner;
+        for (int j = 0; j < 3; j++) {
+            montgomery_ctx_free(&w[j].ctx);
+        }
+    }
+    free(w);
+    return tune_cutover(sizes, crt, full, COUNT, 0, 4097);
+}
+
+/* ===================== PROFILE API ===================== */
+
+void rsa_4096_tuning_defaults(rsa_4096_tuning_t *tuning) {
+    if (tuning == NULL) {
+        return;
+    }
+    memset(tuning, 0, sizeof(*tuning));
+    tuning->simd_kernel = MONTGOMERY_SIMD_AUTO;
+    tuning->simd_min_bits = MONTGOMERY_SIMD_MIN_BITS;
+    const int windows[MONTGOMERY_MAX_WINDOW + 1] = MONTGOMERY_WINDOW_DEFAULT_BITS;
+    memcpy(tuning->window_min_bits, windows, sizeof(windows));
+    tuning->karatsuba_cutoff = BIGINT_KARATSUBA_CUTOFF;
+    tuning->montgomery_min_bits = HYBRID_MONTGOMERY_MIN_BITS;
+    tuning->crt_min_bits = RSA_4096_CRT_MIN_BITS;
+}
+
+void rsa_4096_tuning_active(rsa_4096_tuning_t *tuning) {
+    if (tuning == NULL) {
+        return;
+    }
+    memset(tuning, 0, sizeof(*tuning));
+    tuning->simd_kernel = montgomery_simd_active();
+    tuning->simd_min_bits = montgomery_simd_min_bits();
+    montgomery_get_window_thresholds(tuning->window_min_bits);
+    tuning->karatsuba_cutoff = bigint_karatsuba_cutoff();
+    tuning->montgomery_min_bits = hybrid_montgomery_min_bits();
+    tuning->crt_min_bits = rsa_4096_crt_min_bits();
+}
+
+/**
+ * @brief Range checks matching the module setters, so apply never stops half-way
+ */
+static int tune_validate(const rsa_4096_tuning_t *t) {
+    int best = montgomery_simd_detect();
+    if (t->simd_kernel != MONTGOMERY_SIMD_AUTO && t->simd_kernel != MONTGOMERY_SIMD_NONE &&
+        (t->simd_kernel < MONTGOMERY_SIMD_NONE || t->simd_kernel > best)) {
+        ERROR_RETURN(-5, "Tuning profile kernel %d not supported on this CPU", t->simd_kernel);
+    }
+    int last = 0;
+    for (int w = 2; w <= MONTGOMERY_MAX_WINDOW; w++) {
+        if (t->window_min_bits[w] < 0 || (t->window_min_bits[w] > 0 && t->window_min_bits[w] <= last)) {
+            ERROR_RETURN(-5, "Tuning profile window %d threshold %d out of order", w, t->window_min_bits[w]);
+        }
+        if (t->window_min_bits[w] > 0) {
+            last = t->window_min_bits[w];
+        }
+    }
+    if (t->simd_min_bits < 64 || t->simd_min_bits > 4096 || t->karatsuba_cutoff < 4 ||
+        t->karatsuba_cutoff > BIGINT_4096_WORDS || t->montgomery_min_bits < 8 || t->montgomery_min_bits > 4096 ||
+        t->crt_min_bits < 0 || t->crt_min_bits > 4097) {
+        ERROR_RETURN(-5, "Tuning profile cutover out of range");
+    }
+    return 0;
+}
+
+int rsa_4096_tuning_apply(const rsa_4096_tuning_t *tuning) {
+    if (tuning == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_tuning_apply");
+    }
+    int ret = tune_validate(tuning);
+    if (ret != 0) {
+        return ret;
+    }
+    
+    montgomery_simd_select(tuning->simd_kernel);
+    montgomery_simd_set_min_bits(tuning->simd_min_bits);
+    montgomery_set_window_thresholds(tuning->window_min_bits);
+    bigint_set_karatsuba_cutoff(tuning->karatsuba_cutoff);
+    hybrid_set_montgomery_min_bits(tuning->montgomery_min_bits);
+    rsa_4096_set_crt_min_bits(tuning->crt_min_bits);
+    TRACE(LOG_INFO, "[TUNE] Applied %s profile: %s kernel from %d bits, Karatsuba from %d words",
+          tuning->calibrated ? "calibrated" : "default", montgomery_simd_name(montgomery_simd_active()),
+          tuning->simd_min_bits, tuning->karatsuba_cutoff);
+    return 0;
+}
+
+int rsa_4096_tuning_calibrate(rsa_4096_tuning_t *tuning) {
+    if (tuning == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_tuning_calibrate");
+    }
+    
+    /* Each step runs under the winners of the steps before it; the caller's settings come back at the end */
+    rsa_4096_tuning_t saved, t;
+    rsa_4096_tuning_active(&saved);
+    rsa_4096_tuning_defaults(&t);
+    rsa_4096_tuning_apply(&t);
+    uint32_t seed = 0x54554E45u;
+    double start = tune_now();
+    
+    t.simd_kernel = tune_simd_kernel(&seed);
+    montgomery_simd_select(t.simd_kernel);
+    if (t.simd_kernel != MONTGOMERY_SIMD_NONE) {
+        t.simd_min_bits = tune_simd_min_bits(&seed);
+    }
+    montgomery_simd_set_min_bits(t.simd_min_bits);
+    tune_windows(t.window_min_bits, &seed);
+    montgomery_set_window_thresholds(t.window_min_bits);
+    t.karatsuba_cutoff = tune_karatsuba(&seed);
+    bigint_set_karatsuba_cutoff(t.karatsuba_cutoff);
+    t.montgomery_min_bits = tune_montgomery_min_bits(&seed);
+    t.crt_min_bits = tune_crt_min_bits(&seed);
+    t.calibrated = 1;
+    
+    rsa_4096_tuning_apply(&saved);
+    TRACE(LOG_INFO, "[TUNE] Calibration took %.1f ms", (tune_now() - start) * 1e3);
+    *tuning = t;
+    return 0;
+}
+
+/* ===================== PROFILE FILES ===================== */
+
+/*
+ * One "key value" pair per line; lines starting with '#' are comments. The
+ * version and limb width must match this build: cutoffs in words and timings
+ * taken with the other limb width do not carry over.
+ */
+int rsa_4096_tuning_save(const rsa_4096_tuning_t *tuning, const char *path) {
+    if (tuning == NULL || path == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_tuning_save");
+    }
+    
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        ERROR_RETURN(-2, "Cannot create tuning profile %s", path);
+    }
+    int ret = 0;
+    fprintf(f, "# RSA-4096 tuning profile\n");
+    fprintf(f, "version %d\n", RSA_4096_TUNING_VERSION);
+    fprintf(f, "limb_bits %d\n", BIGINT_WORD_SIZE);
+    fprintf(f, "calibrated %d\n", tuning->calibrated);
+    fprintf(f, "simd_kernel %d\n", tuning->simd_kernel);
+    fprintf(f, "simd_min_bits %d\n", tuning->simd_min_bits);
+    fprintf(f, "window_min_bits");
+    for (int w = 2; w <= MONTGOMERY_MAX_WINDOW; w++) {
+        fprintf(f, " %d", tuning->window_min_bits[w]);
+    }
+    fprintf(f, "\nkaratsuba_cutoff %d\n", tuning->karatsuba_cutoff);
+    fprintf(f, "montgomery_min_bits %d\n", tuning->montgomery_min_bits);
+    if (fprintf(f, "crt_min_bits %d\n", tuning->crt_min_bits) < 0) ret = -4;
+    if (fclose(f) != 0) ret = -4;
+    if (ret != 0) {
+        ERROR_RETURN(ret, "Failed to write tuning profile %s", path);
+    }
+    return 0;
+}
+
+int rsa_4096_tuning_load(rsa_4096_tuning_t *tuning, const char *path) {
+    if (tuning == NULL || path == NULL) {
+        ERROR_RETURN(-1, "NULL pointer in rsa_4096_tuning_load");
+    }
+    
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        ERROR_RETURN(-2, "Cannot open tuning profile %s", path);
+    }
+    
+    rsa_4096_tuning_t t;
+    rsa_4096_tuning_defaults(&t);
+    int version = -1, limb_bits = -1, seen = 0;
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        int *w = t.window_min_bits;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "version %d", &version) == 1) continue;
+        if (sscanf(line, "limb_bits %d", &limb_bits) == 1) continue;
+        if (sscanf(line, "calibrated %d", &t.calibrated) == 1) continue;
+        if (sscanf(line, "simd_kernel %d", &t.simd_kernel) == 1) { seen |= 1; continue; }
+        if (sscanf(line, "simd_min_bits %d", &t.simd_min_bits) == 1) { seen |= 2; continue; }
+        if (sscanf(line, "window_min_bits %d %d %d %d %d", &w[2], &w[3], &w[4], &w[5], &w[6]) == 5) {
+            seen |= 4;
+            continue;
+        }
+        if (sscanf(line, "karatsuba_cutoff %d", &t.karatsuba_cutoff) == 1) { seen |= 8; continue; }
+        if (sscanf(line, "montgomery_min_bits %d", &t.montgomery_min_bits) == 1) { seen |= 16; continue; }
+        if (sscanf(line, "crt_min_bits %d", &t.crt_min_bits) == 1) { seen |= 32; continue; }
+        fclose(f);
+        ERROR_RETURN(-3, "Unrecognised line in tuning profile %s", path);
+    }
+    fclose(f);
+    
+    if (version != RSA_4096_TUNING_VERSION || limb_bits != BIGINT_WORD_SIZE || seen != 63) {
+        ERROR_RETURN(-3, "Tuning profile %s is version %d for %d-bit limbs or incomplete", path, version,
+                     limb_bits);
+    }
+    int ret = tune_validate(&t);
+    if (ret != 0) {
+        return ret;
+    }
+    *tuning = t;
+    return 0;
+}
+
+int rsa_4096_tuning_init(const char *profile_path, rsa_4096_tuning_t *tuning) {
+    rsa_4096_tuning_t t;
+    /* A missing profile is the normal first start; only an unreadable existing one is reported */
+    if (profile_path != NULL && access(profile_path, F_OK) == 0 && rsa_4096_tuning_load(&t, profile_path) == 0) {
+        int ret = rsa_4096_tuning_apply(&t);
+        if (ret != 0) {
+            return ret;
+        }
+        if (tuning != NULL) *tuning = t;
+        return 0;
+    }
+    
+    int ret = rsa_4096_tuning_calibrate(&t);
+    if (ret == 0) ret = rsa_4096_tuning_apply(&t);
+    if (ret != 0) {
+        return ret;
+    }
+    /* A profile that cannot be written only costs the next start another calibration */
+    if (profile_path != NULL) {
+        rsa_4096_tuning_save(&t, profile_path);
+    }
+    if (tuning != NULL) *tuning = t;
+    return 1;
+}